@@ -1,59 +1,287 @@
 #include "EfiInput.h"
+#include "EfiMonitor.h"
 
-EFI_SIMPLE_POINTER_PROTOCOL *gSimplePointer = NULL;
+EFI_SIMPLE_TEXT_INPUT_EX_PROTOCOL *gTextInputEx = NULL;
+
+/* Keys read from the console but not yet reported to LVGL */
+STATIC uint32_t mKeyQueue[INPUT_KEY_QUEUE_MAX];
+STATIC UINT32 mKeyHead = 0;
+STATIC UINT32 mKeyCount = 0;
+STATIC uint32_t mKeyLast = 0;
+STATIC BOOLEAN mKeyPressed = FALSE;
+
+typedef struct {
+    EFI_SIMPLE_POINTER_PROTOCOL *Pointer;
+    INT32 RemainderX;   /* Motion not yet worth a pixel, in device counts */
+    INT32 RemainderY;
+    BOOLEAN Pressed;
+} INPUT_RELATIVE;
+
+typedef struct {
+    EFI_ABSOLUTE_POINTER_PROTOCOL *Pointer;
+    BOOLEAN Pressed;
+} INPUT_ABSOLUTE;
+
+/* Every pointing device, read together on each poll */
+STATIC INPUT_RELATIVE *mRelative = NULL;
+STATIC UINTN mRelativeCount = 0;
+STATIC INPUT_ABSOLUTE *mAbsolute = NULL;
+STATIC UINTN mAbsoluteCount = 0;
+STATIC BOOLEAN mPointersStale = TRUE;
+STATIC EFI_EVENT mPointerNotifyEvent = NULL;
+STATIC VOID *mRelativeRegistration = NULL;
+STATIC VOID *mAbsoluteRegistration = NULL;
+STATIC INT32 mPointerX = 0;
+STATIC INT32 mPointerY = 0;
 
 /**
- * Get the current position and state of the mouse
- * @param data store the mouse data here
- * @return false: because the points are not buffered, so no more data to be read
+ * Get an interface of every handle with a pointer protocol.
+ * The pointer on ConsoleInHandle is usually the console splitter merging
+ * the same devices, so it is only used if there is no other one.
+ * @param Count store the number of interfaces here
+ * @return pool allocated array of interfaces, NULL if there is none
  */
-bool mouse_read(struct _lv_indev_drv_t * indev_drv, lv_indev_data_t * data)
+STATIC VOID ** input_locate_pointers(EFI_GUID *Protocol, UINTN *Count)
+{
+    EFI_STATUS Status;
+    EFI_HANDLE *HndlBuf;
+    UINTN HndlNum;
+    UINTN Index;
+    VOID **Interfaces;
+    VOID *Console = NULL;
+
+    *Count = 0;
+
+    Status = gBS->LocateHandleBuffer(ByProtocol, Protocol, NULL, &HndlNum, &HndlBuf);
+    if (EFI_ERROR(Status) || HndlNum == 0) {
+        return NULL;
+    }
+
+    Interfaces = (VOID **)AllocateZeroPool(HndlNum * sizeof(VOID *));
+    if (Interfaces == NULL) {
+        gBS->FreePool(HndlBuf);
+        return NULL;
+    }
+
+    for (Index = 0; Index < HndlNum; Index++) {
+        if (HndlBuf[Index] == gST->ConsoleInHandle) {
+            gBS->HandleProtocol(HndlBuf[Index], Protocol, &Console);
+            continue;
+        }
+        Status = gBS->HandleProtocol(HndlBuf[Index], Protocol, &Interfaces[*Count]);
+        if (!EFI_ERROR(Status)) {
+            (*Count)++;
+        }
+    }
+    gBS->FreePool(HndlBuf);
+
+    if (*Count == 0 && Console != NULL) {
+        Interfaces[(*Count)++] = Console;
+    }
+    if (*Count == 0) {
+        FreePool(Interfaces);
+        return NULL;
+    }
+
+    return Interfaces;
+}
+
+/**
+ * Rebuild the tables of pointing devices
+ */
+STATIC void input_refresh_pointers(void)
+{
+    VOID **Interfaces;
+    UINTN Count;
+    UINTN Index;
+
+    mPointersStale = FALSE;
+
+    if (mRelative != NULL) {
+        FreePool(mRelative);
+        mRelative = NULL;
+        mRelativeCount = 0;
+    }
+    if (mAbsolute != NULL) {
+        FreePool(mAbsolute);
+        mAbsolute = NULL;
+        mAbsoluteCount = 0;
+    }
+
+    Interfaces = input_locate_pointers(&gEfiSimplePointerProtocolGuid, &Count);
+    if (Interfaces != NULL) {
+        mRelative = (INPUT_RELATIVE *)AllocateZeroPool(Count * sizeof(INPUT_RELATIVE));
+        if (mRelative != NULL) {
+            for (Index = 0; Index < Count; Index++) {
+                mRelative[Index].Pointer = Interfaces[Index];
+            }
+            mRelativeCount = Count;
+        }
+        FreePool(Interfaces);
+    }
+
+    Interfaces = input_locate_pointers(&gEfiAbsolutePointerProtocolGuid, &Count);
+    if (Interfaces != NULL) {
+        mAbsolute = (INPUT_ABSOLUTE *)AllocateZeroPool(Count * sizeof(INPUT_ABSOLUTE));
+        if (mAbsolute != NULL) {
+            for (Index = 0; Index < Count; Index++) {
+                mAbsolute[Index].Pointer = Interfaces[Index];
+            }
+            mAbsoluteCount = Count;
+        }
+        FreePool(Interfaces);
+    }
+}
+
+/**
+ * Protocol notify for the pointer protocols, rebuild the tables on the next poll
+ */
+STATIC VOID EFIAPI input_pointer_notify(IN EFI_EVENT Event, IN VOID *Context)
+{
+    mPointersStale = TRUE;
+}
+
+/**
+ * Add the motion of a relative pointer since the last poll.
+ * Motion below one pixel is kept and added to the next one.
+ */
+STATIC void input_read_relative(INPUT_RELATIVE *Relative)
 {
     EFI_STATUS Status;
     EFI_SIMPLE_POINTER_STATE State;
-    STATIC lv_coord_t X = 0, Y = 0;
-    
-    if (gSimplePointer == NULL) {
-        return false;
+    EFI_SIMPLE_POINTER_MODE *Mode = Relative->Pointer->Mode;
+    INT32 ResX = (Mode->ResolutionX != 0) ? (INT32)Mode->ResolutionX : 1;
+    INT32 ResY = (Mode->ResolutionY != 0) ? (INT32)Mode->ResolutionY : 1;
+    INT32 AccX;
+    INT32 AccY;
+
+    /* The state holds all motion since the previous call, EFI_NOT_READY if there was none */
+    Status = Relative->Pointer->GetState(Relative->Pointer, &State);
+    if (EFI_ERROR(Status)) {
+        return;
     }
 
-    Status = gSimplePointer->GetState(gSimplePointer, &State);
+    AccX = Relative->RemainderX + State.RelativeMovementX;
+    AccY = Relative->RemainderY + State.RelativeMovementY;
+    mPointerX += AccX / ResX;
+    mPointerY += AccY / ResY;
+    Relative->RemainderX = AccX % ResX;
+    Relative->RemainderY = AccY % ResY;
+    Relative->Pressed = State.LeftButton;
+}
+
+/**
+ * Move to the position of an absolute pointer (touch screen, tablet)
+ */
+STATIC void input_read_absolute(INPUT_ABSOLUTE *Absolute, UINTN Width, UINTN Height)
+{
+    EFI_STATUS Status;
+    EFI_ABSOLUTE_POINTER_STATE State;
+    EFI_ABSOLUTE_POINTER_MODE *Mode = Absolute->Pointer->Mode;
+    UINT64 RangeX = Mode->AbsoluteMaxX - Mode->AbsoluteMinX;
+    UINT64 RangeY = Mode->AbsoluteMaxY - Mode->AbsoluteMinY;
+    UINT64 OffsetX;
+    UINT64 OffsetY;
+
+    /* EFI_NOT_READY: nothing changed since the last call */
+    Status = Absolute->Pointer->GetState(Absolute->Pointer, &State);
     if (EFI_ERROR(Status)) {
-        return false;
+        return;
+    }
+
+    if (Width > 0 && Height > 0 && RangeX > 0 && RangeY > 0) {
+        OffsetX = MIN(MAX(State.CurrentX, Mode->AbsoluteMinX) - Mode->AbsoluteMinX, RangeX);
+        OffsetY = MIN(MAX(State.CurrentY, Mode->AbsoluteMinY) - Mode->AbsoluteMinY, RangeY);
+        mPointerX = (INT32)DivU64x64Remainder(MultU64x64(OffsetX, Width - 1), RangeX, NULL);
+        mPointerY = (INT32)DivU64x64Remainder(MultU64x64(OffsetY, Height - 1), RangeY, NULL);
     }
+    Absolute->Pressed = (State.ActiveButtons & EFI_ABSP_TouchActive) != 0;
+}
 
-    X += (lv_coord_t)(State.RelativeMovementX / (INT32)gSimplePointer->Mode->ResolutionX);
-    Y += (lv_coord_t)(State.RelativeMovementY / (INT32)gSimplePointer->Mode->ResolutionY);
+/**
+ * Get the current position and state of the mouse.
+ * All relative and absolute pointers are read and merged into one pointer.
+ * @param data store the mouse data here
+ * @return false: the states are coalesced, so no more data to be read
+ */
+bool mouse_read(struct _lv_indev_drv_t * indev_drv, lv_indev_data_t * data)
+{
+    UINTN Index;
+    UINTN Width;
+    UINTN Height;
+    BOOLEAN Pressed = FALSE;
+
+    if (mPointersStale) {
+        input_refresh_pointers();
+    }
 
-    X = MAX(X, 0);
-    Y = MAX(Y, 0);
+    monitor_get_resolution(&Width, &Height);
+
+    for (Index = 0; Index < mRelativeCount; Index++) {
+        input_read_relative(&mRelative[Index]);
+        Pressed |= mRelative[Index].Pressed;
+    }
+    for (Index = 0; Index < mAbsoluteCount; Index++) {
+        input_read_absolute(&mAbsolute[Index], Width, Height);
+        Pressed |= mAbsolute[Index].Pressed;
+    }
+
+    mPointerX = MAX(mPointerX, 0);
+    mPointerY = MAX(mPointerY, 0);
+    if (Width > 0 && Height > 0) {
+        mPointerX = MIN(mPointerX, (INT32)Width - 1);
+        mPointerY = MIN(mPointerY, (INT32)Height - 1);
+    }
+
+    /* The cursor overlay follows without a redraw by LVGL */
+    monitor_cursor_move(mPointerX, mPointerY);
 
     /* Store the collected data */
-    data->point.x = X;
-    data->point.y = Y;
-    data->state = State.LeftButton ? LV_INDEV_STATE_PR : LV_INDEV_STATE_REL;
+    data->point.x = mPointerX;
+    data->point.y = mPointerY;
+    data->state = Pressed ? LV_INDEV_STATE_PR : LV_INDEV_STATE_REL;
 
     return false;
 }
 
 /**
  * ConvertEfiKeyToLvgl
+ * @param ShiftState KeyShiftState of EFI_KEY_DATA, 0 if unknown
+ * @return the LVGL key, 0: the keystroke has no meaning for LVGL
  */
 uint32_t
 ConvertEfiKeyToLvgl(
-    EFI_INPUT_KEY *Key
+    EFI_INPUT_KEY *Key,
+    UINT32 ShiftState
 )
 {
+    BOOLEAN Shift = FALSE;
+    BOOLEAN Control = FALSE;
+    BOOLEAN Alt = FALSE;
+
+    if ((ShiftState & EFI_SHIFT_STATE_VALID) != 0) {
+        Shift = (ShiftState & (EFI_LEFT_SHIFT_PRESSED | EFI_RIGHT_SHIFT_PRESSED)) != 0;
+        Control = (ShiftState & (EFI_LEFT_CONTROL_PRESSED | EFI_RIGHT_CONTROL_PRESSED)) != 0;
+        Alt = (ShiftState & (EFI_LEFT_ALT_PRESSED | EFI_RIGHT_ALT_PRESSED)) != 0;
+    }
+
     switch (Key->UnicodeChar)
     {
+    case CHAR_NULL:
+        break;
     case CHAR_CARRIAGE_RETURN:
+    case CHAR_LINEFEED:
         return LV_KEY_ENTER;
     case CHAR_BACKSPACE:
         return LV_KEY_BACKSPACE;
     case CHAR_TAB:
-        return LV_KEY_NEXT;  
+        return Shift ? LV_KEY_PREV : LV_KEY_NEXT;
     default:
-        break;
+        /* Ctrl+<key> is a shortcut, not text. AltGr (Alt) may produce real characters */
+        if (Control && !Alt) {
+            return 0;
+        }
+        return Key->UnicodeChar;
     }
 
     switch (Key->ScanCode)
@@ -63,42 +291,100 @@ ConvertEfiKeyToLvgl(
     case SCAN_DOWN:
         return LV_KEY_DOWN;
     case SCAN_RIGHT:
-        return LV_KEY_RIGHT;
+        return Control ? LV_KEY_END : LV_KEY_RIGHT;
     case SCAN_LEFT:
-        return LV_KEY_LEFT;
+        return Control ? LV_KEY_HOME : LV_KEY_LEFT;
     case SCAN_DELETE:
         return LV_KEY_DEL;
     case SCAN_HOME:
         return LV_KEY_HOME;
     case SCAN_END:
         return LV_KEY_END;
+    case SCAN_PAGE_UP:
+        return LV_KEY_PREV;
+    case SCAN_PAGE_DOWN:
+        return LV_KEY_NEXT;
+    case SCAN_ESC:
+        return LV_KEY_ESC;
     default:
         break;
     }
 
-    return Key->UnicodeChar;
+    if (Key->ScanCode >= SCAN_F1 && Key->ScanCode <= SCAN_F10) {
+        return INPUT_KEY_F1 + (Key->ScanCode - SCAN_F1);
+    }
+    if (Key->ScanCode == SCAN_F11 || Key->ScanCode == SCAN_F12) {
+        return INPUT_KEY_F1 + 10 + (Key->ScanCode - SCAN_F11);
+    }
+
+    return 0;
 }
 
 /**
- * Get the current key pressed
- * @param data store the keyboard data here
- * @return false: because the kee are not buffered, so no more data to be read
+ * Read one keystroke from the console
+ * @param LvKey store the LVGL key here, 0: nothing usable was read
+ * @return EFI_NOT_READY: no more keystrokes pending
  */
-bool keyboard_read(struct _lv_indev_drv_t * indev_drv, lv_indev_data_t * data)
+STATIC EFI_STATUS keyboard_read_stroke(uint32_t *LvKey)
 {
     EFI_STATUS Status;
-    EFI_INPUT_KEY Key;
+    EFI_KEY_DATA KeyData;
 
-	Status = gST->ConIn->ReadKeyStroke(gST->ConIn, &Key);
+    if (gTextInputEx != NULL) {
+        Status = gTextInputEx->ReadKeyStrokeEx(gTextInputEx, &KeyData);
+    } else {
+        Status = gST->ConIn->ReadKeyStroke(gST->ConIn, &KeyData.Key);
+        KeyData.KeyState.KeyShiftState = 0;
+    }
     if (EFI_ERROR(Status)) {
+        return Status;
+    }
+
+    /* A bare modifier (partial keystroke) has neither a char nor a scan code and maps to 0 */
+    *LvKey = ConvertEfiKeyToLvgl(&KeyData.Key, KeyData.KeyState.KeyShiftState);
+    return EFI_SUCCESS;
+}
+
+/**
+ * Get the current key pressed.
+ * All pending keystrokes are moved into a ring buffer, then every key is
+ * reported as a press followed by a release.
+ * @param data store the keyboard data here
+ * @return true: there are more key events to read in the same poll
+ */
+bool keyboard_read(struct _lv_indev_drv_t * indev_drv, lv_indev_data_t * data)
+{
+    uint32_t Key;
+
+    while (mKeyCount < INPUT_KEY_QUEUE_MAX && !EFI_ERROR(keyboard_read_stroke(&Key))) {
+        if (Key != 0) {
+            mKeyQueue[(mKeyHead + mKeyCount) % INPUT_KEY_QUEUE_MAX] = Key;
+            mKeyCount++;
+        }
+    }
+
+    if (mKeyPressed) {
+        /* Release the key reported last time */
+        mKeyPressed = FALSE;
+        data->key = mKeyLast;
+        data->state = LV_INDEV_STATE_REL;
+        return mKeyCount > 0;
+    }
+
+    if (mKeyCount == 0) {
+        data->key = mKeyLast;
         data->state = LV_INDEV_STATE_REL;
         return false;
     }
 
-    data->key = ConvertEfiKeyToLvgl(&Key);
-    data->state = LV_INDEV_STATE_PR;
+    mKeyLast = mKeyQueue[mKeyHead];
+    mKeyHead = (mKeyHead + 1) % INPUT_KEY_QUEUE_MAX;
+    mKeyCount--;
+    mKeyPressed = TRUE;
 
-    return false;
+    data->key = mKeyLast;
+    data->state = LV_INDEV_STATE_PR;
+    return true;
 }
 
 /**
@@ -107,8 +393,75 @@ bool keyboard_read(struct _lv_indev_drv_t * indev_drv, lv_indev_data_t * data)
 void input_init()
 {
     EFI_STATUS Status;
-    Status = gBS->HandleProtocol(gST->ConsoleInHandle, &gEfiSimplePointerProtocolGuid, &gSimplePointer);
+
+    Status = gBS->HandleProtocol(gST->ConsoleInHandle, &gEfiSimpleTextInputExProtocolGuid, (VOID **)&gTextInputEx);
     if (EFI_ERROR(Status)) {
-        gSimplePointer = NULL;
+        gTextInputEx = NULL;
+    }
+
+    mPointersStale = TRUE;
+    if (mPointerNotifyEvent != NULL) {
+        return;
+    }
+
+    //
+    // Pick up pointing devices connected later on (e.g. USB hot plug)
+    //
+    Status = gBS->CreateEvent(EVT_NOTIFY_SIGNAL, TPL_CALLBACK, input_pointer_notify, NULL, &mPointerNotifyEvent);
+    if (!EFI_ERROR(Status)) {
+        gBS->RegisterProtocolNotify(&gEfiSimplePointerProtocolGuid, mPointerNotifyEvent, &mRelativeRegistration);
+        gBS->RegisterProtocolNotify(&gEfiAbsolutePointerProtocolGuid, mPointerNotifyEvent, &mAbsoluteRegistration);
+    } else {
+        mPointerNotifyEvent = NULL;
+    }
+}
+
+/**
+ * Get the events signaled on keyboard and pointer input
+ * @param Events store the events here
+ * @param Max size of 'Events'
+ * @return number of events stored
+ */
+UINTN input_get_events(EFI_EVENT *Events, UINTN Max)
+{
+    UINTN Count = 0;
+    UINTN Index;
+
+    if (mPointersStale) {
+        input_refresh_pointers();
+    }
+
+    if (Count < Max) {
+        Events[Count++] = (gTextInputEx != NULL) ? gTextInputEx->WaitForKeyEx : gST->ConIn->WaitForKey;
+    }
+    for (Index = 0; Index < mRelativeCount && Count < Max; Index++) {
+        Events[Count++] = mRelative[Index].Pointer->WaitForInput;
     }
-}
\ No newline at end of file
+    for (Index = 0; Index < mAbsoluteCount && Count < Max; Index++) {
+        Events[Count++] = mAbsolute[Index].Pointer->WaitForInput;
+    }
+
+    return Count;
+}
+
+/**
+ * Deinit Function
+ */
+void input_deinit()
+{
+    if (mPointerNotifyEvent != NULL) {
+        gBS->CloseEvent(mPointerNotifyEvent);
+        mPointerNotifyEvent = NULL;
+    }
+    if (mRelative != NULL) {
+        FreePool(mRelative);
+        mRelative = NULL;
+    }
+    if (mAbsolute != NULL) {
+        FreePool(mAbsolute);
+        mAbsolute = NULL;
+    }
+    mRelativeCount = 0;
+    mAbsoluteCount = 0;
+    mPointersStale = TRUE;
+}
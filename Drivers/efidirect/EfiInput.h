@@ -19,6 +19,8 @@ extern "C" {
 #include <Library/MemoryAllocationLib.h>
 #include <Library/DebugLib.h>
 #include <Protocol/SimplePointer.h>
+#include <Protocol/AbsolutePointer.h>
+#include <Protocol/SimpleTextInEx.h>
 
 #include "../../lv_binding_micropython/lvgl/lvgl.h"
     
@@ -26,6 +28,12 @@ extern "C" {
  *      DEFINES
  *********************/
 
+/*Max. number of keystrokes buffered between two keyboard_read polls*/
+#define INPUT_KEY_QUEUE_MAX     64
+
+/*F1..F12 are reported as INPUT_KEY_F1 + 0..11 (outside of the Unicode range)*/
+#define INPUT_KEY_F1            0x110001
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -46,9 +54,9 @@ void mouse_init(void);
 bool mouse_read(struct _lv_indev_drv_t * indev_drv, lv_indev_data_t * data);
 
 /**
- * Get the current position and state of the mouse
- * @param data store the mouse data here
- * @return false: because the points are not buffered, so no more data to be read
+ * Get the current key pressed
+ * @param data store the keyboard data here
+ * @return true: there are more key events to read in the same poll
  */
 bool keyboard_read(struct _lv_indev_drv_t * indev_drv, lv_indev_data_t * data);
 
@@ -57,6 +65,19 @@ bool keyboard_read(struct _lv_indev_drv_t * indev_drv, lv_indev_data_t * data);
  */
 void input_init();
 
+/**
+ * Get the events signaled on keyboard and pointer input
+ * @param Events store the events here
+ * @param Max size of 'Events'
+ * @return number of events stored
+ */
+UINTN input_get_events(EFI_EVENT *Events, UINTN Max);
+
+/**
+ * Deinit Function
+ */
+void input_deinit();
+
 /**********************
  *      MACROS
  **********************/
@@ -0,0 +1,112 @@
+/**
+ * @file EfiLoop.c
+ * Event driven main loop of LVGL: WaitForEvent instead of busy waiting
+ * between the tasks. LVGL reads its tick from the monotonic clock of the
+ * port (LV_TICK_CUSTOM), so no lv_tick_inc() is needed here.
+ */
+
+#include "EfiLoop.h"
+#include "EfiInput.h"
+#include "../../MicroPythonDxe/Uefi/uefi_clock.h"
+
+typedef struct {
+    EFI_EVENT TimerEvent;
+} LOOP_PRIVATE;
+
+STATIC LOOP_PRIVATE mLoop;
+
+/**
+ * Prepare the loop: create the sleep timer
+ * @return FALSE: the timer could not be created
+ */
+BOOLEAN loop_init(void)
+{
+    EFI_STATUS Status;
+
+    ZeroMem(&mLoop, sizeof(mLoop));
+
+    Status = gBS->CreateEvent(EVT_TIMER, TPL_CALLBACK, NULL, NULL, &mLoop.TimerEvent);
+    if (EFI_ERROR(Status)) {
+        mLoop.TimerEvent = NULL;
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+/**
+ * Release the sleep timer
+ */
+void loop_deinit(void)
+{
+    if (mLoop.TimerEvent != NULL) {
+        gBS->CloseEvent(mLoop.TimerEvent);
+        mLoop.TimerEvent = NULL;
+    }
+}
+
+/**
+ * Get the milliseconds of the monotonic clock, the same time LVGL ticks with
+ */
+UINT64 loop_now_ms(void)
+{
+    return UefiClockMilliseconds();
+}
+
+/**
+ * Run the LVGL tasks
+ * @return milliseconds until the next LVGL task is due
+ */
+UINT32 loop_handle_tasks(void)
+{
+    return lv_task_handler();
+}
+
+/**
+ * Sleep until an input event arrives or 'Ms' milliseconds passed.
+ * On input the LVGL read tasks are made ready to run right away.
+ * @return TRUE: woken by input
+ */
+BOOLEAN loop_wait(UINT32 Ms)
+{
+    EFI_STATUS Status;
+    EFI_EVENT Events[LOOP_MAX_EVENTS + 1];
+    UINTN Count;
+    UINTN Index;
+
+    if (Ms == 0) {
+        return FALSE;
+    }
+
+    Events[0] = mLoop.TimerEvent;
+    Count = 1 + input_get_events(&Events[1], LOOP_MAX_EVENTS);
+
+    Status = gBS->SetTimer(mLoop.TimerEvent, TimerRelative, EFI_TIMER_PERIOD_MILLISECONDS(MIN(Ms, LOOP_MAX_WAIT_MS)));
+    if (EFI_ERROR(Status)) {
+        return FALSE;
+    }
+
+    Status = gBS->WaitForEvent(Count, Events, &Index);
+    gBS->SetTimer(mLoop.TimerEvent, TimerCancel, 0);
+    if (EFI_ERROR(Status) || Index == 0) {
+        return FALSE;
+    }
+
+    loop_input_ready();
+    return TRUE;
+}
+
+/**
+ * Input arrived: make the LVGL read tasks run right away instead of
+ * waiting for their read period
+ */
+void loop_input_ready(void)
+{
+    lv_indev_t * Indev = NULL;
+
+    while ((Indev = lv_indev_get_next(Indev)) != NULL) {
+        if (Indev->driver.read_task != NULL) {
+            lv_task_ready(Indev->driver.read_task);
+        }
+    }
+}
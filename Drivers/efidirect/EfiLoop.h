@@ -0,0 +1,77 @@
+/**
+ * @file EfiLoop.h
+ *
+ */
+
+#ifndef LOOP_H
+#define LOOP_H
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <Uefi.h>
+#include <Library/UefiBootServicesTableLib.h>
+#include <Library/TimerLib.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+
+#include "../../lv_binding_micropython/lvgl/lvgl.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*Longest sleep, the loop checks its exit condition at least this often*/
+#define LOOP_MAX_WAIT_MS    1000
+
+/*Max. number of input events a sleep can be ended by*/
+#define LOOP_MAX_EVENTS     16
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Prepare the loop: create the sleep timer
+ * @return FALSE: the timer could not be created
+ */
+BOOLEAN loop_init(void);
+
+/**
+ * Release the sleep timer
+ */
+void loop_deinit(void);
+
+/**
+ * Get the milliseconds of the monotonic clock, the same time LVGL ticks with
+ */
+UINT64 loop_now_ms(void);
+
+/**
+ * Run the LVGL tasks
+ * @return milliseconds until the next LVGL task is due
+ */
+UINT32 loop_handle_tasks(void);
+
+/**
+ * Sleep until an input event arrives or 'Ms' milliseconds passed.
+ * On input the LVGL read tasks are made ready to run right away.
+ * @return TRUE: woken by input
+ */
+BOOLEAN loop_wait(UINT32 Ms);
+
+/**
+ * Input arrived: make the LVGL read tasks run right away instead of
+ * waiting for their read period
+ */
+void loop_input_ready(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /* LOOP_H */
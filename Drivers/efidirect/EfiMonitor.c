@@ -1,120 +1,1105 @@
 #include "EfiMonitor.h"
 
+#if LV_COLOR_DEPTH != 8 && LV_COLOR_DEPTH != 16 && LV_COLOR_DEPTH != 24 && LV_COLOR_DEPTH != 32
+#error "efidirect supports LV_COLOR_DEPTH 8, 16, 24 and 32"
+#endif
+
+/*Max. number of separate rectangles presented per frame*/
+#define MONITOR_DIRTY_MAX   16
+
+/*Flush areas are widened to multiples of this many pixels (one 64 byte cache line)*/
+#define MONITOR_ALIGN_PX    (64 / sizeof(lv_color_t))
+
+/*Size of the built-in arrow cursor*/
+#define MONITOR_ARROW_W     12
+#define MONITOR_ARROW_H     19
+
+/*Max. number of flushes waiting for the deferred flush worker*/
+#define MONITOR_QUEUE_MAX   4
+
+/**
+ * A flush handed over to the deferred flush worker.
+ * 'Buf' belongs to LVGL until lv_disp_flush_ready() is called for 'Drv'.
+ */
+typedef struct {
+    lv_disp_drv_t *Drv;
+    lv_area_t Area;
+    CONST lv_color_t *Buf;
+} MONITOR_JOB;
+
+typedef struct {
+    EFI_HANDLE                   Handle;
+    EFI_GRAPHICS_OUTPUT_PROTOCOL *Gop;
+    UINT32                       ModeNumber;    /*Mode the format below was computed for*/
+    BOOLEAN                      HasFrameBuffer;
+    PIXEL_FORMAT                 Format;
+} MONITOR_OUTPUT;
+
 typedef struct {
     EFI_GRAPHICS_OUTPUT_PROTOCOL *Gop;
     UINTN Width;
     UINTN Height;
+
+    MONITOR_OUTPUT *Outputs;
+    UINTN OutputCount;
+    BOOLEAN OutputsStale;
+    BOOLEAN DirectEnabled;
+    EFI_EVENT GopNotifyEvent;
+    VOID *GopNotifyRegistration;
+
+    UINT32 *Scratch;        /*BGRX staging buffer for LV_COLOR_DEPTH < 24*/
+    UINTN ScratchPixels;
+
+    BOOLEAN ShadowEnabled;
+    lv_color_t *Shadow;     /*Screen sized copy of everything rendered so far*/
+    UINTN ShadowWidth;
+    UINTN ShadowHeight;
+    lv_area_t Dirty[MONITOR_DIRTY_MAX];
+    UINT32 DirtyCount;
+
+    BOOLEAN CursorVisible;
+    BOOLEAN CursorDrawn;
+    UINT32 *CursorSprite;   /*BGRA, the reserved byte is the alpha*/
+    UINTN CursorWidth;
+    UINTN CursorHeight;
+    INTN CursorHotX;
+    INTN CursorHotY;
+    INTN CursorX;           /*Top left of the sprite on the screen*/
+    INTN CursorY;
+    lv_area_t CursorArea;   /*The sprite clipped to the screen*/
+    UINT32 *CursorUnder;    /*Save-under, stride is CursorWidth*/
+    UINT32 *CursorBlend;    /*Sprite composited over the save-under*/
+
+    EFI_EVENT FlushEvent;   /*TPL_CALLBACK timer running the queued flushes*/
+    MONITOR_JOB Queue[MONITOR_QUEUE_MAX];
+    UINT32 QueueHead;
+    UINT32 QueueCount;
 } MONITOR_PRIVATE;
 
 STATIC MONITOR_PRIVATE *tPrivate = NULL;
 
+/*Built-in arrow cursor: '.' transparent, 'B' black, 'W' white*/
+STATIC CONST CHAR8 * CONST mCursorArrow[MONITOR_ARROW_H] = {
+    "B...........",
+    "BB..........",
+    "BWB.........",
+    "BWWB........",
+    "BWWWB.......",
+    "BWWWWB......",
+    "BWWWWWB.....",
+    "BWWWWWWB....",
+    "BWWWWWWWB...",
+    "BWWWWWWWWB..",
+    "BWWWWWWWWWB.",
+    "BWWWWWWBBBBB",
+    "BWWWBWWB....",
+    "BWWBBWWB....",
+    "BWB..BWWB...",
+    "BB...BWWB...",
+    "B.....BWWB..",
+    "......BWWB..",
+    ".......BB...",
+};
+
 /**
- * Flush a buffer to the display. Calls 'lv_flush_ready()' when finished
+ * Refresh the cached frame buffer layout of an output
  */
-void monitor_flush(struct _disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+STATIC void monitor_update_output_format(MONITOR_OUTPUT *Output)
 {
-    EFI_GRAPHICS_OUTPUT_PROTOCOL *Gop;
-    lv_coord_t w = area->x2 - area->x1 + 1;
-    lv_coord_t h = area->y2 - area->y1 + 1;
+    EFI_GRAPHICS_OUTPUT_PROTOCOL_MODE *Mode = Output->Gop->Mode;
 
-    Gop = tPrivate->Gop;
+    Output->ModeNumber = Mode->Mode;
+    Output->HasFrameBuffer = Mode->FrameBufferBase != 0 &&
+                             pixel_format_from_gop(Mode->Info, &Output->Format);
+}
 
-#if LV_COLOR_DEPTH != 24 && LV_COLOR_DEPTH != 32    /*32 is valid but support 24 for backward compatibility too*/
-    //
-    // TODO: need convert to 32 bit color
-    //
-    ASSERT(FALSE);
+/**
+ * Rebuild the table of GOP instances the flush callback draws into.
+ * Called from monitor_init and, lazily, from the first flush after a
+ * GOP protocol has been (re)installed.
+ */
+STATIC void monitor_refresh_outputs(void)
+{
+    EFI_STATUS Status;
+    UINTN Index;
+    EFI_HANDLE *HndlBuf;
+    UINTN HndlNum;
+    MONITOR_OUTPUT *Outputs;
+    UINTN Count;
+
+    tPrivate->OutputsStale = FALSE;
+
+    Status = gBS->LocateHandleBuffer(ByProtocol, &gEfiGraphicsOutputProtocolGuid, NULL, &HndlNum, &HndlBuf);
+    if (EFI_ERROR(Status) || HndlNum == 0) {
+        return;
+    }
+
+    Outputs = (MONITOR_OUTPUT*)AllocateZeroPool(HndlNum * sizeof(MONITOR_OUTPUT));
+    if (Outputs == NULL) {
+        gBS->FreePool(HndlBuf);
+        return;
+    }
+
+    Count = 0;
+    for (Index = 0; Index < HndlNum; Index++) {
+        Status = gBS->HandleProtocol (
+                        HndlBuf[Index],
+                        &gEfiGraphicsOutputProtocolGuid,
+                        (VOID **) &Outputs[Count].Gop
+                        );
+        if (EFI_ERROR(Status)) {
+            continue;
+        }
+        Outputs[Count].Handle = HndlBuf[Index];
+        monitor_update_output_format(&Outputs[Count]);
+        Count++;
+    }
+
+    gBS->FreePool(HndlBuf);
+
+    if (tPrivate->Outputs != NULL) {
+        FreePool(tPrivate->Outputs);
+    }
+    tPrivate->Outputs = Outputs;
+    tPrivate->OutputCount = Count;
+}
+
+/**
+ * Protocol notify for gEfiGraphicsOutputProtocolGuid.
+ * Runs at TPL_CALLBACK, possibly in the middle of a flush, so only mark
+ * the table stale here and let the next flush rebuild it.
+ */
+STATIC VOID EFIAPI monitor_gop_notify(IN EFI_EVENT Event, IN VOID *Context)
+{
+    if (tPrivate != NULL) {
+        tPrivate->OutputsStale = TRUE;
+    }
+}
+
+/**
+ * Get a BGRX staging buffer of at least 'Pixels' pixels
+ */
+STATIC UINT32 * monitor_get_scratch(UINTN Pixels)
+{
+    if (Pixels > tPrivate->ScratchPixels) {
+        if (tPrivate->Scratch != NULL) {
+            FreePool(tPrivate->Scratch);
+        }
+        tPrivate->Scratch = (UINT32*)AllocatePool(Pixels * sizeof(UINT32));
+        tPrivate->ScratchPixels = (tPrivate->Scratch != NULL) ? Pixels : 0;
+    }
+
+    return tPrivate->Scratch;
+}
+
+/**
+ * Expand a row of lv_color_t to BGRX (EFI_GRAPHICS_OUTPUT_BLT_PIXEL)
+ */
+STATIC void monitor_expand_row(UINT32 *Dst, CONST lv_color_t *Src, UINTN Count)
+{
+#if LV_COLOR_DEPTH == 16
+    pixel_expand_rgb565(Dst, (CONST UINT16 *)Src, Count, LV_COLOR_16_SWAP);
+#elif LV_COLOR_DEPTH == 8
+    pixel_expand_rgb332(Dst, (CONST UINT8 *)Src, Count);
 #else
+    CopyMem(Dst, Src, Count * sizeof(UINT32));
+#endif
+}
 
+/**
+ * Write an area straight into the linear frame buffer of an output
+ * @param buf pixel of 'area->x1;area->y1'
+ * @param stride distance of two rows in 'buf' in pixels
+ */
+STATIC void monitor_present_direct(MONITOR_OUTPUT *Output, const lv_area_t * area, const lv_color_t * buf, UINTN stride)
 {
-  EFI_STATUS Status;
-  UINTN Index;
-  EFI_GRAPHICS_OUTPUT_PROTOCOL   *GraphicsOutput;
-  EFI_HANDLE *HndlBuf;
-  UINTN HndlNum;
+    EFI_GRAPHICS_OUTPUT_PROTOCOL_MODE *Mode = Output->Gop->Mode;
+    UINTN Bpp = Output->Format.BytesPerPixel;
+    INTN X1, Y1, X2, Y2, Y;
+    UINTN Count;
+    UINT8 *Dst;
+    CONST lv_color_t *Src;
+#if LV_COLOR_DEPTH != 24 && LV_COLOR_DEPTH != 32
+    UINT32 *Row = NULL;
+#endif
 
-  Status = gBS->LocateHandleBuffer(ByProtocol, &gEfiGraphicsOutputProtocolGuid, NULL, &HndlNum,  &HndlBuf);
-  if (EFI_ERROR(Status) || HndlNum == 0) {
-    return;
-  }
+    /*Blt validates the rectangle, a raw write must clip to the mode itself*/
+    X1 = MAX(area->x1, 0);
+    Y1 = MAX(area->y1, 0);
+    X2 = MIN(area->x2, (INTN)Mode->Info->HorizontalResolution - 1);
+    Y2 = MIN(area->y2, (INTN)Mode->Info->VerticalResolution - 1);
+    if (X1 > X2 || Y1 > Y2) {
+        return;
+    }
 
-  for (Index = 0; Index < HndlNum; Index++) {
+    Count = X2 - X1 + 1;
+    Src = buf + (Y1 - area->y1) * stride + (X1 - area->x1);
+    Dst = (UINT8 *)(UINTN)Mode->FrameBufferBase + ((UINTN)Y1 * Mode->Info->PixelsPerScanLine + X1) * Bpp;
 
-    Status = gBS->HandleProtocol (
-                    HndlBuf[Index],
-                    &gEfiGraphicsOutputProtocolGuid,
-                    (VOID **) &GraphicsOutput
-                    );
-    if (EFI_ERROR(Status)) {
-      continue;
+#if LV_COLOR_DEPTH != 24 && LV_COLOR_DEPTH != 32
+    /*BGRX targets are expanded into directly, the others go through a staging row*/
+    if (Output->Format.Layout != PIXEL_LAYOUT_BGRX) {
+        Row = monitor_get_scratch(Count);
+        if (Row == NULL) {
+            return;
+        }
+    }
+#endif
+
+    for (Y = Y1; Y <= Y2; Y++) {
+#if LV_COLOR_DEPTH == 24 || LV_COLOR_DEPTH == 32
+        pixel_convert_row(Dst, (CONST UINT32 *)Src, Count, &Output->Format);
+#else
+        if (Row == NULL) {
+            monitor_expand_row((UINT32 *)Dst, Src, Count);
+        } else {
+            monitor_expand_row(Row, Src, Count);
+            pixel_convert_row(Dst, Row, Count, &Output->Format);
+        }
+#endif
+        Src += stride;
+        Dst += Mode->Info->PixelsPerScanLine * Bpp;
+    }
+}
+
+/**
+ * Get the area as a BGRX buffer Blt() can consume
+ * @param buf pixel of 'area->x1;area->y1'
+ * @param stride distance of two rows in 'buf' in pixels
+ * @param delta store the 'Delta' argument of Blt() here
+ * @return 'buf' itself at 24/32 bit depth, an expanded copy otherwise
+ */
+STATIC EFI_GRAPHICS_OUTPUT_BLT_PIXEL * monitor_get_blt_buffer(const lv_area_t * area, const lv_color_t * buf, UINTN stride, UINTN *delta)
+{
+#if LV_COLOR_DEPTH == 24 || LV_COLOR_DEPTH == 32
+    *delta = stride * sizeof(EFI_GRAPHICS_OUTPUT_BLT_PIXEL);
+    return (EFI_GRAPHICS_OUTPUT_BLT_PIXEL*)buf;
+#else
+    UINTN Width = lv_area_get_width(area);
+    UINTN Height = lv_area_get_height(area);
+    UINT32 *Buffer;
+    UINTN Y;
+
+    Buffer = monitor_get_scratch(Width * Height);
+    if (Buffer == NULL) {
+        return NULL;
+    }
+
+    for (Y = 0; Y < Height; Y++) {
+        monitor_expand_row(Buffer + Y * Width, buf + Y * stride, Width);
+    }
+
+    *delta = 0;
+    return (EFI_GRAPHICS_OUTPUT_BLT_PIXEL*)Buffer;
+#endif
+}
+
+/**
+ * Raise the TPL to TPL_CALLBACK (or keep it if already higher) so the
+ * deferred flush worker can not run in the middle of the caller
+ */
+STATIC EFI_TPL monitor_lock(void)
+{
+    EFI_TPL OldTpl;
+
+    OldTpl = gBS->RaiseTPL(TPL_HIGH_LEVEL);
+    gBS->RestoreTPL(OldTpl);
+
+    return gBS->RaiseTPL(MAX(OldTpl, TPL_CALLBACK));
+}
+
+/**
+ * Blt a part of a cursor sized BGRX buffer to the cursor area of every output
+ */
+STATIC void monitor_cursor_blt(UINT32 *Buffer)
+{
+    UINTN Index;
+    EFI_GRAPHICS_OUTPUT_PROTOCOL *GraphicsOutput;
+
+    for (Index = 0; Index < tPrivate->OutputCount; Index++) {
+        GraphicsOutput = tPrivate->Outputs[Index].Gop;
+        GraphicsOutput->Blt(
+            GraphicsOutput,
+            (EFI_GRAPHICS_OUTPUT_BLT_PIXEL*)Buffer,
+            EfiBltBufferToVideo,
+            tPrivate->CursorArea.x1 - tPrivate->CursorX,
+            tPrivate->CursorArea.y1 - tPrivate->CursorY,
+            tPrivate->CursorArea.x1,
+            tPrivate->CursorArea.y1,
+            lv_area_get_width(&tPrivate->CursorArea),
+            lv_area_get_height(&tPrivate->CursorArea),
+            tPrivate->CursorWidth * sizeof(UINT32)
+        );
+    }
+}
+
+/**
+ * Blend the sprite over the save-under and show the result
+ */
+STATIC void monitor_cursor_compose(void)
+{
+    INTN X, Y;
+    UINTN Offset;
+    UINT32 Sprite;
+    UINT32 Under;
+    UINT32 Alpha;
+
+    for (Y = tPrivate->CursorArea.y1 - tPrivate->CursorY; Y <= tPrivate->CursorArea.y2 - tPrivate->CursorY; Y++) {
+        for (X = tPrivate->CursorArea.x1 - tPrivate->CursorX; X <= tPrivate->CursorArea.x2 - tPrivate->CursorX; X++) {
+            Offset = Y * tPrivate->CursorWidth + X;
+            Sprite = tPrivate->CursorSprite[Offset];
+            Under = tPrivate->CursorUnder[Offset];
+            Alpha = Sprite >> 24;
+
+            if (Alpha == 0xFF) {
+                tPrivate->CursorBlend[Offset] = Sprite & 0xFFFFFF;
+            } else if (Alpha == 0) {
+                tPrivate->CursorBlend[Offset] = Under & 0xFFFFFF;
+            } else {
+                tPrivate->CursorBlend[Offset] =
+                    ((((Sprite & 0xFF00FF) * Alpha + (Under & 0xFF00FF) * (255 - Alpha)) >> 8) & 0xFF00FF) |
+                    ((((Sprite & 0x00FF00) * Alpha + (Under & 0x00FF00) * (255 - Alpha)) >> 8) & 0x00FF00);
+            }
+        }
+    }
+
+    monitor_cursor_blt(tPrivate->CursorBlend);
+}
+
+/**
+ * Put the saved pixels back where the cursor was drawn
+ */
+STATIC void monitor_cursor_hide(void)
+{
+    if (tPrivate->CursorDrawn) {
+        monitor_cursor_blt(tPrivate->CursorUnder);
+        tPrivate->CursorDrawn = FALSE;
     }
+}
 
+/**
+ * Save the pixels under the cursor position and draw the cursor there
+ */
+STATIC void monitor_cursor_draw(void)
+{
+    lv_area_t Sprite;
+    lv_area_t Screen;
+    EFI_GRAPHICS_OUTPUT_PROTOCOL *GraphicsOutput;
+
+    if (!tPrivate->CursorVisible || tPrivate->OutputCount == 0) {
+        return;
+    }
 
+    lv_area_set(&Sprite, tPrivate->CursorX, tPrivate->CursorY,
+                tPrivate->CursorX + tPrivate->CursorWidth - 1, tPrivate->CursorY + tPrivate->CursorHeight - 1);
+    lv_area_set(&Screen, 0, 0, tPrivate->Width - 1, tPrivate->Height - 1);
+    if (!_lv_area_intersect(&tPrivate->CursorArea, &Sprite, &Screen)) {
+        return;
+    }
+
+    //
+    // Only the cursor itself is on the screen besides what LVGL presented,
+    // so with the cursor hidden the video memory is the background.
+    //
+    GraphicsOutput = tPrivate->Outputs[0].Gop;
     GraphicsOutput->Blt(
         GraphicsOutput,
-        (EFI_GRAPHICS_OUTPUT_BLT_PIXEL*)color_p,
-        EfiBltBufferToVideo,
-        0,
-        0,
-        area->x1,
-        area->y1,
-        w,
-        h,
-        0
+        (EFI_GRAPHICS_OUTPUT_BLT_PIXEL*)tPrivate->CursorUnder,
+        EfiBltVideoToBltBuffer,
+        tPrivate->CursorArea.x1,
+        tPrivate->CursorArea.y1,
+        tPrivate->CursorArea.x1 - tPrivate->CursorX,
+        tPrivate->CursorArea.y1 - tPrivate->CursorY,
+        lv_area_get_width(&tPrivate->CursorArea),
+        lv_area_get_height(&tPrivate->CursorArea),
+        tPrivate->CursorWidth * sizeof(UINT32)
     );
-  }
-
-  gBS->FreePool(HndlBuf);
-}
-
-/*
-    Gop->Blt(
-        Gop,
-        (EFI_GRAPHICS_OUTPUT_BLT_PIXEL*)color_p,
-        EfiBltVideoFill,//EfiBltBufferToVideo,
-        0,
-        0,
-        area->x1,
-        area->y1,
-        w,
-        h,
-        0
-    );*/
-#endif
+
+    monitor_cursor_compose();
+    tPrivate->CursorDrawn = TRUE;
+}
+
+/**
+ * An area was just presented: take the new pixels under the cursor into
+ * the save-under and draw the cursor over them again
+ * @param buf pixel of 'area->x1;area->y1'
+ * @param stride distance of two rows in 'buf' in pixels
+ */
+STATIC void monitor_cursor_update(const lv_area_t * area, const lv_color_t * buf, UINTN stride)
+{
+    lv_area_t Common;
+    INTN Y;
+
+    if (!tPrivate->CursorDrawn || !_lv_area_intersect(&Common, area, &tPrivate->CursorArea)) {
+        return;
+    }
+
+    for (Y = Common.y1; Y <= Common.y2; Y++) {
+        monitor_expand_row(
+            tPrivate->CursorUnder + (Y - tPrivate->CursorY) * tPrivate->CursorWidth + (Common.x1 - tPrivate->CursorX),
+            buf + (Y - area->y1) * stride + (Common.x1 - area->x1),
+            lv_area_get_width(&Common)
+            );
+    }
+
+    monitor_cursor_compose();
+}
+
+/**
+ * Show an area on every output
+ * @param buf pixel of 'area->x1;area->y1'
+ * @param stride distance of two rows in 'buf' in pixels
+ */
+STATIC void monitor_present(const lv_area_t * area, const lv_color_t * buf, UINTN stride)
+{
+    UINTN Index;
+    UINTN Delta = 0;
+    MONITOR_OUTPUT *Output;
+    EFI_GRAPHICS_OUTPUT_PROTOCOL *GraphicsOutput;
+    EFI_GRAPHICS_OUTPUT_BLT_PIXEL *BltBuffer = NULL;
+
+    for (Index = 0; Index < tPrivate->OutputCount; Index++) {
+        Output = &tPrivate->Outputs[Index];
+        GraphicsOutput = Output->Gop;
+
+        if (GraphicsOutput->Mode->Mode != Output->ModeNumber) {
+            monitor_update_output_format(Output);
+        }
+
+        if (tPrivate->DirectEnabled && Output->HasFrameBuffer) {
+            monitor_present_direct(Output, area, buf, stride);
+            continue;
+        }
+
+        /*Convert once, no matter how many outputs need Blt*/
+        if (BltBuffer == NULL) {
+            BltBuffer = monitor_get_blt_buffer(area, buf, stride, &Delta);
+            if (BltBuffer == NULL) {
+                break;
+            }
+        }
+
+        GraphicsOutput->Blt(
+            GraphicsOutput,
+            BltBuffer,
+            EfiBltBufferToVideo,
+            0,
+            0,
+            area->x1,
+            area->y1,
+            lv_area_get_width(area),
+            lv_area_get_height(area),
+            Delta
+        );
+    }
+
+    monitor_cursor_update(area, buf, stride);
+}
+
+/**
+ * Add an area to the set presented at the end of the frame.
+ * Areas are merged as long as that does not cost more pixels than
+ * presenting them one by one (e.g. the horizontal stripes of one area).
+ */
+STATIC void monitor_dirty_add(const lv_area_t * area)
+{
+    lv_area_t Merged;
+    lv_area_t Union;
+    UINT32 Index;
+    UINT32 Best;
+    UINT32 BestGrowth;
+    UINT32 Growth;
+    BOOLEAN Joined;
+
+    lv_area_copy(&Merged, area);
+
+    do {
+        Joined = FALSE;
+        for (Index = 0; Index < tPrivate->DirtyCount; Index++) {
+            _lv_area_join(&Union, &Merged, &tPrivate->Dirty[Index]);
+            if (lv_area_get_size(&Union) <= lv_area_get_size(&Merged) + lv_area_get_size(&tPrivate->Dirty[Index])) {
+                lv_area_copy(&Merged, &Union);
+                tPrivate->Dirty[Index] = tPrivate->Dirty[--tPrivate->DirtyCount];
+                Joined = TRUE;
+                break;
+            }
+        }
+    } while (Joined);
+
+    if (tPrivate->DirtyCount < MONITOR_DIRTY_MAX) {
+        lv_area_copy(&tPrivate->Dirty[tPrivate->DirtyCount++], &Merged);
+        return;
+    }
+
+    /*The set is full: grow the area which needs the least extra pixels*/
+    Best = 0;
+    BestGrowth = MAX_UINT32;
+    for (Index = 0; Index < MONITOR_DIRTY_MAX; Index++) {
+        _lv_area_join(&Union, &Merged, &tPrivate->Dirty[Index]);
+        Growth = lv_area_get_size(&Union) - lv_area_get_size(&tPrivate->Dirty[Index]);
+        if (Growth < BestGrowth) {
+            BestGrowth = Growth;
+            Best = Index;
+        }
+    }
+    _lv_area_join(&tPrivate->Dirty[Best], &Merged, &tPrivate->Dirty[Best]);
+}
+
+/**
+ * Present the collected areas of a frame from a screen sized buffer
+ * @param screen pixel '0;0' of the buffer
+ * @param stride distance of two rows in 'screen' in pixels
+ */
+STATIC void monitor_dirty_present(const lv_color_t * screen, UINTN stride)
+{
+    UINT32 Index;
+    lv_area_t *Area;
+
+    for (Index = 0; Index < tPrivate->DirtyCount; Index++) {
+        Area = &tPrivate->Dirty[Index];
+        monitor_present(Area, screen + Area->y1 * stride + Area->x1, stride);
+    }
+
+    tPrivate->DirtyCount = 0;
+}
+
+/**
+ * Copy a rendered part into the shadow buffer and remember it as dirty
+ * @return false: no shadow buffer could be allocated, present the part directly
+ */
+STATIC bool monitor_shadow_store(lv_disp_drv_t * disp_drv, const lv_area_t * area, const lv_color_t * color_p)
+{
+    UINTN Width = lv_area_get_width(area);
+    UINTN Pixels = (UINTN)disp_drv->hor_res * disp_drv->ver_res;
+    lv_coord_t Y;
+
+    if (tPrivate->Shadow == NULL || tPrivate->ShadowWidth != (UINTN)disp_drv->hor_res ||
+        tPrivate->ShadowHeight != (UINTN)disp_drv->ver_res) {
+        if (tPrivate->Shadow != NULL) {
+            FreePool(tPrivate->Shadow);
+        }
+        tPrivate->Shadow = (lv_color_t*)AllocateZeroPool(Pixels * sizeof(lv_color_t));
+        tPrivate->ShadowWidth = disp_drv->hor_res;
+        tPrivate->ShadowHeight = disp_drv->ver_res;
+        tPrivate->DirtyCount = 0;
+        if (tPrivate->Shadow == NULL) {
+            return false;
+        }
+    }
+
+    for (Y = area->y1; Y <= area->y2; Y++) {
+        CopyMem(
+            tPrivate->Shadow + Y * tPrivate->ShadowWidth + area->x1,
+            color_p + (Y - area->y1) * Width,
+            Width * sizeof(lv_color_t)
+            );
+    }
+
+    monitor_dirty_add(area);
+    return true;
+}
+
+/**
+ * Run the queued flushes and report them ready to LVGL.
+ * The queue is only touched at TPL_CALLBACK: either here, from the
+ * timer notify, or with the TPL raised by the caller.
+ */
+STATIC void monitor_queue_run(void)
+{
+    MONITOR_JOB *Job;
+
+    while (tPrivate->QueueCount > 0) {
+        Job = &tPrivate->Queue[tPrivate->QueueHead];
+        monitor_present(&Job->Area, Job->Buf, lv_area_get_width(&Job->Area));
+
+        tPrivate->QueueHead = (tPrivate->QueueHead + 1) % MONITOR_QUEUE_MAX;
+        tPrivate->QueueCount--;
+
+        lv_disp_flush_ready(Job->Drv);
+    }
+}
+
+/**
+ * Timer notify of the deferred flush worker
+ */
+STATIC VOID EFIAPI monitor_queue_notify(IN EFI_EVENT Event, IN VOID *Context)
+{
+    if (tPrivate != NULL) {
+        monitor_queue_run();
+    }
+}
+
+/**
+ * Finish every queued flush before returning
+ */
+STATIC void monitor_queue_drain(void)
+{
+    EFI_TPL OldTpl;
+
+    if (tPrivate->QueueCount == 0) {
+        return;
+    }
+
+    OldTpl = gBS->RaiseTPL(TPL_CALLBACK);
+    monitor_queue_run();
+    gBS->RestoreTPL(OldTpl);
+}
+
+/**
+ * Called by LVGL while it waits for a flush to be ready. Set as 'disp_drv->wait_cb'.
+ * Instead of spinning until the next timer tick, do the copy right away.
+ */
+void monitor_wait(struct _disp_drv_t * disp_drv)
+{
+    if (tPrivate != NULL) {
+        monitor_queue_drain();
+    }
+}
+
+/**
+ * Hand a flush over to the deferred flush worker
+ * @return false: the flush has to be done synchronously
+ */
+STATIC bool monitor_queue_add(lv_disp_drv_t * disp_drv, const lv_area_t * area, const lv_color_t * color_p)
+{
+    EFI_TPL OldTpl;
+    MONITOR_JOB *Job;
+
+    //
+    // Raising to TPL_CALLBACK is only allowed from below it, and the worker
+    // would not get to run before the caller returns to a lower TPL anyway.
+    //
+    OldTpl = gBS->RaiseTPL(TPL_HIGH_LEVEL);
+    gBS->RestoreTPL(OldTpl);
+    if (OldTpl >= TPL_CALLBACK) {
+        return false;
+    }
+
+    OldTpl = gBS->RaiseTPL(TPL_CALLBACK);
+    if (tPrivate->QueueCount == MONITOR_QUEUE_MAX) {
+        gBS->RestoreTPL(OldTpl);
+        return false;
+    }
+
+    Job = &tPrivate->Queue[(tPrivate->QueueHead + tPrivate->QueueCount) % MONITOR_QUEUE_MAX];
+    Job->Drv = disp_drv;
+    Job->Buf = color_p;
+    lv_area_copy(&Job->Area, area);
+    tPrivate->QueueCount++;
+
+    /*Run on the next timer tick*/
+    gBS->SetTimer(tPrivate->FlushEvent, TimerRelative, 0);
+    gBS->RestoreTPL(OldTpl);
+
+    return true;
+}
+
+/**
+ * Flush a buffer to the display. Calls 'lv_flush_ready()' when finished.
+ * With 'async_flush' the copy is deferred to a TPL_CALLBACK timer, so LVGL can
+ * render into the second draw buffer meanwhile; 'lv_flush_ready()' is then
+ * called by the worker, or by 'monitor_wait' if it's set as 'disp_drv->wait_cb'.
+ */
+void monitor_flush(struct _disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    lv_disp_t * disp = _lv_refr_get_disp_refreshing();
+    bool true_double = disp != NULL && lv_disp_is_true_double_buf(disp);
+    uint32_t i;
+
+    if (tPrivate->FlushEvent != NULL && !true_double && !tPrivate->ShadowEnabled && !tPrivate->OutputsStale) {
+        if (monitor_queue_add(disp_drv, area, color_p)) {
+            return;
+        }
+    }
+
+    /*Synchronous path: keep the order with the flushes still queued*/
+    monitor_queue_drain();
+
+    if (tPrivate->OutputsStale) {
+        monitor_refresh_outputs();
+    }
+
+    if (true_double) {
+        /*'color_p' is a whole screen: present only what was invalidated in this frame.
+         *lv_refr.c copies the same areas to the other buffer afterwards.*/
+        const lv_region_t * inv = _lv_refr_get_inv_region();
+        for (i = 0; i < inv->cnt; i++) {
+            monitor_dirty_add(&inv->rects[i]);
+        }
+        monitor_dirty_present(color_p, disp_drv->hor_res);
+    }
+    else if (tPrivate->ShadowEnabled && monitor_shadow_store(disp_drv, area, color_p)) {
+        /*Present once per frame from the shadow buffer*/
+        if (lv_disp_flush_is_last(disp_drv)) {
+            monitor_dirty_present(tPrivate->Shadow, tPrivate->ShadowWidth);
+        }
+    }
+    else {
+        monitor_present(area, color_p, lv_area_get_width(area));
+    }
 
     /*IMPORTANT! It must be called to tell the system the flush is ready*/
     lv_disp_flush_ready(disp_drv);
 }
 
+/**
+ * Move the pixels of an area on the screen to scroll its content.
+ * Set as 'disp_drv->copy_cb'. LVGL calls it when the previous flush is ready.
+ * @return false: the area has to be redrawn
+ */
+bool monitor_copy(struct _disp_drv_t * disp_drv, const lv_area_t * area, lv_coord_t dx, lv_coord_t dy)
+{
+    UINTN Index;
+    UINTN Width;
+    UINTN Height;
+    lv_area_t Src;
+    lv_area_t Dst;
+    lv_coord_t Y;
+    EFI_TPL OldTpl;
+    EFI_GRAPHICS_OUTPUT_PROTOCOL *GraphicsOutput;
+
+    if (tPrivate == NULL || tPrivate->OutputCount == 0) {
+        return false;
+    }
+
+    monitor_queue_drain();
+
+    if (tPrivate->OutputsStale) {
+        monitor_refresh_outputs();
+    }
+
+    Width = lv_area_get_width(area) - LV_MATH_ABS(dx);
+    Height = lv_area_get_height(area) - LV_MATH_ABS(dy);
+    lv_area_set(&Src, area->x1 + MAX(-dx, 0), area->y1 + MAX(-dy, 0),
+                area->x2 - MAX(dx, 0), area->y2 - MAX(dy, 0));
+    lv_area_set(&Dst, area->x1 + MAX(dx, 0), area->y1 + MAX(dy, 0),
+                area->x2 + MIN(dx, 0), area->y2 + MIN(dy, 0));
+
+    //
+    // The shadow buffer is the source of the next presents: move the pixels
+    // there and present them with the rest of the frame.
+    //
+    if (tPrivate->ShadowEnabled && tPrivate->Shadow != NULL &&
+        tPrivate->ShadowWidth == (UINTN)disp_drv->hor_res && tPrivate->ShadowHeight == (UINTN)disp_drv->ver_res) {
+        for (Index = 0; Index < Height; Index++) {
+            Y = (dy > 0) ? (lv_coord_t)(Height - 1 - Index) : (lv_coord_t)Index;
+            CopyMem(
+                tPrivate->Shadow + (Dst.y1 + Y) * tPrivate->ShadowWidth + Dst.x1,
+                tPrivate->Shadow + (Src.y1 + Y) * tPrivate->ShadowWidth + Src.x1,
+                Width * sizeof(lv_color_t)
+                );
+        }
+        monitor_dirty_add(&Dst);
+        return true;
+    }
+
+    //
+    // The cursor must not be moved with the content: take it off the
+    // screen and draw it again over the moved pixels.
+    //
+    OldTpl = monitor_lock();
+    monitor_cursor_hide();
+    for (Index = 0; Index < tPrivate->OutputCount; Index++) {
+        GraphicsOutput = tPrivate->Outputs[Index].Gop;
+        GraphicsOutput->Blt(
+            GraphicsOutput,
+            NULL,
+            EfiBltVideoToVideo,
+            Src.x1,
+            Src.y1,
+            Dst.x1,
+            Dst.y1,
+            Width,
+            Height,
+            0
+        );
+    }
+    monitor_cursor_draw();
+    gBS->RestoreTPL(OldTpl);
+
+    return true;
+}
+
+/**
+ * Render the bands of an area on the processors found by 'monitor_init()'.
+ * Set as 'disp_drv->parallel_cb'.
+ * @return false: there are no application processors to render on
+ */
+bool monitor_parallel(struct _disp_drv_t * disp_drv, void (*band_cb)(uint32_t id), uint32_t band_cnt)
+{
+    return parallel_run(disp_drv, band_cb, band_cnt);
+}
+
+/**
+ * Get the number of processors 'monitor_parallel()' renders on.
+ * Set as 'disp_drv->parallel_cnt'.
+ */
+uint32_t monitor_parallel_cnt(void)
+{
+    return parallel_count();
+}
+
+/**
+ * Widen an area to whole cache lines of the draw buffer and frame buffer.
+ * Set as 'disp_drv->rounder_cb'.
+ */
+void monitor_rounder(struct _disp_drv_t * disp_drv, lv_area_t * area)
+{
+    area->x1 = area->x1 & ~(lv_coord_t)(MONITOR_ALIGN_PX - 1);
+    area->x2 = MIN(area->x2 | (lv_coord_t)(MONITOR_ALIGN_PX - 1), disp_drv->hor_res - 1);
+}
+
+/**
+ * Get the resolution of the current GOP mode
+ */
+void monitor_get_resolution(UINTN *Width, UINTN *Height)
+{
+    *Width = (tPrivate != NULL) ? tPrivate->Width : 0;
+    *Height = (tPrivate != NULL) ? tPrivate->Height : 0;
+}
+
+/**
+ * Get the resolution of a GOP mode
+ * @param Mode mode number, 0 .. monitor_get_mode_count() - 1
+ * @return FALSE: the mode could not be queried
+ */
+BOOLEAN monitor_get_mode(UINT32 Mode, UINTN *Width, UINTN *Height)
+{
+    EFI_STATUS Status;
+    UINTN SizeOfInfo;
+    EFI_GRAPHICS_OUTPUT_MODE_INFORMATION *Info;
+
+    if (tPrivate == NULL) {
+        return FALSE;
+    }
+
+    Status = tPrivate->Gop->QueryMode(tPrivate->Gop, Mode, &SizeOfInfo, &Info);
+    if (EFI_ERROR(Status)) {
+        return FALSE;
+    }
+
+    *Width = Info->HorizontalResolution;
+    *Height = Info->VerticalResolution;
+    FreePool(Info);
+    return TRUE;
+}
+
+/**
+ * Get the number of GOP modes
+ */
+UINT32 monitor_get_mode_count(void)
+{
+    return (tPrivate != NULL) ? tPrivate->Gop->Mode->MaxMode : 0;
+}
+
+/**
+ * Switch to the GOP mode closest to the requested resolution.
+ * The current mode is kept if no other mode is closer or the switch fails.
+ * @return the status of SetMode(), EFI_SUCCESS if the current mode is kept
+ */
+STATIC EFI_STATUS monitor_set_resolution(UINTN Width, UINTN Height)
+{
+    EFI_STATUS Status;
+    EFI_GRAPHICS_OUTPUT_PROTOCOL *Gop = tPrivate->Gop;
+    UINT32 Current;
+    UINT32 Mode;
+    UINT32 Best;
+    UINTN BestDiff;
+    UINTN Diff;
+    UINTN ModeWidth;
+    UINTN ModeHeight;
+
+    Current = Gop->Mode->Mode;
+    Best = Current;
+    BestDiff = MAX_UINTN;
+
+    for (Mode = 0; Mode < Gop->Mode->MaxMode; Mode++) {
+        if (!monitor_get_mode(Mode, &ModeWidth, &ModeHeight)) {
+            continue;
+        }
+
+        Diff = ((ModeWidth > Width) ? ModeWidth - Width : Width - ModeWidth) +
+               ((ModeHeight > Height) ? ModeHeight - Height : Height - ModeHeight);
+        if (Diff < BestDiff || (Diff == BestDiff && Mode == Current)) {
+            BestDiff = Diff;
+            Best = Mode;
+        }
+    }
+
+    if (Best == Current) {
+        return EFI_SUCCESS;
+    }
+
+    Status = Gop->SetMode(Gop, Best);
+    if (EFI_ERROR(Status) && Gop->Mode->Mode != Current) {
+        //
+        // The mode may have changed before the driver failed
+        //
+        Gop->SetMode(Gop, Current);
+    }
+    return Status;
+}
+
+/**
+ * Set the sprite of the cursor overlay
+ * @param Sprite BGRA pixels with the alpha in the reserved byte, NULL: built-in arrow
+ * @param HotX, HotY the pixel of the sprite at the pointer position
+ * @return FALSE: out of memory, the previous sprite is kept
+ */
+BOOLEAN monitor_cursor_set_sprite(CONST UINT32 *Sprite, UINTN Width, UINTN Height, INTN HotX, INTN HotY)
+{
+    EFI_TPL OldTpl;
+    UINT32 *Pixels;
+    UINTN X, Y;
+
+    if (tPrivate == NULL) {
+        return FALSE;
+    }
+
+    if (Sprite == NULL) {
+        Width = MONITOR_ARROW_W;
+        Height = MONITOR_ARROW_H;
+    }
+    if (Width == 0 || Height == 0) {
+        return FALSE;
+    }
+
+    /*Sprite, save-under and blend buffer in one allocation*/
+    Pixels = (UINT32*)AllocateZeroPool(3 * Width * Height * sizeof(UINT32));
+    if (Pixels == NULL) {
+        return FALSE;
+    }
+
+    if (Sprite != NULL) {
+        CopyMem(Pixels, Sprite, Width * Height * sizeof(UINT32));
+    } else {
+        for (Y = 0; Y < Height; Y++) {
+            for (X = 0; X < Width; X++) {
+                if (mCursorArrow[Y][X] == 'B') {
+                    Pixels[Y * Width + X] = 0xFF000000;
+                } else if (mCursorArrow[Y][X] == 'W') {
+                    Pixels[Y * Width + X] = 0xFFFFFFFF;
+                }
+            }
+        }
+    }
+
+    OldTpl = monitor_lock();
+    monitor_cursor_hide();
+    if (tPrivate->CursorSprite != NULL) {
+        FreePool(tPrivate->CursorSprite);
+    }
+    tPrivate->CursorX += tPrivate->CursorHotX - HotX;
+    tPrivate->CursorY += tPrivate->CursorHotY - HotY;
+    tPrivate->CursorSprite = Pixels;
+    tPrivate->CursorUnder = Pixels + Width * Height;
+    tPrivate->CursorBlend = Pixels + 2 * Width * Height;
+    tPrivate->CursorWidth = Width;
+    tPrivate->CursorHeight = Height;
+    tPrivate->CursorHotX = HotX;
+    tPrivate->CursorHotY = HotY;
+    monitor_cursor_draw();
+    gBS->RestoreTPL(OldTpl);
+
+    return TRUE;
+}
+
+/**
+ * Show or hide the cursor overlay. The built-in arrow is used if no sprite was set.
+ */
+void monitor_cursor_show(bool show)
+{
+    EFI_TPL OldTpl;
+
+    if (tPrivate == NULL) {
+        return;
+    }
+
+    if (show && tPrivate->CursorSprite == NULL && !monitor_cursor_set_sprite(NULL, 0, 0, 0, 0)) {
+        return;
+    }
+
+    OldTpl = monitor_lock();
+    monitor_cursor_hide();
+    tPrivate->CursorVisible = show;
+    monitor_cursor_draw();
+    gBS->RestoreTPL(OldTpl);
+}
+
+/**
+ * Move the cursor overlay. Only the old and the new cursor area are touched,
+ * nothing has to be rendered by LVGL.
+ */
+void monitor_cursor_move(lv_coord_t x, lv_coord_t y)
+{
+    EFI_TPL OldTpl;
+
+    if (tPrivate == NULL) {
+        return;
+    }
+
+    if (tPrivate->CursorX + tPrivate->CursorHotX == x && tPrivate->CursorY + tPrivate->CursorHotY == y) {
+        return;
+    }
+
+    OldTpl = monitor_lock();
+    monitor_cursor_hide();
+    tPrivate->CursorX = x - tPrivate->CursorHotX;
+    tPrivate->CursorY = y - tPrivate->CursorHotY;
+    monitor_cursor_draw();
+    gBS->RestoreTPL(OldTpl);
+}
+
+/**
+ * Get the way monitor_flush presents pixels
+ * @return "framebuffer" if at least one output is written directly, "blt" otherwise
+ */
+const char * monitor_flush_path(void)
+{
+    UINTN Index;
+
+    if (tPrivate == NULL || !tPrivate->DirectEnabled) {
+        return "blt";
+    }
+
+    for (Index = 0; Index < tPrivate->OutputCount; Index++) {
+        if (tPrivate->Outputs[Index].HasFrameBuffer) {
+            return "framebuffer";
+        }
+    }
+
+    return "blt";
+}
 
 /**
  * Initialize the monitor
+ * @param w requested horizontal resolution, 0: keep the current GOP mode
+ * @param h requested vertical resolution, 0: keep the current GOP mode
+ * @param direct allow writing straight into the GOP frame buffer
+ * @param shadow keep a screen sized shadow buffer and present once per frame
+ * @param async_flush copy flushes from a timer event while LVGL renders the next part
+ * @param parallel render on the application processors too
+ * @return EFI_SUCCESS, or an error and the monitor is not initialized: there is
+ *         no GOP, out of memory or the GOP mode could not be set
  */
-void monitor_init(int w, int h)
+EFI_STATUS monitor_init(int w, int h, bool direct, bool shadow, bool async_flush, bool parallel)
 {
     EFI_STATUS Status;
     EFI_GRAPHICS_OUTPUT_PROTOCOL *Gop;
-    
 
     if (tPrivate != NULL) {
         //
         // Already inited
         //
-        return;
+        return EFI_SUCCESS;
     }
 
     tPrivate = (MONITOR_PRIVATE*)AllocateZeroPool(sizeof(MONITOR_PRIVATE));
     if (tPrivate == NULL) {
         ASSERT(FALSE);
-        return;
+        return EFI_OUT_OF_RESOURCES;
     }
 
-    /*Status = gBS->HandleProtocol (
-                gST->ConsoleOutHandle,
-                &gEfiGraphicsOutputProtocolGuid,
-                (VOID**)&Gop
-                );*/
-
 	Status = gBS->LocateProtocol (
 								&gEfiGraphicsOutputProtocolGuid,
 								NULL,
@@ -123,76 +1108,107 @@ void monitor_init(int w, int h)
     if (EFI_ERROR(Status)) {
         ASSERT(FALSE);
         FreePool(tPrivate);
-        return;
+        tPrivate = NULL;
+        return Status;
     }
 
-    tPrivate->Gop = Gop;
-    tPrivate->Width = MIN(tPrivate->Width, Gop->Mode->Info->HorizontalResolution);
-    tPrivate->Height = MIN(tPrivate->Height, Gop->Mode->Info->VerticalResolution);
+    pixel_init();
 
-{
-  EFI_STATUS Status;
-  UINTN Index;
-  EFI_GRAPHICS_OUTPUT_PROTOCOL   *GraphicsOutput;
-  EFI_HANDLE *HndlBuf;
-  UINTN HndlNum;
+    tPrivate->Gop = Gop;
+    tPrivate->DirectEnabled = direct;
+    tPrivate->ShadowEnabled = shadow;
 
-  Status = gBS->LocateHandleBuffer(ByProtocol, &gEfiGraphicsOutputProtocolGuid, NULL, &HndlNum,  &HndlBuf);
-  if (EFI_ERROR(Status) || HndlNum == 0) {
-    return;
-  }
+    if (w > 0 && h > 0) {
+        Status = monitor_set_resolution(w, h);
+        if (EFI_ERROR(Status)) {
+            FreePool(tPrivate);
+            tPrivate = NULL;
+            return Status;
+        }
+    }
+    tPrivate->Width = Gop->Mode->Info->HorizontalResolution;
+    tPrivate->Height = Gop->Mode->Info->VerticalResolution;
 
-  for (Index = 0; Index < HndlNum; Index++) {
+    monitor_refresh_outputs();
 
-    
-    Status = gBS->HandleProtocol (
-                    HndlBuf[Index],
-                    &gEfiGraphicsOutputProtocolGuid,
-                    (VOID **) &GraphicsOutput
+    //
+    // Keep the output table in sync with GOP instances installed later on
+    // (e.g. a console splitter or a GPU driver connected after us).
+    //
+    Status = gBS->CreateEvent(
+                    EVT_NOTIFY_SIGNAL,
+                    TPL_CALLBACK,
+                    monitor_gop_notify,
+                    NULL,
+                    &tPrivate->GopNotifyEvent
                     );
-    if (EFI_ERROR(Status)) {
-      continue;
+    if (!EFI_ERROR(Status)) {
+        Status = gBS->RegisterProtocolNotify(
+                        &gEfiGraphicsOutputProtocolGuid,
+                        tPrivate->GopNotifyEvent,
+                        &tPrivate->GopNotifyRegistration
+                        );
+        if (EFI_ERROR(Status)) {
+            gBS->CloseEvent(tPrivate->GopNotifyEvent);
+            tPrivate->GopNotifyEvent = NULL;
+        }
     }
 
-    /*EFI_GRAPHICS_OUTPUT_BLT_PIXEL p;
-    p.Blue = 255;
-    GraphicsOutput->Blt(
-        GraphicsOutput,
-        (EFI_GRAPHICS_OUTPUT_BLT_PIXEL*)&p,
-        EfiBltVideoFill,
-        0,
-        0,
-        0,
-        0,
-        100,
-        100,
-        0
-    );*/
-  }
-
-    EFI_GRAPHICS_OUTPUT_BLT_PIXEL p;
-    p.Blue = 255;
-    Gop->Blt(
-        Gop,
-        (EFI_GRAPHICS_OUTPUT_BLT_PIXEL*)&p,
-        EfiBltBufferToVideo,
-        0,
-        0,
-        0,
-        0,
-        100,
-        100,
-        0
-    );
-}
+    //
+    // Without the worker event every flush is done synchronously.
+    //
+    if (async_flush) {
+        Status = gBS->CreateEvent(
+                        EVT_TIMER | EVT_NOTIFY_SIGNAL,
+                        TPL_CALLBACK,
+                        monitor_queue_notify,
+                        NULL,
+                        &tPrivate->FlushEvent
+                        );
+        if (EFI_ERROR(Status)) {
+            tPrivate->FlushEvent = NULL;
+        }
+    }
 
+    //
+    // The display driver opts in with 'ed.monitor_parallel' and 'ed.monitor_parallel_cnt()'
+    //
+    if (parallel) {
+        parallel_init();
+    }
+
+    return EFI_SUCCESS;
 }
 
 /**
- * Deinit the monitor and close SDL
+ * Deinit the monitor
  */
 void monitor_deinit(void)
 {
+    if (tPrivate == NULL) {
+        return;
+    }
+
+    if (tPrivate->FlushEvent != NULL) {
+        monitor_queue_drain();
+        gBS->CloseEvent(tPrivate->FlushEvent);
+    }
+    parallel_deinit();
+    if (tPrivate->GopNotifyEvent != NULL) {
+        gBS->CloseEvent(tPrivate->GopNotifyEvent);
+    }
+    if (tPrivate->Outputs != NULL) {
+        FreePool(tPrivate->Outputs);
+    }
+    if (tPrivate->Scratch != NULL) {
+        FreePool(tPrivate->Scratch);
+    }
+    if (tPrivate->Shadow != NULL) {
+        FreePool(tPrivate->Shadow);
+    }
+    if (tPrivate->CursorSprite != NULL) {
+        FreePool(tPrivate->CursorSprite);
+    }
     FreePool(tPrivate);
     tPrivate = NULL;
-}
\ No newline at end of file
+}
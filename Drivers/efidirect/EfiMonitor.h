@@ -9,16 +9,23 @@
 /*********************
  *      INCLUDES
  *********************/
+#ifdef PIXEL_HOST_BUILD
+#include "HostBench/HostUefi.h"
+#else
 #include <Uefi.h>
 #include <Protocol/GraphicsOutput.h>
 #include <Library/UefiBootServicesTableLib.h>
 #include <Library/MemoryAllocationLib.h>
 #include <Library/DebugLib.h>
+#endif
 
 #include "../../lv_binding_micropython/lvgl/lvgl.h"
     
 #include "lvgl/src/lv_misc/lv_color.h"
 
+#include "EfiPixel.h"
+#include "EfiParallel.h"
+
 extern void lv_disp_flush_ready(lv_disp_drv_t * disp_drv);
 
 /*********************
@@ -32,8 +39,20 @@ extern void lv_disp_flush_ready(lv_disp_drv_t * disp_drv);
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
-void monitor_init(int w, int h);
+EFI_STATUS monitor_init(int w, int h, bool direct, bool shadow, bool async_flush, bool parallel);
 void monitor_deinit(void);
 void monitor_flush(struct _disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
+void monitor_wait(struct _disp_drv_t * disp_drv);
+const char * monitor_flush_path(void);
+void monitor_rounder(struct _disp_drv_t * disp_drv, lv_area_t * area);
+bool monitor_copy(struct _disp_drv_t * disp_drv, const lv_area_t * area, lv_coord_t dx, lv_coord_t dy);
+bool monitor_parallel(struct _disp_drv_t * disp_drv, void (*band_cb)(uint32_t id), uint32_t band_cnt);
+uint32_t monitor_parallel_cnt(void);
+void monitor_get_resolution(UINTN *Width, UINTN *Height);
+BOOLEAN monitor_get_mode(UINT32 Mode, UINTN *Width, UINTN *Height);
+UINT32 monitor_get_mode_count(void);
+BOOLEAN monitor_cursor_set_sprite(CONST UINT32 *Sprite, UINTN Width, UINTN Height, INTN HotX, INTN HotY);
+void monitor_cursor_show(bool show);
+void monitor_cursor_move(lv_coord_t x, lv_coord_t y);
 
  #endif /* MONITOR_H */
\ No newline at end of file
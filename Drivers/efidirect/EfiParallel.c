@@ -0,0 +1,265 @@
+/**
+ * @file EfiParallel.c
+ * Render the bands of LVGL's refreshed areas on the application processors
+ * (APs) with the MP services protocol. The BSP renders band 0 and serves the
+ * memory requests of the APs meanwhile (see lv_worker.h), each AP takes one
+ * of the other bands.
+ *
+ * Code running on an AP must not call boot services or MicroPython: the
+ * fonts, the display driver's 'set_px_cb' and the GPU callbacks used while
+ * rendering have to be MP safe. Image decoders are only called on the BSP.
+ *
+ * XCR0 is per processor: the AVX2 blend kernels are selected on the BSP, so
+ * the AVX state is enabled on the APs too, or the SSE2 kernels are used.
+ */
+
+#include "EfiParallel.h"
+
+#if LV_REFR_PARALLEL_MAX > 1
+
+typedef struct {
+    EFI_MP_SERVICES_PROTOCOL *Mp;
+    UINTN ApCount;                  /*Enabled APs*/
+    EFI_EVENT DoneEvent;            /*Signaled when all APs returned*/
+    void (*BandCb)(uint32_t id);
+    UINT32 BandCount;
+    volatile UINT32 NextBand;       /*The last band taken by an AP*/
+    volatile UINT32 DoneCount;      /*APs which returned from their band*/
+    BOOLEAN Started;                /*'DoneEvent' wasn't checked since the last start*/
+    BOOLEAN ApAvx;                  /*The APs can run the AVX2 kernels*/
+    volatile UINT32 NoAvxCount;     /*APs which can't save the AVX state*/
+} PARALLEL_PRIVATE;
+
+STATIC PARALLEL_PRIVATE mParallel;
+
+#if LV_USE_BLEND_SIMD && defined(MDE_CPU_X64)
+/**
+ * Enable the AVX state on the running processor if the firmware didn't
+ * @return FALSE: the processor can't save the AVX state, the AVX2 kernels would fault
+ */
+STATIC BOOLEAN parallel_enable_avx(VOID)
+{
+    UINT32 Eax;
+    UINT32 Ecx;
+
+    //
+    // XSAVE and AVX, and XCR0 supports the SSE and AVX state
+    //
+    AsmCpuid(1, NULL, NULL, &Ecx, NULL);
+    if ((Ecx & (BIT26 | BIT28)) != (BIT26 | BIT28)) {
+        return FALSE;
+    }
+    AsmCpuidEx(0xD, 0, &Eax, NULL, NULL, NULL);
+    if ((Eax & (BIT1 | BIT2)) != (BIT1 | BIT2)) {
+        return FALSE;
+    }
+
+    if ((AsmReadCr4() & BIT18) == 0) {
+        AsmWriteCr4(AsmReadCr4() | BIT18);  /*CR4.OSXSAVE*/
+    }
+    if ((AsmXGetBv(0) & (BIT1 | BIT2)) != (BIT1 | BIT2)) {
+        AsmXSetBv(0, AsmXGetBv(0) | BIT1 | BIT2);
+    }
+    return TRUE;
+}
+
+/**
+ * Run on every enabled AP by 'parallel_init': count the APs without the AVX state
+ */
+STATIC VOID EFIAPI parallel_ap_avx(VOID *Buffer)
+{
+    if (!parallel_enable_avx()) {
+        InterlockedIncrement(&mParallel.NoAvxCount);
+    }
+}
+
+/**
+ * Enable the AVX state on the APs. The kernels may not be selected yet:
+ * 'parallel_init' can run before 'lv_init'.
+ */
+STATIC VOID parallel_init_avx(VOID)
+{
+    EFI_STATUS Status;
+
+    Status = mParallel.Mp->StartupAllAPs(mParallel.Mp, parallel_ap_avx, FALSE, NULL, 0, NULL, NULL);
+    mParallel.ApAvx = !EFI_ERROR(Status) && mParallel.NoAvxCount == 0;
+}
+#endif
+
+/**
+ * Run on every enabled AP: take the next band and render it.
+ * There can be more APs than bands, the extra ones return right away.
+ */
+STATIC VOID EFIAPI parallel_ap_procedure(VOID *Buffer)
+{
+    UINT32 Id;
+
+#if LV_USE_BLEND_SIMD && defined(MDE_CPU_X64)
+    //
+    // Again, in case the AP was reset since 'parallel_init'
+    //
+    if (mParallel.ApAvx) {
+        parallel_enable_avx();
+    }
+#endif
+
+    Id = InterlockedIncrement(&mParallel.NextBand);
+    if (Id < mParallel.BandCount) {
+        mParallel.BandCb(Id);
+    }
+    InterlockedIncrement(&mParallel.DoneCount);
+}
+
+/**
+ * Render the bands on the BSP and the APs. Set as 'disp_drv->parallel_cb'.
+ * @return false: the APs could not be started, nothing was rendered
+ */
+bool parallel_run(lv_disp_drv_t * disp_drv, void (*band_cb)(uint32_t id), uint32_t band_cnt)
+{
+    EFI_STATUS Status;
+
+    if (mParallel.Mp == NULL) {
+        return false;
+    }
+
+#if LV_USE_BLEND_SIMD && defined(MDE_CPU_X64)
+    //
+    // An AP can't run the AVX2 kernels: all the bands use the SSE2 ones
+    //
+    if (!mParallel.ApAvx && _lv_blend_simd_get() == LV_BLEND_SIMD_AVX2) {
+        _lv_blend_simd_set(LV_BLEND_SIMD_SSE2);
+    }
+#endif
+
+    //
+    // The APs returned from the last run but the MP services see them idle
+    // only on their next periodic check
+    //
+    if (mParallel.Started) {
+        while (gBS->CheckEvent(mParallel.DoneEvent) == EFI_NOT_READY) {
+            CpuPause();
+        }
+        mParallel.Started = FALSE;
+    }
+
+    mParallel.BandCb = band_cb;
+    mParallel.BandCount = band_cnt;
+    mParallel.NextBand = 0;
+    mParallel.DoneCount = 0;
+
+    //
+    // Non-blocking: the BSP renders band 0 while the APs run
+    //
+    Status = mParallel.Mp->StartupAllAPs(
+                             mParallel.Mp,
+                             parallel_ap_procedure,
+                             FALSE,
+                             mParallel.DoneEvent,
+                             0,
+                             NULL,
+                             NULL
+                             );
+    if (EFI_ERROR(Status)) {
+        return false;
+    }
+    mParallel.Started = TRUE;
+
+    //
+    // Returns when every band is rendered. Don't wait for 'DoneEvent' here:
+    // it's signaled up to a timer period after the APs returned.
+    //
+    band_cb(0);
+    while (mParallel.DoneCount < mParallel.ApCount) {
+        CpuPause();
+    }
+
+    return true;
+}
+
+/**
+ * Find the application processors
+ * @return FALSE: there is no MP services protocol or no enabled AP
+ */
+BOOLEAN parallel_init(void)
+{
+    EFI_STATUS Status;
+    EFI_MP_SERVICES_PROTOCOL *Mp;
+    UINTN Count;
+    UINTN EnabledCount;
+
+    ZeroMem(&mParallel, sizeof(mParallel));
+
+    Status = gBS->LocateProtocol(&gEfiMpServiceProtocolGuid, NULL, (VOID **)&Mp);
+    if (EFI_ERROR(Status)) {
+        return FALSE;
+    }
+
+    Status = Mp->GetNumberOfProcessors(Mp, &Count, &EnabledCount);
+    if (EFI_ERROR(Status) || EnabledCount < 2) {
+        return FALSE;
+    }
+
+    Status = gBS->CreateEvent(0, TPL_CALLBACK, NULL, NULL, &mParallel.DoneEvent);
+    if (EFI_ERROR(Status)) {
+        return FALSE;
+    }
+
+    mParallel.Mp = Mp;
+    mParallel.ApCount = EnabledCount - 1;
+#if LV_USE_BLEND_SIMD && defined(MDE_CPU_X64)
+    parallel_init_avx();
+#endif
+    return TRUE;
+}
+
+/**
+ * Forget the application processors
+ */
+void parallel_deinit(void)
+{
+    if (mParallel.DoneEvent != NULL) {
+        if (mParallel.Started) {
+            while (gBS->CheckEvent(mParallel.DoneEvent) == EFI_NOT_READY) {
+                CpuPause();
+            }
+        }
+        gBS->CloseEvent(mParallel.DoneEvent);
+    }
+    ZeroMem(&mParallel, sizeof(mParallel));
+}
+
+/**
+ * Get the number of processors 'parallel_run' renders on. Set as 'disp_drv->parallel_cnt'.
+ * @return the enabled APs + the BSP, 1: 'parallel_init' found no AP
+ */
+uint32_t parallel_count(void)
+{
+    if (mParallel.Mp == NULL) {
+        return 1;
+    }
+
+    return (uint32_t)MIN(mParallel.ApCount + 1, LV_REFR_PARALLEL_MAX);
+}
+
+#else
+
+BOOLEAN parallel_init(void)
+{
+    return FALSE;
+}
+
+void parallel_deinit(void)
+{
+}
+
+bool parallel_run(lv_disp_drv_t * disp_drv, void (*band_cb)(uint32_t id), uint32_t band_cnt)
+{
+    return false;
+}
+
+uint32_t parallel_count(void)
+{
+    return 1;
+}
+
+#endif /*LV_REFR_PARALLEL_MAX > 1*/
@@ -0,0 +1,64 @@
+/**
+ * @file EfiParallel.h
+ *
+ */
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+/*********************
+ *      INCLUDES
+ *********************/
+#ifdef PIXEL_HOST_BUILD
+#include "HostBench/HostUefi.h"
+#else
+#include <Uefi.h>
+#include <Protocol/MpService.h>
+#include <Library/UefiBootServicesTableLib.h>
+#include <Library/SynchronizationLib.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#endif
+
+#include "../../lv_binding_micropython/lvgl/lvgl.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Find the application processors
+ * @return FALSE: there is no MP services protocol or no enabled AP
+ */
+BOOLEAN parallel_init(void);
+
+/**
+ * Forget the application processors
+ */
+void parallel_deinit(void);
+
+/**
+ * Render the bands on the BSP and the APs. Set as 'disp_drv->parallel_cb'.
+ * @return false: the APs could not be started, nothing was rendered
+ */
+bool parallel_run(lv_disp_drv_t * disp_drv, void (*band_cb)(uint32_t id), uint32_t band_cnt);
+
+/**
+ * Get the number of processors 'parallel_run' renders on. Set as 'disp_drv->parallel_cnt'.
+ * @return the enabled APs + the BSP, 1: 'parallel_init' found no AP
+ */
+uint32_t parallel_count(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /* PARALLEL_H */
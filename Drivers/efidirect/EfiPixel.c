@@ -0,0 +1,445 @@
+#include "EfiPixel.h"
+
+#if defined(MDE_CPU_X64)
+#include <emmintrin.h>
+#define PIXEL_USE_SSE2  1
+#else
+#define PIXEL_USE_SSE2  0
+#endif
+
+#if PIXEL_USE_SSE2 && (defined(__GNUC__) || defined(_MSC_VER))
+#include <immintrin.h>
+#define PIXEL_USE_AVX2  1
+#ifdef __GNUC__
+#define PIXEL_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define PIXEL_TARGET_AVX2
+#endif
+#else
+#define PIXEL_USE_AVX2  0
+#endif
+
+typedef void (*PIXEL_EXPAND_RGB565)(UINT32 *Dst, CONST UINT16 *Src, UINTN Count, BOOLEAN Swapped);
+
+STATIC void pixel_expand_rgb565_sse2(UINT32 *Dst, CONST UINT16 *Src, UINTN Count, BOOLEAN Swapped);
+#if PIXEL_USE_AVX2
+STATIC PIXEL_TARGET_AVX2 void pixel_expand_rgb565_avx2(UINT32 *Dst, CONST UINT16 *Src, UINTN Count, BOOLEAN Swapped);
+#endif
+
+STATIC PIXEL_EXPAND_RGB565 mExpandRgb565 = pixel_expand_rgb565_sse2;
+STATIC UINT32 mRgb332Lut[256];
+STATIC BOOLEAN mUseAvx2 = FALSE;
+
+/**
+ * Expand one RGB565 pixel, the reference for the vector kernels
+ */
+STATIC UINT32 pixel_rgb565_to_bgrx(UINT16 Pixel)
+{
+    UINT32 R = (((Pixel >> 11) & 0x1F) * 263 + 7) >> 5;
+    UINT32 G = (((Pixel >> 5) & 0x3F) * 259 + 3) >> 6;
+    UINT32 B = ((Pixel & 0x1F) * 263 + 7) >> 5;
+
+    return 0xFF000000 | (R << 16) | (G << 8) | B;
+}
+
+#if PIXEL_USE_AVX2
+/**
+ * AVX2 is usable only if the CPU has it and XCR0 enables the YMM state.
+ * Firmware does not always set up the latter.
+ */
+STATIC BOOLEAN pixel_cpu_has_avx2(void)
+{
+    UINT32 MaxLeaf;
+    UINT32 Ebx;
+    UINT32 Ecx;
+    UINT64 Xcr0;
+
+    AsmCpuid(0, &MaxLeaf, NULL, NULL, NULL);
+    if (MaxLeaf < 7) {
+        return FALSE;
+    }
+
+    AsmCpuid(1, NULL, NULL, &Ecx, NULL);
+    if ((Ecx & BIT27) == 0 || (Ecx & BIT28) == 0) {  /*OSXSAVE, AVX*/
+        return FALSE;
+    }
+
+#ifdef _MSC_VER
+    Xcr0 = _xgetbv(0);
+#else
+    {
+        UINT32 Lo, Hi;
+        __asm__ __volatile__ ("xgetbv" : "=a" (Lo), "=d" (Hi) : "c" (0));
+        Xcr0 = ((UINT64)Hi << 32) | Lo;
+    }
+#endif
+    if ((Xcr0 & 0x6) != 0x6) {  /*XMM and YMM state*/
+        return FALSE;
+    }
+
+    AsmCpuidEx(7, 0, NULL, &Ebx, NULL, NULL);
+    return (Ebx & BIT5) != 0;
+}
+#endif
+
+/**
+ * Select the row kernels for the running CPU (SSE2 or AVX2)
+ */
+void pixel_init(void)
+{
+    UINT32 Index;
+
+    /*lv_color8_t is R3 G3 B2, scale like lv_color_to32()*/
+    for (Index = 0; Index < 256; Index++) {
+        mRgb332Lut[Index] = 0xFF000000 |
+                            (((Index >> 5) & 0x7) * 36) << 16 |
+                            (((Index >> 2) & 0x7) * 36) << 8 |
+                            ((Index & 0x3) * 85);
+    }
+
+#if PIXEL_USE_AVX2
+    mUseAvx2 = pixel_cpu_has_avx2();
+    if (mUseAvx2) {
+        mExpandRgb565 = pixel_expand_rgb565_avx2;
+    }
+#endif
+}
+
+/**
+ * Check whether the AVX2 kernels were selected by pixel_init
+ */
+BOOLEAN pixel_use_avx2(void)
+{
+    return mUseAvx2;
+}
+
+/**
+ * Compute the shifts which place an 8 bit channel value into 'Mask'
+ */
+STATIC void pixel_mask_to_shift(UINT32 Mask, UINT8 *Shr, UINT8 *Shl)
+{
+    UINT8 Low = 0;
+    UINT8 Width = 0;
+
+    if (Mask == 0) {
+        *Shr = 8;
+        *Shl = 0;
+        return;
+    }
+
+    while ((Mask & 1) == 0) {
+        Mask >>= 1;
+        Low++;
+    }
+    while ((Mask & 1) != 0) {
+        Mask >>= 1;
+        Width++;
+    }
+
+    if (Width < 8) {
+        *Shr = 8 - Width;
+        *Shl = Low;
+    } else {
+        *Shr = 0;
+        *Shl = Low + Width - 8;
+    }
+}
+
+/**
+ * Describe the frame buffer layout of a GOP mode
+ * @param Info mode information of the GOP
+ * @param Format store the layout here
+ * @return FALSE: the mode has no linear frame buffer (PixelBltOnly) or an unknown format
+ */
+BOOLEAN pixel_format_from_gop(CONST EFI_GRAPHICS_OUTPUT_MODE_INFORMATION *Info, PIXEL_FORMAT *Format)
+{
+    UINT32 AllBits;
+
+    ZeroMem(Format, sizeof(PIXEL_FORMAT));
+
+    switch (Info->PixelFormat) {
+    case PixelBlueGreenRedReserved8BitPerColor:
+        Format->Layout = PIXEL_LAYOUT_BGRX;
+        Format->BytesPerPixel = 4;
+        return TRUE;
+
+    case PixelRedGreenBlueReserved8BitPerColor:
+        Format->Layout = PIXEL_LAYOUT_RGBX;
+        Format->BytesPerPixel = 4;
+        return TRUE;
+
+    case PixelBitMask:
+        AllBits = Info->PixelInformation.RedMask | Info->PixelInformation.GreenMask |
+                  Info->PixelInformation.BlueMask | Info->PixelInformation.ReservedMask;
+        if (AllBits == 0) {
+            return FALSE;
+        }
+
+        Format->Layout = PIXEL_LAYOUT_BITMASK;
+        Format->BytesPerPixel = (AllBits > 0xFFFFFF) ? 4 : (AllBits > 0xFFFF) ? 3 : 2;
+        pixel_mask_to_shift(Info->PixelInformation.RedMask, &Format->RedShr, &Format->RedShl);
+        pixel_mask_to_shift(Info->PixelInformation.GreenMask, &Format->GreenShr, &Format->GreenShl);
+        pixel_mask_to_shift(Info->PixelInformation.BlueMask, &Format->BlueShr, &Format->BlueShl);
+        return TRUE;
+
+    default:
+        return FALSE;
+    }
+}
+
+/**
+ * BGRX -> BGRX. The frame buffer is usually write-combined, so use
+ * streaming stores once the destination is 16 byte aligned.
+ */
+STATIC void pixel_row_copy(UINT32 *Dst, CONST UINT32 *Src, UINTN Count)
+{
+#if PIXEL_USE_SSE2
+    while (Count > 0 && ((UINTN)Dst & 0xF) != 0) {
+        *Dst++ = *Src++;
+        Count--;
+    }
+
+    while (Count >= 8) {
+        __m128i A = _mm_loadu_si128((CONST __m128i *)Src);
+        __m128i B = _mm_loadu_si128((CONST __m128i *)(Src + 4));
+        _mm_stream_si128((__m128i *)Dst, A);
+        _mm_stream_si128((__m128i *)(Dst + 4), B);
+        Src += 8;
+        Dst += 8;
+        Count -= 8;
+    }
+
+    if (Count >= 4) {
+        _mm_stream_si128((__m128i *)Dst, _mm_loadu_si128((CONST __m128i *)Src));
+        Src += 4;
+        Dst += 4;
+        Count -= 4;
+    }
+    _mm_sfence();
+#endif
+
+    while (Count > 0) {
+        *Dst++ = *Src++;
+        Count--;
+    }
+}
+
+/**
+ * BGRX -> RGBX: swap the red and blue bytes of every pixel
+ */
+STATIC void pixel_row_swap_rb(UINT32 *Dst, CONST UINT32 *Src, UINTN Count)
+{
+    UINT32 Pixel;
+
+#if PIXEL_USE_SSE2
+    CONST __m128i RbMask = _mm_set1_epi32(0x00FF00FF);
+    CONST __m128i GxMask = _mm_set1_epi32((INT32)0xFF00FF00);
+
+    while (Count >= 4) {
+        __m128i V = _mm_loadu_si128((CONST __m128i *)Src);
+        __m128i Rb = _mm_or_si128(_mm_slli_epi32(V, 16), _mm_srli_epi32(V, 16));
+        V = _mm_or_si128(_mm_and_si128(V, GxMask), _mm_and_si128(Rb, RbMask));
+        _mm_storeu_si128((__m128i *)Dst, V);
+        Src += 4;
+        Dst += 4;
+        Count -= 4;
+    }
+#endif
+
+    while (Count > 0) {
+        Pixel = *Src++;
+        *Dst++ = (Pixel & 0xFF00FF00) | ((Pixel >> 16) & 0xFF) | ((Pixel & 0xFF) << 16);
+        Count--;
+    }
+}
+
+/**
+ * BGRX -> arbitrary PixelBitMask layout. Rare enough in practice that a
+ * scalar loop is good enough.
+ */
+STATIC void pixel_row_bitmask(UINT8 *Dst, CONST UINT32 *Src, UINTN Count, CONST PIXEL_FORMAT *Format)
+{
+    UINT32 Pixel;
+    UINT32 Out;
+
+    while (Count > 0) {
+        Pixel = *Src++;
+        Out = (((Pixel >> 16) & 0xFF) >> Format->RedShr) << Format->RedShl;
+        Out |= (((Pixel >> 8) & 0xFF) >> Format->GreenShr) << Format->GreenShl;
+        Out |= ((Pixel & 0xFF) >> Format->BlueShr) << Format->BlueShl;
+
+        switch (Format->BytesPerPixel) {
+        case 2:
+            *(UINT16 *)Dst = (UINT16)Out;
+            break;
+        case 3:
+            Dst[0] = (UINT8)Out;
+            Dst[1] = (UINT8)(Out >> 8);
+            Dst[2] = (UINT8)(Out >> 16);
+            break;
+        default:
+            *(UINT32 *)Dst = Out;
+            break;
+        }
+        Dst += Format->BytesPerPixel;
+        Count--;
+    }
+}
+
+/**
+ * Convert a row of BGRX (lv_color32_t) pixels to the frame buffer layout
+ * @param Dst destination in the frame buffer
+ * @param Src source pixels
+ * @param Count number of pixels
+ * @param Format destination layout
+ */
+void pixel_convert_row(VOID *Dst, CONST UINT32 *Src, UINTN Count, CONST PIXEL_FORMAT *Format)
+{
+    switch (Format->Layout) {
+    case PIXEL_LAYOUT_BGRX:
+        pixel_row_copy((UINT32 *)Dst, Src, Count);
+        break;
+    case PIXEL_LAYOUT_RGBX:
+        pixel_row_swap_rb((UINT32 *)Dst, Src, Count);
+        break;
+    case PIXEL_LAYOUT_BITMASK:
+        pixel_row_bitmask((UINT8 *)Dst, Src, Count, Format);
+        break;
+    }
+}
+
+/**
+ * RGB565 -> BGRX, 8 pixels per iteration with SSE2
+ */
+STATIC void pixel_expand_rgb565_sse2(UINT32 *Dst, CONST UINT16 *Src, UINTN Count, BOOLEAN Swapped)
+{
+    UINT16 Pixel;
+
+#if PIXEL_USE_SSE2
+    CONST __m128i Mask5 = _mm_set1_epi16(0x1F);
+    CONST __m128i Mask6 = _mm_set1_epi16(0x3F);
+    CONST __m128i Mul5 = _mm_set1_epi16(263);
+    CONST __m128i Add5 = _mm_set1_epi16(7);
+    CONST __m128i Mul6 = _mm_set1_epi16(259);
+    CONST __m128i Add6 = _mm_set1_epi16(3);
+    CONST __m128i Alpha = _mm_set1_epi16((INT16)0xFF00);
+
+    while (Count >= 8) {
+        __m128i V = _mm_loadu_si128((CONST __m128i *)Src);
+        __m128i R, G, B, Lo, Hi;
+
+        if (Swapped) {
+            V = _mm_or_si128(_mm_slli_epi16(V, 8), _mm_srli_epi16(V, 8));
+        }
+
+        R = _mm_srli_epi16(V, 11);
+        G = _mm_and_si128(_mm_srli_epi16(V, 5), Mask6);
+        B = _mm_and_si128(V, Mask5);
+        R = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(R, Mul5), Add5), 5);
+        G = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(G, Mul6), Add6), 6);
+        B = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(B, Mul5), Add5), 5);
+
+        Lo = _mm_or_si128(B, _mm_slli_epi16(G, 8));
+        Hi = _mm_or_si128(R, Alpha);
+        _mm_storeu_si128((__m128i *)Dst, _mm_unpacklo_epi16(Lo, Hi));
+        _mm_storeu_si128((__m128i *)(Dst + 4), _mm_unpackhi_epi16(Lo, Hi));
+
+        Src += 8;
+        Dst += 8;
+        Count -= 8;
+    }
+#endif
+
+    while (Count > 0) {
+        Pixel = *Src++;
+        if (Swapped) {
+            Pixel = (UINT16)((Pixel << 8) | (Pixel >> 8));
+        }
+        *Dst++ = pixel_rgb565_to_bgrx(Pixel);
+        Count--;
+    }
+}
+
+#if PIXEL_USE_AVX2
+/**
+ * RGB565 -> BGRX, 16 pixels per iteration with AVX2
+ */
+STATIC PIXEL_TARGET_AVX2 void pixel_expand_rgb565_avx2(UINT32 *Dst, CONST UINT16 *Src, UINTN Count, BOOLEAN Swapped)
+{
+    CONST __m256i Mask5 = _mm256_set1_epi16(0x1F);
+    CONST __m256i Mask6 = _mm256_set1_epi16(0x3F);
+    CONST __m256i Mul5 = _mm256_set1_epi16(263);
+    CONST __m256i Add5 = _mm256_set1_epi16(7);
+    CONST __m256i Mul6 = _mm256_set1_epi16(259);
+    CONST __m256i Add6 = _mm256_set1_epi16(3);
+    CONST __m256i Alpha = _mm256_set1_epi16((INT16)0xFF00);
+
+    while (Count >= 16) {
+        __m256i V = _mm256_loadu_si256((CONST __m256i *)Src);
+        __m256i R, G, B, Lo, Hi, P0, P1;
+
+        if (Swapped) {
+            V = _mm256_or_si256(_mm256_slli_epi16(V, 8), _mm256_srli_epi16(V, 8));
+        }
+
+        R = _mm256_srli_epi16(V, 11);
+        G = _mm256_and_si256(_mm256_srli_epi16(V, 5), Mask6);
+        B = _mm256_and_si256(V, Mask5);
+        R = _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(R, Mul5), Add5), 5);
+        G = _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(G, Mul6), Add6), 6);
+        B = _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(B, Mul5), Add5), 5);
+
+        Lo = _mm256_or_si256(B, _mm256_slli_epi16(G, 8));
+        Hi = _mm256_or_si256(R, Alpha);
+
+        /*The unpacks work per 128 bit lane: P0 = px 0-3, 8-11; P1 = px 4-7, 12-15*/
+        P0 = _mm256_unpacklo_epi16(Lo, Hi);
+        P1 = _mm256_unpackhi_epi16(Lo, Hi);
+        _mm256_storeu_si256((__m256i *)Dst, _mm256_permute2x128_si256(P0, P1, 0x20));
+        _mm256_storeu_si256((__m256i *)(Dst + 8), _mm256_permute2x128_si256(P0, P1, 0x31));
+
+        Src += 16;
+        Dst += 16;
+        Count -= 16;
+    }
+
+    pixel_expand_rgb565_sse2(Dst, Src, Count, Swapped);
+}
+#endif
+
+/**
+ * Expand a row of RGB565 (lv_color16_t) pixels to BGRX with the same rounding as lv_color_to32()
+ * @param Dst destination pixels
+ * @param Src source pixels
+ * @param Count number of pixels
+ * @param Swapped TRUE: the source bytes are swapped (LV_COLOR_16_SWAP)
+ */
+void pixel_expand_rgb565(UINT32 *Dst, CONST UINT16 *Src, UINTN Count, BOOLEAN Swapped)
+{
+    mExpandRgb565(Dst, Src, Count, Swapped);
+}
+
+/**
+ * Expand a row of RGB332 (lv_color8_t) pixels to BGRX with the same rounding as lv_color_to32()
+ * There are only 256 source values, so a table lookup beats any vector math.
+ * @param Dst destination pixels
+ * @param Src source pixels
+ * @param Count number of pixels
+ */
+void pixel_expand_rgb332(UINT32 *Dst, CONST UINT8 *Src, UINTN Count)
+{
+    while (Count >= 4) {
+        Dst[0] = mRgb332Lut[Src[0]];
+        Dst[1] = mRgb332Lut[Src[1]];
+        Dst[2] = mRgb332Lut[Src[2]];
+        Dst[3] = mRgb332Lut[Src[3]];
+        Src += 4;
+        Dst += 4;
+        Count -= 4;
+    }
+
+    while (Count > 0) {
+        *Dst++ = mRgb332Lut[*Src++];
+        Count--;
+    }
+}
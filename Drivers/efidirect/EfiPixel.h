@@ -0,0 +1,100 @@
+/**
+ * @file EfiPixel.h
+ *
+ */
+
+#ifndef PIXEL_H
+#define PIXEL_H
+
+/*********************
+ *      INCLUDES
+ *********************/
+#ifdef PIXEL_HOST_BUILD
+#include "HostBench/HostUefi.h"
+#else
+#include <Uefi.h>
+#include <Protocol/GraphicsOutput.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/BaseLib.h>
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef enum {
+    PIXEL_LAYOUT_BGRX,      /*PixelBlueGreenRedReserved8BitPerColor, same as lv_color32_t*/
+    PIXEL_LAYOUT_RGBX,      /*PixelRedGreenBlueReserved8BitPerColor*/
+    PIXEL_LAYOUT_BITMASK,   /*PixelBitMask, 2..4 bytes per pixel*/
+} PIXEL_LAYOUT;
+
+/**
+ * Destination pixel layout of a linear frame buffer.
+ * For PIXEL_LAYOUT_BITMASK an 8 bit channel value 'v' is stored as
+ * '((v >> Shr) << Shl)'.
+ */
+typedef struct {
+    PIXEL_LAYOUT Layout;
+    UINT8 BytesPerPixel;
+    UINT8 RedShr, RedShl;
+    UINT8 GreenShr, GreenShl;
+    UINT8 BlueShr, BlueShl;
+} PIXEL_FORMAT;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Select the row kernels for the running CPU (SSE2 or AVX2)
+ */
+void pixel_init(void);
+
+/**
+ * Check whether the AVX2 kernels were selected by pixel_init
+ */
+BOOLEAN pixel_use_avx2(void);
+
+/**
+ * Describe the frame buffer layout of a GOP mode
+ * @param Info mode information of the GOP
+ * @param Format store the layout here
+ * @return FALSE: the mode has no linear frame buffer (PixelBltOnly) or an unknown format
+ */
+BOOLEAN pixel_format_from_gop(CONST EFI_GRAPHICS_OUTPUT_MODE_INFORMATION *Info, PIXEL_FORMAT *Format);
+
+/**
+ * Convert a row of BGRX (lv_color32_t) pixels to the frame buffer layout
+ * @param Dst destination in the frame buffer
+ * @param Src source pixels
+ * @param Count number of pixels
+ * @param Format destination layout
+ */
+void pixel_convert_row(VOID *Dst, CONST UINT32 *Src, UINTN Count, CONST PIXEL_FORMAT *Format);
+
+/**
+ * Expand a row of RGB565 (lv_color16_t) pixels to BGRX with the same rounding as lv_color_to32()
+ * @param Dst destination pixels
+ * @param Src source pixels
+ * @param Count number of pixels
+ * @param Swapped TRUE: the source bytes are swapped (LV_COLOR_16_SWAP)
+ */
+void pixel_expand_rgb565(UINT32 *Dst, CONST UINT16 *Src, UINTN Count, BOOLEAN Swapped);
+
+/**
+ * Expand a row of RGB332 (lv_color8_t) pixels to BGRX with the same rounding as lv_color_to32()
+ * @param Dst destination pixels
+ * @param Src source pixels
+ * @param Count number of pixels
+ */
+void pixel_expand_rgb332(UINT32 *Dst, CONST UINT8 *Src, UINTN Count);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /* PIXEL_H */
@@ -0,0 +1,298 @@
+/**
+ * @file FlushTest.c
+ * Host check of the deferred flush worker of EfiMonitor.c: with 'async_flush'
+ * LVGL renders the next part of the screen while the previous one is queued,
+ * and 'monitor_wait' (set as 'disp_drv->wait_cb') finishes the queued flush.
+ *
+ * Build and run on an x86-64 Linux host:
+ *   gcc -O2 -DPIXEL_HOST_BUILD -DLV_CONF_PATH=HostBench/lv_conf_host.h -I.. -I../../../lv_binding_micropython \
+ *       -o FlushTest FlushTest.c $(find ../../../lv_binding_micropython/lvgl/src -name '*.c') && ./FlushTest
+ *
+ * The boot services run everything synchronously: the timer of the worker
+ * only fires when the test says so, like a tick that comes after LVGL
+ * rendered the whole screen.
+ *
+ * Also checks that a failing GOP SetMode() leaves the mode and the monitor
+ * as they were.
+ */
+
+#include <stdio.h>
+
+#include "../EfiPixel.c"
+#include "../EfiParallel.c"
+#include "../EfiMonitor.c"
+
+#define SCREEN_W    LV_HOR_RES_MAX
+#define SCREEN_H    LV_VER_RES_MAX
+#define BUF_LINES   40
+
+/*Written into the draw buffers before rendering and after their flush*/
+#define SENTINEL    0xA5A5A5A5
+
+typedef struct {
+    EFI_EVENT_NOTIFY Notify;
+    BOOLEAN Armed;
+} HOST_EVENT;
+
+EFI_GUID gEfiGraphicsOutputProtocolGuid;
+EFI_BOOT_SERVICES *gBS;
+
+static EFI_TPL mTpl = TPL_APPLICATION;
+static HOST_EVENT *mTimer;
+
+static EFI_GRAPHICS_OUTPUT_MODE_INFORMATION mInfo = {
+    0, SCREEN_W, SCREEN_H, PixelBltOnly, {0, 0, 0, 0}, SCREEN_W
+};
+/*Mode 1 is 640x480 and can't be set*/
+static EFI_GRAPHICS_OUTPUT_PROTOCOL_MODE mMode = {2, 0, &mInfo, sizeof(mInfo), 0, 0};
+static EFI_GRAPHICS_OUTPUT_PROTOCOL mGop;
+static UINT32 mScreen[SCREEN_W * SCREEN_H];
+
+static lv_disp_buf_t mDispBuf;
+static lv_color_t mBuf1[SCREEN_W * BUF_LINES];
+static lv_color_t mBuf2[SCREEN_W * BUF_LINES];
+static lv_color_t mBg;
+
+static BOOLEAN mInFlush;
+static BOOLEAN mInWait;
+static UINT32 mBltCount;
+static UINT32 mBltInFlush;
+static UINT32 mBltInWait;
+static UINT32 mBltOverlapped;
+
+static EFI_TPL EFIAPI host_raise_tpl(EFI_TPL NewTpl)
+{
+    EFI_TPL OldTpl = mTpl;
+    mTpl = NewTpl;
+    return OldTpl;
+}
+
+static VOID EFIAPI host_restore_tpl(EFI_TPL OldTpl)
+{
+    mTpl = OldTpl;
+}
+
+static EFI_STATUS EFIAPI host_free_pool(VOID *Buffer)
+{
+    free(Buffer);
+    return EFI_SUCCESS;
+}
+
+static EFI_STATUS EFIAPI host_create_event(UINT32 Type, EFI_TPL NotifyTpl, EFI_EVENT_NOTIFY NotifyFunction,
+                                           VOID *NotifyContext, EFI_EVENT *Event)
+{
+    HOST_EVENT *HostEvent = calloc(1, sizeof(HOST_EVENT));
+
+    HostEvent->Notify = NotifyFunction;
+    if (Type & EVT_TIMER) {
+        mTimer = HostEvent;
+    }
+    *Event = HostEvent;
+    return EFI_SUCCESS;
+}
+
+static EFI_STATUS EFIAPI host_set_timer(EFI_EVENT Event, EFI_TIMER_DELAY Type, UINT64 TriggerTime)
+{
+    ((HOST_EVENT *)Event)->Armed = Type != TimerCancel;
+    return EFI_SUCCESS;
+}
+
+static EFI_STATUS EFIAPI host_close_event(EFI_EVENT Event)
+{
+    if (Event == mTimer) {
+        mTimer = NULL;
+    }
+    free(Event);
+    return EFI_SUCCESS;
+}
+
+static EFI_STATUS EFIAPI host_handle_protocol(EFI_HANDLE Handle, EFI_GUID *Protocol, VOID **Interface)
+{
+    *Interface = &mGop;
+    return EFI_SUCCESS;
+}
+
+static EFI_STATUS EFIAPI host_register_protocol_notify(EFI_GUID *Protocol, EFI_EVENT Event, VOID **Registration)
+{
+    return EFI_SUCCESS;
+}
+
+static EFI_STATUS EFIAPI host_locate_handle_buffer(EFI_LOCATE_SEARCH_TYPE SearchType, EFI_GUID *Protocol,
+                                                   VOID *SearchKey, UINTN *NoHandles, EFI_HANDLE **Buffer)
+{
+    *Buffer = calloc(1, sizeof(EFI_HANDLE));
+    *NoHandles = 1;
+    return EFI_SUCCESS;
+}
+
+static EFI_STATUS EFIAPI host_locate_protocol(EFI_GUID *Protocol, VOID *Registration, VOID **Interface)
+{
+    *Interface = &mGop;
+    return EFI_SUCCESS;
+}
+
+static EFI_BOOT_SERVICES mBootServices = {
+    host_raise_tpl, host_restore_tpl, host_free_pool, host_create_event, host_set_timer,
+    host_close_event, host_handle_protocol, host_register_protocol_notify,
+    host_locate_handle_buffer, host_locate_protocol
+};
+
+static EFI_STATUS EFIAPI gop_query_mode(EFI_GRAPHICS_OUTPUT_PROTOCOL *This, UINT32 ModeNumber,
+                                        UINTN *SizeOfInfo, EFI_GRAPHICS_OUTPUT_MODE_INFORMATION **Info)
+{
+    if (ModeNumber >= mMode.MaxMode) {
+        return EFI_INVALID_PARAMETER;
+    }
+
+    *Info = malloc(sizeof(mInfo));
+    **Info = mInfo;
+    if (ModeNumber == 1) {
+        (*Info)->HorizontalResolution = 640;
+        (*Info)->VerticalResolution = 480;
+    }
+    *SizeOfInfo = sizeof(mInfo);
+    return EFI_SUCCESS;
+}
+
+static EFI_STATUS EFIAPI gop_set_mode(EFI_GRAPHICS_OUTPUT_PROTOCOL *This, UINT32 ModeNumber)
+{
+    return (ModeNumber == 0) ? EFI_SUCCESS : EFI_DEVICE_ERROR;
+}
+
+/**
+ * Copy to the screen. A flush finished while LVGL waits must come after the
+ * next part was rendered into the other draw buffer.
+ */
+static EFI_STATUS EFIAPI gop_blt(EFI_GRAPHICS_OUTPUT_PROTOCOL *This, EFI_GRAPHICS_OUTPUT_BLT_PIXEL *BltBuffer,
+                                 EFI_GRAPHICS_OUTPUT_BLT_OPERATION BltOperation, UINTN SourceX, UINTN SourceY,
+                                 UINTN DestinationX, UINTN DestinationY, UINTN Width, UINTN Height, UINTN Delta)
+{
+    lv_disp_buf_t * vdb = &mDispBuf;
+    lv_color_t * other;
+    UINTN Y;
+
+    if (BltOperation != EfiBltBufferToVideo) {
+        return EFI_UNSUPPORTED;
+    }
+
+    for (Y = 0; Y < Height; Y++) {
+        memcpy(&mScreen[(DestinationY + Y) * SCREEN_W + DestinationX],
+               (UINT8 *)BltBuffer + Y * (Delta ? Delta : Width * sizeof(UINT32)), Width * sizeof(UINT32));
+    }
+
+    mBltCount++;
+    if (mInFlush) {
+        mBltInFlush++;
+    }
+    if (mInWait) {
+        mBltInWait++;
+        other = ((lv_color_t *)BltBuffer == vdb->buf1) ? vdb->buf2 : vdb->buf1;
+        if (other[0].full == mBg.full) {
+            mBltOverlapped++;
+        }
+        /*LVGL has to render into the buffer again before it is flushed the next time*/
+        lv_color_fill((lv_color_t *)BltBuffer, lv_color_hex(SENTINEL), Width * Height);
+    }
+
+    return EFI_SUCCESS;
+}
+
+static void test_flush(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    mInFlush = TRUE;
+    monitor_flush(disp_drv, area, color_p);
+    mInFlush = FALSE;
+}
+
+static void test_wait(lv_disp_drv_t * disp_drv)
+{
+    mInWait = TRUE;
+    monitor_wait(disp_drv);
+    mInWait = FALSE;
+}
+
+/**
+ * Let the timer of the deferred flush worker fire
+ */
+static void fire_timer(void)
+{
+    EFI_TPL OldTpl;
+
+    if (mTimer != NULL && mTimer->Armed) {
+        mTimer->Armed = FALSE;
+        OldTpl = host_raise_tpl(TPL_CALLBACK);
+        mTimer->Notify(mTimer, NULL);
+        host_restore_tpl(OldTpl);
+    }
+}
+
+static int check(const char *What, UINT32 Got, UINT32 Expect)
+{
+    if (Got != Expect) {
+        printf("FAIL %-38s got %u expected %u\n", What, Got, Expect);
+        return 1;
+    }
+    printf("ok   %-38s %u\n", What, Got);
+    return 0;
+}
+
+int main(void)
+{
+    lv_disp_drv_t disp_drv;
+    lv_disp_t * disp;
+    UINT32 Parts = SCREEN_H / BUF_LINES;
+    UINT32 Wrong = 0;
+    UINT32 Index;
+    int Fail = 0;
+
+    gBS = &mBootServices;
+    mGop.QueryMode = gop_query_mode;
+    mGop.SetMode = gop_set_mode;
+    mGop.Blt = gop_blt;
+    mGop.Mode = &mMode;
+
+    lv_init();
+
+    Fail |= check("init with a failing SetMode", EFI_ERROR(monitor_init(640, 480, false, false, true, false)), 1);
+    Fail |= check("... keeps the mode", mMode.Mode, 0);
+    Fail |= check("... isn't initialized", tPrivate != NULL, 0);
+
+    Fail |= check("init", monitor_init(0, 0, false, false, true, false), EFI_SUCCESS);
+
+    lv_color_fill(mBuf1, lv_color_hex(SENTINEL), SCREEN_W * BUF_LINES);
+    lv_color_fill(mBuf2, lv_color_hex(SENTINEL), SCREEN_W * BUF_LINES);
+    lv_disp_buf_init(&mDispBuf, mBuf1, mBuf2, SCREEN_W * BUF_LINES);
+
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.buffer = &mDispBuf;
+    disp_drv.flush_cb = test_flush;
+    disp_drv.wait_cb = test_wait;
+    disp_drv.hor_res = SCREEN_W;
+    disp_drv.ver_res = SCREEN_H;
+    disp = lv_disp_drv_register(&disp_drv);
+
+    mBg = lv_color_hex(0x123456);
+    lv_obj_set_style_local_bg_color(lv_disp_get_scr_act(disp), LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, mBg);
+    lv_obj_set_style_local_bg_opa(lv_disp_get_scr_act(disp), LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_OPA_COVER);
+
+    /*Render the whole screen in 'Parts' parts, the last one is left to the timer*/
+    lv_obj_invalidate(lv_disp_get_scr_act(disp));
+    lv_refr_now(disp);
+    Fail |= check("flushes done in flush_cb", mBltInFlush, 0);
+    Fail |= check("flushes done in wait_cb", mBltInWait, Parts - 1);
+    Fail |= check("... after the next part was rendered", mBltOverlapped, Parts - 1);
+
+    fire_timer();
+    Fail |= check("flushes done in total", mBltCount, Parts);
+    Fail |= check("flush ready", mDispBuf.flushing, 0);
+
+    for (Index = 0; Index < SCREEN_W * SCREEN_H; Index++) {
+        Wrong += (mScreen[Index] & 0xFFFFFF) != (mBg.full & 0xFFFFFF);
+    }
+    Fail |= check("wrong pixels on the screen", Wrong, 0);
+
+    monitor_deinit();
+
+    printf(Fail ? "FAILED\n" : "All flush tests passed\n");
+    return Fail;
+}
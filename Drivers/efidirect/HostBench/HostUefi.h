@@ -0,0 +1,207 @@
+/**
+ * @file HostUefi.h
+ * Minimal stand-ins for the EDK2 types and library calls used by the
+ * efidirect pixel and monitor code, so it can be built and measured on a
+ * Linux host. The boot services and the GOP are provided by the test.
+ */
+
+#ifndef HOST_UEFI_H
+#define HOST_UEFI_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <cpuid.h>
+
+typedef char        CHAR8;
+typedef uint8_t     UINT8;
+typedef uint16_t    UINT16;
+typedef uint32_t    UINT32;
+typedef uint64_t    UINT64;
+typedef int16_t     INT16;
+typedef int32_t     INT32;
+typedef int64_t     INT64;
+typedef uintptr_t   UINTN;
+typedef intptr_t    INTN;
+typedef uint8_t     BOOLEAN;
+typedef void        VOID;
+
+#define CONST       const
+#define STATIC      static
+#define IN
+#define OUT
+#define EFIAPI
+#define TRUE        ((BOOLEAN)1)
+#define FALSE       ((BOOLEAN)0)
+#define BIT5        0x00000020
+#define BIT27       0x08000000
+#define BIT28       0x10000000
+
+#if defined(__x86_64__)
+#define MDE_CPU_X64
+#endif
+
+#define MAX_UINT32  0xFFFFFFFF
+#define MAX_UINTN   ((UINTN)-1)
+#define MIN(a, b)   (((a) < (b)) ? (a) : (b))
+#define MAX(a, b)   (((a) > (b)) ? (a) : (b))
+#define ASSERT(Expression)
+
+#define ZeroMem(Buffer, Length)             memset((Buffer), 0, (Length))
+#define CopyMem(Dst, Src, Length)           memmove((Dst), (Src), (Length))
+
+static inline void AsmCpuidEx(UINT32 Index, UINT32 SubIndex, UINT32 *Eax, UINT32 *Ebx, UINT32 *Ecx, UINT32 *Edx)
+{
+    unsigned int A, B, C, D;
+
+    __cpuid_count(Index, SubIndex, A, B, C, D);
+    if (Eax != NULL) *Eax = A;
+    if (Ebx != NULL) *Ebx = B;
+    if (Ecx != NULL) *Ecx = C;
+    if (Edx != NULL) *Edx = D;
+}
+
+static inline void AsmCpuid(UINT32 Index, UINT32 *Eax, UINT32 *Ebx, UINT32 *Ecx, UINT32 *Edx)
+{
+    AsmCpuidEx(Index, 0, Eax, Ebx, Ecx, Edx);
+}
+
+typedef enum {
+    PixelRedGreenBlueReserved8BitPerColor,
+    PixelBlueGreenRedReserved8BitPerColor,
+    PixelBitMask,
+    PixelBltOnly,
+    PixelFormatMax
+} EFI_GRAPHICS_PIXEL_FORMAT;
+
+typedef struct {
+    UINT32 RedMask;
+    UINT32 GreenMask;
+    UINT32 BlueMask;
+    UINT32 ReservedMask;
+} EFI_PIXEL_BITMASK;
+
+typedef struct {
+    UINT32                    Version;
+    UINT32                    HorizontalResolution;
+    UINT32                    VerticalResolution;
+    EFI_GRAPHICS_PIXEL_FORMAT PixelFormat;
+    EFI_PIXEL_BITMASK         PixelInformation;
+    UINT32                    PixelsPerScanLine;
+} EFI_GRAPHICS_OUTPUT_MODE_INFORMATION;
+
+typedef UINTN       EFI_STATUS;
+typedef UINTN       EFI_TPL;
+typedef VOID        *EFI_EVENT;
+typedef VOID        *EFI_HANDLE;
+typedef UINT64      EFI_PHYSICAL_ADDRESS;
+
+typedef struct {
+    UINT32 Data1;
+    UINT16 Data2;
+    UINT16 Data3;
+    UINT8  Data4[8];
+} EFI_GUID;
+
+#define EFI_SUCCESS             0
+#define EFI_INVALID_PARAMETER   (((UINTN)1 << (sizeof(UINTN) * 8 - 1)) | 2)
+#define EFI_UNSUPPORTED         (((UINTN)1 << (sizeof(UINTN) * 8 - 1)) | 3)
+#define EFI_NOT_READY           (((UINTN)1 << (sizeof(UINTN) * 8 - 1)) | 6)
+#define EFI_DEVICE_ERROR        (((UINTN)1 << (sizeof(UINTN) * 8 - 1)) | 7)
+#define EFI_OUT_OF_RESOURCES    (((UINTN)1 << (sizeof(UINTN) * 8 - 1)) | 9)
+#define EFI_ERROR(Status)       ((INTN)(EFI_STATUS)(Status) < 0)
+
+#define TPL_APPLICATION         4
+#define TPL_CALLBACK            8
+#define TPL_NOTIFY              16
+#define TPL_HIGH_LEVEL          31
+
+#define EVT_TIMER               0x80000000
+#define EVT_NOTIFY_SIGNAL       0x00000200
+
+typedef enum {
+    TimerCancel,
+    TimerPeriodic,
+    TimerRelative
+} EFI_TIMER_DELAY;
+
+typedef enum {
+    AllHandles,
+    ByRegisterNotify,
+    ByProtocol
+} EFI_LOCATE_SEARCH_TYPE;
+
+typedef VOID (EFIAPI *EFI_EVENT_NOTIFY)(EFI_EVENT Event, VOID *Context);
+
+typedef struct {
+    UINT8 Blue;
+    UINT8 Green;
+    UINT8 Red;
+    UINT8 Reserved;
+} EFI_GRAPHICS_OUTPUT_BLT_PIXEL;
+
+typedef enum {
+    EfiBltVideoFill,
+    EfiBltVideoToBltBuffer,
+    EfiBltBufferToVideo,
+    EfiBltVideoToVideo,
+    EfiGraphicsOutputBltOperationMax
+} EFI_GRAPHICS_OUTPUT_BLT_OPERATION;
+
+typedef struct {
+    UINT32                               MaxMode;
+    UINT32                               Mode;
+    EFI_GRAPHICS_OUTPUT_MODE_INFORMATION *Info;
+    UINTN                                SizeOfInfo;
+    EFI_PHYSICAL_ADDRESS                 FrameBufferBase;
+    UINTN                                FrameBufferSize;
+} EFI_GRAPHICS_OUTPUT_PROTOCOL_MODE;
+
+typedef struct _EFI_GRAPHICS_OUTPUT_PROTOCOL EFI_GRAPHICS_OUTPUT_PROTOCOL;
+
+struct _EFI_GRAPHICS_OUTPUT_PROTOCOL {
+    EFI_STATUS (EFIAPI *QueryMode)(EFI_GRAPHICS_OUTPUT_PROTOCOL *This, UINT32 ModeNumber,
+                                   UINTN *SizeOfInfo, EFI_GRAPHICS_OUTPUT_MODE_INFORMATION **Info);
+    EFI_STATUS (EFIAPI *SetMode)(EFI_GRAPHICS_OUTPUT_PROTOCOL *This, UINT32 ModeNumber);
+    EFI_STATUS (EFIAPI *Blt)(EFI_GRAPHICS_OUTPUT_PROTOCOL *This, EFI_GRAPHICS_OUTPUT_BLT_PIXEL *BltBuffer,
+                             EFI_GRAPHICS_OUTPUT_BLT_OPERATION BltOperation, UINTN SourceX, UINTN SourceY,
+                             UINTN DestinationX, UINTN DestinationY, UINTN Width, UINTN Height, UINTN Delta);
+    EFI_GRAPHICS_OUTPUT_PROTOCOL_MODE *Mode;
+};
+
+/*Only the boot services efidirect calls*/
+typedef struct {
+    EFI_TPL (EFIAPI *RaiseTPL)(EFI_TPL NewTpl);
+    VOID (EFIAPI *RestoreTPL)(EFI_TPL OldTpl);
+    EFI_STATUS (EFIAPI *FreePool)(VOID *Buffer);
+    EFI_STATUS (EFIAPI *CreateEvent)(UINT32 Type, EFI_TPL NotifyTpl, EFI_EVENT_NOTIFY NotifyFunction,
+                                     VOID *NotifyContext, EFI_EVENT *Event);
+    EFI_STATUS (EFIAPI *SetTimer)(EFI_EVENT Event, EFI_TIMER_DELAY Type, UINT64 TriggerTime);
+    EFI_STATUS (EFIAPI *CloseEvent)(EFI_EVENT Event);
+    EFI_STATUS (EFIAPI *HandleProtocol)(EFI_HANDLE Handle, EFI_GUID *Protocol, VOID **Interface);
+    EFI_STATUS (EFIAPI *RegisterProtocolNotify)(EFI_GUID *Protocol, EFI_EVENT Event, VOID **Registration);
+    EFI_STATUS (EFIAPI *LocateHandleBuffer)(EFI_LOCATE_SEARCH_TYPE SearchType, EFI_GUID *Protocol, VOID *SearchKey,
+                                            UINTN *NoHandles, EFI_HANDLE **Buffer);
+    EFI_STATUS (EFIAPI *LocateProtocol)(EFI_GUID *Protocol, VOID *Registration, VOID **Interface);
+} EFI_BOOT_SERVICES;
+
+extern EFI_BOOT_SERVICES *gBS;
+extern EFI_GUID gEfiGraphicsOutputProtocolGuid;
+
+static inline VOID *AllocatePool(UINTN Size)
+{
+    return malloc(Size);
+}
+
+static inline VOID *AllocateZeroPool(UINTN Size)
+{
+    return calloc(1, Size);
+}
+
+static inline VOID FreePool(VOID *Buffer)
+{
+    free(Buffer);
+}
+
+#endif /* HOST_UEFI_H */
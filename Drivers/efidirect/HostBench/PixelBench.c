@@ -0,0 +1,205 @@
+/**
+ * @file PixelBench.c
+ * Host check and benchmark of the efidirect pixel kernels.
+ *
+ * Build and run on an x86-64 Linux host:
+ *   gcc -O2 -DPIXEL_HOST_BUILD -I.. -o PixelBench PixelBench.c && ./PixelBench
+ *
+ * Every kernel is first compared bit-exact against the scalar reference,
+ * then a full frame is flushed repeatedly into a memory buffer standing in
+ * for the GOP frame buffer. Note that a real frame buffer is usually mapped
+ * write-combining, so absolute numbers on target differ; the ratios between
+ * color depths and kernels are what this is for.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/*Pull in the kernels directly so the STATIC SSE2/AVX2 variants can be compared*/
+#include "../EfiPixel.c"
+
+#define FRAME_W     1920
+#define FRAME_H     1080
+#define FRAME_LOOPS 50
+
+typedef void (*FLUSH_FN)(void *Fb, const void *Buf, UINT32 *Row, const PIXEL_FORMAT *Format);
+
+static double now_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static int check_rgb565(PIXEL_EXPAND_RGB565 Fn, const char *Name)
+{
+    static UINT16 Src[65536 + 7];
+    static UINT32 Dst[65536 + 7];
+    UINT32 Index;
+    UINT16 Pixel;
+    int Swap;
+
+    for (Index = 0; Index < 65536 + 7; Index++) {
+        Src[Index] = (UINT16)Index;
+    }
+
+    for (Swap = 0; Swap < 2; Swap++) {
+        /*Odd length and offset to cover the scalar tails*/
+        Fn(Dst, Src + 1, 65536 + 5, (BOOLEAN)Swap);
+        for (Index = 0; Index < 65536 + 5; Index++) {
+            Pixel = Src[Index + 1];
+            if (Swap) {
+                Pixel = (UINT16)((Pixel << 8) | (Pixel >> 8));
+            }
+            if (Dst[Index] != pixel_rgb565_to_bgrx(Pixel)) {
+                printf("FAIL %s swap=%d px=%04x got %08x\n", Name, Swap, Src[Index + 1], Dst[Index]);
+                return 1;
+            }
+        }
+    }
+
+    printf("ok   %s\n", Name);
+    return 0;
+}
+
+static int check_rgb332(void)
+{
+    UINT8 Src[259];
+    UINT32 Dst[259];
+    UINT32 Index;
+    UINT32 Expect;
+
+    for (Index = 0; Index < 259; Index++) {
+        Src[Index] = (UINT8)Index;
+    }
+    pixel_expand_rgb332(Dst, Src, 259);
+
+    for (Index = 0; Index < 259; Index++) {
+        Expect = 0xFF000000 | (((Src[Index] >> 5) & 7) * 36) << 16 |
+                 (((Src[Index] >> 2) & 7) * 36) << 8 | ((Src[Index] & 3) * 85);
+        if (Dst[Index] != Expect) {
+            printf("FAIL rgb332 px=%02x got %08x\n", Src[Index], Dst[Index]);
+            return 1;
+        }
+    }
+
+    printf("ok   rgb332\n");
+    return 0;
+}
+
+static PIXEL_EXPAND_RGB565 mBench565;
+
+static void flush32(void *Fb, const void *Buf, UINT32 *Row, const PIXEL_FORMAT *Format)
+{
+    UINT32 Y;
+    (void)Row;
+    for (Y = 0; Y < FRAME_H; Y++) {
+        pixel_convert_row((UINT8 *)Fb + Y * FRAME_W * 4, (const UINT32 *)Buf + Y * FRAME_W, FRAME_W, Format);
+    }
+}
+
+static void flush16(void *Fb, const void *Buf, UINT32 *Row, const PIXEL_FORMAT *Format)
+{
+    UINT32 Y;
+    for (Y = 0; Y < FRAME_H; Y++) {
+        if (Format->Layout == PIXEL_LAYOUT_BGRX) {
+            mBench565((UINT32 *)Fb + Y * FRAME_W, (const UINT16 *)Buf + Y * FRAME_W, FRAME_W, FALSE);
+        } else {
+            mBench565(Row, (const UINT16 *)Buf + Y * FRAME_W, FRAME_W, FALSE);
+            pixel_convert_row((UINT8 *)Fb + Y * FRAME_W * 4, Row, FRAME_W, Format);
+        }
+    }
+}
+
+static void flush8(void *Fb, const void *Buf, UINT32 *Row, const PIXEL_FORMAT *Format)
+{
+    UINT32 Y;
+    for (Y = 0; Y < FRAME_H; Y++) {
+        if (Format->Layout == PIXEL_LAYOUT_BGRX) {
+            pixel_expand_rgb332((UINT32 *)Fb + Y * FRAME_W, (const UINT8 *)Buf + Y * FRAME_W, FRAME_W);
+        } else {
+            pixel_expand_rgb332(Row, (const UINT8 *)Buf + Y * FRAME_W, FRAME_W);
+            pixel_convert_row((UINT8 *)Fb + Y * FRAME_W * 4, Row, FRAME_W, Format);
+        }
+    }
+}
+
+static void bench(const char *Name, FLUSH_FN Fn, const void *Buf, UINTN BufBytes, void *Fb, UINT32 *Row, EFI_GRAPHICS_PIXEL_FORMAT GopFormat)
+{
+    EFI_GRAPHICS_OUTPUT_MODE_INFORMATION Info;
+    PIXEL_FORMAT Format;
+    double Start;
+    double Ms;
+    int Loop;
+
+    memset(&Info, 0, sizeof(Info));
+    Info.PixelFormat = GopFormat;
+    pixel_format_from_gop(&Info, &Format);
+
+    Fn(Fb, Buf, Row, &Format);  /*warm up*/
+    Start = now_ms();
+    for (Loop = 0; Loop < FRAME_LOOPS; Loop++) {
+        Fn(Fb, Buf, Row, &Format);
+    }
+    Ms = (now_ms() - Start) / FRAME_LOOPS;
+
+    printf("%-28s %-5s draw buf %5lu KiB  %7.3f ms/frame  %7.1f Mpx/s\n",
+           Name, GopFormat == PixelBlueGreenRedReserved8BitPerColor ? "BGRX" : "RGBX",
+           (unsigned long)(BufBytes / 1024), Ms, FRAME_W * FRAME_H / Ms / 1000.0);
+}
+
+int main(void)
+{
+    UINT32 *Fb = malloc(FRAME_W * FRAME_H * 4);
+    UINT32 *Buf32 = malloc(FRAME_W * FRAME_H * 4);
+    UINT16 *Buf16 = malloc(FRAME_W * FRAME_H * 2);
+    UINT8 *Buf8 = malloc(FRAME_W * FRAME_H);
+    UINT32 *Row = malloc(FRAME_W * 4);
+    EFI_GRAPHICS_PIXEL_FORMAT GopFormats[2] = {PixelBlueGreenRedReserved8BitPerColor, PixelRedGreenBlueReserved8BitPerColor};
+    UINTN Index;
+    int Fmt;
+    int Fail = 0;
+
+    pixel_init();
+    printf("AVX2 %s\n", pixel_use_avx2() ? "available" : "not available");
+
+    Fail |= check_rgb565(pixel_expand_rgb565_sse2, "rgb565 sse2");
+#if PIXEL_USE_AVX2
+    if (pixel_use_avx2()) {
+        Fail |= check_rgb565(pixel_expand_rgb565_avx2, "rgb565 avx2");
+    }
+#endif
+    Fail |= check_rgb332();
+    if (Fail) {
+        return 1;
+    }
+
+    srand(1);
+    for (Index = 0; Index < FRAME_W * FRAME_H; Index++) {
+        Buf32[Index] = (UINT32)rand();
+        Buf16[Index] = (UINT16)Buf32[Index];
+        Buf8[Index] = (UINT8)Buf32[Index];
+    }
+
+    printf("\nFull frame %dx%d flush into a memory frame buffer\n", FRAME_W, FRAME_H);
+    for (Fmt = 0; Fmt < 2; Fmt++) {
+        bench("LV_COLOR_DEPTH 32", flush32, Buf32, FRAME_W * FRAME_H * 4, Fb, Row, GopFormats[Fmt]);
+        mBench565 = pixel_expand_rgb565_sse2;
+        bench("LV_COLOR_DEPTH 16 (sse2)", flush16, Buf16, FRAME_W * FRAME_H * 2, Fb, Row, GopFormats[Fmt]);
+#if PIXEL_USE_AVX2
+        if (pixel_use_avx2()) {
+            mBench565 = pixel_expand_rgb565_avx2;
+            bench("LV_COLOR_DEPTH 16 (avx2)", flush16, Buf16, FRAME_W * FRAME_H * 2, Fb, Row, GopFormats[Fmt]);
+        }
+#endif
+        bench("LV_COLOR_DEPTH 8 (lut)", flush8, Buf8, FRAME_W * FRAME_H, Fb, Row, GopFormats[Fmt]);
+    }
+
+    free(Fb);
+    free(Buf32);
+    free(Buf16);
+    free(Buf8);
+    free(Row);
+    return 0;
+}
@@ -0,0 +1,28 @@
+/**
+ * @file lv_conf_host.h
+ * LVGL configuration of the efidirect host tests. The binding's lv_conf.h
+ * needs MicroPython and the UEFI clock, everything not set here is default.
+ */
+
+#ifndef LV_CONF_H
+#define LV_CONF_H
+
+#include <stdint.h>
+
+#define LV_HOR_RES_MAX      (480)
+#define LV_VER_RES_MAX      (320)
+#define LV_COLOR_DEPTH      32
+#define LV_MEM_SIZE         (128U * 1024U)
+#define LV_USE_LOG          0
+
+typedef int16_t lv_coord_t;
+typedef void * lv_anim_user_data_t;
+typedef void * lv_group_user_data_t;
+typedef void * lv_fs_drv_user_data_t;
+typedef void * lv_img_decoder_user_data_t;
+typedef void * lv_disp_drv_user_data_t;
+typedef void * lv_indev_drv_user_data_t;
+typedef void * lv_font_user_data_t;
+typedef void * lv_obj_user_data_t;
+
+#endif /*LV_CONF_H*/
@@ -1,35 +1,237 @@
+#include <string.h>
 #include "../include/common.h"
 #include "EfiMonitor.h"
 #include "EfiInput.h"
+#include "EfiLoop.h"
+#include "../../MicroPythonDxe/Uefi/uefi_clock.h"
 
 STATIC mp_obj_t mp_init_efidirect(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args)
 {
-    enum { ARG_w, ARG_h, ARG_auto_refresh };
+    enum { ARG_w, ARG_h, ARG_direct, ARG_shadow, ARG_async_flush, ARG_parallel };
     static const mp_arg_t allowed_args[] = {
-        { MP_QSTR_w, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = LV_HOR_RES_MAX} },
-        { MP_QSTR_h, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = LV_VER_RES_MAX} },
+        { MP_QSTR_w, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_h, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_direct, MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = true} },
+        { MP_QSTR_shadow, MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = false} },
+        { MP_QSTR_async_flush, MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = false} },
+        { MP_QSTR_parallel, MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = false} },
     };
 
     // parse args
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    const char *path;
+    EFI_STATUS Status;
     mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
-    monitor_init(args[ARG_w].u_int, args[ARG_h].u_int);
+    Status = monitor_init(args[ARG_w].u_int, args[ARG_h].u_int, args[ARG_direct].u_bool, args[ARG_shadow].u_bool,
+                          args[ARG_async_flush].u_bool, args[ARG_parallel].u_bool);
+    if (Status == EFI_OUT_OF_RESOURCES) {
+        mp_raise_msg(&mp_type_MemoryError, NULL);
+    }
+    if (EFI_ERROR(Status)) {
+        // The GOP mode is left as it was, init(w = 0, h = 0) can use it
+        mp_raise_msg(&mp_type_OSError, "efidirect.init: no GOP or its mode can't be set");
+    }
 
     input_init();
 
-    return mp_const_none;
+    // Report the flush path that was selected
+    path = monitor_flush_path();
+    return mp_obj_new_str(path, strlen(path));
 }
 
 STATIC mp_obj_t mp_deinit_efidirect(void)
 {
+    input_deinit();
     monitor_deinit();
     return mp_const_none;
 }
 
+STATIC mp_obj_t mp_monitor_parallel_cnt_efidirect(void)
+{
+    // For 'disp_drv.parallel_cnt', 1 unless init(parallel=True) found application processors
+    return mp_obj_new_int_from_uint(monitor_parallel_cnt());
+}
+
+STATIC mp_obj_t mp_resolution_efidirect(void)
+{
+    UINTN Width;
+    UINTN Height;
+    mp_obj_t items[2];
+
+    monitor_get_resolution(&Width, &Height);
+    items[0] = mp_obj_new_int(Width);
+    items[1] = mp_obj_new_int(Height);
+    return mp_obj_new_tuple(2, items);
+}
+
+STATIC mp_obj_t mp_modes_efidirect(void)
+{
+    UINT32 Mode;
+    UINTN Width;
+    UINTN Height;
+    mp_obj_t items[2];
+    mp_obj_t list = mp_obj_new_list(0, NULL);
+
+    // The list index is the GOP mode number, unusable modes are None
+    for (Mode = 0; Mode < monitor_get_mode_count(); Mode++) {
+        if (monitor_get_mode(Mode, &Width, &Height)) {
+            items[0] = mp_obj_new_int(Width);
+            items[1] = mp_obj_new_int(Height);
+            mp_obj_list_append(list, mp_obj_new_tuple(2, items));
+        } else {
+            mp_obj_list_append(list, mp_const_none);
+        }
+    }
+    return list;
+}
+
+STATIC mp_obj_t mp_cursor_efidirect(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args)
+{
+    enum { ARG_show, ARG_sprite, ARG_w, ARG_h, ARG_hot_x, ARG_hot_y };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_show, MP_ARG_BOOL, {.u_bool = true} },
+        { MP_QSTR_sprite, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_obj = mp_const_none} },
+        { MP_QSTR_w, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_h, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_hot_x, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_hot_y, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 0} },
+    };
+
+    // parse args
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_buffer_info_t bufinfo;
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    // The sprite is w * h BGRA pixels, e.g. the data of a 32 bit LV_IMG_CF_TRUE_COLOR_ALPHA image
+    if (args[ARG_sprite].u_obj != mp_const_none) {
+        mp_get_buffer_raise(args[ARG_sprite].u_obj, &bufinfo, MP_BUFFER_READ);
+        if (args[ARG_w].u_int <= 0 || args[ARG_h].u_int <= 0 ||
+            bufinfo.len < (size_t)args[ARG_w].u_int * args[ARG_h].u_int * sizeof(UINT32)) {
+            mp_raise_ValueError("sprite must hold w * h BGRA pixels");
+        }
+        if (!monitor_cursor_set_sprite(bufinfo.buf, args[ARG_w].u_int, args[ARG_h].u_int,
+                                       args[ARG_hot_x].u_int, args[ARG_hot_y].u_int)) {
+            mp_raise_msg(&mp_type_MemoryError, NULL);
+        }
+    }
+
+    monitor_cursor_show(args[ARG_show].u_bool);
+    return mp_const_none;
+}
+
+STATIC mp_obj_t mp_run_efidirect(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args)
+{
+    enum { ARG_callback, ARG_period, ARG_until };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_callback, MP_ARG_OBJ, {.u_obj = mp_const_none} },
+        { MP_QSTR_period, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_until, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_obj = mp_const_none} },
+    };
+
+    // parse args
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_obj_t callback;
+    mp_obj_t until;
+    UINT64 now;
+    UINT64 start;
+    UINT64 next_callback = 0;
+    UINT64 until_ms = MAX_UINT64;
+    UINT64 left;
+    UINT32 wait;
+    nlr_buf_t nlr;
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    // 'until' is either a run time in ms or a callable returning True to stop
+    callback = args[ARG_callback].u_obj;
+    until = args[ARG_until].u_obj;
+    if (MP_OBJ_IS_INT(until)) {
+        until_ms = mp_obj_get_int(until);
+        until = mp_const_none;
+    }
+
+    if (!loop_init()) {
+        mp_raise_msg(&mp_type_OSError, "efidirect.run: no timer event");
+    }
+
+    // The run time counts from here, not from the origin of the clock
+    start = loop_now_ms();
+
+    if (nlr_push(&nlr) == 0) {
+        for (;;) {
+            wait = loop_handle_tasks();
+            now = loop_now_ms();
+            left = ClockTimeLeft(start, now, until_ms);
+
+            // Python code only runs when it is due
+            if (callback != mp_const_none && now >= next_callback) {
+                mp_call_function_0(callback);
+                next_callback = now + args[ARG_period].u_int;
+            }
+            if (left == 0 || (until != mp_const_none && mp_obj_is_true(mp_call_function_0(until)))) {
+                break;
+            }
+
+            if (MP_STATE_VM(mp_pending_exception) != MP_OBJ_NULL) {
+                mp_obj_t obj = MP_STATE_VM(mp_pending_exception);
+                MP_STATE_VM(mp_pending_exception) = MP_OBJ_NULL;
+                nlr_raise(obj);
+            }
+
+            // Sleep until the next LVGL task, callback or the end, whatever comes first
+            if (callback != mp_const_none) {
+                wait = (UINT32)MIN(wait, next_callback - MIN(now, next_callback));
+            }
+            wait = (UINT32)MIN(wait, left);
+            loop_wait(wait);
+        }
+        nlr_pop();
+    } else {
+        loop_deinit();
+        nlr_jump(nlr.ret_val);
+    }
+
+    loop_deinit();
+    return mp_const_none;
+}
+
+// One step of LVGL for an external scheduler such as uasyncio
+STATIC mp_obj_t mp_task_handler_efidirect(size_t n_args, const mp_obj_t *args)
+{
+    if (n_args > 0 && mp_obj_is_true(args[0])) {
+        loop_input_ready();
+    }
+    return mp_obj_new_int_from_uint(loop_handle_tasks());
+}
+
+// The UEFI events signaled on keyboard and pointer input, to wait on them
+STATIC mp_obj_t mp_input_events_efidirect(void)
+{
+    EFI_EVENT events[LOOP_MAX_EVENTS];
+    UINTN count = input_get_events(events, LOOP_MAX_EVENTS);
+    mp_obj_t list = mp_obj_new_list(0, NULL);
+    UINTN i;
+
+    for (i = 0; i < count; i++) {
+        mp_obj_list_append(list, mp_obj_new_int_from_uint((UINTN)events[i]));
+    }
+    return list;
+}
+
 STATIC MP_DEFINE_CONST_FUN_OBJ_KW(mp_init_efidirect_obj, 0, mp_init_efidirect);
 STATIC MP_DEFINE_CONST_FUN_OBJ_0(mp_deinit_efidirect_obj, mp_deinit_efidirect);
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(mp_monitor_parallel_cnt_efidirect_obj, mp_monitor_parallel_cnt_efidirect);
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(mp_resolution_efidirect_obj, mp_resolution_efidirect);
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(mp_modes_efidirect_obj, mp_modes_efidirect);
+STATIC MP_DEFINE_CONST_FUN_OBJ_KW(mp_cursor_efidirect_obj, 0, mp_cursor_efidirect);
+STATIC MP_DEFINE_CONST_FUN_OBJ_KW(mp_run_efidirect_obj, 0, mp_run_efidirect);
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mp_task_handler_efidirect_obj, 0, 1, mp_task_handler_efidirect);
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(mp_input_events_efidirect_obj, mp_input_events_efidirect);
 
 DEFINE_PTR_OBJ(monitor_flush);
+DEFINE_PTR_OBJ(monitor_wait);
+DEFINE_PTR_OBJ(monitor_rounder);
+DEFINE_PTR_OBJ(monitor_copy);
+DEFINE_PTR_OBJ(monitor_parallel);
 DEFINE_PTR_OBJ(mouse_read);
 DEFINE_PTR_OBJ(keyboard_read);
 
@@ -37,9 +239,21 @@ STATIC const mp_rom_map_elem_t efidirect_globals_table[] = {
         { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_efidirect) },
         { MP_ROM_QSTR(MP_QSTR_init), MP_ROM_PTR(&mp_init_efidirect_obj) },
         { MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&mp_deinit_efidirect_obj) },
+        { MP_ROM_QSTR(MP_QSTR_resolution), MP_ROM_PTR(&mp_resolution_efidirect_obj) },
+        { MP_ROM_QSTR(MP_QSTR_modes), MP_ROM_PTR(&mp_modes_efidirect_obj) },
+        { MP_ROM_QSTR(MP_QSTR_cursor), MP_ROM_PTR(&mp_cursor_efidirect_obj) },
+        { MP_ROM_QSTR(MP_QSTR_run), MP_ROM_PTR(&mp_run_efidirect_obj) },
+        { MP_ROM_QSTR(MP_QSTR_task_handler), MP_ROM_PTR(&mp_task_handler_efidirect_obj) },
+        { MP_ROM_QSTR(MP_QSTR_input_events), MP_ROM_PTR(&mp_input_events_efidirect_obj) },
         { MP_ROM_QSTR(MP_QSTR_monitor_flush), MP_ROM_PTR(&PTR_OBJ(monitor_flush))},
+        { MP_ROM_QSTR(MP_QSTR_monitor_wait), MP_ROM_PTR(&PTR_OBJ(monitor_wait))},
+        { MP_ROM_QSTR(MP_QSTR_monitor_rounder), MP_ROM_PTR(&PTR_OBJ(monitor_rounder))},
+        { MP_ROM_QSTR(MP_QSTR_monitor_copy), MP_ROM_PTR(&PTR_OBJ(monitor_copy))},
+        { MP_ROM_QSTR(MP_QSTR_monitor_parallel), MP_ROM_PTR(&PTR_OBJ(monitor_parallel))},
+        { MP_ROM_QSTR(MP_QSTR_monitor_parallel_cnt), MP_ROM_PTR(&mp_monitor_parallel_cnt_efidirect_obj) },
         { MP_ROM_QSTR(MP_QSTR_mouse_read), MP_ROM_PTR(&PTR_OBJ(mouse_read))},
         { MP_ROM_QSTR(MP_QSTR_keyboard_read), MP_ROM_PTR(&PTR_OBJ(keyboard_read))},
+        { MP_ROM_QSTR(MP_QSTR_KEY_F1), MP_ROM_INT(INPUT_KEY_F1) },
 };
          
 
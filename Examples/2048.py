@@ -125,9 +125,7 @@ class Screen():
 		#
 		# Init mouse
 		#
-		img = lv.img(lv.scr_act(), None)
-		img.set_src(lv.SYMBOL.PLAY)
-		mouse_indev.set_cursor(img)
+		ed.cursor(True)
 
 		self.scr = lv.obj()
 
@@ -141,25 +139,23 @@ class Screen():
 		return lv.indev_t.get_key(self.kb_indev)
 
 	def run(self, callback = None):
-		global key_up_event
 		# Load the screen
 		lv.scr_load(self.scr)
 
-		while(1):
-			lv.task_handler()
-			lv.tick_inc(10)
-			uefi.bs.Stall(1000)
+		def step():
+			global key_up_event
 			last_key = self.get_last_key()
 
 			if key_up_event:
 				set_key(last_key)
 				key_up_event = False
-			if CLOSE_FLAG:
-				break
 
 			if callback:
 				callback()
 
+		# LVGL ticks from the real time, sleeps until the next task or input
+		ed.run(step, until = lambda: CLOSE_FLAG)
+
 #
 # Gui Board
 #
@@ -0,0 +1,131 @@
+import lvgl as lv
+import efidirect as ed
+import uasyncio
+import _uasyncio
+from utime import ticks_us, ticks_ms, ticks_diff
+
+# Benchmark of the uasyncio scheduler of the UEFI port:
+#  1. cost of a coroutine switch (await sleep_ms(0) round robin)
+#  2. LVGL frame pacing while other coroutines compete for the CPU
+
+SWITCH_TASKS = 10
+SWITCH_ROUNDS = 1000
+PACING_MS = 5000
+WORKERS = 4
+WORK_SLICE_US = 2000
+
+#
+# 1. Coroutine switch cost
+#
+async def switcher(n):
+    for i in range(n):
+        await uasyncio.sleep_ms(0)
+
+async def switch_bench():
+    start = ticks_us()
+    tasks = [uasyncio.create_task(switcher(SWITCH_ROUNDS)) for i in range(SWITCH_TASKS)]
+    await uasyncio.gather(*tasks)
+    us = ticks_diff(ticks_us(), start)
+    switches = SWITCH_TASKS * SWITCH_ROUNDS
+    print("switch: %d switches in %d us, %d ns per switch" % (switches, us, us * 1000 // switches))
+
+#
+# 2. LVGL frame pacing under concurrent tasks
+#
+frames = []
+
+def monitor_cb(drv, time, px):
+    frames.append(ticks_ms())
+
+async def lvgl_task():
+    # LVGL runs when one of its tasks is due or input arrived, the CPU is
+    # halted in between
+    inputs = ed.input_events()
+    input_ready = False
+    while True:
+        wait = ed.task_handler(input_ready)
+        event = await uasyncio.wait_event(inputs, min(wait, 1000))
+        input_ready = event is not None
+
+async def worker(busy):
+    # Busy for WORK_SLICE_US, then yield: a compute bound coroutine
+    while True:
+        start = ticks_us()
+        while ticks_diff(ticks_us(), start) < WORK_SLICE_US:
+            pass
+        busy[0] += 1
+        await uasyncio.sleep_ms(0)
+
+async def animate(bar):
+    value = 0
+    while True:
+        value = (value + 1) % 101
+        bar.set_value(value, lv.ANIM.OFF)
+        await uasyncio.sleep_ms(16)
+
+def report(name):
+    intervals = [ticks_diff(frames[i], frames[i - 1]) for i in range(1, len(frames))]
+    if not intervals:
+        print("%s: no frames" % name)
+        return
+    intervals.sort()
+    print("%s: %d frames, interval avg %d ms, median %d ms, p95 %d ms, max %d ms" % (
+        name, len(frames),
+        sum(intervals) // len(intervals),
+        intervals[len(intervals) // 2],
+        intervals[len(intervals) * 95 // 100],
+        intervals[-1]))
+
+async def pacing_bench(bar, workers):
+    busy = [0]
+    del frames[:]
+    tasks = [uasyncio.create_task(animate(bar))]
+    for i in range(workers):
+        tasks.append(uasyncio.create_task(worker(busy)))
+    await uasyncio.sleep_ms(PACING_MS)
+    for task in tasks:
+        task.cancel()
+    report("pacing with %d workers" % workers)
+    if workers:
+        print("  worker slices done: %d" % busy[0])
+
+async def main():
+    await switch_bench()
+
+    ed.init()
+    w, h = ed.resolution()
+    lv.init()
+
+    disp_buf = lv.disp_buf_t()
+    buf = bytearray(w * 40 * 4)
+    disp_buf.init(buf, None, len(buf) // 4)
+    disp_drv = lv.disp_drv_t()
+    disp_drv.init()
+    disp_drv.buffer = disp_buf
+    disp_drv.flush_cb = ed.monitor_flush
+    disp_drv.rounder_cb = ed.monitor_rounder
+    disp_drv.monitor_cb = monitor_cb
+    disp_drv.hor_res = w
+    disp_drv.ver_res = h
+    disp_drv.register()
+
+    indev_drv = lv.indev_drv_t()
+    indev_drv.init()
+    indev_drv.type = lv.INDEV_TYPE.POINTER
+    indev_drv.read_cb = ed.mouse_read
+    indev_drv.register()
+
+    scr = lv.obj()
+    bar = lv.bar(scr)
+    bar.set_size(w * 2 // 3, 30)
+    bar.align(None, lv.ALIGN.CENTER, 0, 0)
+    lv.scr_load(scr)
+
+    lvgl = uasyncio.create_task(lvgl_task())
+    await pacing_bench(bar, 0)
+    await pacing_bench(bar, WORKERS)
+    lvgl.cancel()
+
+    ed.deinit()
+
+uasyncio.run(main())
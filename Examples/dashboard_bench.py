@@ -0,0 +1,72 @@
+import lvgl as lv
+import efidirect as ed
+import urandom
+from utime import ticks_ms, ticks_diff
+
+# Benchmark of the invalidation: a dashboard of labels, a few of them change
+# per frame. Reports the pixels LVGL redraws per frame (monitor_cb) next to
+# the pixels of the labels which really changed.
+
+COLS = 8
+ROWS = 12
+FRAMES = 100
+
+ed.init()
+w, h = ed.resolution()
+lv.init()
+
+disp_buf = lv.disp_buf_t()
+buf = bytearray(w * 40 * 4)
+disp_buf.init(buf, None, len(buf) // 4)
+disp_drv = lv.disp_drv_t()
+disp_drv.init()
+disp_drv.buffer = disp_buf
+disp_drv.flush_cb = ed.monitor_flush
+disp_drv.rounder_cb = ed.monitor_rounder
+disp_drv.hor_res = w
+disp_drv.ver_res = h
+
+frame = [0, 0]
+
+def monitor_cb(drv, time, px):
+    frame[0] += px
+    frame[1] += 1
+
+disp_drv.monitor_cb = monitor_cb
+disp_drv.register()
+
+scr = lv.obj()
+labels = []
+for row in range(ROWS):
+    for col in range(COLS):
+        label = lv.label(scr)
+        label.set_pos(col * w // COLS + 4, row * h // ROWS + 4)
+        label.set_text("0")
+        labels.append(label)
+lv.scr_load(scr)
+lv.refr_now(None)
+
+def dirty_px(label):
+    area = lv.area_t()
+    label.get_coords(area)
+    return (area.x2 - area.x1 + 1) * (area.y2 - area.y1 + 1)
+
+updates = 4
+while updates <= COLS * ROWS:
+    frame[0] = 0
+    frame[1] = 0
+    changed = 0
+    start = ticks_ms()
+    for f in range(FRAMES):
+        for u in range(updates):
+            label = labels[urandom.getrandbits(16) % len(labels)]
+            changed += dirty_px(label)
+            label.set_text(str(urandom.getrandbits(16)))
+            changed += dirty_px(label)
+        lv.refr_now(None)
+    ms = ticks_diff(ticks_ms(), start)
+    print("%2d labels/frame: %6d px redrawn, %6d px of changed labels, %d ms per frame" % (
+        updates, frame[0] // FRAMES, changed // FRAMES, ms // FRAMES))
+    updates *= 2
+
+ed.deinit()
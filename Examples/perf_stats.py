@@ -0,0 +1,73 @@
+import lvgl as lv
+import efidirect as ed
+
+# Refresh statistics: render a screen of widgets for a while, then print
+# where the frame time went (lv.perf_stats()) and which widget types cost
+# the most time in their design callbacks.
+
+FRAMES = 100
+
+ed.init()
+w, h = ed.resolution()
+lv.init()
+
+disp_buf = lv.disp_buf_t()
+buf = bytearray(w * 40 * 4)
+disp_buf.init(buf, None, len(buf) // 4)
+disp_drv = lv.disp_drv_t()
+disp_drv.init()
+disp_drv.buffer = disp_buf
+disp_drv.flush_cb = ed.monitor_flush
+disp_drv.rounder_cb = ed.monitor_rounder
+disp_drv.hor_res = w
+disp_drv.ver_res = h
+disp_drv.register()
+
+scr = lv.obj()
+for i in range(8):
+    btn = lv.btn(scr)
+    btn.set_pos(10 + (i % 4) * w // 4, 10 + (i // 4) * 60)
+    lv.label(btn).set_text("Button %d" % i)
+bar = lv.bar(scr)
+bar.set_size(w // 2, 20)
+bar.set_pos(10, 140)
+arc = lv.arc(scr)
+arc.set_pos(10, 180)
+chart = lv.chart(scr)
+chart.set_size(w // 2, h // 3)
+chart.set_pos(w // 2 - 10, 180)
+lv.scr_load(scr)
+
+lv.perf_reset()
+for f in range(FRAMES):
+    bar.set_value(f % 100, lv.ANIM.OFF)
+    arc.set_end_angle(f * 3 % 360)
+    scr.invalidate()
+    lv.refr_now(None)
+
+def line(name, hist, unit):
+    if hist.cnt == 0:
+        return
+    print("%-12s %6d samples, avg %8d %s, max %8d %s" % (
+        name, hist.cnt, hist.sum // hist.cnt, unit, hist.max, unit))
+
+stats = lv.perf_stats()
+line("frame", stats.frame, "us")
+line("join", stats.join, "us")
+line("area", stats.area, "us")
+line("flush", stats.flush, "us")
+line("masks", stats.masks, "  ")
+line("blend_px", stats.blend_px, "px")
+
+print("Frame times, bins of powers of 2 us:")
+for i, n in enumerate(stats.frame.bins):
+    if n:
+        print("  < %8d us: %d" % (1 << i, n))
+
+widgets = stats.widgets[:stats.widget_cnt]
+widgets.sort(key=lambda wd: wd.design.sum, reverse=True)
+print("Design time by widget type:")
+for wd in widgets:
+    line(wd.name, wd.design, "us")
+
+ed.deinit()
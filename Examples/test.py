@@ -34,6 +34,8 @@ def event_handler_hello(source,evt):
 
 
 ed.init(w = scr_width, h = scr_height)
+# The closest GOP mode is used, render at its native resolution
+scr_width, scr_height = ed.resolution()
 lv.init()
 
 # Register EFI display driver.
@@ -45,6 +47,13 @@ disp_drv = lv.disp_drv_t()
 disp_drv.init()
 disp_drv.buffer = disp_buf1
 disp_drv.flush_cb = ed.monitor_flush
+# Finishes the flushes queued by ed.init(async_flush = True) instead of spinning
+disp_drv.wait_cb = ed.monitor_wait
+disp_drv.rounder_cb = ed.monitor_rounder
+disp_drv.copy_cb = ed.monitor_copy
+# Renders on 1 core unless ed.init(parallel = True) found more
+disp_drv.parallel_cb = ed.monitor_parallel
+disp_drv.parallel_cnt = ed.monitor_parallel_cnt()
 disp_drv.hor_res = scr_width
 disp_drv.ver_res = scr_height
 disp_drv.register()
@@ -88,14 +97,8 @@ btn.set_event_cb(event_handler_hello)
 
 lv.scr_load(scr)
 
-img = lv.img(lv.scr_act(), None)
-img.set_src(lv.SYMBOL.PLAY)
-mouse_indev.set_cursor(img)
-
-while(1):
-	lv.task_handler()
-	lv.tick_inc(10)
-	uefi.bs.Stall(1000)
-	key = lv.indev_t.get_key(kb_indev)
-	if close_flag:
-		break
+# Cursor overlay drawn by efidirect, moving it does not redraw any widget
+ed.cursor(True)
+
+# LVGL ticks from the real time, sleeps until the next task or input
+ed.run(until = lambda: close_flag)
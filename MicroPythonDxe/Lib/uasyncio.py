@@ -0,0 +1,329 @@
+## @file
+# uasyncio compatible scheduler for MicroPython on UEFI.
+#
+# Tasks are run round robin until all of them wait; then the poller of the
+# _uasyncio module halts the CPU in WaitForEvent until the next sleep is due
+# or one of the UEFI events awaited by a task (ConIn WaitForKey, pointer
+# WaitForInput, timers or events created by the script) is signaled.
+#
+# The subset of the uasyncio API implemented here is enough for
+# lv_binding_micropython/lib/async_utils.py:
+#
+#   import uasyncio
+#
+#   async def blink(n):
+#       while True:
+#           await uasyncio.sleep_ms(500)
+#
+#   uasyncio.create_task(blink(1))
+#   uasyncio.run(main())
+#
+# Copyright (c) 2018, Intel Corporation. All rights reserved.<BR>
+# This program and the accompanying materials
+# are licensed and made available under the terms and conditions of the BSD License
+# which accompanies this distribution.  The full text of the license may be found at
+# http://opensource.org/licenses/bsd-license.php
+#
+# THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+# WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+#
+
+import sys
+from utime import ticks_ms, ticks_diff, ticks_add
+from uheapq import heappush, heappop
+import _uasyncio
+
+# Longest single poll, keeps a script responsive even if nothing is due
+POLL_MAX_MS = 1000
+
+class CancelledError(BaseException):
+    pass
+
+class TimeoutError(Exception):
+    pass
+
+# Tasks ready to run
+_ready = []
+# Sleeping tasks: heap of (due ticks, sequence, task)
+_timers = []
+# Tasks waiting for a UEFI event: {event: [task, ...]}
+_events = {}
+_seq = 0
+_cur = None
+_stopped = False
+
+def _schedule(task, exc=None):
+    if exc is not None:
+        task.exc_in = exc
+    if not task.queued:
+        task.queued = True
+        _ready.append(task)
+
+def _unpark(task):
+    # Forget what the task was waiting for. Wakers check task.wait, so only
+    # the UEFI event lists have to be cleaned up; timers and Event/Task
+    # waiter lists are dropped lazily.
+    wait = task.wait
+    task.wait = None
+    task.seq = 0
+    if isinstance(wait, (tuple, list)):
+        for event in wait:
+            tasks = _events.get(event)
+            if tasks is not None and task in tasks:
+                tasks.remove(task)
+                if not tasks:
+                    del _events[event]
+
+def _wake(task, source):
+    # Wake a task parked on 'source', unless it moved on meanwhile
+    if task.wait is source:
+        _unpark(task)
+        _schedule(task)
+
+class Task:
+    def __init__(self, coro):
+        self.coro = coro
+        self.exc_in = None
+        self.queued = False
+        self.wait = None        # what the task is parked on
+        self.seq = 0            # its timer entry while sleeping
+        self.signaled = None
+        self.done = False
+        self.result = None
+        self.exc = None
+        self.waiters = None     # tasks awaiting this one
+
+    def __iter__(self):
+        if not self.done:
+            if self.waiters is None:
+                self.waiters = []
+            self.waiters.append(_cur)
+            _cur.wait = self
+            yield
+        if self.exc is not None:
+            raise self.exc
+        return self.result
+
+    def cancel(self):
+        if self.done or self is _cur:
+            return False
+        _unpark(self)
+        _schedule(self, CancelledError())
+        return True
+
+    def _finish(self, result, exc):
+        self.done = True
+        self.result = result
+        self.exc = exc
+        if self.waiters:
+            for task in self.waiters:
+                _wake(task, self)
+            self.waiters = None
+        elif exc is not None and not isinstance(exc, CancelledError):
+            print("Task exception wasn't retrieved")
+            sys.print_exception(exc)
+
+def current_task():
+    return _cur
+
+def create_task(coro):
+    task = Task(coro)
+    _schedule(task)
+    return task
+
+def _sleep(due):
+    global _seq
+    _seq += 1
+    task = _cur
+    task.wait = due
+    task.seq = _seq
+    heappush(_timers, (due, _seq, task))
+    yield
+
+def sleep_ms(t):
+    return _sleep(ticks_add(ticks_ms(), max(0, t)))
+
+def sleep(t):
+    return _sleep(ticks_add(ticks_ms(), max(0, int(t * 1000))))
+
+def wait_event(events, timeout_ms=-1):
+    # Wait for one of the UEFI events (handles as int, e.g. from
+    # _uasyncio.conin() or _uasyncio.pointers()).
+    # Returns the signaled event, or None on timeout.
+    global _seq
+    task = _cur
+    if isinstance(events, int):
+        events = (events,)
+    for event in events:
+        _events.setdefault(event, []).append(task)
+    task.wait = events
+    task.signaled = None
+    if timeout_ms >= 0:
+        _seq += 1
+        task.seq = _seq
+        heappush(_timers, (ticks_add(ticks_ms(), timeout_ms), _seq, task))
+    yield
+    return task.signaled
+
+class Event:
+    def __init__(self):
+        self.state = False
+        self.waiting = []
+
+    def is_set(self):
+        return self.state
+
+    def set(self):
+        self.state = True
+        for task in self.waiting:
+            _wake(task, self)
+        self.waiting = []
+
+    def clear(self):
+        self.state = False
+
+    def wait(self):
+        if not self.state:
+            self.waiting.append(_cur)
+            _cur.wait = self
+            yield
+        return True
+
+async def _cancel_after(task, timeout, expired):
+    await sleep_ms(timeout)
+    expired.append(True)
+    task.cancel()
+
+async def wait_for_ms(aw, timeout):
+    task = aw if isinstance(aw, Task) else create_task(aw)
+    expired = []
+    timer = create_task(_cancel_after(task, timeout, expired))
+    try:
+        return await task
+    except CancelledError:
+        if expired:
+            raise TimeoutError
+        raise
+    finally:
+        timer.cancel()
+        task.cancel()
+
+async def wait_for(aw, timeout):
+    return await wait_for_ms(aw, int(timeout * 1000))
+
+async def gather(*aws):
+    results = []
+    for aw in aws:
+        task = aw if isinstance(aw, Task) else create_task(aw)
+        results.append(task)
+    for index in range(len(results)):
+        results[index] = await results[index]
+    return results
+
+def _run_task(task):
+    global _cur
+    _cur = task
+    task.queued = False
+    exc = task.exc_in
+    task.exc_in = None
+    try:
+        if exc is None:
+            task.coro.send(None)
+        else:
+            task.coro.throw(exc)
+        if task.wait is None and not task.queued:
+            # A bare yield, run again in the next round
+            _schedule(task)
+    except StopIteration as e:
+        task._finish(e.value, None)
+    except CancelledError as e:
+        task._finish(None, e)
+    except Exception as e:
+        task._finish(None, e)
+    finally:
+        _cur = None
+
+def _wake_timers(now):
+    # Wake the due tasks and drop the entries of tasks woken otherwise
+    while _timers:
+        due, seq, task = _timers[0]
+        if task.seq == seq and ticks_diff(due, now) > 0:
+            break
+        heappop(_timers)
+        if task.seq == seq:
+            _unpark(task)
+            _schedule(task)
+
+def _poll(timeout):
+    events = list(_events)
+    if not events and timeout < 0:
+        return
+    index = _uasyncio.poll(timeout, events)
+    if index < 0:
+        return
+    event = events[index]
+    for task in _events.pop(event):
+        _unpark(task)
+        task.signaled = event
+        _schedule(task)
+
+def _run_once():
+    global _ready
+    _wake_timers(ticks_ms())
+
+    # Run what is ready now, tasks scheduled meanwhile go to the next round
+    ready = _ready
+    _ready = []
+    for task in ready:
+        if not task.done:
+            _run_task(task)
+
+    if _ready:
+        timeout = 0
+    elif _timers:
+        timeout = min(max(0, ticks_diff(_timers[0][0], ticks_ms())), POLL_MAX_MS)
+    elif _events:
+        timeout = POLL_MAX_MS
+    else:
+        timeout = -1
+    _poll(timeout)
+
+class Loop:
+    @staticmethod
+    def create_task(coro):
+        return create_task(coro)
+
+    @staticmethod
+    def run_forever():
+        global _stopped
+        _stopped = False
+        _uasyncio.start()
+        while not _stopped and (_ready or _timers or _events):
+            _run_once()
+
+    @staticmethod
+    def run_until_complete(aw):
+        task = aw if isinstance(aw, Task) else create_task(aw)
+        _uasyncio.start()
+        while not task.done:
+            if not (_ready or _timers or _events):
+                raise RuntimeError("deadlock")
+            _run_once()
+        if task.exc is not None:
+            raise task.exc
+        return task.result
+
+    @staticmethod
+    def stop():
+        global _stopped
+        _stopped = True
+
+    @staticmethod
+    def close():
+        pass
+
+def get_event_loop():
+    return Loop
+
+def run(coro):
+    return Loop.run_until_complete(coro)
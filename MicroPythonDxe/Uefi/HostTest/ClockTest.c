@@ -0,0 +1,168 @@
+/** @file
+  Host unit test of the monotonic clock with simulated performance counters.
+
+  Build and run on a Linux host:
+    gcc -O2 -Wall -DCLOCK_HOST_BUILD -I.. -o ClockTest ClockTest.c && ./ClockTest
+
+Copyright (c) 2018, Intel Corporation. All rights reserved.<BR>
+This program and the accompanying materials
+are licensed and made available under the terms and conditions of the BSD License
+which accompanies this distribution.  The full text of the license may be found at
+http://opensource.org/licenses/bsd-license.php
+
+THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+
+**/
+
+#include <stdio.h>
+
+#include "../uefi_clock.c"
+
+//
+// A simulated counter: 'Now' is the true time in counter ticks, the raw value
+// is derived from it like the hardware would present it.
+//
+typedef struct {
+  const char  *Name;
+  UINT64      StartValue;
+  UINT64      EndValue;
+  UINT64      Frequency;
+} SIM_COUNTER;
+
+STATIC UINT64 SimValue (CONST SIM_COUNTER *Sim, UINT64 Now)
+{
+  UINT64    Range;
+
+  if (Sim->EndValue >= Sim->StartValue) {
+    Range = Sim->EndValue - Sim->StartValue + 1;
+    return (Range == 0) ? Sim->StartValue + Now : Sim->StartValue + Now % Range;
+  }
+  Range = Sim->StartValue - Sim->EndValue + 1;
+  return Sim->StartValue - Now % Range;
+}
+
+STATIC int Check (const char *Name, const char *What, UINT64 Got, UINT64 Expect)
+{
+  if (Got != Expect) {
+    printf ("FAIL %-26s %-22s got %llu expected %llu\n", Name, What,
+            (unsigned long long)Got, (unsigned long long)Expect);
+    return 1;
+  }
+  return 0;
+}
+
+STATIC int RunCounter (CONST SIM_COUNTER *Sim, UINT64 Origin)
+{
+  UEFI_CLOCK  Clock;
+  UINT64      Now;
+  UINT64      Step;
+  UINT64      Ticks;
+  UINT64      Prev = 0;
+  UINT64      Range;
+  int         Loop;
+  int         Fail = 0;
+
+  Range = (Sim->EndValue >= Sim->StartValue) ? Sim->EndValue - Sim->StartValue : Sim->StartValue - Sim->EndValue;
+
+  Now = Origin;
+  ClockSetup (&Clock, Sim->StartValue, Sim->EndValue, Sim->Frequency, SimValue (Sim, Now));
+
+  //
+  // Irregular sampling, always less than one wrap period apart
+  //
+  for (Loop = 0; Loop < 100000; Loop++) {
+    Step  = (Range < 1000) ? 1 + Loop % Range : 1 + ((UINT64)Loop * 2654435761u) % (Range / 3 + 1);
+    Now  += Step;
+    Ticks = ClockUpdate (&Clock, SimValue (Sim, Now));
+    Fail |= Check (Sim->Name, "ticks", Ticks, Now - Origin);
+    if (Ticks < Prev) {
+      printf ("FAIL %-26s not monotonic\n", Sim->Name);
+      return 1;
+    }
+    Prev = Ticks;
+    if (Fail) {
+      return 1;
+    }
+  }
+
+  Fail |= Check (Sim->Name, "ms", ClockTicksToUnits (&Clock, Ticks, 1000),
+                 (UINT64)((unsigned __int128)Ticks * 1000 / Clock.Frequency));
+  Fail |= Check (Sim->Name, "us", ClockTicksToUnits (&Clock, Ticks, 1000000),
+                 (UINT64)((unsigned __int128)Ticks * 1000000 / Clock.Frequency));
+
+  if (!Fail) {
+    printf ("ok   %-26s %llu ticks = %llu ms\n", Sim->Name, (unsigned long long)Ticks,
+            (unsigned long long)ClockTicksToUnits (&Clock, Ticks, 1000));
+  }
+  return Fail;
+}
+
+STATIC int CheckLongRun (VOID)
+{
+  UEFI_CLOCK  Clock;
+  UINT64      Ticks;
+
+  //
+  // 30 days of a 4 GHz TSC: Ticks * 1000000 would overflow 64 bits
+  //
+  ClockSetup (&Clock, 0, MAX_UINT64, 4000000000ull, 0);
+  Ticks = ClockUpdate (&Clock, 30ull * 24 * 3600 * 4000000000ull + 1999);
+  return Check ("tsc 30 days", "us", ClockTicksToUnits (&Clock, Ticks, 1000000), 30ull * 24 * 3600 * 1000000) |
+         Check ("tsc 30 days", "ms", ClockTicksToUnits (&Clock, Ticks, 1000), 30ull * 24 * 3600 * 1000);
+}
+
+STATIC int CheckRunTime (VOID)
+{
+  UINT64      Start;
+  int         Fail = 0;
+
+  //
+  // efidirect.run(until=500) started 10 minutes after the clock: the run
+  // time counts from the start, not from the clock's origin
+  //
+  Start = 10ull * 60 * 1000;
+  Fail |= Check ("run time 500 ms", "at start", ClockTimeLeft (Start, Start, 500), 500);
+  Fail |= Check ("run time 500 ms", "after 499 ms", ClockTimeLeft (Start, Start + 499, 500), 1);
+  Fail |= Check ("run time 500 ms", "after 500 ms", ClockTimeLeft (Start, Start + 500, 500), 0);
+  Fail |= Check ("run time 500 ms", "after 501 ms", ClockTimeLeft (Start, Start + 501, 500), 0);
+  Fail |= Check ("run time 0 ms", "at start", ClockTimeLeft (Start, Start, 0), 0);
+
+  //
+  // Without 'until' the run time is MAX_UINT64 and never elapses
+  //
+  Fail |= Check ("run time forever", "after 30 days", ClockTimeLeft (Start, Start + 30ull * 24 * 3600 * 1000, MAX_UINT64),
+                 MAX_UINT64 - 30ull * 24 * 3600 * 1000);
+
+  if (!Fail) {
+    printf ("ok   run time\n");
+  }
+  return Fail;
+}
+
+int main (void)
+{
+  STATIC CONST SIM_COUNTER  Counters[] = {
+    { "acpi pm timer 24 bit",     0,          0xFFFFFF,       3579545 },
+    { "acpi pm timer 32 bit",     0,          0xFFFFFFFF,     3579545 },
+    { "tsc 64 bit 3 GHz",         0,          MAX_UINT64, 3000000000ull },
+    { "local apic down counter",  0xFFFFFFFF, 0,              100000000 },
+    { "offset range 1000..1999",  1000,       1999,           1000 },
+    { "tiny down counter",        15,         8,              1 },
+  };
+  UINTN   Index;
+  int     Fail = 0;
+
+  for (Index = 0; Index < sizeof (Counters) / sizeof (Counters[0]); Index++) {
+    Fail |= RunCounter (&Counters[Index], 0);
+    //
+    // Start right before the wrap
+    //
+    Fail |= RunCounter (&Counters[Index], 0xFFFFF0);
+  }
+  Fail |= CheckLongRun ();
+  Fail |= CheckRunTime ();
+
+  printf (Fail ? "FAILED\n" : "All clock tests passed\n");
+  return Fail;
+}
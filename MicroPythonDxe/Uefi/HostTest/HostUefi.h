@@ -0,0 +1,50 @@
+/** @file
+  Minimal stand-ins for the EDK2 types and BaseLib calls used by the
+  monotonic clock, so it can be tested on a Linux host.
+
+Copyright (c) 2018, Intel Corporation. All rights reserved.<BR>
+This program and the accompanying materials
+are licensed and made available under the terms and conditions of the BSD License
+which accompanies this distribution.  The full text of the license may be found at
+http://opensource.org/licenses/bsd-license.php
+
+THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+
+**/
+
+#ifndef   HOST_UEFI_H
+#define   HOST_UEFI_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef uint8_t     UINT8;
+typedef uint32_t    UINT32;
+typedef uint64_t    UINT64;
+typedef uint8_t     BOOLEAN;
+typedef void        VOID;
+typedef uintptr_t   UINTN;
+
+#define CONST       const
+#define STATIC      static
+#define IN
+#define OUT
+#define TRUE        ((BOOLEAN)1)
+#define FALSE       ((BOOLEAN)0)
+#define MAX_UINT64  0xFFFFFFFFFFFFFFFFull
+
+static inline UINT64 DivU64x64Remainder (UINT64 Dividend, UINT64 Divisor, UINT64 *Remainder)
+{
+  if (Remainder != NULL) {
+    *Remainder = Dividend % Divisor;
+  }
+  return Dividend / Divisor;
+}
+
+static inline UINT64 MultU64x32 (UINT64 Multiplicand, UINT32 Multiplier)
+{
+  return Multiplicand * Multiplier;
+}
+
+#endif
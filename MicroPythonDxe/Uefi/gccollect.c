@@ -160,9 +160,13 @@ void gc_collect_regs_and_stack(void) {
   gc_collect_root(regs_ptr, ((uintptr_t)MP_STATE_THREAD(stack_top) - (uintptr_t)&regs) / sizeof(uintptr_t));
 }
 
+// suspended scripts of the script engine, in use.c
+void UpyGcCollectScripts(void);
+
 void gc_collect(void) {
   gc_collect_start();
   gc_collect_regs_and_stack();
+  UpyGcCollectScripts();
   #if MICROPY_PY_THREAD
   mp_thread_gc_others();
   #endif
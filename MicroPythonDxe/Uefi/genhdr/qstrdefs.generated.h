@@ -3002,6 +3002,56 @@ QDEF(MP_QSTR_efidirect, (const byte*)"\xa2\xf7\x09" "efidirect")
 QDEF(MP_QSTR_monitor_flush, (const byte*)"\x12\x14\x0d" "monitor_flush")
 QDEF(MP_QSTR_mouse_read, (const byte*)"\xe9\x6e\x0a" "mouse_read")
 QDEF(MP_QSTR_keyboard_read, (const byte*)"\x45\x2b\x0d" "keyboard_read")
+QDEF(MP_QSTR_direct, (const byte*)"\xa8\x15\x06" "direct")
+QDEF(MP_QSTR_shadow, (const byte*)"\xa3\x52\x06" "shadow")
+QDEF(MP_QSTR_async_flush, (const byte*)"\x18\x17\x0b" "async_flush")
+QDEF(MP_QSTR_resolution, (const byte*)"\x8b\x47\x0a" "resolution")
+QDEF(MP_QSTR_modes, (const byte*)"\x95\xc4\x05" "modes")
+QDEF(MP_QSTR_monitor_rounder, (const byte*)"\xe3\xef\x0f" "monitor_rounder")
+QDEF(MP_QSTR_show, (const byte*)"\x86\xaa\x04" "show")
+QDEF(MP_QSTR_sprite, (const byte*)"\xac\x44\x06" "sprite")
+QDEF(MP_QSTR_hot_x, (const byte*)"\xb1\xea\x05" "hot_x")
+QDEF(MP_QSTR_hot_y, (const byte*)"\xb0\xea\x05" "hot_y")
+QDEF(MP_QSTR_KEY_F1, (const byte*)"\x7a\x12\x06" "KEY_F1")
+QDEF(MP_QSTR_run, (const byte*)"\x6c\x89\x03" "run")
+QDEF(MP_QSTR_until, (const byte*)"\xef\x4c\x05" "until")
+QDEF(MP_QSTR__uasyncio, (const byte*)"\xcf\x5f\x09" "_uasyncio")
+QDEF(MP_QSTR_poll, (const byte*)"\x9a\xd9\x04" "poll")
+QDEF(MP_QSTR_conin, (const byte*)"\x80\xfe\x05" "conin")
+QDEF(MP_QSTR_pointers, (const byte*)"\x2d\xd8\x08" "pointers")
+QDEF(MP_QSTR_input_events, (const byte*)"\x13\xfd\x0c" "input_events")
+QDEF(MP_QSTR_parallel, (const byte*)"\xee\x93\x08" "parallel")
+QDEF(MP_QSTR_bins, (const byte*)"\x93\x64\x04" "bins")
+QDEF(MP_QSTR_blend_px, (const byte*)"\xd3\x83\x08" "blend_px")
+QDEF(MP_QSTR_cnt, (const byte*)"\x9c\x4b\x03" "cnt")
+QDEF(MP_QSTR_design, (const byte*)"\xd7\x27\x06" "design")
+QDEF(MP_QSTR_frame, (const byte*)"\x78\x8a\x05" "frame")
+QDEF(MP_QSTR_lv_perf_hist_t, (const byte*)"\xb3\xac\x0e" "lv_perf_hist_t")
+QDEF(MP_QSTR_lv_perf_stats_t, (const byte*)"\x74\x72\x0f" "lv_perf_stats_t")
+QDEF(MP_QSTR_lv_perf_widget_t, (const byte*)"\xd9\x52\x10" "lv_perf_widget_t")
+QDEF(MP_QSTR_masks, (const byte*)"\xc2\x0c\x05" "masks")
+QDEF(MP_QSTR_perf_hist_t, (const byte*)"\xb6\x1b\x0b" "perf_hist_t")
+QDEF(MP_QSTR_perf_reset, (const byte*)"\x4e\x5c\x0a" "perf_reset")
+QDEF(MP_QSTR_perf_stats, (const byte*)"\x1a\x47\x0a" "perf_stats")
+QDEF(MP_QSTR_perf_stats_t, (const byte*)"\xd1\x6a\x0c" "perf_stats_t")
+QDEF(MP_QSTR_perf_widget_t, (const byte*)"\x9c\x62\x0d" "perf_widget_t")
+QDEF(MP_QSTR_ring, (const byte*)"\x97\x2a\x04" "ring")
+QDEF(MP_QSTR_ring_pos, (const byte*)"\x64\x14\x08" "ring_pos")
+QDEF(MP_QSTR_widget_cnt, (const byte*)"\xcf\xb7\x0a" "widget_cnt")
+QDEF(MP_QSTR_widgets, (const byte*)"\x1a\x93\x07" "widgets")
+QDEF(MP_QSTR_monitor_copy, (const byte*)"\x33\xf5\x0c" "monitor_copy")
+QDEF(MP_QSTR_copy_cb, (const byte*)"\x1e\x4f\x07" "copy_cb")
+QDEF(MP_QSTR_GET_SCROLL_AREA, (const byte*)"\x29\x20\x0f" "GET_SCROLL_AREA")
+QDEF(MP_QSTR_scroll_area, (const byte*)"\xe0\x91\x0b" "scroll_area")
+QDEF(MP_QSTR_scroll_pending, (const byte*)"\x88\x67\x0e" "scroll_pending")
+QDEF(MP_QSTR_lv_disp_drv_t_copy_cb, (const byte*)"\x5e\xc6\x15" "lv_disp_drv_t_copy_cb")
+QDEF(MP_QSTR_scroll_dx, (const byte*)"\xeb\x54\x09" "scroll_dx")
+QDEF(MP_QSTR_scroll_dy, (const byte*)"\xea\x54\x09" "scroll_dy")
+QDEF(MP_QSTR_monitor_parallel, (const byte*)"\x3d\xc0\x10" "monitor_parallel")
+QDEF(MP_QSTR_monitor_parallel_cnt, (const byte*)"\xfb\x21\x14" "monitor_parallel_cnt")
+QDEF(MP_QSTR_parallel_cb, (const byte*)"\xd0\x5e\x0b" "parallel_cb")
+QDEF(MP_QSTR_parallel_cnt, (const byte*)"\x28\x3a\x0c" "parallel_cnt")
+QDEF(MP_QSTR_monitor_wait, (const byte*)"\x9d\xf7\x0c" "monitor_wait")
 
 QDEF(MP_QSTR_uctypes, (const byte*)"\xf8\x71\x07" "uctypes")
 QDEF(MP_QSTR_struct, (const byte*)"\x12\x90\x06" "struct")
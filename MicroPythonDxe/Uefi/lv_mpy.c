@@ -2223,6 +2223,7 @@ STATIC const mp_rom_map_elem_t LV_SIGNAL_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_GET_TYPE), MP_ROM_PTR(MP_ROM_INT(LV_SIGNAL_GET_TYPE)) },
     { MP_ROM_QSTR(MP_QSTR_GET_STYLE), MP_ROM_PTR(MP_ROM_INT(LV_SIGNAL_GET_STYLE)) },
     { MP_ROM_QSTR(MP_QSTR_GET_STATE_DSC), MP_ROM_PTR(MP_ROM_INT(LV_SIGNAL_GET_STATE_DSC)) },
+    { MP_ROM_QSTR(MP_QSTR_GET_SCROLL_AREA), MP_ROM_PTR(MP_ROM_INT(LV_SIGNAL_GET_SCROLL_AREA)) },
     { MP_ROM_QSTR(MP_QSTR_HIT_TEST), MP_ROM_PTR(MP_ROM_INT(LV_SIGNAL_HIT_TEST)) },
     { MP_ROM_QSTR(MP_QSTR_PRESSED), MP_ROM_PTR(MP_ROM_INT(LV_SIGNAL_PRESSED)) },
     { MP_ROM_QSTR(MP_QSTR_PRESSING), MP_ROM_PTR(MP_ROM_INT(LV_SIGNAL_PRESSING)) },
@@ -7789,6 +7790,31 @@ STATIC MP_DEFINE_CONST_LV_FUN_OBJ_STATIC_VAR(mp_funcptr_wait_cb_obj, 1, mp_funcp
 STATIC inline mp_obj_t mp_lv_funcptr_wait_cb(void *func){ return mp_lv_funcptr(&mp_funcptr_wait_cb_obj, func, NULL, MP_QSTR_, NULL); }
 
 STATIC void lv_disp_drv_t_wait_cb_callback(struct _disp_drv_t *disp_drv);
+#define funcptr_copy_cb NULL
+
+
+/*
+ * lvgl extension definition for:
+ * bool copy_cb(struct _disp_drv_t *disp_drv, const lv_area_t *area, lv_coord_t dx, lv_coord_t dy)
+ */
+ 
+STATIC mp_obj_t mp_funcptr_copy_cb(size_t mp_n_args, const mp_obj_t *mp_args, void *lv_func_ptr)
+{
+    struct _disp_drv_t *disp_drv = mp_to_ptr(mp_args[0]);
+    const lv_area_t *area = mp_write_ptr_lv_area_t(mp_args[1]);
+    lv_coord_t dx = (int16_t)mp_obj_get_int(mp_args[2]);
+    lv_coord_t dy = (int16_t)mp_obj_get_int(mp_args[3]);
+    bool _res = ((bool (*)(struct _disp_drv_t *, const lv_area_t *, lv_coord_t, lv_coord_t))lv_func_ptr)(disp_drv, area, dx, dy);
+    return convert_to_bool(_res);
+}
+
+ 
+
+STATIC MP_DEFINE_CONST_LV_FUN_OBJ_STATIC_VAR(mp_funcptr_copy_cb_obj, 4, mp_funcptr_copy_cb, funcptr_copy_cb);
+    
+STATIC inline mp_obj_t mp_lv_funcptr_copy_cb(void *func){ return mp_lv_funcptr(&mp_funcptr_copy_cb_obj, func, NULL, MP_QSTR_, NULL); }
+
+STATIC bool lv_disp_drv_t_copy_cb_callback(struct _disp_drv_t *disp_drv, const lv_area_t *area, lv_coord_t dx, lv_coord_t dy);
 STATIC void lv_disp_drv_t_clean_dcache_cb_callback(struct _disp_drv_t *disp_drv);
 STATIC void lv_disp_drv_t_gpu_wait_cb_callback(struct _disp_drv_t *disp_drv);
 #define funcptr_gpu_blend_cb NULL
@@ -7886,8 +7912,13 @@ STATIC void mp_lv_disp_drv_t_attr(mp_obj_t self_in, qstr attr, mp_obj_t *dest)
             case MP_QSTR_set_px_cb: dest[0] = mp_lv_funcptr(&mp_funcptr_set_px_cb_obj, (void*)data->set_px_cb, lv_disp_drv_t_set_px_cb_callback ,MP_QSTR_lv_disp_drv_t_set_px_cb, data->user_data); break; // converting from callback void (*)(lv_disp_drv_t *disp_drv, uint8_t *buf, lv_coord_t buf_w, lv_coord_t x, lv_coord_t y, lv_color_t color, lv_opa_t opa);
             case MP_QSTR_monitor_cb: dest[0] = mp_lv_funcptr(&mp_funcptr_monitor_cb_obj, (void*)data->monitor_cb, lv_disp_drv_t_monitor_cb_callback ,MP_QSTR_lv_disp_drv_t_monitor_cb, data->user_data); break; // converting from callback void (*)(lv_disp_drv_t *disp_drv, uint32_t time, uint32_t px);
             case MP_QSTR_wait_cb: dest[0] = mp_lv_funcptr(&mp_funcptr_wait_cb_obj, (void*)data->wait_cb, lv_disp_drv_t_wait_cb_callback ,MP_QSTR_lv_disp_drv_t_wait_cb, data->user_data); break; // converting from callback void (*)(lv_disp_drv_t *disp_drv);
+            case MP_QSTR_copy_cb: dest[0] = mp_lv_funcptr(&mp_funcptr_copy_cb_obj, (void*)data->copy_cb, lv_disp_drv_t_copy_cb_callback ,MP_QSTR_lv_disp_drv_t_copy_cb, data->user_data); break; // converting from callback bool (*)(lv_disp_drv_t *disp_drv, lv_area_t *area, lv_coord_t dx, lv_coord_t dy);
             case MP_QSTR_clean_dcache_cb: dest[0] = mp_lv_funcptr(&mp_funcptr_wait_cb_obj, (void*)data->clean_dcache_cb, lv_disp_drv_t_clean_dcache_cb_callback ,MP_QSTR_lv_disp_drv_t_clean_dcache_cb, data->user_data); break; // converting from callback void (*)(lv_disp_drv_t *disp_drv);
             case MP_QSTR_gpu_wait_cb: dest[0] = mp_lv_funcptr(&mp_funcptr_wait_cb_obj, (void*)data->gpu_wait_cb, lv_disp_drv_t_gpu_wait_cb_callback ,MP_QSTR_lv_disp_drv_t_gpu_wait_cb, data->user_data); break; // converting from callback void (*)(lv_disp_drv_t *disp_drv);
+#if LV_REFR_PARALLEL_MAX > 1
+            case MP_QSTR_parallel_cb: dest[0] = ptr_to_mp((void*)data->parallel_cb); break; // converting from void * (runs on other cores, no Python callback);
+            case MP_QSTR_parallel_cnt: dest[0] = mp_obj_new_int_from_uint(data->parallel_cnt); break; // converting from uint32_t;
+#endif
             case MP_QSTR_gpu_blend_cb: dest[0] = mp_lv_funcptr(&mp_funcptr_gpu_blend_cb_obj, (void*)data->gpu_blend_cb, lv_disp_drv_t_gpu_blend_cb_callback ,MP_QSTR_lv_disp_drv_t_gpu_blend_cb, data->user_data); break; // converting from callback void (*)(lv_disp_drv_t *disp_drv, lv_color_t *dest, lv_color_t *src, uint32_t length, lv_opa_t opa);
             case MP_QSTR_gpu_fill_cb: dest[0] = mp_lv_funcptr(&mp_funcptr_gpu_fill_cb_obj, (void*)data->gpu_fill_cb, lv_disp_drv_t_gpu_fill_cb_callback ,MP_QSTR_lv_disp_drv_t_gpu_fill_cb, data->user_data); break; // converting from callback void (*)(lv_disp_drv_t *disp_drv, lv_color_t *dest_buf, lv_coord_t dest_width, lv_area_t *fill_area, lv_color_t color);
             case MP_QSTR_color_chroma_key: dest[0] = mp_read_byref_lv_color32_t(data->color_chroma_key); break; // converting from lv_color_t;
@@ -7911,8 +7942,13 @@ STATIC void mp_lv_disp_drv_t_attr(mp_obj_t self_in, qstr attr, mp_obj_t *dest)
                 case MP_QSTR_set_px_cb: data->set_px_cb = (void*)mp_lv_callback(dest[1], lv_disp_drv_t_set_px_cb_callback ,MP_QSTR_lv_disp_drv_t_set_px_cb, &data->user_data); break; // converting to callback void (*)(lv_disp_drv_t *disp_drv, uint8_t *buf, lv_coord_t buf_w, lv_coord_t x, lv_coord_t y, lv_color_t color, lv_opa_t opa);
                 case MP_QSTR_monitor_cb: data->monitor_cb = (void*)mp_lv_callback(dest[1], lv_disp_drv_t_monitor_cb_callback ,MP_QSTR_lv_disp_drv_t_monitor_cb, &data->user_data); break; // converting to callback void (*)(lv_disp_drv_t *disp_drv, uint32_t time, uint32_t px);
                 case MP_QSTR_wait_cb: data->wait_cb = (void*)mp_lv_callback(dest[1], lv_disp_drv_t_wait_cb_callback ,MP_QSTR_lv_disp_drv_t_wait_cb, &data->user_data); break; // converting to callback void (*)(lv_disp_drv_t *disp_drv);
+                case MP_QSTR_copy_cb: data->copy_cb = (void*)mp_lv_callback(dest[1], lv_disp_drv_t_copy_cb_callback ,MP_QSTR_lv_disp_drv_t_copy_cb, &data->user_data); break; // converting to callback bool (*)(lv_disp_drv_t *disp_drv, lv_area_t *area, lv_coord_t dx, lv_coord_t dy);
                 case MP_QSTR_clean_dcache_cb: data->clean_dcache_cb = (void*)mp_lv_callback(dest[1], lv_disp_drv_t_clean_dcache_cb_callback ,MP_QSTR_lv_disp_drv_t_clean_dcache_cb, &data->user_data); break; // converting to callback void (*)(lv_disp_drv_t *disp_drv);
                 case MP_QSTR_gpu_wait_cb: data->gpu_wait_cb = (void*)mp_lv_callback(dest[1], lv_disp_drv_t_gpu_wait_cb_callback ,MP_QSTR_lv_disp_drv_t_gpu_wait_cb, &data->user_data); break; // converting to callback void (*)(lv_disp_drv_t *disp_drv);
+#if LV_REFR_PARALLEL_MAX > 1
+                case MP_QSTR_parallel_cb: data->parallel_cb = (void*)mp_to_ptr(dest[1]); break; // converting to void * (runs on other cores, no Python callback);
+                case MP_QSTR_parallel_cnt: data->parallel_cnt = (uint32_t)mp_obj_get_int(dest[1]); break; // converting to uint32_t;
+#endif
                 case MP_QSTR_gpu_blend_cb: data->gpu_blend_cb = (void*)mp_lv_callback(dest[1], lv_disp_drv_t_gpu_blend_cb_callback ,MP_QSTR_lv_disp_drv_t_gpu_blend_cb, &data->user_data); break; // converting to callback void (*)(lv_disp_drv_t *disp_drv, lv_color_t *dest, lv_color_t *src, uint32_t length, lv_opa_t opa);
                 case MP_QSTR_gpu_fill_cb: data->gpu_fill_cb = (void*)mp_lv_callback(dest[1], lv_disp_drv_t_gpu_fill_cb_callback ,MP_QSTR_lv_disp_drv_t_gpu_fill_cb, &data->user_data); break; // converting to callback void (*)(lv_disp_drv_t *disp_drv, lv_color_t *dest_buf, lv_coord_t dest_width, lv_area_t *fill_area, lv_color_t color);
                 case MP_QSTR_color_chroma_key: data->color_chroma_key = mp_write_lv_color32_t(dest[1]); break; // converting to lv_color_t;
@@ -8134,66 +8170,6 @@ STATIC inline const mp_obj_type_t *get_mp_lv_ll_t_type()
 }
     
 
-/*
- * Array convertors for lv_area_t [32]
- */
-
-STATIC lv_area_t *mp_arr_to_lv_area_t___32__(mp_obj_t mp_arr)
-{
-    mp_obj_t mp_len = mp_obj_len_maybe(mp_arr);
-    if (mp_len == MP_OBJ_NULL) return mp_to_ptr(mp_arr);
-    mp_int_t len = mp_obj_get_int(mp_len);
-    //TODO check dim!
-    lv_area_t *lv_arr = (lv_area_t*)m_malloc(len * sizeof(lv_area_t));
-    mp_obj_t iter = mp_getiter(mp_arr, NULL);
-    mp_obj_t item;
-    size_t i = 0;
-    while ((item = mp_iternext(iter)) != MP_OBJ_STOP_ITERATION) {
-        lv_arr[i++] = mp_write_lv_area_t(item);
-    }
-    return (lv_area_t *)lv_arr;
-}
-    
-STATIC mp_obj_t mp_arr_from_lv_area_t___32__(lv_area_t *arr)
-{
-    mp_obj_t obj_arr[32];
-    for (size_t i=0; i<32; i++){
-        obj_arr[i] = mp_read_lv_area_t(arr[i]);
-    }
-    return mp_obj_new_list(32, obj_arr); // TODO: return custom iterable object!
-}
-    
-
-/*
- * Array convertors for uint8_t [32]
- */
-
-STATIC uint8_t *mp_arr_to_uint8_t___32__(mp_obj_t mp_arr)
-{
-    mp_obj_t mp_len = mp_obj_len_maybe(mp_arr);
-    if (mp_len == MP_OBJ_NULL) return mp_to_ptr(mp_arr);
-    mp_int_t len = mp_obj_get_int(mp_len);
-    //TODO check dim!
-    uint8_t *lv_arr = (uint8_t*)m_malloc(len * sizeof(uint8_t));
-    mp_obj_t iter = mp_getiter(mp_arr, NULL);
-    mp_obj_t item;
-    size_t i = 0;
-    while ((item = mp_iternext(iter)) != MP_OBJ_STOP_ITERATION) {
-        lv_arr[i++] = (uint8_t)mp_obj_get_int(item);
-    }
-    return (uint8_t *)lv_arr;
-}
-    
-STATIC mp_obj_t mp_arr_from_uint8_t___32__(uint8_t *arr)
-{
-    mp_obj_t obj_arr[32];
-    for (size_t i=0; i<32; i++){
-        obj_arr[i] = mp_obj_new_int_from_uint(arr[i]);
-    }
-    return mp_obj_new_list(32, obj_arr); // TODO: return custom iterable object!
-}
-    
-
 /*
  * Struct lv_disp_t
  */
@@ -8237,9 +8213,10 @@ STATIC void mp_lv_disp_t_attr(mp_obj_t self_in, qstr attr, mp_obj_t *dest)
             case MP_QSTR_bg_color: dest[0] = mp_read_byref_lv_color32_t(data->bg_color); break; // converting from lv_color_t;
             case MP_QSTR_bg_img: dest[0] = ptr_to_mp((void*)data->bg_img); break; // converting from void *;
             case MP_QSTR_bg_opa: dest[0] = mp_obj_new_int_from_uint(data->bg_opa); break; // converting from lv_opa_t;
-            case MP_QSTR_inv_areas: dest[0] = mp_arr_from_lv_area_t___32__(data->inv_areas); break; // converting from lv_area_t [32];
-            case MP_QSTR_inv_area_joined: dest[0] = mp_arr_from_uint8_t___32__(data->inv_area_joined); break; // converting from uint8_t [32];
-            case MP_QSTR_inv_p: dest[0] = mp_obj_new_int_from_uint(data->inv_p); break; // converting from uint32_t;
+            case MP_QSTR_scroll_area: dest[0] = mp_read_byref_lv_area_t(data->scroll_area); break; // converting from lv_area_t;
+            case MP_QSTR_scroll_dx: dest[0] = mp_obj_new_int(data->scroll_dx); break; // converting from lv_coord_t;
+            case MP_QSTR_scroll_dy: dest[0] = mp_obj_new_int(data->scroll_dy); break; // converting from lv_coord_t;
+            case MP_QSTR_scroll_pending: dest[0] = mp_obj_new_int_from_uint(data->scroll_pending); break; // converting from uint8_t;
             case MP_QSTR_last_activity_time: dest[0] = mp_obj_new_int_from_uint(data->last_activity_time); break; // converting from uint32_t;
             default: call_parent_methods(self_in, attr, dest); // fallback to locals_dict lookup
         }
@@ -8261,9 +8238,10 @@ STATIC void mp_lv_disp_t_attr(mp_obj_t self_in, qstr attr, mp_obj_t *dest)
                 case MP_QSTR_bg_color: data->bg_color = mp_write_lv_color32_t(dest[1]); break; // converting to lv_color_t;
                 case MP_QSTR_bg_img: data->bg_img = (void*)mp_to_ptr(dest[1]); break; // converting to void *;
                 case MP_QSTR_bg_opa: data->bg_opa = (uint8_t)mp_obj_get_int(dest[1]); break; // converting to lv_opa_t;
-                case MP_QSTR_inv_areas: memcpy((void*)&data->inv_areas, mp_arr_to_lv_area_t___32__(dest[1]), sizeof(lv_area_t)*32); break; // converting to lv_area_t [32];
-                case MP_QSTR_inv_area_joined: memcpy((void*)&data->inv_area_joined, mp_arr_to_uint8_t___32__(dest[1]), sizeof(uint8_t)*32); break; // converting to uint8_t [32];
-                case MP_QSTR_inv_p: data->inv_p = (uint32_t)mp_obj_get_int(dest[1]); break; // converting to uint32_t;
+                case MP_QSTR_scroll_area: data->scroll_area = mp_write_lv_area_t(dest[1]); break; // converting to lv_area_t;
+                case MP_QSTR_scroll_dx: data->scroll_dx = (int16_t)mp_obj_get_int(dest[1]); break; // converting to lv_coord_t;
+                case MP_QSTR_scroll_dy: data->scroll_dy = (int16_t)mp_obj_get_int(dest[1]); break; // converting to lv_coord_t;
+                case MP_QSTR_scroll_pending: data->scroll_pending = (uint8_t)mp_obj_get_int(dest[1]); break; // converting to uint8_t;
                 case MP_QSTR_last_activity_time: data->last_activity_time = (uint32_t)mp_obj_get_int(dest[1]); break; // converting to uint32_t;
                 default: return;
             }
@@ -25992,6 +25970,398 @@ STATIC mp_obj_t mp_lv_scr_load_anim(size_t mp_n_args, const mp_obj_t *mp_args, v
 STATIC MP_DEFINE_CONST_LV_FUN_OBJ_VAR(mp_lv_scr_load_anim_obj, 5, mp_lv_scr_load_anim, lv_scr_load_anim);
     
 
+/*
+ * Array convertors for uint32_t [24]
+ */
+
+STATIC uint32_t *mp_arr_to_uint32_t___24__(mp_obj_t mp_arr)
+{
+    mp_obj_t mp_len = mp_obj_len_maybe(mp_arr);
+    if (mp_len == MP_OBJ_NULL) return mp_to_ptr(mp_arr);
+    mp_int_t len = mp_obj_get_int(mp_len);
+    //TODO check dim!
+    uint32_t *lv_arr = (uint32_t*)m_malloc(len * sizeof(uint32_t));
+    mp_obj_t iter = mp_getiter(mp_arr, NULL);
+    mp_obj_t item;
+    size_t i = 0;
+    while ((item = mp_iternext(iter)) != MP_OBJ_STOP_ITERATION) {
+        lv_arr[i++] = (uint32_t)mp_obj_get_int(item);
+    }
+    return (uint32_t *)lv_arr;
+}
+    
+STATIC mp_obj_t mp_arr_from_uint32_t___24__(uint32_t *arr)
+{
+    mp_obj_t obj_arr[24];
+    for (size_t i=0; i<24; i++){
+        obj_arr[i] = mp_obj_new_int_from_uint(arr[i]);
+    }
+    return mp_obj_new_list(24, obj_arr); // TODO: return custom iterable object!
+}
+    
+
+/*
+ * Array convertors for uint32_t [32]
+ */
+
+STATIC uint32_t *mp_arr_to_uint32_t___32__(mp_obj_t mp_arr)
+{
+    mp_obj_t mp_len = mp_obj_len_maybe(mp_arr);
+    if (mp_len == MP_OBJ_NULL) return mp_to_ptr(mp_arr);
+    mp_int_t len = mp_obj_get_int(mp_len);
+    //TODO check dim!
+    uint32_t *lv_arr = (uint32_t*)m_malloc(len * sizeof(uint32_t));
+    mp_obj_t iter = mp_getiter(mp_arr, NULL);
+    mp_obj_t item;
+    size_t i = 0;
+    while ((item = mp_iternext(iter)) != MP_OBJ_STOP_ITERATION) {
+        lv_arr[i++] = (uint32_t)mp_obj_get_int(item);
+    }
+    return (uint32_t *)lv_arr;
+}
+    
+STATIC mp_obj_t mp_arr_from_uint32_t___32__(uint32_t *arr)
+{
+    mp_obj_t obj_arr[32];
+    for (size_t i=0; i<32; i++){
+        obj_arr[i] = mp_obj_new_int_from_uint(arr[i]);
+    }
+    return mp_obj_new_list(32, obj_arr); // TODO: return custom iterable object!
+}
+    
+
+/*
+ * Struct lv_perf_hist_t
+ */
+
+STATIC inline const mp_obj_type_t *get_mp_lv_perf_hist_t_type();
+
+STATIC inline lv_perf_hist_t* mp_write_ptr_lv_perf_hist_t(mp_obj_t self_in)
+{
+    mp_lv_struct_t *self = MP_OBJ_TO_PTR(cast(self_in, get_mp_lv_perf_hist_t_type()));
+    return (lv_perf_hist_t*)self->data;
+}
+
+#define mp_write_lv_perf_hist_t(struct_obj) *mp_write_ptr_lv_perf_hist_t(struct_obj)
+
+STATIC inline mp_obj_t mp_read_ptr_lv_perf_hist_t(lv_perf_hist_t *field)
+{
+    return lv_to_mp_struct(get_mp_lv_perf_hist_t_type(), (void*)field);
+}
+
+#define mp_read_lv_perf_hist_t(field) mp_read_ptr_lv_perf_hist_t(copy_buffer(&field, sizeof(lv_perf_hist_t)))
+#define mp_read_byref_lv_perf_hist_t(field) mp_read_ptr_lv_perf_hist_t(&field)
+
+STATIC void mp_lv_perf_hist_t_attr(mp_obj_t self_in, qstr attr, mp_obj_t *dest)
+{
+    mp_lv_struct_t *self = MP_OBJ_TO_PTR(self_in);
+    lv_perf_hist_t *data = (lv_perf_hist_t*)self->data;
+
+    if (dest[0] == MP_OBJ_NULL) {
+        // load attribute
+        switch(attr)
+        {
+            case MP_QSTR_cnt: dest[0] = mp_obj_new_int_from_uint(data->cnt); break; // converting from uint32_t;
+            case MP_QSTR_sum: dest[0] = mp_obj_new_int_from_ull(data->sum); break; // converting from uint64_t;
+            case MP_QSTR_max: dest[0] = mp_obj_new_int_from_uint(data->max); break; // converting from uint32_t;
+            case MP_QSTR_bins: dest[0] = mp_arr_from_uint32_t___24__(data->bins); break; // converting from uint32_t [24];
+            case MP_QSTR_ring: dest[0] = mp_arr_from_uint32_t___32__(data->ring); break; // converting from uint32_t [32];
+            case MP_QSTR_ring_pos: dest[0] = mp_obj_new_int_from_uint(data->ring_pos); break; // converting from uint16_t;
+            default: call_parent_methods(self_in, attr, dest); // fallback to locals_dict lookup
+        }
+    } else {
+        if (dest[1])
+        {
+            // store attribute
+            switch(attr)
+            {
+                case MP_QSTR_cnt: data->cnt = (uint32_t)mp_obj_get_int(dest[1]); break; // converting to uint32_t;
+                case MP_QSTR_sum: data->sum = (uint64_t)mp_obj_get_ull(dest[1]); break; // converting to uint64_t;
+                case MP_QSTR_max: data->max = (uint32_t)mp_obj_get_int(dest[1]); break; // converting to uint32_t;
+                case MP_QSTR_bins: memcpy((void*)&data->bins, mp_arr_to_uint32_t___24__(dest[1]), sizeof(uint32_t)*24); break; // converting to uint32_t [24];
+                case MP_QSTR_ring: memcpy((void*)&data->ring, mp_arr_to_uint32_t___32__(dest[1]), sizeof(uint32_t)*32); break; // converting to uint32_t [32];
+                case MP_QSTR_ring_pos: data->ring_pos = (uint16_t)mp_obj_get_int(dest[1]); break; // converting to uint16_t;
+                default: return;
+            }
+
+            dest[0] = MP_OBJ_NULL; // indicate success
+        }
+    }
+}
+
+STATIC void mp_lv_perf_hist_t_print(const mp_print_t *print,
+    mp_obj_t self_in,
+    mp_print_kind_t kind)
+{
+    mp_printf(print, "struct lv_perf_hist_t");
+}
+
+STATIC const mp_obj_dict_t mp_lv_perf_hist_t_locals_dict;
+
+STATIC const mp_obj_type_t mp_lv_perf_hist_t_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_lv_perf_hist_t,
+    .print = mp_lv_perf_hist_t_print,
+    .make_new = make_new_lv_struct,
+    .attr = mp_lv_perf_hist_t_attr,
+    .locals_dict = (mp_obj_dict_t*)&mp_lv_perf_hist_t_locals_dict,
+    .buffer_p = { .get_buffer = mp_blob_get_buffer }
+};
+
+STATIC inline const mp_obj_type_t *get_mp_lv_perf_hist_t_type()
+{
+    return &mp_lv_perf_hist_t_type;
+}
+    
+
+/*
+ * Struct lv_perf_widget_t
+ */
+
+STATIC inline const mp_obj_type_t *get_mp_lv_perf_widget_t_type();
+
+STATIC inline lv_perf_widget_t* mp_write_ptr_lv_perf_widget_t(mp_obj_t self_in)
+{
+    mp_lv_struct_t *self = MP_OBJ_TO_PTR(cast(self_in, get_mp_lv_perf_widget_t_type()));
+    return (lv_perf_widget_t*)self->data;
+}
+
+#define mp_write_lv_perf_widget_t(struct_obj) *mp_write_ptr_lv_perf_widget_t(struct_obj)
+
+STATIC inline mp_obj_t mp_read_ptr_lv_perf_widget_t(lv_perf_widget_t *field)
+{
+    return lv_to_mp_struct(get_mp_lv_perf_widget_t_type(), (void*)field);
+}
+
+#define mp_read_lv_perf_widget_t(field) mp_read_ptr_lv_perf_widget_t(copy_buffer(&field, sizeof(lv_perf_widget_t)))
+#define mp_read_byref_lv_perf_widget_t(field) mp_read_ptr_lv_perf_widget_t(&field)
+
+STATIC void mp_lv_perf_widget_t_attr(mp_obj_t self_in, qstr attr, mp_obj_t *dest)
+{
+    mp_lv_struct_t *self = MP_OBJ_TO_PTR(self_in);
+    lv_perf_widget_t *data = (lv_perf_widget_t*)self->data;
+
+    if (dest[0] == MP_OBJ_NULL) {
+        // load attribute
+        switch(attr)
+        {
+            case MP_QSTR_name: dest[0] = convert_to_str((void*)data->name); break; // converting from char *;
+            case MP_QSTR_design: dest[0] = mp_read_byref_lv_perf_hist_t(data->design); break; // converting from lv_perf_hist_t;
+            default: call_parent_methods(self_in, attr, dest); // fallback to locals_dict lookup
+        }
+    } else {
+        if (dest[1])
+        {
+            // store attribute
+            switch(attr)
+            {
+                case MP_QSTR_name: data->name = (void*)(char*)convert_from_str(dest[1]); break; // converting to char *;
+                case MP_QSTR_design: data->design = mp_write_lv_perf_hist_t(dest[1]); break; // converting to lv_perf_hist_t;
+                default: return;
+            }
+
+            dest[0] = MP_OBJ_NULL; // indicate success
+        }
+    }
+}
+
+STATIC void mp_lv_perf_widget_t_print(const mp_print_t *print,
+    mp_obj_t self_in,
+    mp_print_kind_t kind)
+{
+    mp_printf(print, "struct lv_perf_widget_t");
+}
+
+STATIC const mp_obj_dict_t mp_lv_perf_widget_t_locals_dict;
+
+STATIC const mp_obj_type_t mp_lv_perf_widget_t_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_lv_perf_widget_t,
+    .print = mp_lv_perf_widget_t_print,
+    .make_new = make_new_lv_struct,
+    .attr = mp_lv_perf_widget_t_attr,
+    .locals_dict = (mp_obj_dict_t*)&mp_lv_perf_widget_t_locals_dict,
+    .buffer_p = { .get_buffer = mp_blob_get_buffer }
+};
+
+STATIC inline const mp_obj_type_t *get_mp_lv_perf_widget_t_type()
+{
+    return &mp_lv_perf_widget_t_type;
+}
+    
+
+/*
+ * Array convertors for lv_perf_widget_t [32]
+ */
+
+STATIC lv_perf_widget_t *mp_arr_to_lv_perf_widget_t___32__(mp_obj_t mp_arr)
+{
+    mp_obj_t mp_len = mp_obj_len_maybe(mp_arr);
+    if (mp_len == MP_OBJ_NULL) return mp_to_ptr(mp_arr);
+    mp_int_t len = mp_obj_get_int(mp_len);
+    //TODO check dim!
+    lv_perf_widget_t *lv_arr = (lv_perf_widget_t*)m_malloc(len * sizeof(lv_perf_widget_t));
+    mp_obj_t iter = mp_getiter(mp_arr, NULL);
+    mp_obj_t item;
+    size_t i = 0;
+    while ((item = mp_iternext(iter)) != MP_OBJ_STOP_ITERATION) {
+        lv_arr[i++] = mp_write_lv_perf_widget_t(item);
+    }
+    return (lv_perf_widget_t *)lv_arr;
+}
+    
+STATIC mp_obj_t mp_arr_from_lv_perf_widget_t___32__(lv_perf_widget_t *arr)
+{
+    mp_obj_t obj_arr[32];
+    for (size_t i=0; i<32; i++){
+        obj_arr[i] = mp_read_lv_perf_widget_t(arr[i]);
+    }
+    return mp_obj_new_list(32, obj_arr); // TODO: return custom iterable object!
+}
+    
+
+/*
+ * Struct lv_perf_stats_t
+ */
+
+STATIC inline const mp_obj_type_t *get_mp_lv_perf_stats_t_type();
+
+STATIC inline lv_perf_stats_t* mp_write_ptr_lv_perf_stats_t(mp_obj_t self_in)
+{
+    mp_lv_struct_t *self = MP_OBJ_TO_PTR(cast(self_in, get_mp_lv_perf_stats_t_type()));
+    return (lv_perf_stats_t*)self->data;
+}
+
+#define mp_write_lv_perf_stats_t(struct_obj) *mp_write_ptr_lv_perf_stats_t(struct_obj)
+
+STATIC inline mp_obj_t mp_read_ptr_lv_perf_stats_t(lv_perf_stats_t *field)
+{
+    return lv_to_mp_struct(get_mp_lv_perf_stats_t_type(), (void*)field);
+}
+
+#define mp_read_lv_perf_stats_t(field) mp_read_ptr_lv_perf_stats_t(copy_buffer(&field, sizeof(lv_perf_stats_t)))
+#define mp_read_byref_lv_perf_stats_t(field) mp_read_ptr_lv_perf_stats_t(&field)
+
+STATIC void mp_lv_perf_stats_t_attr(mp_obj_t self_in, qstr attr, mp_obj_t *dest)
+{
+    mp_lv_struct_t *self = MP_OBJ_TO_PTR(self_in);
+    lv_perf_stats_t *data = (lv_perf_stats_t*)self->data;
+
+    if (dest[0] == MP_OBJ_NULL) {
+        // load attribute
+        switch(attr)
+        {
+            case MP_QSTR_frame: dest[0] = mp_read_byref_lv_perf_hist_t(data->frame); break; // converting from lv_perf_hist_t;
+            case MP_QSTR_join: dest[0] = mp_read_byref_lv_perf_hist_t(data->join); break; // converting from lv_perf_hist_t;
+            case MP_QSTR_area: dest[0] = mp_read_byref_lv_perf_hist_t(data->area); break; // converting from lv_perf_hist_t;
+            case MP_QSTR_flush: dest[0] = mp_read_byref_lv_perf_hist_t(data->flush); break; // converting from lv_perf_hist_t;
+            case MP_QSTR_masks: dest[0] = mp_read_byref_lv_perf_hist_t(data->masks); break; // converting from lv_perf_hist_t;
+            case MP_QSTR_blend_px: dest[0] = mp_read_byref_lv_perf_hist_t(data->blend_px); break; // converting from lv_perf_hist_t;
+            case MP_QSTR_widgets: dest[0] = mp_arr_from_lv_perf_widget_t___32__(data->widgets); break; // converting from lv_perf_widget_t [32];
+            case MP_QSTR_widget_cnt: dest[0] = mp_obj_new_int_from_uint(data->widget_cnt); break; // converting from uint16_t;
+            default: call_parent_methods(self_in, attr, dest); // fallback to locals_dict lookup
+        }
+    } else {
+        if (dest[1])
+        {
+            // store attribute
+            switch(attr)
+            {
+                case MP_QSTR_frame: data->frame = mp_write_lv_perf_hist_t(dest[1]); break; // converting to lv_perf_hist_t;
+                case MP_QSTR_join: data->join = mp_write_lv_perf_hist_t(dest[1]); break; // converting to lv_perf_hist_t;
+                case MP_QSTR_area: data->area = mp_write_lv_perf_hist_t(dest[1]); break; // converting to lv_perf_hist_t;
+                case MP_QSTR_flush: data->flush = mp_write_lv_perf_hist_t(dest[1]); break; // converting to lv_perf_hist_t;
+                case MP_QSTR_masks: data->masks = mp_write_lv_perf_hist_t(dest[1]); break; // converting to lv_perf_hist_t;
+                case MP_QSTR_blend_px: data->blend_px = mp_write_lv_perf_hist_t(dest[1]); break; // converting to lv_perf_hist_t;
+                case MP_QSTR_widgets: memcpy((void*)&data->widgets, mp_arr_to_lv_perf_widget_t___32__(dest[1]), sizeof(lv_perf_widget_t)*32); break; // converting to lv_perf_widget_t [32];
+                case MP_QSTR_widget_cnt: data->widget_cnt = (uint16_t)mp_obj_get_int(dest[1]); break; // converting to uint16_t;
+                default: return;
+            }
+
+            dest[0] = MP_OBJ_NULL; // indicate success
+        }
+    }
+}
+
+STATIC void mp_lv_perf_stats_t_print(const mp_print_t *print,
+    mp_obj_t self_in,
+    mp_print_kind_t kind)
+{
+    mp_printf(print, "struct lv_perf_stats_t");
+}
+
+STATIC const mp_obj_dict_t mp_lv_perf_stats_t_locals_dict;
+
+STATIC const mp_obj_type_t mp_lv_perf_stats_t_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_lv_perf_stats_t,
+    .print = mp_lv_perf_stats_t_print,
+    .make_new = make_new_lv_struct,
+    .attr = mp_lv_perf_stats_t_attr,
+    .locals_dict = (mp_obj_dict_t*)&mp_lv_perf_stats_t_locals_dict,
+    .buffer_p = { .get_buffer = mp_blob_get_buffer }
+};
+
+STATIC inline const mp_obj_type_t *get_mp_lv_perf_stats_t_type()
+{
+    return &mp_lv_perf_stats_t_type;
+}
+    
+
+/*
+ * lvgl extension definition for:
+ * lv_perf_stats_t *lv_perf_stats(void)
+ */
+ 
+STATIC mp_obj_t mp_lv_perf_stats(size_t mp_n_args, const mp_obj_t *mp_args, void *lv_func_ptr)
+{
+    
+    lv_perf_stats_t * _res = ((lv_perf_stats_t *(*)(void))lv_func_ptr)();
+    return mp_read_ptr_lv_perf_stats_t((void*)_res);
+}
+
+ 
+
+STATIC MP_DEFINE_CONST_LV_FUN_OBJ_STATIC_VAR(mp_lv_perf_stats_obj, 0, mp_lv_perf_stats, lv_perf_stats);
+    
+
+STATIC const mp_rom_map_elem_t mp_lv_perf_stats_t_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_SIZE), MP_ROM_PTR(MP_ROM_INT(sizeof(lv_perf_stats_t))) },
+    { MP_ROM_QSTR(MP_QSTR_cast), MP_ROM_PTR(&mp_lv_cast_class_method) },
+    { MP_ROM_QSTR(MP_QSTR_cast_instance), MP_ROM_PTR(&mp_lv_cast_instance_obj) },
+    { MP_ROM_QSTR(MP_QSTR___dereference__), MP_ROM_PTR(&mp_lv_dereference_obj) },
+    
+};
+
+STATIC MP_DEFINE_CONST_DICT(mp_lv_perf_stats_t_locals_dict, mp_lv_perf_stats_t_locals_dict_table);
+        
+
+STATIC const mp_rom_map_elem_t mp_lv_perf_hist_t_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_SIZE), MP_ROM_PTR(MP_ROM_INT(sizeof(lv_perf_hist_t))) },
+    { MP_ROM_QSTR(MP_QSTR_cast), MP_ROM_PTR(&mp_lv_cast_class_method) },
+    { MP_ROM_QSTR(MP_QSTR_cast_instance), MP_ROM_PTR(&mp_lv_cast_instance_obj) },
+    { MP_ROM_QSTR(MP_QSTR___dereference__), MP_ROM_PTR(&mp_lv_dereference_obj) },
+    
+};
+
+STATIC MP_DEFINE_CONST_DICT(mp_lv_perf_hist_t_locals_dict, mp_lv_perf_hist_t_locals_dict_table);
+        
+
+STATIC const mp_rom_map_elem_t mp_lv_perf_widget_t_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_SIZE), MP_ROM_PTR(MP_ROM_INT(sizeof(lv_perf_widget_t))) },
+    { MP_ROM_QSTR(MP_QSTR_cast), MP_ROM_PTR(&mp_lv_cast_class_method) },
+    { MP_ROM_QSTR(MP_QSTR_cast_instance), MP_ROM_PTR(&mp_lv_cast_instance_obj) },
+    { MP_ROM_QSTR(MP_QSTR___dereference__), MP_ROM_PTR(&mp_lv_dereference_obj) },
+    
+};
+
+STATIC MP_DEFINE_CONST_DICT(mp_lv_perf_widget_t_locals_dict, mp_lv_perf_widget_t_locals_dict_table);
+        
+/* Reusing lv_mem_defrag for lv_perf_reset */
+
+STATIC MP_DEFINE_CONST_LV_FUN_OBJ_STATIC_VAR(mp_lv_perf_reset_obj, 0, mp_lv_mem_defrag, lv_perf_reset);
+    
+
 /*
  * lvgl extension definition for:
  * lv_theme_t *lv_theme_get_act(void)
@@ -26363,6 +26733,24 @@ STATIC void lv_disp_drv_t_wait_cb_callback(struct _disp_drv_t * arg0)
 }
 
 
+/*
+ * Callback function lv_disp_drv_t_copy_cb
+ * bool copy_cb(struct _disp_drv_t *disp_drv, const lv_area_t *area, lv_coord_t dx, lv_coord_t dy)
+ */
+
+STATIC bool lv_disp_drv_t_copy_cb_callback(struct _disp_drv_t * arg0, const lv_area_t * arg1, lv_coord_t arg2, lv_coord_t arg3)
+{
+    mp_obj_t mp_args[4];
+    mp_args[0] = mp_read_ptr_lv_disp_drv_t((void*)arg0);
+    mp_args[1] = mp_read_ptr_lv_area_t((void*)arg1);
+    mp_args[2] = mp_obj_new_int(arg2);
+    mp_args[3] = mp_obj_new_int(arg3);
+    mp_obj_t callbacks = get_callback_dict_from_user_data(arg0->user_data);
+    mp_obj_t callback_result = mp_call_function_n_kw(mp_obj_dict_get(callbacks, MP_OBJ_NEW_QSTR(MP_QSTR_lv_disp_drv_t_copy_cb)) , 4, 0, mp_args);
+    return mp_obj_is_true(callback_result);
+}
+
+
 /*
  * Callback function lv_disp_drv_t_clean_dcache_cb
  * void clean_dcache_cb(struct _disp_drv_t *disp_drv)
@@ -26863,6 +27251,8 @@ STATIC const mp_rom_map_elem_t lvgl_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR_refr_now), MP_ROM_PTR(&mp_lv_refr_now_obj) },
     { MP_ROM_QSTR(MP_QSTR_disp_load_scr), MP_ROM_PTR(&mp_lv_disp_load_scr_obj) },
     { MP_ROM_QSTR(MP_QSTR_scr_load_anim), MP_ROM_PTR(&mp_lv_scr_load_anim_obj) },
+    { MP_ROM_QSTR(MP_QSTR_perf_stats), MP_ROM_PTR(&mp_lv_perf_stats_obj) },
+    { MP_ROM_QSTR(MP_QSTR_perf_reset), MP_ROM_PTR(&mp_lv_perf_reset_obj) },
     { MP_ROM_QSTR(MP_QSTR_theme_get_act), MP_ROM_PTR(&mp_lv_theme_get_act_obj) },
     { MP_ROM_QSTR(MP_QSTR_theme_apply), MP_ROM_PTR(&mp_lv_theme_apply_obj) },
     { MP_ROM_QSTR(MP_QSTR_theme_get_font_small), MP_ROM_PTR(&mp_lv_theme_get_font_small_obj) },
@@ -26989,6 +27379,9 @@ STATIC const mp_rom_map_elem_t lvgl_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR_fs_dir_t), MP_ROM_PTR(&mp_lv_fs_dir_t_type) },
     { MP_ROM_QSTR(MP_QSTR_theme_t), MP_ROM_PTR(&mp_lv_theme_t_type) },
     { MP_ROM_QSTR(MP_QSTR_draw_label_hint_t), MP_ROM_PTR(&mp_lv_draw_label_hint_t_type) },
+    { MP_ROM_QSTR(MP_QSTR_perf_stats_t), MP_ROM_PTR(&mp_lv_perf_stats_t_type) },
+    { MP_ROM_QSTR(MP_QSTR_perf_hist_t), MP_ROM_PTR(&mp_lv_perf_hist_t_type) },
+    { MP_ROM_QSTR(MP_QSTR_perf_widget_t), MP_ROM_PTR(&mp_lv_perf_widget_t_type) },
     
     { MP_ROM_QSTR(MP_QSTR_color_t), MP_ROM_PTR(&mp_lv_color32_t_type) },
     
@@ -33,6 +33,8 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #include <Library/UefiRuntimeServicesTableLib.h>
 #include <lib/timeutils/timeutils.h>
 
+#include "uefi_clock.h"
+
 
 /******************************************************************************
 DECLARE EXPORTED DATA
@@ -41,8 +43,6 @@ const char mpexception_value_invalid_arguments[] = "invalid argument(s) value";
 const char mpexception_num_type_invalid_arguments[] = "invalid argument(s) num/type";
 const char mpexception_uncaught[] = "uncaught exception";
 
-STATIC mp_uint_t   mClockSeconds = 0;
-STATIC mp_uint_t   mClockNanoSeconds = 0;
 
 STATIC mp_obj_t mod_time_time (void)
 {
@@ -68,43 +68,11 @@ STATIC mp_obj_t mod_time_time (void)
 STATIC MP_DEFINE_CONST_FUN_OBJ_0 (mod_time_time_obj, mod_time_time);
 
 // Note: this is deprecated since CPy3.3, but pystone still uses it.
-// This function returns wall-clock seconds elapsed since the first call to this
-// function, as a floating point number, based on the gRT->GetTime().
+// This function returns seconds elapsed since the first use of the monotonic
+// clock. Without float support they are whole seconds.
 STATIC mp_obj_t mod_time_clock (void)
 {
-  EFI_STATUS    Status;
-  EFI_TIME      Time;
-  mp_uint_t     Seconds;
-  mp_uint_t     NanoSeconds;
-
-  Status = gRT->GetTime (&Time, NULL);
-  if (EFI_ERROR (Status)) {
-    return mp_const_none;
-  }
-
-  Seconds = timeutils_seconds_since_2000 (
-              Time.Year,
-              Time.Month,
-              Time.Day,
-              Time.Hour,
-              Time.Minute,
-              Time.Second
-              );
-  NanoSeconds = Time.Nanosecond;
-
-  if (mClockSeconds == 0 && mClockNanoSeconds == 0) {
-    mClockSeconds     = Seconds;
-    mClockNanoSeconds = NanoSeconds;
-  }
-
-  Seconds       -= mClockSeconds;
-  if (NanoSeconds < mClockNanoSeconds) {
-    Seconds     -= 1;
-    NanoSeconds += 1000000000;
-  }
-  NanoSeconds   -= mClockSeconds;
-
-  return mp_obj_new_int_from_uint (Seconds);
+  return mp_obj_new_int_from_ull (UefiClockMilliseconds () / 1000);
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_0 (mod_time_clock_obj, mod_time_clock);
 
@@ -114,7 +82,7 @@ STATIC mp_obj_t time_sleep_ms (mp_obj_t arg)
   /* Delay for given number of milliseconds, should be positive or 0 */
   mp_int_t ms = mp_obj_get_int(arg);
   if (ms > 0) {
-    MicroSecondDelay (ms * 1000);
+    mp_hal_delay_ms (ms);
   }
 
   return mp_const_none;
@@ -127,7 +95,7 @@ STATIC mp_obj_t time_sleep_us (mp_obj_t arg)
   /* Delay for given number of milliseconds, should be positive or 0 */
   mp_int_t us = mp_obj_get_int(arg);
   if (us > 0) {
-    MicroSecondDelay (us);
+    mp_hal_delay_us (us);
   }
 
   return mp_const_none;
@@ -135,42 +103,26 @@ STATIC mp_obj_t time_sleep_us (mp_obj_t arg)
 }
 MP_DEFINE_CONST_FUN_OBJ_1 (mp_utime_sleep_us_obj, time_sleep_us);
 
+//
+// ticks_* wrap at MICROPY_PY_UTIME_TICKS_PERIOD so they stay small ints and
+// ticks_diff/ticks_add work on them. They come from the performance counter,
+// calibrated once, instead of the seconds field of gRT->GetTime().
+//
 STATIC mp_obj_t time_ticks_ms (void)
 {
-  EFI_TIME            Time;
-  EFI_STATUS          Status;
-
-  //
-  // Use the EFI Runtime Services Table to get the current time and data.
-  //
-  Status = gRT->GetTime(&Time, NULL);
-  if (EFI_ERROR (Status)) {
-    return mp_const_none;
-  }
-
-  return MP_OBJ_NEW_SMALL_INT((Time.Second * 1000 + Time.Nanosecond / 1000000));
+  return MP_OBJ_NEW_SMALL_INT (mp_hal_ticks_ms () & (MICROPY_PY_UTIME_TICKS_PERIOD - 1));
 }
 MP_DEFINE_CONST_FUN_OBJ_0 (mp_utime_ticks_ms_obj, time_ticks_ms);
 
-STATIC mp_obj_t time_ticks_us (void) {
-  EFI_TIME            Time;
-  EFI_STATUS          Status;
-
-  //
-  // Use the EFI Runtime Services Table to get the current time and data.
-  //
-  Status = gRT->GetTime(&Time, NULL);
-  if (EFI_ERROR (Status)) {
-    return mp_const_none;
-  }
-
-  return mp_obj_new_int_from_uint(Time.Second * 1000000 + Time.Nanosecond / 1000);
-
+STATIC mp_obj_t time_ticks_us (void)
+{
+  return MP_OBJ_NEW_SMALL_INT (mp_hal_ticks_us () & (MICROPY_PY_UTIME_TICKS_PERIOD - 1));
 }
 MP_DEFINE_CONST_FUN_OBJ_0 (mp_utime_ticks_us_obj, time_ticks_us);
 
-STATIC mp_obj_t time_ticks_cpu (void) {
-  return mp_obj_new_int_from_ull(GetPerformanceCounter());
+STATIC mp_obj_t time_ticks_cpu (void)
+{
+  return MP_OBJ_NEW_SMALL_INT (mp_hal_ticks_cpu () & (MICROPY_PY_UTIME_TICKS_PERIOD - 1));
 }
 MP_DEFINE_CONST_FUN_OBJ_0 (mp_utime_ticks_cpu_obj, time_ticks_cpu);
 
@@ -196,7 +148,7 @@ STATIC mp_obj_t mod_time_sleep (mp_obj_t arg)
   */
   mp_int_t seconds = mp_obj_get_int(arg);
   if (seconds > 0) {
-    MicroSecondDelay(seconds * 1000 * 1000);
+    mp_hal_delay_ms (seconds * 1000);
   }
 
   return mp_const_none;
@@ -0,0 +1,229 @@
+/** @file
+  _uasyncio module for MicroPython: the UEFI event poller under uasyncio.
+
+  The scheduler itself is Lib/uasyncio.py. Whenever no task is ready, it
+  calls poll() here, which halts the CPU in WaitForEvent until the next
+  timer is due or one of the UEFI events that tasks are waiting on (ConIn
+  WaitForKey, pointer WaitForInput, or any event of a script) is signaled.
+
+Copyright (c) 2018, Intel Corporation. All rights reserved.<BR>
+This program and the accompanying materials
+are licensed and made available under the terms and conditions of the BSD License
+which accompanies this distribution.  The full text of the license may be found at
+http://opensource.org/licenses/bsd-license.php
+
+THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+
+**/
+#include <py/mpconfig.h>
+#include <py/nlr.h>
+#include <py/runtime.h>
+#include <py/obj.h>
+#include <py/objlist.h>
+#include <py/objint.h>
+#include <lib/mp-readline/readline.h>
+
+#include <Library/UefiBootServicesTableLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/UefiLib.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+
+#include <Protocol/SimplePointer.h>
+#include <Protocol/AbsolutePointer.h>
+
+#include "objuefi.h"
+#include "uefi_mphal.h"
+#include "upy.h"
+
+#define POLL_MAX_EVENTS   64
+
+STATIC EFI_EVENT    mPollTimer = NULL;
+
+/**
+  Create the poll timer, once.
+
+**/
+STATIC
+VOID
+PollInit (
+  VOID
+  )
+{
+  EFI_STATUS    Status;
+
+  if (mPollTimer == NULL) {
+    Status = gBS->CreateEvent (EVT_TIMER, TPL_CALLBACK, NULL, NULL, &mPollTimer);
+    RAISE_UEFI_EXCEPTION_ON_ERROR (Status);
+  }
+}
+
+/**
+  poll(timeout_ms, events)
+
+  Wait for one of the UEFI events in the list, or for timeout_ms to pass.
+  A negative timeout waits without limit, 0 only checks the events.
+  Ctrl-C raises KeyboardInterrupt.
+
+  @retval Index of the signaled event in the list, -1 on timeout.
+**/
+STATIC mp_obj_t mod_uasyncio_poll (mp_obj_t timeout_in, mp_obj_t events_in)
+{
+  EFI_STATUS    Status;
+  EFI_EVENT     Events[POLL_MAX_EVENTS + 2];
+  EFI_EVENT     BreakEvent;
+  mp_obj_t      *Items;
+  size_t        Length;
+  UINTN         Count;
+  UINTN         Index;
+  mp_int_t      Timeout;
+
+  PollInit ();
+  BreakEvent = UpyBreakEvent ();
+
+  Timeout = mp_obj_get_int (timeout_in);
+  mp_obj_get_array (events_in, &Length, &Items);
+  if (Length > POLL_MAX_EVENTS) {
+    mp_raise_ValueError ("too many events");
+  }
+
+  //
+  // Events[0] is the break event, Events[1] the timer, then the list
+  //
+  Count = 0;
+  if (BreakEvent != NULL) {
+    Events[Count++] = BreakEvent;
+  }
+  Events[Count++] = mPollTimer;
+  for (Index = 0; Index < Length; Index++) {
+    Events[Count++] = (EFI_EVENT)(UINTN)mp_obj_int_get_truncated (Items[Index]);
+  }
+
+  if (Timeout == 0) {
+    for (Index = Count - Length; Index < Count; Index++) {
+      if (!EFI_ERROR (gBS->CheckEvent (Events[Index]))) {
+        break;
+      }
+    }
+  } else {
+    if (Timeout > 0) {
+      Status = gBS->SetTimer (mPollTimer, TimerRelative, EFI_TIMER_PERIOD_MILLISECONDS (Timeout));
+      RAISE_UEFI_EXCEPTION_ON_ERROR (Status);
+    }
+
+    Status = gBS->WaitForEvent (Count, Events, &Index);
+    gBS->SetTimer (mPollTimer, TimerCancel, 0);
+    RAISE_UEFI_EXCEPTION_ON_ERROR (Status);
+  }
+
+  if (BreakEvent != NULL && (Index == 0 || !EFI_ERROR (gBS->CheckEvent (BreakEvent)))) {
+    nlr_raise (mp_obj_new_exception (&mp_type_KeyboardInterrupt));
+  }
+
+  if (Index < Count - Length || Index >= Count) {
+    return MP_OBJ_NEW_SMALL_INT (-1);
+  }
+  return MP_OBJ_NEW_SMALL_INT (Index - (Count - Length));
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2 (mod_uasyncio_poll_obj, mod_uasyncio_poll);
+
+/**
+  start()
+
+  Called when a loop starts. Forget a Ctrl-C typed while no loop was
+  running, e.g. at the REPL, so that it doesn't stop the new loop at once.
+**/
+STATIC mp_obj_t mod_uasyncio_start (void)
+{
+  EFI_EVENT   BreakEvent;
+
+  BreakEvent = UpyBreakEvent ();
+  if (BreakEvent != NULL) {
+    gBS->CheckEvent (BreakEvent);
+  }
+  return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_0 (mod_uasyncio_start_obj, mod_uasyncio_start);
+
+/**
+  conin()
+
+  @retval The WaitForKey event of ConIn.
+**/
+STATIC mp_obj_t mod_uasyncio_conin (void)
+{
+  return mp_obj_new_int_from_uint ((UINTN)gST->ConIn->WaitForKey);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_0 (mod_uasyncio_conin_obj, mod_uasyncio_conin);
+
+/**
+  Append the WaitForInput events of all instances of a pointer protocol.
+
+**/
+STATIC
+VOID
+PollAppendPointers (
+  IN mp_obj_t   List,
+  IN EFI_GUID   *Guid,
+  IN BOOLEAN    Absolute
+  )
+{
+  EFI_STATUS                      Status;
+  EFI_HANDLE                      *Handles;
+  UINTN                           HandleCount;
+  UINTN                           Index;
+  EFI_SIMPLE_POINTER_PROTOCOL     *Simple;
+  EFI_ABSOLUTE_POINTER_PROTOCOL   *Abs;
+
+  Status = gBS->LocateHandleBuffer (ByProtocol, Guid, NULL, &HandleCount, &Handles);
+  if (EFI_ERROR (Status)) {
+    return;
+  }
+
+  for (Index = 0; Index < HandleCount; Index++) {
+    if (Absolute) {
+      Status = gBS->HandleProtocol (Handles[Index], Guid, (VOID **)&Abs);
+      if (!EFI_ERROR (Status)) {
+        mp_obj_list_append (List, mp_obj_new_int_from_uint ((UINTN)Abs->WaitForInput));
+      }
+    } else {
+      Status = gBS->HandleProtocol (Handles[Index], Guid, (VOID **)&Simple);
+      if (!EFI_ERROR (Status)) {
+        mp_obj_list_append (List, mp_obj_new_int_from_uint ((UINTN)Simple->WaitForInput));
+      }
+    }
+  }
+
+  FreePool (Handles);
+}
+
+/**
+  pointers()
+
+  @retval List of the WaitForInput events of all pointer devices.
+**/
+STATIC mp_obj_t mod_uasyncio_pointers (void)
+{
+  mp_obj_t    List;
+
+  List = mp_obj_new_list (0, NULL);
+  PollAppendPointers (List, &gEfiSimplePointerProtocolGuid, FALSE);
+  PollAppendPointers (List, &gEfiAbsolutePointerProtocolGuid, TRUE);
+  return List;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_0 (mod_uasyncio_pointers_obj, mod_uasyncio_pointers);
+
+STATIC const mp_rom_map_elem_t uasyncio_module_globals_table[] = {
+  { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR__uasyncio) },
+  { MP_ROM_QSTR(MP_QSTR_start), MP_ROM_PTR(&mod_uasyncio_start_obj) },
+  { MP_ROM_QSTR(MP_QSTR_poll), MP_ROM_PTR(&mod_uasyncio_poll_obj) },
+  { MP_ROM_QSTR(MP_QSTR_conin), MP_ROM_PTR(&mod_uasyncio_conin_obj) },
+  { MP_ROM_QSTR(MP_QSTR_pointers), MP_ROM_PTR(&mod_uasyncio_pointers_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(uasyncio_module_globals, uasyncio_module_globals_table);
+
+const mp_obj_module_t mp_module__uasyncio = {
+  .base = { &mp_type_module },
+  .globals = (mp_obj_dict_t *)&uasyncio_module_globals,
+};
@@ -109,7 +109,7 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #define MICROPY_PY_IO_FILEIO                      (1)
 #define MICROPY_PY_GC_COLLECT_RETVAL              (1)
 #define MICROPY_PY_DELATTR_SETATTR                (1)
-#define MICROPY_PY_ASYNC_AWAIT                    (0)
+#define MICROPY_PY_ASYNC_AWAIT                    (1)
 
 #define MICROPY_PY_UERRNO               (1)
 #define MICROPY_PY_UZLIB                (1)
@@ -195,6 +195,7 @@ extern const struct _mp_obj_module_t mp_module_machine;
 extern const struct _mp_obj_module_t mp_module__uefi;
 extern const struct _mp_obj_module_t mp_module__ets;
 extern const struct _mp_obj_module_t mp_module__re;
+extern const struct _mp_obj_module_t mp_module__uasyncio;
 
 #define MICROPY_PORT_BUILTIN_MODULES \
     { MP_OBJ_NEW_QSTR(MP_QSTR_uos), (mp_obj_t)&mp_module_os }, \
@@ -205,6 +206,7 @@ extern const struct _mp_obj_module_t mp_module__re;
     { MP_OBJ_NEW_QSTR(MP_QSTR__uefi), (mp_obj_t)&mp_module__uefi }, \
     { MP_OBJ_NEW_QSTR(MP_QSTR__ets), (mp_obj_t)&mp_module__ets }, \
     { MP_OBJ_NEW_QSTR(MP_QSTR__re), (mp_obj_t)&mp_module__re }, \
+    { MP_OBJ_NEW_QSTR(MP_QSTR__uasyncio), (mp_obj_t)&mp_module__uasyncio }, \
     MICROPY_PY_LVGL_DEF \
     MICROPY_PY_LVGL_EFI_DIRECT_DEF
 
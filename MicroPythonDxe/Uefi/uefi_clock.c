@@ -0,0 +1,290 @@
+/** @file
+  Monotonic clock for MicroPython on UEFI, based on the performance counter.
+
+  GetTime() is a slow runtime service with RTC granularity, so all ticks
+  (mp_hal_ticks_*, utime.ticks_*, the LVGL tick) come from TimerLib's
+  performance counter instead. Its frequency is read once; a timer event
+  samples the counter often enough that a wrap is never missed.
+
+Copyright (c) 2018, Intel Corporation. All rights reserved.<BR>
+This program and the accompanying materials
+are licensed and made available under the terms and conditions of the BSD License
+which accompanies this distribution.  The full text of the license may be found at
+http://opensource.org/licenses/bsd-license.php
+
+THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+
+**/
+
+#include "uefi_clock.h"
+
+#ifndef CLOCK_HOST_BUILD
+#include <Library/TimerLib.h>
+#include <Library/UefiBootServicesTableLib.h>
+#endif
+
+/**
+  Set up a clock from the properties of a counter.
+
+  @param  Clock         The clock.
+  @param  StartValue    First value of the counter.
+  @param  EndValue      Last value of the counter before it wraps.
+  @param  Frequency     Counter ticks per second, 0 if unknown.
+  @param  Value         Current value of the counter.
+
+**/
+VOID
+ClockSetup (
+  OUT UEFI_CLOCK  *Clock,
+  IN  UINT64      StartValue,
+  IN  UINT64      EndValue,
+  IN  UINT64      Frequency,
+  IN  UINT64      Value
+  )
+{
+  Clock->StartValue = StartValue;
+  Clock->EndValue   = EndValue;
+  Clock->Frequency  = (Frequency != 0) ? Frequency : 1000000;
+  Clock->LastValue  = Value;
+  Clock->Ticks      = 0;
+}
+
+/**
+  Advance a clock to a new counter value.
+
+  @param  Clock         The clock.
+  @param  Value         Current value of the counter.
+
+  @retval Counter ticks since ClockSetup.
+
+**/
+UINT64
+ClockUpdate (
+  IN OUT UEFI_CLOCK  *Clock,
+  IN     UINT64      Value
+  )
+{
+  UINT64    Delta;
+
+  if (Clock->EndValue >= Clock->StartValue) {
+    if (Value >= Clock->LastValue) {
+      Delta = Value - Clock->LastValue;
+    } else {
+      Delta = (Clock->EndValue - Clock->LastValue) + (Value - Clock->StartValue) + 1;
+    }
+  } else {
+    //
+    // Counting down
+    //
+    if (Value <= Clock->LastValue) {
+      Delta = Clock->LastValue - Value;
+    } else {
+      Delta = (Clock->LastValue - Clock->EndValue) + (Clock->StartValue - Value) + 1;
+    }
+  }
+
+  Clock->LastValue = Value;
+  Clock->Ticks    += Delta;
+  return Clock->Ticks;
+}
+
+/**
+  Convert counter ticks of a clock to another unit without overflowing.
+
+  @param  Clock         The clock.
+  @param  Ticks         Counter ticks.
+  @param  UnitsPerSecond  1000 for milliseconds, 1000000 for microseconds.
+
+  @retval Ticks in the requested unit, rounded down.
+
+**/
+UINT64
+ClockTicksToUnits (
+  IN CONST UEFI_CLOCK  *Clock,
+  IN       UINT64      Ticks,
+  IN       UINT32      UnitsPerSecond
+  )
+{
+  UINT64    Seconds;
+  UINT64    Remainder;
+
+  //
+  // Whole seconds and the rest separately: Ticks * UnitsPerSecond overflows
+  // after a few hours of a GHz counter, Remainder * UnitsPerSecond does not.
+  //
+  Seconds = DivU64x64Remainder (Ticks, Clock->Frequency, &Remainder);
+  return MultU64x32 (Seconds, UnitsPerSecond) +
+         DivU64x64Remainder (MultU64x32 (Remainder, UnitsPerSecond), Clock->Frequency, NULL);
+}
+
+/**
+  Get the time left of a run time measured on a clock.
+
+  @param  Start         The clock when the run started.
+  @param  Now           The clock now.
+  @param  Length        The run time, in the unit of the clock.
+
+  @retval The time left, 0 if the run time elapsed.
+
+**/
+UINT64
+ClockTimeLeft (
+  IN UINT64  Start,
+  IN UINT64  Now,
+  IN UINT64  Length
+  )
+{
+  UINT64    Elapsed;
+
+  Elapsed = Now - Start;
+  return (Elapsed >= Length) ? 0 : Length - Elapsed;
+}
+
+#ifndef CLOCK_HOST_BUILD
+
+STATIC UEFI_CLOCK   mClock;
+STATIC BOOLEAN      mClockReady = FALSE;
+STATIC EFI_EVENT    mClockWrapEvent = NULL;
+
+/**
+  Sample the counter, serialized with the wrap guard timer.
+
+**/
+STATIC
+UINT64
+UefiClockSample (
+  VOID
+  )
+{
+  EFI_TPL   OldTpl;
+  UINT64    Ticks;
+
+  OldTpl = gBS->RaiseTPL (TPL_HIGH_LEVEL);
+  Ticks  = ClockUpdate (&mClock, GetPerformanceCounter ());
+  gBS->RestoreTPL (OldTpl);
+
+  return Ticks;
+}
+
+/**
+  Timer notify sampling the counter before it can wrap twice.
+
+**/
+STATIC
+VOID
+EFIAPI
+UefiClockWrapNotify (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  UefiClockSample ();
+}
+
+/**
+  Read the counter properties once and start the wrap guard if needed.
+
+**/
+STATIC
+VOID
+UefiClockInit (
+  VOID
+  )
+{
+  EFI_STATUS    Status;
+  UINT64        StartValue;
+  UINT64        EndValue;
+  UINT64        Frequency;
+  UINT64        Range;
+  UINT64        WrapMs;
+
+  Frequency = GetPerformanceCounterProperties (&StartValue, &EndValue);
+  ClockSetup (&mClock, StartValue, EndValue, Frequency, GetPerformanceCounter ());
+  mClockReady = TRUE;
+
+  //
+  // A 64 bit TSC does not wrap in practice, but e.g. the 24 bit ACPI timer
+  // wraps every 4.7 seconds: sample it twice per wrap period. The guard runs
+  // at TPL_NOTIFY so that async scripts and other code running at
+  // TPL_CALLBACK can't hold it off for a whole wrap period.
+  //
+  Range  = (EndValue >= StartValue) ? EndValue - StartValue : StartValue - EndValue;
+  WrapMs = ClockTicksToUnits (&mClock, Range, 1000);
+  if (WrapMs < 3600 * 1000) {
+    Status = gBS->CreateEvent (
+                    EVT_TIMER | EVT_NOTIFY_SIGNAL,
+                    TPL_NOTIFY,
+                    UefiClockWrapNotify,
+                    NULL,
+                    &mClockWrapEvent
+                    );
+    if (!EFI_ERROR (Status)) {
+      gBS->SetTimer (mClockWrapEvent, TimerPeriodic, EFI_TIMER_PERIOD_MILLISECONDS (MAX (WrapMs / 2, 1)));
+    }
+  }
+}
+
+/**
+  Get the counter ticks of the monotonic clock since it was first used.
+
+**/
+UINT64
+UefiClockTicks (
+  VOID
+  )
+{
+  if (!mClockReady) {
+    UefiClockInit ();
+  }
+
+  return UefiClockSample ();
+}
+
+/**
+  Get the counter ticks per second of the monotonic clock.
+
+**/
+UINT64
+UefiClockFrequency (
+  VOID
+  )
+{
+  if (!mClockReady) {
+    UefiClockInit ();
+  }
+
+  return mClock.Frequency;
+}
+
+/**
+  Get the microseconds of the monotonic clock since it was first used.
+
+**/
+UINT64
+UefiClockMicroseconds (
+  VOID
+  )
+{
+  UINT64    Ticks;
+
+  Ticks = UefiClockTicks ();
+  return ClockTicksToUnits (&mClock, Ticks, 1000000);
+}
+
+/**
+  Get the milliseconds of the monotonic clock since it was first used.
+
+**/
+UINT64
+UefiClockMilliseconds (
+  VOID
+  )
+{
+  UINT64    Ticks;
+
+  Ticks = UefiClockTicks ();
+  return ClockTicksToUnits (&mClock, Ticks, 1000);
+}
+
+#endif
@@ -0,0 +1,156 @@
+/** @file
+  Monotonic clock for MicroPython on UEFI, based on the performance counter.
+
+Copyright (c) 2018, Intel Corporation. All rights reserved.<BR>
+This program and the accompanying materials
+are licensed and made available under the terms and conditions of the BSD License
+which accompanies this distribution.  The full text of the license may be found at
+http://opensource.org/licenses/bsd-license.php
+
+THE PROGRAM IS DISTRIBUTED UNDER THE BSD LICENSE ON AN "AS IS" BASIS,
+WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
+
+**/
+
+#ifndef   UEFI_CLOCK_H
+#define   UEFI_CLOCK_H
+
+#ifdef CLOCK_HOST_BUILD
+#include "HostTest/HostUefi.h"
+#else
+#include <Uefi.h>
+#include <Library/BaseLib.h>
+#endif
+
+//
+// State of a performance counter turned into a monotonic 64 bit tick count.
+// The raw counter may count up or down and may wrap around; it has to be
+// sampled at least once per wrap period (UefiClockInit arranges that).
+//
+typedef struct {
+  UINT64    StartValue;   // First value of the counter
+  UINT64    EndValue;     // Last value before it wraps to StartValue
+  UINT64    Frequency;    // Counter ticks per second
+  UINT64    LastValue;    // Raw counter at the previous update
+  UINT64    Ticks;        // Counter ticks since the clock was set up
+} UEFI_CLOCK;
+
+/**
+  Set up a clock from the properties of a counter.
+
+  @param  Clock         The clock.
+  @param  StartValue    First value of the counter.
+  @param  EndValue      Last value of the counter before it wraps.
+  @param  Frequency     Counter ticks per second, 0 if unknown.
+  @param  Value         Current value of the counter.
+
+**/
+VOID
+ClockSetup (
+  OUT UEFI_CLOCK  *Clock,
+  IN  UINT64      StartValue,
+  IN  UINT64      EndValue,
+  IN  UINT64      Frequency,
+  IN  UINT64      Value
+  );
+
+/**
+  Advance a clock to a new counter value.
+
+  @param  Clock         The clock.
+  @param  Value         Current value of the counter.
+
+  @retval Counter ticks since ClockSetup.
+
+**/
+UINT64
+ClockUpdate (
+  IN OUT UEFI_CLOCK  *Clock,
+  IN     UINT64      Value
+  );
+
+/**
+  Convert counter ticks of a clock to another unit without overflowing.
+
+  @param  Clock         The clock.
+  @param  Ticks         Counter ticks.
+  @param  UnitsPerSecond  1000 for milliseconds, 1000000 for microseconds.
+
+  @retval Ticks in the requested unit, rounded down.
+
+**/
+UINT64
+ClockTicksToUnits (
+  IN CONST UEFI_CLOCK  *Clock,
+  IN       UINT64      Ticks,
+  IN       UINT32      UnitsPerSecond
+  );
+
+/**
+  Get the time left of a run time measured on a clock.
+
+  @param  Start         The clock when the run started.
+  @param  Now           The clock now.
+  @param  Length        The run time, in the unit of the clock.
+
+  @retval The time left, 0 if the run time elapsed.
+
+**/
+UINT64
+ClockTimeLeft (
+  IN UINT64  Start,
+  IN UINT64  Now,
+  IN UINT64  Length
+  );
+
+#ifndef CLOCK_HOST_BUILD
+
+/**
+  Get the counter ticks of the monotonic clock since it was first used.
+
+**/
+UINT64
+UefiClockTicks (
+  VOID
+  );
+
+/**
+  Get the counter ticks per second of the monotonic clock.
+
+**/
+UINT64
+UefiClockFrequency (
+  VOID
+  );
+
+/**
+  Get the microseconds of the monotonic clock since it was first used.
+
+**/
+UINT64
+UefiClockMicroseconds (
+  VOID
+  );
+
+/**
+  Get the milliseconds of the monotonic clock since it was first used.
+
+**/
+UINT64
+UefiClockMilliseconds (
+  VOID
+  );
+
+//
+// LVGL reads its tick from here (LV_TICK_CUSTOM in lv_conf.h)
+//
+#define UEFI_CLOCK_LV_TICK()  ((uint32_t)UefiClockMilliseconds ())
+
+//
+// LVGL's refresh statistics read microseconds from here (LV_PERF_TIME_CUSTOM in lv_conf.h)
+//
+#define UEFI_CLOCK_LV_PERF_TIME()  ((uint32_t)UefiClockMicroseconds ())
+
+#endif
+
+#endif
@@ -25,8 +25,39 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #include <Library/DebugLib.h>
 #include <Library/UefiBootServicesTableLib.h>
 #include <Library/MemoryAllocationLib.h>
+#include <Library/TimerLib.h>
+#include <Library/BaseMemoryLib.h>
+
+#include <Protocol/SimpleTextInEx.h>
 
 #include "upy.h"
+#include "uefi_clock.h"
+
+//
+// Sleeps shorter than this are stalled. Longer ones wait on a timer event
+// and only stall the last part, since the timer fires at the granularity of
+// the platform timer tick (often 1 to 10 ms).
+//
+#define SLEEP_SPIN_US   2000
+
+//
+// Without a timer event, or where WaitForEvent is not allowed (above
+// TPL_APPLICATION), the sleep is stalled in slices of this length and an
+// exception to raise or a Ctrl-C still ends it early.
+//
+#define SLEEP_SLICE_US  1000
+
+STATIC EFI_EVENT      mSleepTimer = NULL;
+//
+// Ctrl-C is reported as the control character or as 'c' with either
+// control key, so three key notifies signal the break event
+//
+#define BREAK_NOTIFY_MAX  3
+
+STATIC EFI_EVENT      mBreakEvent = NULL;
+STATIC BOOLEAN        mBreakReady = FALSE;
+STATIC EFI_SIMPLE_TEXT_INPUT_EX_PROTOCOL  *mBreakTextInputEx = NULL;
+STATIC VOID           *mBreakNotify[BREAK_NOTIFY_MAX];
 
 void mp_hal_set_interrupt_char(char c) {
   // configure terminal settings to (not) let ctrl-C through
@@ -107,7 +138,210 @@ void mp_hal_stdout_tx_str(const char *str) {
 }
 
 mp_uint_t mp_hal_ticks_ms(void) {
-  return 0;
+  return (mp_uint_t)UefiClockMilliseconds ();
+}
+
+mp_uint_t mp_hal_ticks_us(void) {
+  return (mp_uint_t)UefiClockMicroseconds ();
+}
+
+mp_uint_t mp_hal_ticks_cpu(void) {
+  return (mp_uint_t)UefiClockTicks ();
+}
+
+/**
+  Key notify for Ctrl-C: signal the break event.
+
+  The key stays in the ConIn buffer, so neither stdin, a task reading keys
+  nor the keyboard of efidirect loses it.
+
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+BreakNotify (
+  IN EFI_KEY_DATA   *KeyData
+  )
+{
+  gBS->SignalEvent (mBreakEvent);
+  return EFI_SUCCESS;
+}
+
+/**
+  Get the event signaled when Ctrl-C is typed on ConIn.
+
+  The key notify is registered on the first call.
+
+  @retval The break event, NULL if ConIn has no SimpleTextInputEx.
+
+**/
+EFI_EVENT
+UpyBreakEvent (
+  VOID
+  )
+{
+  EFI_STATUS                          Status;
+  EFI_SIMPLE_TEXT_INPUT_EX_PROTOCOL   *TextInputEx;
+  EFI_KEY_DATA                        KeyData;
+
+  if (mBreakReady) {
+    return mBreakEvent;
+  }
+  mBreakReady = TRUE;
+
+  Status = gBS->HandleProtocol (gST->ConsoleInHandle, &gEfiSimpleTextInputExProtocolGuid, (VOID **)&TextInputEx);
+  if (EFI_ERROR (Status)) {
+    return NULL;
+  }
+
+  Status = gBS->CreateEvent (0, TPL_CALLBACK, NULL, NULL, &mBreakEvent);
+  if (EFI_ERROR (Status)) {
+    mBreakEvent = NULL;
+    return NULL;
+  }
+
+  mBreakTextInputEx = TextInputEx;
+  ZeroMem (mBreakNotify, sizeof (mBreakNotify));
+
+  ZeroMem (&KeyData, sizeof (KeyData));
+  KeyData.Key.UnicodeChar = CHAR_CTRL_C;
+  TextInputEx->RegisterKeyNotify (TextInputEx, &KeyData, BreakNotify, &mBreakNotify[0]);
+
+  KeyData.Key.UnicodeChar = L'c';
+  KeyData.KeyState.KeyShiftState = EFI_SHIFT_STATE_VALID | EFI_LEFT_CONTROL_PRESSED;
+  TextInputEx->RegisterKeyNotify (TextInputEx, &KeyData, BreakNotify, &mBreakNotify[1]);
+
+  KeyData.KeyState.KeyShiftState = EFI_SHIFT_STATE_VALID | EFI_RIGHT_CONTROL_PRESSED;
+  TextInputEx->RegisterKeyNotify (TextInputEx, &KeyData, BreakNotify, &mBreakNotify[2]);
+
+  return mBreakEvent;
+}
+
+/**
+  Unregister the Ctrl-C key notifies and close the break event.
+
+**/
+VOID
+UpyBreakDeinit (
+  VOID
+  )
+{
+  UINTN   Index;
+
+  if (mBreakTextInputEx != NULL) {
+    for (Index = 0; Index < BREAK_NOTIFY_MAX; Index++) {
+      if (mBreakNotify[Index] != NULL) {
+        mBreakTextInputEx->UnregisterKeyNotify (mBreakTextInputEx, mBreakNotify[Index]);
+        mBreakNotify[Index] = NULL;
+      }
+    }
+    mBreakTextInputEx = NULL;
+  }
+
+  if (mBreakEvent != NULL) {
+    gBS->CloseEvent (mBreakEvent);
+    mBreakEvent = NULL;
+  }
+
+  mBreakReady = FALSE;
+}
+
+/**
+  Sleep without keeping the CPU busy.
+
+  The CPU is halted in WaitForEvent until a one-shot timer or Ctrl-C wakes
+  it up, only the remainder below SLEEP_SPIN_US is stalled. Other keys are left
+  in ConIn.
+
+  @param  Us    Microseconds to sleep.
+
+**/
+STATIC
+VOID
+SleepUs (
+  IN UINT64   Us
+  )
+{
+  EFI_STATUS    Status;
+  EFI_EVENT     Events[2];
+  UINTN         Count;
+  UINTN         Index;
+  UINT64        End;
+  UINT64        Now;
+
+  if (Us == 0) {
+    return;
+  }
+
+  if (mSleepTimer == NULL) {
+    Status = gBS->CreateEvent (EVT_TIMER, TPL_CALLBACK, NULL, NULL, &mSleepTimer);
+    if (EFI_ERROR (Status)) {
+      mSleepTimer = NULL;
+    }
+  }
+
+  //
+  // Only a Ctrl-C typed during the sleep interrupts it, drop an older one
+  //
+  Events[0] = mSleepTimer;
+  Events[1] = UpyBreakEvent ();
+  Count     = 1;
+  if (Events[1] != NULL) {
+    gBS->CheckEvent (Events[1]);
+    Count = 2;
+  }
+
+  Now = UefiClockMicroseconds ();
+  End = Now + Us;
+
+  while (mSleepTimer != NULL && Now + SLEEP_SPIN_US <= End) {
+    //
+    // Stop early if the VM has an exception to raise
+    //
+    if (MP_STATE_VM (mp_pending_exception) != MP_OBJ_NULL) {
+      return;
+    }
+
+    //
+    // EFI timer periods are in 100 ns units
+    //
+    Status = gBS->SetTimer (mSleepTimer, TimerRelative, MultU64x32 (End - Now - SLEEP_SPIN_US / 2, 10));
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+
+    Status = gBS->WaitForEvent (Count, Events, &Index);
+    gBS->SetTimer (mSleepTimer, TimerCancel, 0);
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+
+    if (Index == 1) {
+      nlr_raise (mp_obj_new_exception (&mp_type_KeyboardInterrupt));
+    }
+
+    Now = UefiClockMicroseconds ();
+  }
+
+  while (End > Now) {
+    if (MP_STATE_VM (mp_pending_exception) != MP_OBJ_NULL) {
+      return;
+    }
+    if (Count == 2 && gBS->CheckEvent (Events[1]) == EFI_SUCCESS) {
+      nlr_raise (mp_obj_new_exception (&mp_type_KeyboardInterrupt));
+    }
+
+    gBS->Stall ((UINTN)MIN (End - Now, SLEEP_SLICE_US));
+    Now = UefiClockMicroseconds ();
+  }
+}
+
+void mp_hal_delay_ms(mp_uint_t ms) {
+  SleepUs (MultU64x32 (ms, 1000));
+}
+
+void mp_hal_delay_us(mp_uint_t us) {
+  SleepUs (us);
 }
 
 #include <Library/UefiBootServicesTableLib.h>
@@ -26,8 +26,8 @@ void mp_hal_erase_line_from_cursor(uint n_chars_to_erase);
 void mp_hal_set_interrupt_char(char c);
 void mp_hal_stdio_mode_raw(void);
 void mp_hal_stdio_mode_orig(void);
-
-static inline void mp_hal_delay_ms(mp_uint_t ms) { usleep((ms) * 1000); }
+void mp_hal_delay_ms(mp_uint_t ms);
+void mp_hal_delay_us(mp_uint_t us);
 
 #define RAISE_ERRNO(err_flag, error_val) \
     { if (err_flag) \
@@ -71,6 +71,38 @@ UseDeinit (
   VOID
 );
 
+/**
+  Scan the stacks and saved VM state of the suspended async scripts for the
+  garbage collector. Called by gc_collect().
+
+**/
+VOID
+UpyGcCollectScripts (
+  VOID
+);
+
+/**
+  Get the event signaled when Ctrl-C is typed on ConIn.
+
+  The key notify is registered on the first call.
+
+  @retval The break event, NULL if ConIn has no SimpleTextInputEx.
+
+**/
+EFI_EVENT
+UpyBreakEvent (
+  VOID
+);
+
+/**
+  Unregister the Ctrl-C key notifies and close the break event.
+
+**/
+VOID
+UpyBreakDeinit (
+  VOID
+);
+
 /**
   Initialize and install the script file protocol.
 
@@ -44,24 +44,44 @@ WITHOUT WARRANTIES OR REPRESENTATIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED.
 #include "genhdr/mpversion.h"
 #include "upy.h"
 #include "repl.h"
+#include "uefi_clock.h"
 
-#define UPY_ASYNC_EXEC_TIMER_INTERVAL   ((100 * 1000 * 1000) / 100) // 100ms in 100ns unit
+#define UPY_ASYNC_EXEC_DEFAULT_DELAY    100   // ms
+#define UPY_MAX_SCRIPTS                 8
 
 #define UPY_PRIVATE_DATA_FROM_SEP(a)    \
           CR (a, UPY_PRIVATE_DATA, ScriptEngine, EFI_SCRIPT_ENGINE_TYPE_MICROPYTHON)
 
+//
+// One script in execution. All scripts share the interpreter and its heap,
+// each one has its own stack, jump buffer and VM thread state (NLR chain,
+// globals, stack limits), which are swapped in when it is resumed.
+//
+typedef struct {
+  BOOLEAN                         InUse;
+  BOOLEAN                         IsRunning;      // Started on its own stack
+  BOOLEAN                         Async;
+  UINT8                           *Script;
+  UINTN                           ScriptLength;
+  BASE_LIBRARY_JUMP_BUFFER        ScriptEngineContext;
+  VOID                            *ScriptEngineStack;
+  UINTN                           ScriptEngineStackSize;
+  mp_state_thread_t               ThreadState;
+  UINT64                          Deadline;       // When to resume it, in ms
+  EFI_STATUS                      ExecStatus;
+} UPY_SCRIPT_CONTEXT;
+
 typedef struct {
   EFI_HANDLE                      Handle;
   EFI_EVENT                       ExecEvent;
   EFI_STATUS                      ExecStatus;
   EFI_SCRIPT_ENGINE_PROTOCOL      *ScriptEngineProtocol;
   EFI_SCRIPT_FILE_PROTOCOL        *ScriptFileProtocol;
-  UINT8                           *Script;
-  UINTN                           ScriptLength;
   BASE_LIBRARY_JUMP_BUFFER        ExecutorContext;
-  BASE_LIBRARY_JUMP_BUFFER        ScriptEngineContext;
-  VOID                            *ScriptEngineStack;
-  UINTN                           ScriptEngineStackSize;
+  UPY_SCRIPT_CONTEXT              Scripts[UPY_MAX_SCRIPTS];
+  UPY_SCRIPT_CONTEXT              *Current;
+  UINTN                           LastIndex;      // Round robin position
+  UINTN                           ScriptCount;
   BOOLEAN                         IsRunning;
   BOOLEAN                         DeinitAfterwards;
 } UPY_EXECUTOR_DATA;
@@ -275,6 +295,7 @@ UpyInit (
   CHAR16                      *CurDir;
   CHAR8                       *AscPath;
   UINTN                       Length;
+  vstr_t                      LibPath;
 
 
   CurDir = NULL;
@@ -362,6 +383,14 @@ UpyInit (
   AscPath = UnicodeToUtf8(ImageFilePath, NULL, &Length);
   mp_obj_list_append(mp_sys_path, mp_obj_new_str(AscPath, (size_t)Length));
 
+  //
+  // And its Lib directory, for top level library modules like uasyncio
+  //
+  vstr_init(&LibPath, Length + 5);
+  vstr_add_strn(&LibPath, AscPath, Length);
+  vstr_add_str(&LibPath, "/Lib");
+  mp_obj_list_append(mp_sys_path, mp_obj_new_str_from_vstr(&mp_type_str, &LibPath));
+
   FREE_NON_NULL (AscPath);
   FREE_NON_NULL (ImageFilePath);
 
@@ -457,25 +486,206 @@ DoMpy (
   return 0;
 }
 
+/**
+  Allocate a script context with its own stack.
+
+  @param  Source    The script, NULL for the REPL.
+  @param  Length    Length of the script.
+  @param  Async     Whether the script runs from the scheduler timer.
+
+  @retval The context, or NULL if the table is full or out of memory.
+**/
+STATIC
+UPY_SCRIPT_CONTEXT *
+UpyNewScript (
+  UINT8       *Source,
+  UINTN       Length,
+  BOOLEAN     Async
+)
+{
+  UPY_SCRIPT_CONTEXT    *Script;
+  UINTN                 Index;
+
+  for (Index = 0; Index < UPY_MAX_SCRIPTS; Index++) {
+    Script = &mExecutorData.Scripts[Index];
+    if (!Script->InUse) {
+      break;
+    }
+  }
+  if (Index == UPY_MAX_SCRIPTS) {
+    return NULL;
+  }
+
+  ZeroMem (Script, sizeof (*Script));
+
+  //
+  // Use separate stack for MicroPython.
+  //
+  Script->ScriptEngineStackSize = mStackSize;
+  Script->ScriptEngineStack = AllocateAlignedPages(
+                                EFI_SIZE_TO_PAGES (Script->ScriptEngineStackSize),
+                                CPU_STACK_ALIGNMENT
+                                );
+  if (Script->ScriptEngineStack == NULL) {
+    return NULL;
+  }
+
+  Script->InUse = TRUE;
+  Script->Async = Async;
+  Script->Script = Source;
+  Script->ScriptLength = Length;
+  mExecutorData.ScriptCount++;
+
+  return Script;
+}
+
+/**
+  Release a script context and its stack.
+**/
+STATIC
+VOID
+UpyFreeScript (
+  UPY_SCRIPT_CONTEXT    *Script
+)
+{
+  if (Script->ScriptEngineStack != NULL) {
+    FreeAlignedPages(
+      Script->ScriptEngineStack,
+      EFI_SIZE_TO_PAGES (Script->ScriptEngineStackSize)
+      );
+  }
+
+  ZeroMem (Script, sizeof (*Script));
+  mExecutorData.ScriptCount--;
+}
+
+/**
+  Pick the async script to resume: the one whose deadline passed first.
+  Scripts due at the same time are taken round robin.
+
+  @param  Now       Current time in ms.
+
+  @retval The script to run, or NULL if none is due.
+**/
+STATIC
+UPY_SCRIPT_CONTEXT *
+UpyPickScript (
+  UINT64      Now
+)
+{
+  UPY_SCRIPT_CONTEXT    *Script;
+  UPY_SCRIPT_CONTEXT    *Best;
+  UINTN                 Count;
+  UINTN                 Index;
+
+  Best = NULL;
+  for (Count = 1; Count <= UPY_MAX_SCRIPTS; Count++) {
+    Index = (mExecutorData.LastIndex + Count) % UPY_MAX_SCRIPTS;
+    Script = &mExecutorData.Scripts[Index];
+    if (!Script->InUse || !Script->Async || Script->Deadline > Now) {
+      continue;
+    }
+    if (Best == NULL || Script->Deadline < Best->Deadline) {
+      Best = Script;
+      mExecutorData.LastIndex = Index;
+    }
+  }
+
+  return Best;
+}
+
+/**
+  Set the scheduler timer to the earliest deadline of the async scripts.
+**/
+STATIC
+VOID
+UpyArmScheduler (
+  VOID
+)
+{
+  EFI_STATUS    Status;
+  UINT64        Now;
+  UINT64        Deadline;
+  UINTN         Index;
+
+  Deadline = MAX_UINT64;
+  for (Index = 0; Index < UPY_MAX_SCRIPTS; Index++) {
+    if (mExecutorData.Scripts[Index].InUse && mExecutorData.Scripts[Index].Async) {
+      Deadline = MIN (Deadline, mExecutorData.Scripts[Index].Deadline);
+    }
+  }
+  if (Deadline == MAX_UINT64 || mExecutorData.ExecEvent == NULL) {
+    return;
+  }
+
+  //
+  // A relative trigger time of 0 would cancel the timer
+  //
+  Now = UefiClockMilliseconds ();
+  Status = gBS->SetTimer(
+                  mExecutorData.ExecEvent,
+                  TimerRelative,
+                  (Deadline > Now) ? MultU64x32 (Deadline - Now, 10 * 1000) : 1
+                  );
+  ASSERT_EFI_ERROR(Status);
+}
+
+/**
+  Scan the stacks and saved VM state of the suspended scripts for the GC.
+
+  The running script is covered by gc_collect() itself.
+**/
+VOID
+UpyGcCollectScripts (
+  VOID
+)
+{
+  UPY_SCRIPT_CONTEXT    *Script;
+  UINTN                 Index;
+
+  for (Index = 0; Index < UPY_MAX_SCRIPTS; Index++) {
+    Script = &mExecutorData.Scripts[Index];
+    if (!Script->InUse || !Script->IsRunning || Script == mExecutorData.Current) {
+      continue;
+    }
+
+    gc_collect_root (
+      (void **)Script->ScriptEngineStack,
+      Script->ScriptEngineStackSize / sizeof (void *)
+      );
+    gc_collect_root (
+      (void **)&Script->ThreadState,
+      sizeof (Script->ThreadState) / sizeof (void *)
+      );
+    gc_collect_root (
+      (void **)&Script->ScriptEngineContext,
+      sizeof (Script->ScriptEngineContext) / sizeof (void *)
+      );
+  }
+}
+
 /**
   Save MicroPython execution context and jump back to UEFI context.
 
   This method is used by MicroPython to proactively release its control to UEFI
   code. The value passed to UEFI code is the time (in milliseconds) used to tell
-  UEFI code when it should return the control back to MicroPython.
+  UEFI code when it should return the control back to MicroPython. Meanwhile
+  the other async scripts which are due get their turn.
 **/
 mp_obj_t
 UpySuspend (
   mp_obj_t    ms
 )
 {
-  UINTN   time = (UINTN)mp_obj_get_int(ms);
+  UINTN               time = (UINTN)mp_obj_get_int(ms);
+  UPY_SCRIPT_CONTEXT  *Script;
 
-  if (mExecutorData.ExecEvent == NULL) {
+  Script = mExecutorData.Current;
+  if (Script == NULL || !Script->Async) {
     mp_raise_msg(&mp_type_RuntimeError, "Current interpreter is not running in async mode.");
   }
 
-  if (SetJump(&mExecutorData.ScriptEngineContext) == 0) {
+  if (SetJump(&Script->ScriptEngineContext) == 0) {
     //
     // Use LongJump to pass time value (in higher 24-bit or 56-bit)
     //
@@ -491,12 +701,11 @@ UpySuspend (
 /**
   Entry method of MicroPython interpreter.
 
-  This is basically the timer event handler in async mode. In normal mode,
-  it's called directly with parameters of NULL value.
+  This is called on the own stack of the current script context, by
+  ScriptExecutor() both in async and normal mode.
 
-  @param[in]  Event       Event whose notification function is being invoked.
-  @param[in]  Context     The pointer to the notification function's context,
-                          which is implementation-dependent.
+  @param[in]  This        A pointer to the EFI_SCRIPT_ENGINE_PROTOCOL instance.
+  @param[in]  Source      The script to execute, NULL for the REPL.
 
 **/
 EFI_STATUS
@@ -507,25 +716,42 @@ UpyDoScript (
 )
 {
   EFI_STATUS          Status;
+  UPY_SCRIPT_CONTEXT  *Script;
+  mp_obj_dict_t       *Globals;
+
+  Script = mExecutorData.Current;
+  if (Script != NULL) {
+    mp_stack_set_top((UINT8 *)Script->ScriptEngineStack +
+                     Script->ScriptEngineStackSize);
+    //
+    // MicroPython's stack check cannot take the code of UEFI part into
+    // account. We should not set the limit to the whole stack but just
+    // MicroPython part.
+    //
+    mp_stack_set_limit (mStackSize);
 
-  if (mExecutorData.ScriptEngineStack != NULL) {
-    if (!mExecutorData.IsRunning) {
-      mp_stack_set_top((UINT8 *)mExecutorData.ScriptEngineStack +
-                       mExecutorData.ScriptEngineStackSize);
-      //
-      // MicroPython's stack check cannot take the code of UEFI part into
-      // account. We should not set the limit to the whole stack but just
-      // MicroPython part.
-      //
-      mp_stack_set_limit (mStackSize);
+    //
+    // The NLR chain of a suspended script lives on its own stack
+    //
+    MP_STATE_THREAD(nlr_top) = NULL;
+
+    //
+    // The first script uses __main__ as before, concurrent ones get a
+    // namespace of their own so they do not overwrite each other's globals
+    //
+    if (mExecutorData.ScriptCount > 1) {
+      Globals = mp_obj_new_dict(1);
+      mp_obj_dict_store(MP_OBJ_FROM_PTR(Globals), MP_OBJ_NEW_QSTR(MP_QSTR___name__), MP_OBJ_NEW_QSTR(MP_QSTR___main__));
+    } else {
+      Globals = &MP_STATE_VM(dict_main);
     }
+    mp_globals_set(Globals);
+    mp_locals_set(Globals);
   } else {
     mp_stack_ctrl_init();
     mp_stack_set_limit (mStackSize);
   }
 
-  mExecutorData.IsRunning = TRUE;
-
   // Header of compiled Python script contains
   //  byte  'M'
   //  byte  version
@@ -558,11 +784,12 @@ UpyDoScript (
   gc_collect();
 
   //
-  // Normal exit from script interpreter. For asynchronous execution, we need
-  // to LongJump back to timer event handler.
+  // Normal exit from script interpreter. LongJump back to the executor which
+  // switched to the stack of this script.
   //
   mExecutorData.ExecStatus = Status;
-  if (mExecutorData.ScriptEngineStack != NULL) {
+  if (Script != NULL) {
+    Script->ExecStatus = Status;
     LongJump(&mExecutorData.ExecutorContext, 2);
   }
 
@@ -572,8 +799,10 @@ UpyDoScript (
 /**
   Helper method used primarily for async execution mode for MicroPython.
 
-  This is the handler of timer event in async mode. In normal mode, it's called
-  directly with parameters of NULL value.
+  This is the handler of timer event in async mode: it resumes the async
+  script which is due, or starts it on its own stack, until the script
+  suspends itself or ends. In normal mode, it's called directly with
+  parameters of NULL value and runs mExecutorData.Current to its end.
 
   @param[in]  Event       Event whose notification function is being invoked.
   @param[in]  Context     The pointer to the notification function's context,
@@ -587,62 +816,72 @@ ScriptExecutor (
   IN VOID             *Context
 )
 {
-  EFI_STATUS      Status;
-  UINTN           Value;
+  UINTN               Value;
+  UPY_SCRIPT_CONTEXT  *Script;
 
   Value = SetJump(&mExecutorData.ExecutorContext);
   switch (Value & 0xF) {
   case 0:
     // Normal return from just above call of SetJump().
     DEBUG((DEBUG_INFO, "ScriptExecutor(): SetJump => 0: return from saving jump context\r\n"));
+    if (Event != NULL) {
+      Script = UpyPickScript (UefiClockMilliseconds ());
+      if (Script == NULL) {
+        UpyArmScheduler ();
+        break;
+      }
+      mExecutorData.Current = Script;
+    } else {
+      Script = mExecutorData.Current;
+    }
+
     //
-    // If it's the first time to launch the script engine, we must preprare a
+    // If it's the first time to launch the script, we must preprare a
     // standalone stack for it in order to avoid using the stack of current
     // function, because this timer event handler has to exit, when necessary,
     // to give a chance to other modules to run.
     //
-    if (!mExecutorData.IsRunning && mExecutorData.ScriptEngineProtocol != NULL) {
+    if (!Script->IsRunning) {
+      Script->IsRunning = TRUE;
       // Use SwitchStack to call the entry of script engine
       SwitchStack(
         (SWITCH_STACK_ENTRY_POINT)UpyDoScript,
         mExecutorData.ScriptEngineProtocol,
-        mExecutorData.Script,
-        (UINT8 *)mExecutorData.ScriptEngineStack +
-        mExecutorData.ScriptEngineStackSize
+        Script->Script,
+        (UINT8 *)Script->ScriptEngineStack +
+        Script->ScriptEngineStackSize
         );
     } else {
       // Simply restore the execution of script engine if it's still running.
-      LongJump(&mExecutorData.ScriptEngineContext, 1);
+      CopyMem (&mp_state_ctx.thread, &Script->ThreadState, sizeof (Script->ThreadState));
+      LongJump(&Script->ScriptEngineContext, 1);
     }
     break;
 
   case 1:
     // LongJump() return from the middle execution of script interpreter.
     // It means interpreter relinguish its contol of processor temporarily.
-    // Do nothing special but wait for another timer expiration.
+    // Keep its VM state and let the due scripts run in turn.
     DEBUG((DEBUG_INFO, "ScriptExecutor(): SetJump => 1: yield from script engine\r\n"));
+    Script = mExecutorData.Current;
+    CopyMem (&Script->ThreadState, &mp_state_ctx.thread, sizeof (Script->ThreadState));
 
     // Value returned by LongJump may contain the delay time value for another re-entry.
     Value = Value >> 8;
-    Value = (Value == 0) ? UPY_ASYNC_EXEC_TIMER_INTERVAL : (Value * 1000 * 10);
-    Status = gBS->SetTimer(
-                    mExecutorData.ExecEvent,
-                    TimerRelative,
-                    Value
-                    );
-    ASSERT_EFI_ERROR(Status);
+    Script->Deadline = UefiClockMilliseconds () + ((Value == 0) ? UPY_ASYNC_EXEC_DEFAULT_DELAY : Value);
+    mExecutorData.Current = NULL;
+    UpyArmScheduler ();
     break;
 
   default:
     // Exeuction of interpreter done. Let's do clean-up.
     DEBUG((DEBUG_INFO, "ScriptExecutor(): SetJump => %d: exit from script engine\r\n", Value));
-    if (mExecutorData.ScriptEngineStack != NULL) {
-      FreeAlignedPages(
-        mExecutorData.ScriptEngineStack,
-        EFI_SIZE_TO_PAGES (mExecutorData.ScriptEngineStackSize)
-        );
-      mExecutorData.ScriptEngineStack = NULL;
-      mExecutorData.ScriptEngineStackSize = 0;
+    UpyFreeScript (mExecutorData.Current);
+    mExecutorData.Current = NULL;
+
+    if (mExecutorData.ScriptCount > 0) {
+      UpyArmScheduler ();
+      break;
     }
 
     if (mExecutorData.DeinitAfterwards) {
@@ -688,8 +927,9 @@ UpyGetType (
 
   @retval EFI_SUCCESS           The script is lauched successfully.
   @retval EFI_LOAD_ERROR        The script is lauched with error.
-  @retval EFI_ALREADY_STARTED   There's another script in running.
-  @retval EFI_OUT_OF_RESOURCES  Not enough resource to start the script engine.
+  @retval EFI_ALREADY_STARTED   There's a script running in normal mode.
+  @retval EFI_OUT_OF_RESOURCES  Not enough resource to start the script engine,
+                                or UPY_MAX_SCRIPTS scripts are running already.
 
 **/
 EFI_STATUS
@@ -702,12 +942,17 @@ UpyExecuteAsync (
 )
 {
   EFI_STATUS          Status;
+  UPY_SCRIPT_CONTEXT  *Script;
 
   if (Source == NULL || Length == 0) {
     return EFI_INVALID_PARAMETER;
   }
 
-  if (mExecutorData.IsRunning) {
+  //
+  // Async scripts run side by side, but not along with a script in normal
+  // mode: that one is not on the scheduler and may be preempted anywhere.
+  //
+  if (mExecutorData.Current != NULL && !mExecutorData.Current->Async) {
     return EFI_ALREADY_STARTED;
   }
 
@@ -716,46 +961,43 @@ UpyExecuteAsync (
     mExecutorData.ScriptEngineProtocol = This;
   }
 
-  mExecutorData.DeinitAfterwards = !Sharable;
-  mExecutorData.Script = Source;
-  mExecutorData.ScriptLength = Length;
+  Script = UpyNewScript (Source, Length, TRUE);
+  if (Script == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
 
   //
-  // Use separate stack for MicroPython.
+  // The engine is kept as long as any script wants to share it
   //
-  mExecutorData.ScriptEngineStackSize = mStackSize;
-  mExecutorData.ScriptEngineStack = AllocateAlignedPages(
-                                      EFI_SIZE_TO_PAGES (
-                                        mExecutorData.ScriptEngineStackSize
-                                        ),
-                                      CPU_STACK_ALIGNMENT
-                                      );
-  ASSERT (mExecutorData.ScriptEngineStack != NULL);
+  if (mExecutorData.IsRunning) {
+    mExecutorData.DeinitAfterwards = mExecutorData.DeinitAfterwards && !Sharable;
+  } else {
+    mExecutorData.DeinitAfterwards = !Sharable;
+  }
+  mExecutorData.IsRunning = TRUE;
 
   //
   // Use a timer to schedule the running of script engine. Then we can go back
-  // to caller of this method immediately.
+  // to caller of this method immediately. All async scripts share it.
   //
-  Status = gBS->CreateEvent(
-                 EVT_TIMER | EVT_NOTIFY_SIGNAL,
-                 TPL_CALLBACK,
-                 ScriptExecutor,
-                 (VOID *)&mExecutorData,
-                 &mExecutorData.ExecEvent
-                 );
-  ASSERT_EFI_ERROR(Status);
+  if (mExecutorData.ExecEvent == NULL) {
+    Status = gBS->CreateEvent(
+                   EVT_TIMER | EVT_NOTIFY_SIGNAL,
+                   TPL_CALLBACK,
+                   ScriptExecutor,
+                   (VOID *)&mExecutorData,
+                   &mExecutorData.ExecEvent
+                   );
+    ASSERT_EFI_ERROR(Status);
+  }
 
   //
-  // Set the alarm.
+  // Due right away
   //
-  Status = gBS->SetTimer(
-                 mExecutorData.ExecEvent,
-                 TimerRelative,
-                 1
-                 );
-  ASSERT_EFI_ERROR(Status);
+  Script->Deadline = UefiClockMilliseconds ();
+  UpyArmScheduler ();
 
-  return Status;
+  return EFI_SUCCESS;
 }
 
 /**
@@ -798,20 +1040,12 @@ UpyExecute (
     mExecutorData.ScriptEngineProtocol = This;
   }
 
+  mExecutorData.Current = UpyNewScript (Source, Length, FALSE);
+  if (mExecutorData.Current == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
   mExecutorData.DeinitAfterwards = !Sharable;
-  mExecutorData.ExecEvent = NULL;
-  mExecutorData.Script = Source;
-  mExecutorData.ScriptLength = Length;
-
-  //
-  // Use separate stack for MicroPython.
-  //
-  mExecutorData.ScriptEngineStackSize = mStackSize;
-  mExecutorData.ScriptEngineStack = AllocateAlignedPages(
-                                      EFI_SIZE_TO_PAGES (mExecutorData.ScriptEngineStackSize),
-                                      CPU_STACK_ALIGNMENT
-                                      );
-  ASSERT (mExecutorData.ScriptEngineStack != NULL);
+  mExecutorData.IsRunning = TRUE;
 
   ScriptExecutor (NULL, NULL);
 
@@ -1108,6 +1342,11 @@ UseDeinit (
     DEBUG((DEBUG_WARN, "There's script in execution\r\n"));
   }
 
+  if (mExecutorData.ExecEvent != NULL) {
+    gBS->CloseEvent (mExecutorData.ExecEvent);
+  }
+
+  UpyBreakDeinit ();
   UpyDeinit ();
   UsfDeinit (mExecutorData.Handle);
 
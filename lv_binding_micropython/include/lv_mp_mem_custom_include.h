@@ -5,4 +5,10 @@
 #include <py/misc.h>
 #include <py/gc.h>
 
+// m_realloc raises MemoryError. Used where leaving with an nlr jump would leave other cores waiting.
+static inline void *lv_mp_realloc_maybe(void *ptr, size_t new_num_bytes)
+{
+    return m_realloc_maybe(ptr, new_num_bytes, true);
+}
+
 #endif //__LV_MP_MEM_CUSTOM_INCLUDE_H
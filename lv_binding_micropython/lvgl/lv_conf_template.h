@@ -50,6 +50,11 @@
  * Can be changed in the display driver (`lv_disp_drv_t`).*/
 #define LV_DISP_DEF_REFR_PERIOD      30      /*[ms]*/
 
+/* Max. number of horizontal bands the refreshed areas are split into to render them
+ * on several cores at the same time. The display driver's `parallel_cb` runs the bands.
+ * Requires a compiler with `__atomic` builtins (GCC, Clang). 1: disable*/
+#define LV_REFR_PARALLEL_MAX         1
+
 /* Dot Per Inch: used to initialize default sizes.
  * E.g. a button with width = LV_DPI / 2 -> half inch wide
  * (Not so important, you can adjust it to modify default sizes and spaces)*/
@@ -108,6 +113,7 @@ typedef int16_t lv_coord_t;
 #  define LV_GC_INCLUDE "gc.h"                           /*Include Garbage Collector related things*/
 #  define LV_MEM_CUSTOM_REALLOC   your_realloc           /*Wrapper to realloc*/
 #  define LV_MEM_CUSTOM_GET_SIZE  your_mem_get_size      /*Wrapper to lv_mem_get_size*/
+#  define LV_MEM_CUSTOM_REALLOC_MAYBE LV_MEM_CUSTOM_REALLOC /*Wrapper to realloc which returns NULL instead of raising an exception*/
 #endif /* LV_ENABLE_GC */
 
 /*=======================
@@ -156,13 +162,17 @@ typedef void * lv_anim_user_data_t;
 /* 1: Enable shadow drawing on rectangles*/
 #define LV_USE_SHADOW           1
 #if LV_USE_SHADOW
-/* Allow buffering some shadow calculation
- * LV_SHADOW_CACHE_SIZE is the max. shadow size to buffer,
- * where shadow size is `shadow_width + radius`
- * Caching has LV_SHADOW_CACHE_SIZE^2 RAM cost*/
-#define LV_SHADOW_CACHE_SIZE    0
+/* Keep the blurred corners of shadows, so the shadows of the same size don't have to be blurred again.
+ * Max. memory of the cache in bytes. 0: disable
+ * A corner takes `(shadow_width + radius)^2` bytes, the least recently used ones are dropped if the cache is full*/
+#define LV_SHADOW_CACHE_SIZE    (8U * 1024U)
 #endif
 
+/* Keep the corners of rounded rectangles precomputed for their radius, so their masks don't have to
+ * calculate the circle in every row of every frame. Max. memory of the cache in bytes. 0: disable
+ * A corner takes about `10 * radius` bytes, the least recently used ones are dropped if the cache is full*/
+#define LV_RADIUS_CACHE_SIZE    (4U * 1024U)
+
 /*1: enable outline drawing on rectangles*/
 #define LV_USE_OUTLINE  1
 
@@ -175,6 +185,10 @@ typedef void * lv_anim_user_data_t;
 /* 1: Use other blend modes than normal (`LV_BLEND_MODE_...`)*/
 #define LV_USE_BLEND_MODES      1
 
+/* 1: Dither the gradients with a 4x4 ordered pattern on 16 bit color depth to avoid visible bands.
+ * The dithered gradients are blended from a map instead of filled, so they are drawn a little slower*/
+#define LV_DITHER_GRADIENT      0
+
 /* 1: Use the `opa_scale` style property to set the opacity of an object and its children at once*/
 #define LV_USE_OPA_SCALE        1
 
@@ -207,6 +221,11 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 /*1: Use VG-Lite for CPU offload on NXP RTxxx platforms */
 #define LV_USE_GPU_NXP_VG_LITE   0
 
+/* 1: Use SSE2/AVX2 kernels on x86-64 (selected in `lv_init()`) for the normal blend mode with 32 bit colors
+ * and for the additive and subtractive modes with 32 and 16 bit (not swapped) colors.
+ * Ignored on other CPUs and color depths. The normal mode doesn't use them on displays with `screen_transp`*/
+#define LV_USE_BLEND_SIMD        1
+
 /* 1: Enable file system (might be required for images */
 #define LV_USE_FILESYSTEM       1
 #if LV_USE_FILESYSTEM
@@ -220,6 +239,25 @@ typedef void * lv_fs_drv_user_data_t;
 /*1: Show CPU usage and FPS count in the right bottom corner*/
 #define LV_USE_PERF_MONITOR     0
 
+/*1: Collect timing statistics of the refresh: frame, area and flush time, design time per widget type,
+ * masks and blended pixels. Read them with `lv_perf_stats()` (see lv_perf.h)*/
+#define LV_USE_PERF_STATS       0
+#if LV_USE_PERF_STATS
+/*Number of the last samples kept for each statistic*/
+#  define LV_PERF_RING_SIZE     32
+
+/*Max. number of widget types whose design time is collected*/
+#  define LV_PERF_WIDGET_MAX    32
+
+/* 1: use a custom microsecond time source for the statistics.
+ * 0: use the tick, so the times have only millisecond resolution */
+#  define LV_PERF_TIME_CUSTOM   0
+#  if LV_PERF_TIME_CUSTOM == 1
+#    define LV_PERF_TIME_CUSTOM_INCLUDE  <time.h>       /*Header for the time function*/
+#    define LV_PERF_TIME_CUSTOM_US_EXPR  (micros())     /*Expression evaluating to current time in us*/
+#  endif
+#endif
+
 /*1: Use the functions and types from the older API if possible */
 #define LV_USE_API_EXTENSION_V6  1
 #define LV_USE_API_EXTENSION_V7  1
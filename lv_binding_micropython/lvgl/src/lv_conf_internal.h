@@ -128,6 +128,17 @@
 #  endif
 #endif
 
+/* Max. number of horizontal bands the refreshed areas are split into to render them
+ * on several cores at the same time. The display driver's `parallel_cb` runs the bands.
+ * Requires a compiler with `__atomic` builtins (GCC, Clang). 1: disable*/
+#ifndef LV_REFR_PARALLEL_MAX
+#  ifdef CONFIG_LV_REFR_PARALLEL_MAX
+#    define LV_REFR_PARALLEL_MAX CONFIG_LV_REFR_PARALLEL_MAX
+#  else
+#    define  LV_REFR_PARALLEL_MAX         1
+#  endif
+#endif
+
 /* Dot Per Inch: used to initialize default sizes.
  * E.g. a button with width = LV_DPI / 2 -> half inch wide
  * (Not so important, you can adjust it to modify default sizes and spaces)*/
@@ -287,6 +298,13 @@
 #    define  LV_MEM_CUSTOM_GET_SIZE  your_mem_get_size      /*Wrapper to lv_mem_get_size*/
 #  endif
 #endif
+#ifndef LV_MEM_CUSTOM_REALLOC_MAYBE
+#  ifdef CONFIG_LV_MEM_CUSTOM_REALLOC_MAYBE
+#    define LV_MEM_CUSTOM_REALLOC_MAYBE CONFIG_LV_MEM_CUSTOM_REALLOC_MAYBE
+#  else
+#    define  LV_MEM_CUSTOM_REALLOC_MAYBE LV_MEM_CUSTOM_REALLOC /*Wrapper to realloc which returns NULL instead of raising an exception*/
+#  endif
+#endif
 #endif /* LV_ENABLE_GC */
 
 /*=======================
@@ -388,19 +406,29 @@
 #  endif
 #endif
 #if LV_USE_SHADOW
-/* Allow buffering some shadow calculation
- * LV_SHADOW_CACHE_SIZE is the max. shadow size to buffer,
- * where shadow size is `shadow_width + radius`
- * Caching has LV_SHADOW_CACHE_SIZE^2 RAM cost*/
+/* Keep the blurred corners of shadows, so the shadows of the same size don't have to be blurred again.
+ * Max. memory of the cache in bytes. 0: disable
+ * A corner takes `(shadow_width + radius)^2` bytes, the least recently used ones are dropped if the cache is full*/
 #ifndef LV_SHADOW_CACHE_SIZE
 #  ifdef CONFIG_LV_SHADOW_CACHE_SIZE
 #    define LV_SHADOW_CACHE_SIZE CONFIG_LV_SHADOW_CACHE_SIZE
 #  else
-#    define  LV_SHADOW_CACHE_SIZE    0
+#    define  LV_SHADOW_CACHE_SIZE    (8U * 1024U)
 #  endif
 #endif
 #endif
 
+/* Keep the corners of rounded rectangles precomputed for their radius, so their masks don't have to
+ * calculate the circle in every row of every frame. Max. memory of the cache in bytes. 0: disable
+ * A corner takes about `10 * radius` bytes, the least recently used ones are dropped if the cache is full*/
+#ifndef LV_RADIUS_CACHE_SIZE
+#  ifdef CONFIG_LV_RADIUS_CACHE_SIZE
+#    define LV_RADIUS_CACHE_SIZE CONFIG_LV_RADIUS_CACHE_SIZE
+#  else
+#    define  LV_RADIUS_CACHE_SIZE    (4U * 1024U)
+#  endif
+#endif
+
 /*1: enable outline drawing on rectangles*/
 #ifndef LV_USE_OUTLINE
 #  ifdef CONFIG_LV_USE_OUTLINE
@@ -437,6 +465,16 @@
 #  endif
 #endif
 
+/* 1: Dither the gradients with a 4x4 ordered pattern on 16 bit color depth to avoid visible bands.
+ * The dithered gradients are blended from a map instead of filled, so they are drawn a little slower*/
+#ifndef LV_DITHER_GRADIENT
+#  ifdef CONFIG_LV_DITHER_GRADIENT
+#    define LV_DITHER_GRADIENT CONFIG_LV_DITHER_GRADIENT
+#  else
+#    define  LV_DITHER_GRADIENT      0
+#  endif
+#endif
+
 /* 1: Use the `opa_scale` style property to set the opacity of an object and its children at once*/
 #ifndef LV_USE_OPA_SCALE
 #  ifdef CONFIG_LV_USE_OPA_SCALE
@@ -522,6 +560,17 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 #  endif
 #endif
 
+/* 1: Use SSE2/AVX2 kernels on x86-64 (selected in `lv_init()`) for the normal blend mode with 32 bit colors
+ * and for the additive and subtractive modes with 32 and 16 bit (not swapped) colors.
+ * Ignored on other CPUs and color depths. The normal mode doesn't use them on displays with `screen_transp`*/
+#ifndef LV_USE_BLEND_SIMD
+#  ifdef CONFIG_LV_USE_BLEND_SIMD
+#    define LV_USE_BLEND_SIMD CONFIG_LV_USE_BLEND_SIMD
+#  else
+#    define  LV_USE_BLEND_SIMD        1
+#  endif
+#endif
+
 /* 1: Enable file system (might be required for images */
 #ifndef LV_USE_FILESYSTEM
 #  ifdef CONFIG_LV_USE_FILESYSTEM
@@ -552,6 +601,61 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h" */
 #  endif
 #endif
 
+/*1: Collect timing statistics of the refresh: frame, area and flush time, design time per widget type,
+ * masks and blended pixels. Read them with `lv_perf_stats()` (see lv_perf.h)*/
+#ifndef LV_USE_PERF_STATS
+#  ifdef CONFIG_LV_USE_PERF_STATS
+#    define LV_USE_PERF_STATS CONFIG_LV_USE_PERF_STATS
+#  else
+#    define  LV_USE_PERF_STATS       0
+#  endif
+#endif
+#if LV_USE_PERF_STATS
+/*Number of the last samples kept for each statistic*/
+#ifndef LV_PERF_RING_SIZE
+#  ifdef CONFIG_LV_PERF_RING_SIZE
+#    define LV_PERF_RING_SIZE CONFIG_LV_PERF_RING_SIZE
+#  else
+#    define  LV_PERF_RING_SIZE     32
+#  endif
+#endif
+
+/*Max. number of widget types whose design time is collected*/
+#ifndef LV_PERF_WIDGET_MAX
+#  ifdef CONFIG_LV_PERF_WIDGET_MAX
+#    define LV_PERF_WIDGET_MAX CONFIG_LV_PERF_WIDGET_MAX
+#  else
+#    define  LV_PERF_WIDGET_MAX    32
+#  endif
+#endif
+
+/* 1: use a custom microsecond time source for the statistics.
+ * 0: use the tick, so the times have only millisecond resolution */
+#ifndef LV_PERF_TIME_CUSTOM
+#  ifdef CONFIG_LV_PERF_TIME_CUSTOM
+#    define LV_PERF_TIME_CUSTOM CONFIG_LV_PERF_TIME_CUSTOM
+#  else
+#    define  LV_PERF_TIME_CUSTOM   0
+#  endif
+#endif
+#if LV_PERF_TIME_CUSTOM == 1
+#ifndef LV_PERF_TIME_CUSTOM_INCLUDE
+#  ifdef CONFIG_LV_PERF_TIME_CUSTOM_INCLUDE
+#    define LV_PERF_TIME_CUSTOM_INCLUDE CONFIG_LV_PERF_TIME_CUSTOM_INCLUDE
+#  else
+#    define  LV_PERF_TIME_CUSTOM_INCLUDE  <time.h>       /*Header for the time function*/
+#  endif
+#endif
+#ifndef LV_PERF_TIME_CUSTOM_US_EXPR
+#  ifdef CONFIG_LV_PERF_TIME_CUSTOM_US_EXPR
+#    define LV_PERF_TIME_CUSTOM_US_EXPR CONFIG_LV_PERF_TIME_CUSTOM_US_EXPR
+#  else
+#    define  LV_PERF_TIME_CUSTOM_US_EXPR  (micros())     /*Expression evaluating to current time in us*/
+#  endif
+#endif
+#endif
+#endif
+
 /*1: Use the functions and types from the older API if possible */
 #ifndef LV_USE_API_EXTENSION_V6
 #  ifdef CONFIG_LV_USE_API_EXTENSION_V6
@@ -1379,8 +1379,10 @@ static void indev_drag(lv_indev_proc_t * proc)
                 act_y += proc->types.pointer.vect.y;
             }
 
-            uint16_t inv_buf_size =
-                lv_disp_get_inv_buf_size(indev_act->driver.disp); /*Get the number of currently invalidated areas*/
+            /*Save the currently invalidated region*/
+            lv_region_t inv_ori;
+            lv_region_init(&inv_ori);
+            lv_region_copy(&inv_ori, &indev_act->driver.disp->inv_region);
 
             lv_obj_set_pos(drag_obj, act_x, act_y);
             proc->types.pointer.drag_in_prog = 1;
@@ -1393,10 +1395,10 @@ static void indev_drag(lv_indev_proc_t * proc)
                 lv_coord_t act_par_w = lv_obj_get_width(lv_obj_get_parent(drag_obj));
                 lv_coord_t act_par_h = lv_obj_get_height(lv_obj_get_parent(drag_obj));
                 if(act_par_w == prev_par_w && act_par_h == prev_par_h) {
-                    uint16_t new_inv_buf_size = lv_disp_get_inv_buf_size(indev_act->driver.disp);
-                    _lv_disp_pop_from_inv_buf(indev_act->driver.disp, new_inv_buf_size - inv_buf_size);
+                    lv_region_copy(&indev_act->driver.disp->inv_region, &inv_ori);
                 }
             }
+            lv_region_free(&inv_ori);
 
             /*Set the drag in progress flag*/
             /*Send the drag begin signal on first move*/
@@ -21,6 +21,7 @@
 #include "../lv_misc/lv_gc.h"
 #include "../lv_misc/lv_math.h"
 #include "../lv_misc/lv_log.h"
+#include "../lv_misc/lv_worker.h"
 #include "../lv_hal/lv_hal.h"
 #include <stdint.h>
 #include <string.h>
@@ -116,6 +117,9 @@ typedef enum {
 static lv_design_res_t lv_obj_design(lv_obj_t * obj, const lv_area_t * clip_area, lv_design_mode_t mode);
 static lv_res_t lv_obj_signal(lv_obj_t * obj, lv_signal_t sign, void * param);
 static void refresh_children_position(lv_obj_t * obj, lv_coord_t x_diff, lv_coord_t y_diff);
+static bool get_scroll_area(const lv_obj_t * obj, const lv_point_t * diff, lv_area_t * area);
+static bool area_is_free(const lv_obj_t * obj, const lv_area_t * area);
+static void invalidate_outside(const lv_obj_t * obj, const lv_area_t * area);
 static void report_style_mod_core(void * style_p, lv_obj_t * obj);
 static void refresh_children_style(lv_obj_t * obj);
 static void base_dir_refr_children(lv_obj_t * obj);
@@ -199,6 +203,11 @@ void lv_init(void)
     }
 #endif
 
+#if LV_USE_BLEND_SIMD
+    /*Select the blend kernels for the CPU*/
+    _lv_blend_simd_init();
+#endif
+
     _lv_ll_init(&LV_GC_ROOT(_lv_obj_style_trans_ll), sizeof(lv_style_trans_t));
 
     _lv_ll_init(&LV_GC_ROOT(_lv_disp_ll), sizeof(lv_disp_t));
@@ -378,6 +387,7 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, const lv_obj_t * copy)
     new_obj->parent_event = 0;
     new_obj->gesture_parent = parent ? 1 : 0;
     new_obj->focus_parent  = 0;
+    new_obj->occluded      = 0;
     new_obj->state = LV_STATE_DEFAULT;
 
     new_obj->ext_attr = NULL;
@@ -781,8 +791,19 @@ void lv_obj_set_pos(lv_obj_t * obj, lv_coord_t x, lv_coord_t y)
      * occur without position change*/
     if(diff.x == 0 && diff.y == 0) return;
 
+    /*If only the object is visible on an area (e.g. it's the scrollable of a page)
+     *move its pixels there and redraw only the rest*/
+    lv_area_t scroll_area;
+    bool scroll = get_scroll_area(obj, &diff, &scroll_area);
+
     /*Invalidate the original area*/
-    lv_obj_invalidate(obj);
+    if(scroll) {
+        invalidate_outside(obj, &scroll_area);
+        _lv_scroll_area(lv_obj_get_disp(obj), &scroll_area, diff.x, diff.y);
+    }
+    else {
+        lv_obj_invalidate(obj);
+    }
 
     /*Save the original coordinates*/
     lv_area_t ori;
@@ -802,7 +823,8 @@ void lv_obj_set_pos(lv_obj_t * obj, lv_coord_t x, lv_coord_t y)
     if(par) par->signal_cb(par, LV_SIGNAL_CHILD_CHG, obj);
 
     /*Invalidate the new area*/
-    lv_obj_invalidate(obj);
+    if(scroll) invalidate_outside(obj, &scroll_area);
+    else lv_obj_invalidate(obj);
 }
 
 /**
@@ -2577,7 +2599,8 @@ lv_style_int_t _lv_obj_get_style_int(const lv_obj_t * obj, uint8_t part, lv_styl
     const lv_obj_t * parent = obj;
     while(parent) {
         lv_style_list_t * list = lv_obj_get_style_list(parent, part);
-        if(!list->ignore_cache && list->style_cnt > 0) {
+        /*The workers rendering in parallel can use the cache but not update it*/
+        if(!list->ignore_cache && list->style_cnt > 0 && (list->valid_cache || !_lv_worker_is_parallel())) {
             if(!list->valid_cache) update_style_cache((lv_obj_t *)parent, part, prop  & (~LV_STYLE_STATE_MASK));
 
             bool def = false;
@@ -2765,7 +2788,8 @@ lv_opa_t _lv_obj_get_style_opa(const lv_obj_t * obj, uint8_t part, lv_style_prop
     while(parent) {
         lv_style_list_t * list = lv_obj_get_style_list(parent, part);
 
-        if(!list->ignore_cache && list->style_cnt > 0) {
+        /*The workers rendering in parallel can use the cache but not update it*/
+        if(!list->ignore_cache && list->style_cnt > 0 && (list->valid_cache || !_lv_worker_is_parallel())) {
             if(!list->valid_cache) update_style_cache((lv_obj_t *)parent, part, prop  & (~LV_STYLE_STATE_MASK));
             bool def = false;
             switch(prop & (~LV_STYLE_STATE_MASK)) {
@@ -2843,7 +2867,8 @@ const void * _lv_obj_get_style_ptr(const lv_obj_t * obj, uint8_t part, lv_style_
     while(parent) {
         lv_style_list_t * list = lv_obj_get_style_list(parent, part);
 
-        if(!list->ignore_cache && list->style_cnt > 0) {
+        /*The workers rendering in parallel can use the cache but not update it*/
+        if(!list->ignore_cache && list->style_cnt > 0 && (list->valid_cache || !_lv_worker_is_parallel())) {
             if(!list->valid_cache) update_style_cache((lv_obj_t *)parent, part, prop  & (~LV_STYLE_STATE_MASK));
             bool def = false;
             switch(prop  & (~LV_STYLE_STATE_MASK)) {
@@ -4034,6 +4059,157 @@ static lv_res_t lv_obj_signal(lv_obj_t * obj, lv_signal_t sign, void * param)
     return res;
 }
 
+/**
+ * Get the area where the pixels of an object can be moved instead of redrawing it.
+ * The parent tells the area (e.g. a page for its scrollable). On this area the object has to cover
+ * the parent before and after moving or the parent's background has to be a single color.
+ * @param obj pointer to an object to move
+ * @param diff the movement of the object
+ * @param area store the area to move here
+ * @return true: the pixels on `area` can be moved; false: the object has to be redrawn
+ */
+static bool get_scroll_area(const lv_obj_t * obj, const lv_point_t * diff, lv_area_t * area)
+{
+    lv_obj_t * par = obj->parent;
+    if(par == NULL) return false;
+
+    /*Check the cheap things first: most drivers can't move pixels*/
+    lv_disp_t * disp = lv_obj_get_disp(obj);
+    if(disp->driver.copy_cb == NULL || disp->prev_scr) return false;
+    if(lv_obj_get_screen(obj) != disp->act_scr || lv_obj_get_hidden(obj)) return false;
+
+    lv_get_scroll_area_info_t info;
+    lv_area_set(&info.area, 0, 0, -1, -1);
+    info.bg_uniform = false;
+    par->signal_cb(par, LV_SIGNAL_GET_SCROLL_AREA, &info);
+    if(info.area.x1 > info.area.x2 || info.area.y1 > info.area.y2) return false;
+
+    /*Only the visible part matters*/
+    lv_area_copy(area, &info.area);
+    if(lv_obj_area_is_visible(par, area) == false) return false;
+
+    if(info.bg_uniform == false) {
+        /*Covering after moving is the same as covering the area moved back before moving*/
+        lv_area_t ori_area;
+        lv_area_copy(&ori_area, area);
+        ori_area.x1 -= diff->x;
+        ori_area.x2 -= diff->x;
+        ori_area.y1 -= diff->y;
+        ori_area.y2 -= diff->y;
+
+        lv_obj_t * o = (lv_obj_t *)obj;
+        if(lv_obj_get_style_opa_scale(o, LV_OBJ_PART_MAIN) != LV_OPA_COVER) return false;
+        if(o->design_cb(o, area, LV_DESIGN_COVER_CHK) != LV_DESIGN_RES_COVER) return false;
+        if(o->design_cb(o, &ori_area, LV_DESIGN_COVER_CHK) != LV_DESIGN_RES_COVER) return false;
+    }
+
+    return area_is_free(obj, area);
+}
+
+/**
+ * Check if nothing is drawn over an object on an area: no later siblings of the object or of its
+ * parents, no post drawing of the grandparents and no objects on the layers
+ * @param obj pointer to an object
+ * @param area the area to check
+ * @return true: only the object (with its children) and the things under it are drawn on the area
+ */
+static bool area_is_free(const lv_obj_t * obj, const lv_area_t * area)
+{
+    const lv_obj_t * o = obj;
+    const lv_obj_t * par = obj->parent;
+    while(par) {
+        /*The children after `o` are drawn after it*/
+        lv_obj_t * sib = _lv_ll_get_prev(&par->child_ll, o);
+        while(sib) {
+            lv_area_t sib_area;
+            lv_obj_get_coords(sib, &sib_area);
+            sib_area.x1 -= sib->ext_draw_pad;
+            sib_area.y1 -= sib->ext_draw_pad;
+            sib_area.x2 += sib->ext_draw_pad;
+            sib_area.y2 += sib->ext_draw_pad;
+            if(lv_obj_get_hidden(sib) == false && _lv_area_is_on(&sib_area, area)) return false;
+            sib = _lv_ll_get_prev(&par->child_ll, sib);
+        }
+
+        /*The parent has reported the area already. The others might draw over their children.*/
+        if(par != obj->parent) {
+            if(par->design_cb == lv_obj_design) {
+                if(lv_obj_get_style_clip_corner(par, LV_OBJ_PART_MAIN)) return false;
+                if(lv_obj_get_style_border_post(par, LV_OBJ_PART_MAIN)) return false;
+            }
+            else {
+                lv_get_scroll_area_info_t info;
+                lv_area_set(&info.area, 0, 0, -1, -1);
+                info.bg_uniform = false;
+                par->signal_cb((lv_obj_t *)par, LV_SIGNAL_GET_SCROLL_AREA, &info);
+                if(_lv_area_is_in(area, &info.area, 0) == false) return false;
+            }
+        }
+
+        o = par;
+        par = par->parent;
+    }
+
+    lv_disp_t * disp = lv_obj_get_disp(obj);
+    lv_obj_t * layers[2] = {disp->top_layer, disp->sys_layer};
+    uint32_t i;
+    for(i = 0; i < 2; i++) {
+        lv_obj_t * child;
+        _LV_LL_READ(layers[i]->child_ll, child) {
+            lv_area_t child_area;
+            lv_obj_get_coords(child, &child_area);
+            child_area.x1 -= child->ext_draw_pad;
+            child_area.y1 -= child->ext_draw_pad;
+            child_area.x2 += child->ext_draw_pad;
+            child_area.y2 += child->ext_draw_pad;
+            if(lv_obj_get_hidden(child) == false && _lv_area_is_on(&child_area, area)) return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Invalidate the parts of an object out of an area
+ * @param obj pointer to an object
+ * @param area the area not to invalidate
+ */
+static void invalidate_outside(const lv_obj_t * obj, const lv_area_t * area)
+{
+    lv_area_t coords;
+    lv_obj_get_coords(obj, &coords);
+    coords.x1 -= obj->ext_draw_pad;
+    coords.y1 -= obj->ext_draw_pad;
+    coords.x2 += obj->ext_draw_pad;
+    coords.y2 += obj->ext_draw_pad;
+
+    lv_area_t part;
+
+    /*Above and below the area*/
+    if(coords.y1 < area->y1) {
+        lv_area_set(&part, coords.x1, coords.y1, coords.x2, area->y1 - 1);
+        lv_obj_invalidate_area(obj, &part);
+    }
+    if(coords.y2 > area->y2) {
+        lv_area_set(&part, coords.x1, area->y2 + 1, coords.x2, coords.y2);
+        lv_obj_invalidate_area(obj, &part);
+    }
+
+    /*Left and right in the rows of the area*/
+    lv_coord_t y1 = LV_MATH_MAX(coords.y1, area->y1);
+    lv_coord_t y2 = LV_MATH_MIN(coords.y2, area->y2);
+    if(y1 > y2) return;
+
+    if(coords.x1 < area->x1) {
+        lv_area_set(&part, coords.x1, y1, area->x1 - 1, y2);
+        lv_obj_invalidate_area(obj, &part);
+    }
+    if(coords.x2 > area->x2) {
+        lv_area_set(&part, area->x2 + 1, y1, coords.x2, y2);
+        lv_obj_invalidate_area(obj, &part);
+    }
+}
+
 /**
  * Reposition the children of an object. (Called recursively)
  * @param obj pointer to an object which children will be repositioned
@@ -129,6 +129,7 @@ enum {
     LV_SIGNAL_GET_TYPE, /**< LVGL needs to retrieve the object's type */
     LV_SIGNAL_GET_STYLE, /**<Get the style of an object*/
     LV_SIGNAL_GET_STATE_DSC, /**<Get the state of the object*/
+    LV_SIGNAL_GET_SCROLL_AREA, /**<Get the area where the children can be scrolled by moving their pixels*/
 
     /*Input device related*/
     LV_SIGNAL_HIT_TEST,          /**< Advanced hit-testing */
@@ -226,6 +227,7 @@ typedef struct _lv_obj_t {
     uint8_t adv_hittest     : 1; /**< 1: Use advanced hit-testing (slower) */
     uint8_t gesture_parent  : 1; /**< 1: Parent will be gesture instead*/
     uint8_t focus_parent    : 1; /**< 1: Parent will be focused instead*/
+    uint8_t occluded        : 1; /**< 1: Covered by opaque objects in the area being refreshed (set by lv_refr.c)*/
 
     lv_drag_dir_t drag_dir  : 3; /**<  Which directions the object can be dragged in */
     lv_bidi_dir_t base_dir  : 2; /**< Base direction of texts related to this object */
@@ -278,6 +280,12 @@ typedef struct {
     lv_state_t result;
 } lv_get_state_info_t;
 
+/** Parameter of `LV_SIGNAL_GET_SCROLL_AREA`. Empty until the object sets it.*/
+typedef struct {
+    lv_area_t area;     /**< Nothing is drawn over the children here*/
+    bool bg_uniform;    /**< The background under the children is a single color on `area`*/
+} lv_get_scroll_area_info_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -0,0 +1,223 @@
+/**
+ * @file lv_perf.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_perf.h"
+
+#if LV_USE_PERF_STATS
+
+#include "../lv_hal/lv_hal_tick.h"
+#include "../lv_misc/lv_mem.h"
+#include "../lv_misc/lv_worker.h"
+
+#if LV_PERF_TIME_CUSTOM
+    #include LV_PERF_TIME_CUSTOM_INCLUDE
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_perf_stats_t stats;
+
+/*The signal callback identifies the type of the widgets in `stats.widgets`*/
+static lv_signal_cb_t widget_keys[LV_PERF_WIDGET_MAX];
+
+/*Data of the current refresh*/
+static uint32_t frame_start;
+static uint32_t frame_flush_us;
+static uint32_t area_start;
+static uint32_t area_flush_us;
+
+/*Counted on every worker separately*/
+static uint32_t frame_masks[LV_REFR_PARALLEL_MAX];
+static uint32_t frame_blend_px[LV_REFR_PARALLEL_MAX];
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Get the statistics collected since the last reset
+ * @return pointer to the statistics. They are updated by the refresh, copy them to keep a snapshot.
+ */
+lv_perf_stats_t * lv_perf_stats(void)
+{
+    return &stats;
+}
+
+/**
+ * Clear all the statistics
+ */
+void lv_perf_reset(void)
+{
+    _lv_memset_00(&stats, sizeof(stats));
+    _lv_memset_00(widget_keys, sizeof(widget_keys));
+}
+
+/**
+ * Get the time used for the statistics
+ * @return time in microseconds (millisecond resolution without `LV_PERF_TIME_CUSTOM`)
+ */
+uint32_t _lv_perf_time_us(void)
+{
+#if LV_PERF_TIME_CUSTOM
+    return LV_PERF_TIME_CUSTOM_US_EXPR;
+#else
+    return lv_tick_get() * 1000;
+#endif
+}
+
+/**
+ * Add a sample to a histogram
+ * @param hist pointer to a histogram of the statistics
+ * @param value the sample
+ */
+void _lv_perf_add(lv_perf_hist_t * hist, uint32_t value)
+{
+    hist->cnt++;
+    hist->sum += value;
+    if(value > hist->max) hist->max = value;
+
+    /*The bin is the number of significant bits*/
+    uint32_t bin = 0;
+    while(bin < LV_PERF_BIN_CNT - 1 && (value >> bin) != 0) bin++;
+    hist->bins[bin]++;
+
+    hist->ring[hist->ring_pos] = value;
+    hist->ring_pos++;
+    if(hist->ring_pos >= LV_PERF_RING_SIZE) hist->ring_pos = 0;
+}
+
+/**
+ * Called when a refresh starts
+ */
+void _lv_perf_frame_begin(void)
+{
+    frame_start = _lv_perf_time_us();
+    frame_flush_us = 0;
+    _lv_memset_00(frame_masks, sizeof(frame_masks));
+    _lv_memset_00(frame_blend_px, sizeof(frame_blend_px));
+}
+
+/**
+ * Called when a refresh redrew something. Adds the samples of the refresh.
+ * @param join_us microseconds spent on joining the invalid areas
+ */
+void _lv_perf_frame_end(uint32_t join_us)
+{
+    uint32_t masks = 0;
+    uint32_t blend_px = 0;
+    uint32_t i;
+    for(i = 0; i < LV_REFR_PARALLEL_MAX; i++) {
+        masks += frame_masks[i];
+        blend_px += frame_blend_px[i];
+    }
+
+    _lv_perf_add(&stats.frame, _lv_perf_time_us() - frame_start);
+    _lv_perf_add(&stats.join, join_us);
+    _lv_perf_add(&stats.flush, frame_flush_us);
+    _lv_perf_add(&stats.masks, masks);
+    _lv_perf_add(&stats.blend_px, blend_px);
+}
+
+/**
+ * Called before rendering an invalid area
+ */
+void _lv_perf_area_begin(void)
+{
+    area_start = _lv_perf_time_us();
+    area_flush_us = frame_flush_us;
+}
+
+/**
+ * Called when an invalid area is rendered and flushed. The flushing time is not counted.
+ */
+void _lv_perf_area_end(void)
+{
+    uint32_t flush_us = frame_flush_us - area_flush_us;
+    uint32_t elaps = _lv_perf_time_us() - area_start;
+    _lv_perf_add(&stats.area, elaps > flush_us ? elaps - flush_us : 0);
+}
+
+/**
+ * Count time spent on flushing in the current refresh
+ * @param us microseconds
+ */
+void _lv_perf_add_flush(uint32_t us)
+{
+    frame_flush_us += us;
+}
+
+/**
+ * Count added masks in the current refresh. Can be called on any worker.
+ * @param cnt number of masks
+ */
+void _lv_perf_add_masks(uint32_t cnt)
+{
+    frame_masks[_lv_worker_get_id()] += cnt;
+}
+
+/**
+ * Count blended pixels in the current refresh. Can be called on any worker.
+ * @param px number of pixels
+ */
+void _lv_perf_add_blend_px(uint32_t px)
+{
+    frame_blend_px[_lv_worker_get_id()] += px;
+}
+
+/**
+ * Add the time of a design callback call to the statistics of the object's type.
+ * Ignored on the workers other than the main core.
+ * @param obj pointer to the object which was drawn
+ * @param us microseconds spent in the design callback
+ */
+void _lv_perf_add_design(const lv_obj_t * obj, uint32_t us)
+{
+    /*The other workers would add types at the same time*/
+    if(_lv_worker_get_id() != 0) return;
+
+    uint16_t i;
+    for(i = 0; i < stats.widget_cnt; i++) {
+        if(widget_keys[i] == obj->signal_cb) break;
+    }
+
+    /*A new type*/
+    if(i == stats.widget_cnt) {
+        if(i >= LV_PERF_WIDGET_MAX) return;
+
+        lv_obj_type_t type;
+        lv_obj_get_type(obj, &type);
+        widget_keys[i] = obj->signal_cb;
+        stats.widgets[i].name = type.type[0];
+        stats.widget_cnt++;
+    }
+
+    _lv_perf_add(&stats.widgets[i].design, us);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#endif /*LV_USE_PERF_STATS*/
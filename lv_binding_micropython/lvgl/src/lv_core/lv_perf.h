@@ -0,0 +1,148 @@
+/**
+ * @file lv_perf.h
+ * Timing statistics of the refresh, enabled with `LV_USE_PERF_STATS`.
+ *
+ * Every statistic is a histogram of samples (times in microseconds or counts) with the last
+ * `LV_PERF_RING_SIZE` samples kept in a ring buffer. `frame`, `join`, `flush`, `masks` and `blend_px`
+ * get a sample in every refresh which redrew something, `area` for every refreshed area and
+ * the widget types for every call of their design callback.
+ */
+
+#ifndef LV_PERF_H
+#define LV_PERF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+
+#if LV_USE_PERF_STATS
+
+#include <stdint.h>
+#include "lv_obj.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+/*Number of histogram bins. The last one collects every sample >= 2^(LV_PERF_BIN_CNT - 2)*/
+#define LV_PERF_BIN_CNT 24
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    uint32_t cnt;                       /*Number of samples since the last reset*/
+    uint64_t sum;                       /*Sum of the samples*/
+    uint32_t max;                       /*Largest sample*/
+    uint32_t bins[LV_PERF_BIN_CNT];     /*bins[0]: samples of 0, bins[i]: samples in [2^(i-1), 2^i)*/
+    uint32_t ring[LV_PERF_RING_SIZE];   /*The last samples. The next one is written to `ring[ring_pos]`*/
+    uint16_t ring_pos;
+} lv_perf_hist_t;
+
+typedef struct {
+    const char * name;                  /*Type of the widgets, e.g. "lv_btn"*/
+    lv_perf_hist_t design;              /*Microseconds spent in a call of the design callback (children excluded)*/
+} lv_perf_widget_t;
+
+typedef struct {
+    lv_perf_hist_t frame;               /*Microseconds of a refresh*/
+    lv_perf_hist_t join;                /*Microseconds to join the invalid areas*/
+    lv_perf_hist_t area;                /*Microseconds to render an invalid area, flushing excluded*/
+    lv_perf_hist_t flush;               /*Microseconds of flushing in a refresh, waiting for the display included*/
+    lv_perf_hist_t masks;               /*Masks added in a refresh*/
+    lv_perf_hist_t blend_px;            /*Pixels blended in a refresh*/
+    lv_perf_widget_t widgets[LV_PERF_WIDGET_MAX];   /*Design time by widget type in order of appearance*/
+    uint16_t widget_cnt;                /*Number of used elements in `widgets`*/
+} lv_perf_stats_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Get the statistics collected since the last reset
+ * @return pointer to the statistics. They are updated by the refresh, copy them to keep a snapshot.
+ */
+lv_perf_stats_t * lv_perf_stats(void);
+
+/**
+ * Clear all the statistics
+ */
+void lv_perf_reset(void);
+
+/**
+ * Get the time used for the statistics
+ * @return time in microseconds (millisecond resolution without `LV_PERF_TIME_CUSTOM`)
+ */
+uint32_t _lv_perf_time_us(void);
+
+/**
+ * Add a sample to a histogram
+ * @param hist pointer to a histogram of the statistics
+ * @param value the sample
+ */
+void _lv_perf_add(lv_perf_hist_t * hist, uint32_t value);
+
+/**
+ * Called when a refresh starts
+ */
+void _lv_perf_frame_begin(void);
+
+/**
+ * Called when a refresh redrew something. Adds the samples of the refresh.
+ * @param join_us microseconds spent on joining the invalid areas
+ */
+void _lv_perf_frame_end(uint32_t join_us);
+
+/**
+ * Called before rendering an invalid area
+ */
+void _lv_perf_area_begin(void);
+
+/**
+ * Called when an invalid area is rendered and flushed. The flushing time is not counted.
+ */
+void _lv_perf_area_end(void);
+
+/**
+ * Count time spent on flushing in the current refresh
+ * @param us microseconds
+ */
+void _lv_perf_add_flush(uint32_t us);
+
+/**
+ * Count added masks in the current refresh. Can be called on any worker.
+ * @param cnt number of masks
+ */
+void _lv_perf_add_masks(uint32_t cnt);
+
+/**
+ * Count blended pixels in the current refresh. Can be called on any worker.
+ * @param px number of pixels
+ */
+void _lv_perf_add_blend_px(uint32_t px);
+
+/**
+ * Add the time of a design callback call to the statistics of the object's type.
+ * Ignored on the workers other than the main core.
+ * @param obj pointer to the object which was drawn
+ * @param us microseconds spent in the design callback
+ */
+void _lv_perf_add_design(const lv_obj_t * obj, uint32_t us);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_PERF_STATS*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_PERF_H*/
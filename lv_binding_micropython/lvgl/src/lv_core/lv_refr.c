@@ -9,12 +9,14 @@
 #include <stddef.h>
 #include "lv_refr.h"
 #include "lv_disp.h"
+#include "lv_perf.h"
 #include "../lv_hal/lv_hal_tick.h"
 #include "../lv_hal/lv_hal_disp.h"
 #include "../lv_misc/lv_task.h"
 #include "../lv_misc/lv_mem.h"
 #include "../lv_misc/lv_math.h"
 #include "../lv_misc/lv_gc.h"
+#include "../lv_misc/lv_worker.h"
 #include "../lv_draw/lv_draw.h"
 #include "../lv_font/lv_font_fmt_txt.h"
 #include "../lv_gpu/lv_gpu_stm32_dma2d.h"
@@ -29,6 +31,19 @@
 /* Draw translucent random colored areas on the invalidated (redrawn) areas*/
 #define MASK_AREA_DEBUG 0
 
+/* Simplify the invalid region while collecting areas if it has more rectangles.
+ * Keeps the cost of adding an area low, it's simplified to `LV_INV_BUF_SIZE` before refreshing.*/
+#define INV_REGION_MAX_CNT (LV_INV_BUF_SIZE * 4)
+
+/* Stop collecting occluders if the occluded region has this many rectangles.
+ * Keeps the occlusion pass cheap on screens with many small opaque objects.*/
+#define OCC_REGION_MAX_CNT 64
+
+/* Render an area part in parallel only if every band has at least this many rows and pixels.
+ * Smaller bands don't pay off the cost of starting the workers.*/
+#define PARALLEL_BAND_MIN_ROWS 4
+#define PARALLEL_BAND_MIN_PX   4096
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -36,20 +51,32 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
-static void lv_refr_join_area(void);
+static void lv_refr_scroll(void);
 static void lv_refr_areas(void);
 static void lv_refr_area(const lv_area_t * area_p);
 static void lv_refr_area_part(const lv_area_t * area_p);
+static void lv_refr_layers(const lv_area_t * mask_p, lv_obj_t * top_act_scr, lv_obj_t * top_prev_scr);
+#if LV_REFR_PARALLEL_MAX > 1
+    static bool lv_refr_parallel(const lv_area_t * mask_p, lv_obj_t * top_act_scr, lv_obj_t * top_prev_scr);
+    static void lv_refr_band(uint32_t id);
+#endif
 static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj);
+static void lv_refr_occlusion(lv_obj_t * obj, const lv_area_t * clip_p, bool masked);
 static void lv_refr_obj_and_children(lv_obj_t * top_p, const lv_area_t * mask_p);
 static void lv_refr_obj(lv_obj_t * obj, const lv_area_t * mask_ori_p);
 static void lv_refr_vdb_flush(void);
+static void lv_refr_design(lv_obj_t * obj, const lv_area_t * clip_area, lv_design_mode_t mode);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 static uint32_t px_num;
 static lv_disp_t * disp_refr; /*Display being refreshed*/
+#if LV_REFR_PARALLEL_MAX > 1
+    static lv_area_t bands[LV_REFR_PARALLEL_MAX];   /*The bands of the area part rendered in parallel*/
+    static lv_obj_t * bands_top_act_scr;
+    static lv_obj_t * bands_top_prev_scr;
+#endif
 #if LV_USE_PERF_MONITOR
     static uint32_t fps_sum_cnt;
     static uint32_t fps_sum_all;
@@ -108,9 +135,10 @@ void _lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p)
     if(!disp) disp = lv_disp_get_default();
     if(!disp) return;
 
-    /*Clear the invalidate buffer if the parameter is NULL*/
+    /*Clear the invalid region if the parameter is NULL*/
     if(area_p == NULL) {
-        disp->inv_p = 0;
+        lv_region_clear(&disp->inv_region);
+        disp->scroll_pending = 0;
         return;
     }
 
@@ -129,23 +157,113 @@ void _lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p)
     if(suc != false) {
         if(disp->driver.rounder_cb) disp->driver.rounder_cb(&disp->driver, &com_area);
 
-        /*Save only if this area is not in one of the saved areas*/
-        uint16_t i;
-        for(i = 0; i < disp->inv_p; i++) {
-            if(_lv_area_is_in(&com_area, &disp->inv_areas[i], 0) != false) return;
+        /*Nothing to do if it's invalid already*/
+        if(lv_region_is_in(&disp->inv_region, &com_area)) return;
+
+        /*Add the area. If there is no memory for it the bounding box is invalidated.*/
+        lv_region_union_area(&disp->inv_region, &com_area);
+        if(disp->inv_region.cnt > INV_REGION_MAX_CNT) {
+            lv_region_simplify(&disp->inv_region, LV_INV_BUF_SIZE);
         }
+        lv_task_set_prio(disp->refr_task, LV_REFR_TASK_PRIO);
+    }
+}
 
-        /*Save the area*/
-        if(disp->inv_p < LV_INV_BUF_SIZE) {
-            lv_area_copy(&disp->inv_areas[disp->inv_p], &com_area);
+/**
+ * Scroll the content of an area on a display. If the driver can move pixels (`copy_cb`) the pixels
+ * already on the display are moved in the next refresh and only the uncovered strips are redrawn.
+ * Else the area is invalidated.
+ * @param disp pointer to display (NULL can be used if there is only one display)
+ * @param area_p the area to scroll. Nothing else but the moving content should be drawn here.
+ * @param dx horizontal movement of the content
+ * @param dy vertical movement of the content
+ */
+void _lv_scroll_area(lv_disp_t * disp, const lv_area_t * area_p, lv_coord_t dx, lv_coord_t dy)
+{
+    if(!disp) disp = lv_disp_get_default();
+    if(!disp) return;
+
+    if(dx == 0 && dy == 0) return;
+
+    lv_area_t scr_area;
+    scr_area.x1 = 0;
+    scr_area.y1 = 0;
+    scr_area.x2 = lv_disp_get_hor_res(disp) - 1;
+    scr_area.y2 = lv_disp_get_ver_res(disp) - 1;
+
+    lv_area_t area;
+    if(_lv_area_intersect(&area, area_p, &scr_area) == false) return;
+
+    /*With true double buffering the driver can't know which buffer to move.
+     *Only one area can be moved in a refresh so redraw the others.*/
+    if(disp->driver.copy_cb == NULL || lv_disp_is_true_double_buf(disp) ||
+       (disp->scroll_pending && (disp->scroll_area.x1 != area.x1 || disp->scroll_area.y1 != area.y1 ||
+                                 disp->scroll_area.x2 != area.x2 || disp->scroll_area.y2 != area.y2))) {
+        _lv_inv_area(disp, &area);
+        return;
+    }
+
+    lv_coord_t ofs_x = dx;
+    lv_coord_t ofs_y = dy;
+    if(disp->scroll_pending) {
+        ofs_x += disp->scroll_dx;
+        ofs_y += disp->scroll_dy;
+    }
+
+    /*Nothing remains from the area or the content got back to its place*/
+    if(LV_MATH_ABS(ofs_x) >= lv_area_get_width(&area) || LV_MATH_ABS(ofs_y) >= lv_area_get_height(&area) ||
+       (ofs_x == 0 && ofs_y == 0)) {
+        disp->scroll_pending = 0;
+        _lv_inv_area(disp, &area);
+        return;
+    }
+
+    /*The content invalidated so far will be moved too: redraw it at the new place as well.
+     *The rectangles are copied because invalidating changes the region.*/
+    uint32_t inv_cnt = disp->inv_region.cnt;
+    if(inv_cnt) {
+        lv_area_t * inv_rects = _lv_mem_buf_get(inv_cnt * sizeof(lv_area_t));
+        if(inv_rects == NULL) {
+            disp->scroll_pending = 0;
+            _lv_inv_area(disp, &area);
+            return;
         }
-        else {   /*If no place for the area add the screen*/
-            disp->inv_p = 0;
-            lv_area_copy(&disp->inv_areas[disp->inv_p], &scr_area);
+        _lv_memcpy(inv_rects, disp->inv_region.rects, inv_cnt * sizeof(lv_area_t));
+
+        uint32_t i;
+        for(i = 0; i < inv_cnt; i++) {
+            lv_area_t moved;
+            if(_lv_area_intersect(&moved, &inv_rects[i], &area) == false) continue;
+            moved.x1 += dx;
+            moved.x2 += dx;
+            moved.y1 += dy;
+            moved.y2 += dy;
+            if(_lv_area_intersect(&moved, &moved, &area)) _lv_inv_area(disp, &moved);
         }
-        disp->inv_p++;
-        lv_task_set_prio(disp->refr_task, LV_REFR_TASK_PRIO);
+
+        _lv_mem_buf_release(inv_rects);
     }
+
+    /*Redraw the strips uncovered by the movement*/
+    lv_area_t strip;
+    if(dx != 0) {
+        lv_area_copy(&strip, &area);
+        if(dx > 0) strip.x2 = LV_MATH_MIN(area.x1 + dx - 1, area.x2);
+        else strip.x1 = LV_MATH_MAX(area.x2 + dx + 1, area.x1);
+        _lv_inv_area(disp, &strip);
+    }
+    if(dy != 0) {
+        lv_area_copy(&strip, &area);
+        if(dy > 0) strip.y2 = LV_MATH_MIN(area.y1 + dy - 1, area.y2);
+        else strip.y1 = LV_MATH_MAX(area.y2 + dy + 1, area.y1);
+        _lv_inv_area(disp, &strip);
+    }
+
+    lv_area_copy(&disp->scroll_area, &area);
+    disp->scroll_dx = ofs_x;
+    disp->scroll_dy = ofs_y;
+    disp->scroll_pending = 1;
+    lv_task_set_prio(disp->refr_task, LV_REFR_TASK_PRIO);
 }
 
 /**
@@ -168,6 +286,16 @@ void _lv_refr_set_disp_refreshing(lv_disp_t * disp)
     disp_refr = disp;
 }
 
+/**
+ * Get the region which is being refreshed on the display being refreshed.
+ * Areas invalidated meanwhile are collected for the next refresh.
+ * @return the region being refreshed
+ */
+const lv_region_t * _lv_refr_get_inv_region(void)
+{
+    return &disp_refr->refr_region;
+}
+
 /**
  * Called periodically to handle the refreshing
  * @param task pointer to the task itself
@@ -190,16 +318,37 @@ void _lv_disp_refr_task(lv_task_t * task)
 
     /*Do nothing if there is no active screen*/
     if(disp_refr->act_scr == NULL) {
-        disp_refr->inv_p = 0;
+        lv_region_clear(&disp_refr->inv_region);
+        disp_refr->scroll_pending = 0;
         return;
     }
 
-    lv_refr_join_area();
+#if LV_USE_PERF_STATS
+    _lv_perf_frame_begin();
+    uint32_t perf_join_us = _lv_perf_time_us();
+#endif
+
+    /*Take the invalid region: areas invalidated while drawing go to the next refresh.
+     *The memory of the regions is kept and swapped to avoid allocations.*/
+    lv_region_t tmp = disp_refr->refr_region;
+    disp_refr->refr_region = disp_refr->inv_region;
+    disp_refr->inv_region = tmp;
+    lv_region_clear(&disp_refr->inv_region);
+
+    /*Move the pixels of a scrolled area before redrawing the strips around them*/
+    if(disp_refr->scroll_pending) lv_refr_scroll();
+
+    /*Refresh a limited number of rectangles joined with the least overdraw*/
+    lv_region_simplify(&disp_refr->refr_region, LV_INV_BUF_SIZE);
+
+#if LV_USE_PERF_STATS
+    perf_join_us = _lv_perf_time_us() - perf_join_us;
+#endif
 
     lv_refr_areas();
 
     /*If refresh happened ...*/
-    if(disp_refr->inv_p != 0) {
+    if(!lv_region_is_empty(&disp_refr->refr_region)) {
         /* In true double buffered mode copy the refreshed areas to the new VDB to keep it up to date.
          * With set_px_cb we don't know anything about the buffer (even it's size) so skip copying.*/
         if(lv_disp_is_true_double_buf(disp_refr)) {
@@ -215,7 +364,13 @@ void _lv_disp_refr_task(lv_task_t * task)
                 /* With true double buffering the flushing should be only the address change of the
                  * current frame buffer. Wait until the address change is ready and copy the changed
                  * content to the other frame buffer (new active VDB) to keep the buffers synchronized*/
+#if LV_USE_PERF_STATS
+                uint32_t perf_wait_us = _lv_perf_time_us();
+                while(vdb->flushing);
+                _lv_perf_add_flush(_lv_perf_time_us() - perf_wait_us);
+#else
                 while(vdb->flushing);
+#endif
 
                 lv_color_t * copy_buf = NULL;
 #if LV_USE_GPU_STM32_DMA2D
@@ -228,30 +383,28 @@ void _lv_disp_refr_task(lv_task_t * task)
                 uint8_t * buf_ina = (uint8_t *)vdb->buf_act == vdb->buf1 ? vdb->buf2 : vdb->buf1;
 
                 lv_coord_t hres = lv_disp_get_hor_res(disp_refr);
-                uint16_t a;
-                for(a = 0; a < disp_refr->inv_p; a++) {
-                    if(disp_refr->inv_area_joined[a] == 0) {
-                        uint32_t start_offs =
-                            (hres * disp_refr->inv_areas[a].y1 + disp_refr->inv_areas[a].x1) * sizeof(lv_color_t);
+                uint32_t a;
+                for(a = 0; a < disp_refr->refr_region.cnt; a++) {
+                    const lv_area_t * inv_area = &disp_refr->refr_region.rects[a];
+                    uint32_t start_offs = (hres * inv_area->y1 + inv_area->x1) * sizeof(lv_color_t);
 #if LV_USE_GPU_STM32_DMA2D
-                        lv_gpu_stm32_dma2d_copy((lv_color_t *)(buf_act + start_offs), disp_refr->driver.hor_res,
-                                                (lv_color_t *)(buf_ina + start_offs), disp_refr->driver.hor_res,
-                                                lv_area_get_width(&disp_refr->inv_areas[a]),
-                                                lv_area_get_height(&disp_refr->inv_areas[a]));
+                    lv_gpu_stm32_dma2d_copy((lv_color_t *)(buf_act + start_offs), disp_refr->driver.hor_res,
+                                            (lv_color_t *)(buf_ina + start_offs), disp_refr->driver.hor_res,
+                                            lv_area_get_width(inv_area),
+                                            lv_area_get_height(inv_area));
 #else
 
-                        lv_coord_t y;
-                        uint32_t line_length = lv_area_get_width(&disp_refr->inv_areas[a]) * sizeof(lv_color_t);
+                    lv_coord_t y;
+                    uint32_t line_length = lv_area_get_width(inv_area) * sizeof(lv_color_t);
 
-                        for(y = disp_refr->inv_areas[a].y1; y <= disp_refr->inv_areas[a].y2; y++) {
-                            /* The frame buffer is probably in an external RAM where sequential access is much faster.
-                             * So first copy a line into a buffer and write it back the ext. RAM */
-                            _lv_memcpy(copy_buf, buf_ina + start_offs, line_length);
-                            _lv_memcpy(buf_act + start_offs, copy_buf, line_length);
-                            start_offs += hres * sizeof(lv_color_t);
-                        }
-#endif
+                    for(y = inv_area->y1; y <= inv_area->y2; y++) {
+                        /* The frame buffer is probably in an external RAM where sequential access is much faster.
+                         * So first copy a line into a buffer and write it back the ext. RAM */
+                        _lv_memcpy(copy_buf, buf_ina + start_offs, line_length);
+                        _lv_memcpy(buf_act + start_offs, copy_buf, line_length);
+                        start_offs += hres * sizeof(lv_color_t);
                     }
+#endif
                 }
 
                 if(copy_buf) _lv_mem_buf_release(copy_buf);
@@ -259,9 +412,11 @@ void _lv_disp_refr_task(lv_task_t * task)
         } /*End of true double buffer handling*/
 
         /*Clean up*/
-        _lv_memset_00(disp_refr->inv_areas, sizeof(disp_refr->inv_areas));
-        _lv_memset_00(disp_refr->inv_area_joined, sizeof(disp_refr->inv_area_joined));
-        disp_refr->inv_p = 0;
+        lv_region_clear(&disp_refr->refr_region);
+
+#if LV_USE_PERF_STATS
+        _lv_perf_frame_end(perf_join_us);
+#endif
 
         elaps = lv_tick_elaps(start);
         /*Call monitor cb if present*/
@@ -333,74 +488,56 @@ uint32_t lv_refr_get_fps_avg(void)
  **********************/
 
 /**
- * Join the areas which has got common parts
+ * Move the pixels of the scrolled area of the display being refreshed.
+ * If the driver can't do it the area is added to the region to refresh.
  */
-static void lv_refr_join_area(void)
+static void lv_refr_scroll(void)
 {
-    uint32_t join_from;
-    uint32_t join_in;
-    lv_area_t joined_area;
-    for(join_in = 0; join_in < disp_refr->inv_p; join_in++) {
-        if(disp_refr->inv_area_joined[join_in] != 0) continue;
-
-        /*Check all areas to join them in 'join_in'*/
-        for(join_from = 0; join_from < disp_refr->inv_p; join_from++) {
-            /*Handle only unjoined areas and ignore itself*/
-            if(disp_refr->inv_area_joined[join_from] != 0 || join_in == join_from) {
-                continue;
-            }
+    disp_refr->scroll_pending = 0;
 
-            /*Check if the areas are on each other*/
-            if(_lv_area_is_on(&disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]) == false) {
-                continue;
-            }
-
-            _lv_area_join(&joined_area, &disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]);
-
-            /*Join two area only if the joined area size is smaller*/
-            if(lv_area_get_size(&joined_area) < (lv_area_get_size(&disp_refr->inv_areas[join_in]) +
-                                                 lv_area_get_size(&disp_refr->inv_areas[join_from]))) {
-                lv_area_copy(&disp_refr->inv_areas[join_in], &joined_area);
+    /*The pixels to move should be on the display already*/
+    lv_disp_buf_t * vdb = lv_disp_get_buf(disp_refr);
+    while(vdb->flushing) {
+        if(disp_refr->driver.wait_cb) disp_refr->driver.wait_cb(&disp_refr->driver);
+    }
 
-                /*Mark 'join_form' is joined into 'join_in'*/
-                disp_refr->inv_area_joined[join_from] = 1;
-            }
-        }
+    if(disp_refr->driver.copy_cb &&
+       disp_refr->driver.copy_cb(&disp_refr->driver, &disp_refr->scroll_area,
+                                 disp_refr->scroll_dx, disp_refr->scroll_dy)) {
+        return;
     }
+
+    lv_area_t area;
+    lv_area_copy(&area, &disp_refr->scroll_area);
+    if(disp_refr->driver.rounder_cb) disp_refr->driver.rounder_cb(&disp_refr->driver, &area);
+    lv_region_union_area(&disp_refr->refr_region, &area);
 }
 
 /**
- * Refresh the joined areas
+ * Refresh the rectangles of the invalid region
  */
 static void lv_refr_areas(void)
 {
     px_num = 0;
 
-    if(disp_refr->inv_p == 0) return;
-
-    /*Find the last area which will be drawn*/
-    int32_t i;
-    int32_t last_i = 0;
-    for(i = disp_refr->inv_p - 1; i >= 0; i--) {
-        if(disp_refr->inv_area_joined[i] == 0) {
-            last_i = i;
-            break;
-        }
-    }
+    if(lv_region_is_empty(&disp_refr->refr_region)) return;
 
     disp_refr->driver.buffer->last_area = 0;
     disp_refr->driver.buffer->last_part = 0;
 
-    for(i = 0; i < disp_refr->inv_p; i++) {
-        /*Refresh the unjoined areas*/
-        if(disp_refr->inv_area_joined[i] == 0) {
-
-            if(i == last_i) disp_refr->driver.buffer->last_area = 1;
-            disp_refr->driver.buffer->last_part = 0;
-            lv_refr_area(&disp_refr->inv_areas[i]);
+    uint32_t i;
+    for(i = 0; i < disp_refr->refr_region.cnt; i++) {
+        if(i == disp_refr->refr_region.cnt - 1) disp_refr->driver.buffer->last_area = 1;
+        disp_refr->driver.buffer->last_part = 0;
+#if LV_USE_PERF_STATS
+        _lv_perf_area_begin();
+        lv_refr_area(&disp_refr->refr_region.rects[i]);
+        _lv_perf_area_end();
+#else
+        lv_refr_area(&disp_refr->refr_region.rects[i]);
+#endif
 
-            px_num += lv_area_get_size(&disp_refr->inv_areas[i]);
-        }
+        px_num += lv_area_get_size(&disp_refr->refr_region.rects[i]);
     }
 }
 
@@ -503,9 +640,15 @@ static void lv_refr_area_part(const lv_area_t * area_p)
     /*In non double buffered mode, before rendering the next part wait until the previous image is
      * flushed*/
     if(lv_disp_is_double_buf(disp_refr) == false) {
+#if LV_USE_PERF_STATS
+        uint32_t perf_wait_us = _lv_perf_time_us();
+#endif
         while(vdb->flushing) {
             if(disp_refr->driver.wait_cb) disp_refr->driver.wait_cb(&disp_refr->driver);
         }
+#if LV_USE_PERF_STATS
+        _lv_perf_add_flush(_lv_perf_time_us() - perf_wait_us);
+#endif
     }
 
     lv_obj_t * top_act_scr = NULL;
@@ -522,8 +665,38 @@ static void lv_refr_area_part(const lv_area_t * area_p)
         top_prev_scr = lv_refr_get_top_obj(&start_mask, disp_refr->prev_scr);
     }
 
+    /*Mark the objects covered by opaque objects in front of them. Go front to back in the
+     *reverse order of drawing.*/
+    lv_region_clear(&disp_refr->occ_region);
+    lv_refr_occlusion(lv_disp_get_layer_sys(disp_refr), &start_mask, false);
+    lv_refr_occlusion(lv_disp_get_layer_top(disp_refr), &start_mask, false);
+    lv_refr_occlusion(disp_refr->act_scr, &start_mask, false);
+    if(disp_refr->prev_scr) lv_refr_occlusion(disp_refr->prev_scr, &start_mask, false);
+
+    /*Split the area part into bands if it can be rendered on several cores*/
+    bool drawn = false;
+#if LV_REFR_PARALLEL_MAX > 1
+    drawn = lv_refr_parallel(&start_mask, top_act_scr, top_prev_scr);
+#endif
+    if(drawn == false) lv_refr_layers(&start_mask, top_act_scr, top_prev_scr);
+
+    /* In true double buffered mode flush only once when all areas were rendered.
+     * In normal mode flush after every area */
+    if(lv_disp_is_true_double_buf(disp_refr) == false) {
+        lv_refr_vdb_flush();
+    }
+}
+
+/**
+ * Draw the background and the layers of the display being refreshed
+ * @param mask_p the area to draw. A part of the draw buffer's area.
+ * @param top_act_scr the top object of the active screen which covers `mask_p` or NULL
+ * @param top_prev_scr the top object of the previous screen which covers `mask_p` or NULL
+ */
+static void lv_refr_layers(const lv_area_t * mask_p, lv_obj_t * top_act_scr, lv_obj_t * top_prev_scr)
+{
     /*Draw a display background if there is no top object*/
-    if(top_act_scr == NULL && top_prev_scr == NULL) {
+    if(top_act_scr == NULL && top_prev_scr == NULL && lv_region_is_in(&disp_refr->occ_region, mask_p) == false) {
         if(disp_refr->bg_img) {
             lv_draw_img_dsc_t dsc;
             lv_draw_img_dsc_init(&dsc);
@@ -534,7 +707,7 @@ static void lv_refr_area_part(const lv_area_t * area_p)
             if(res == LV_RES_OK) {
                 lv_area_t a;
                 lv_area_set(&a, 0, 0, header.w - 1, header.h - 1);
-                lv_draw_img(&a, &start_mask, disp_refr->bg_img, &dsc);
+                lv_draw_img(&a, mask_p, disp_refr->bg_img, &dsc);
             }
             else {
                 LV_LOG_WARN("Can't draw the background image")
@@ -545,7 +718,7 @@ static void lv_refr_area_part(const lv_area_t * area_p)
             lv_draw_rect_dsc_init(&dsc);
             dsc.bg_color = disp_refr->bg_color;
             dsc.bg_opa = disp_refr->bg_opa;
-            lv_draw_rect(&start_mask, &start_mask, &dsc);
+            lv_draw_rect(mask_p, mask_p, &dsc);
 
         }
     }
@@ -556,7 +729,7 @@ static void lv_refr_area_part(const lv_area_t * area_p)
             top_prev_scr = disp_refr->prev_scr;
         }
         /*Do the refreshing from the top object*/
-        lv_refr_obj_and_children(top_prev_scr, &start_mask);
+        lv_refr_obj_and_children(top_prev_scr, mask_p);
 
     }
 
@@ -564,18 +737,78 @@ static void lv_refr_area_part(const lv_area_t * area_p)
         top_act_scr = disp_refr->act_scr;
     }
     /*Do the refreshing from the top object*/
-    lv_refr_obj_and_children(top_act_scr, &start_mask);
+    lv_refr_obj_and_children(top_act_scr, mask_p);
 
     /*Also refresh top and sys layer unconditionally*/
-    lv_refr_obj_and_children(lv_disp_get_layer_top(disp_refr), &start_mask);
-    lv_refr_obj_and_children(lv_disp_get_layer_sys(disp_refr), &start_mask);
+    lv_refr_obj_and_children(lv_disp_get_layer_top(disp_refr), mask_p);
+    lv_refr_obj_and_children(lv_disp_get_layer_sys(disp_refr), mask_p);
+}
 
-    /* In true double buffered mode flush only once when all areas were rendered.
-     * In normal mode flush after every area */
-    if(lv_disp_is_true_double_buf(disp_refr) == false) {
-        lv_refr_vdb_flush();
+#if LV_REFR_PARALLEL_MAX > 1
+/**
+ * Split an area into horizontal bands and render them on several cores with the display driver's `parallel_cb`.
+ * The bands which couldn't be rendered by a worker are rendered again on this core.
+ * @param mask_p the area to draw. A part of the draw buffer's area.
+ * @param top_act_scr the top object of the active screen which covers `mask_p` or NULL
+ * @param top_prev_scr the top object of the previous screen which covers `mask_p` or NULL
+ * @return true: `mask_p` is rendered; false: it should be rendered without the other cores
+ */
+static bool lv_refr_parallel(const lv_area_t * mask_p, lv_obj_t * top_act_scr, lv_obj_t * top_prev_scr)
+{
+    lv_disp_drv_t * drv = &disp_refr->driver;
+    if(drv->parallel_cb == NULL) return false;
+
+    uint32_t h = lv_area_get_height(mask_p);
+    uint32_t cnt = LV_MATH_MIN(drv->parallel_cnt, LV_REFR_PARALLEL_MAX);
+    cnt = LV_MATH_MIN(cnt, h / PARALLEL_BAND_MIN_ROWS);
+    cnt = LV_MATH_MIN(cnt, lv_area_get_size(mask_p) / PARALLEL_BAND_MIN_PX);
+    if(cnt < 2) return false;
+
+    /*Bands of (almost) equal height*/
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        lv_area_copy(&bands[i], mask_p);
+        bands[i].y1 = mask_p->y1 + (h * i) / cnt;
+        bands[i].y2 = mask_p->y1 + (h * (i + 1)) / cnt - 1;
     }
+    bands_top_act_scr = top_act_scr;
+    bands_top_prev_scr = top_prev_scr;
+
+    _lv_worker_begin(cnt);
+    bool res = drv->parallel_cb(drv, lv_refr_band, cnt);
+    _lv_worker_end();
+
+    /*The workers couldn't add to the caches, do it now for the next frames*/
+    _lv_draw_mask_radius_cache_add_missed();
+    _lv_draw_shadow_cache_add_missed();
+
+    if(res == false) return false;
+
+    for(i = 0; i < cnt; i++) {
+        if(_lv_worker_has_failed(i)) {
+            LV_LOG_TRACE("lv_refr_parallel: render a band again");
+            lv_refr_layers(&bands[i], top_act_scr, top_prev_scr);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Render a band. Called by the display driver's `parallel_cb` on each core.
+ * @param id index of the band, 0 is rendered by the core which refreshes the display
+ */
+static void lv_refr_band(uint32_t id)
+{
+    /*The stack position of the worker identifies it in the draw functions*/
+    uint8_t stack_mark;
+    _lv_worker_enter(id, &stack_mark);
+
+    lv_refr_layers(&bands[id], bands_top_act_scr, bands_top_prev_scr);
+
+    _lv_worker_leave(id);
 }
+#endif
 
 /**
  * Search the most top object which fully covers an area
@@ -619,6 +852,62 @@ static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj)
     return found_p;
 }
 
+/**
+ * Set the `occluded` flag of an object and its children: 1 if the part of the object
+ * which is visible in the clip area is covered by opaque objects in front of it.
+ * The covered parts of the opaque objects are added to `occ_region`. (Called recursively)
+ * @param obj pointer to an object
+ * @param clip_p the object is visible only here: the area part truncated to the parents
+ * @param masked true: a parent masks its children (e.g. with `clip_corner`), they can't cover
+ */
+static void lv_refr_occlusion(lv_obj_t * obj, const lv_area_t * clip_p, bool masked)
+{
+    if(obj == NULL || obj->hidden != 0) return;
+
+    /*The area where the object can draw, with its shadow, outline, etc*/
+    lv_area_t obj_area;
+    lv_area_t vis_area;
+    lv_obj_get_coords(obj, &obj_area);
+    obj_area.x1 -= obj->ext_draw_pad;
+    obj_area.y1 -= obj->ext_draw_pad;
+    obj_area.x2 += obj->ext_draw_pad;
+    obj_area.y2 += obj->ext_draw_pad;
+
+    obj->occluded = 0;
+    if(_lv_area_intersect(&vis_area, clip_p, &obj_area) == false) return;
+
+    /*Skip the object and its children if everything they could draw is covered*/
+    if(lv_region_is_in(&disp_refr->occ_region, &vis_area)) {
+        obj->occluded = 1;
+        return;
+    }
+
+    /*The children are visible only on the object*/
+    lv_area_t obj_clip;
+    if(_lv_area_intersect(&obj_clip, clip_p, &obj->coords) == false) return;
+
+    lv_design_res_t design_res = LV_DESIGN_RES_MASKED;
+    if(!masked && obj->design_cb) {
+        design_res = obj->design_cb(obj, &obj_clip, LV_DESIGN_COVER_CHK);
+#if LV_USE_OPA_SCALE
+        if(design_res == LV_DESIGN_RES_COVER && lv_obj_get_style_opa_scale(obj, LV_OBJ_PART_MAIN) != LV_OPA_COVER) {
+            design_res = LV_DESIGN_RES_NOT_COVER;
+        }
+#endif
+    }
+
+    /*The children are in front of the object: the first in the list is the top most*/
+    lv_obj_t * child;
+    _LV_LL_READ(obj->child_ll, child) {
+        lv_refr_occlusion(child, &obj_clip, design_res == LV_DESIGN_RES_MASKED);
+    }
+
+    /*The object covers what's behind it. If there is no memory the region is not reliable.*/
+    if(design_res == LV_DESIGN_RES_COVER && disp_refr->occ_region.cnt < OCC_REGION_MAX_CNT) {
+        if(lv_region_union_area(&disp_refr->occ_region, &obj_clip) == false) lv_region_clear(&disp_refr->occ_region);
+    }
+}
+
 /**
  * Make the refreshing from an object. Draw all its children and the youngers too.
  * @param top_p pointer to an objects. Start the drawing from it.
@@ -653,7 +942,7 @@ static void lv_refr_obj_and_children(lv_obj_t * top_p, const lv_area_t * mask_p)
         }
 
         /*Call the post draw design function of the parents of the to object*/
-        if(par->design_cb) par->design_cb(par, mask_p, LV_DESIGN_DRAW_POST);
+        if(par->design_cb) lv_refr_design(par, mask_p, LV_DESIGN_DRAW_POST);
 
         /*The new border will be there last parents,
          *so the 'younger' brothers of parent will be refreshed*/
@@ -670,8 +959,18 @@ static void lv_refr_obj_and_children(lv_obj_t * top_p, const lv_area_t * mask_p)
  */
 static void lv_refr_obj(lv_obj_t * obj, const lv_area_t * mask_ori_p)
 {
-    /*Do not refresh hidden objects*/
-    if(obj->hidden != 0) return;
+    /*Do not refresh hidden objects and the ones covered by opaque objects*/
+    if(obj->hidden != 0 || obj->occluded != 0) return;
+
+#if LV_REFR_PARALLEL_MAX > 1
+    if(_lv_worker_is_parallel()) {
+        /*Allocate memory for the other workers if they wait for it*/
+        _lv_worker_serve();
+
+        /*This band will be rendered again, don't waste time on it*/
+        if(_lv_worker_has_failed(_lv_worker_get_id())) return;
+    }
+#endif
 
     bool union_ok; /* Store the return value of area_union */
     /* Truncate the original mask to the coordinates of the parent
@@ -691,7 +990,7 @@ static void lv_refr_obj(lv_obj_t * obj, const lv_area_t * mask_ori_p)
     if(union_ok != false) {
 
         /* Redraw the object */
-        if(obj->design_cb) obj->design_cb(obj, &obj_ext_mask, LV_DESIGN_DRAW_MAIN);
+        if(obj->design_cb) lv_refr_design(obj, &obj_ext_mask, LV_DESIGN_DRAW_MAIN);
 
 #if MASK_AREA_DEBUG
         static lv_color_t debug_color = LV_COLOR_RED;
@@ -737,7 +1036,7 @@ static void lv_refr_obj(lv_obj_t * obj, const lv_area_t * mask_ori_p)
         }
 
         /* If all the children are redrawn make 'post draw' design */
-        if(obj->design_cb) obj->design_cb(obj, &obj_ext_mask, LV_DESIGN_DRAW_POST);
+        if(obj->design_cb) lv_refr_design(obj, &obj_ext_mask, LV_DESIGN_DRAW_POST);
     }
 }
 
@@ -746,6 +1045,10 @@ static void lv_refr_obj(lv_obj_t * obj, const lv_area_t * mask_ori_p)
  */
 static void lv_refr_vdb_flush(void)
 {
+#if LV_USE_PERF_STATS
+    uint32_t perf_start = _lv_perf_time_us();
+#endif
+
     lv_disp_buf_t * vdb = lv_disp_get_buf(disp_refr);
 
     /*In double buffered mode wait until the other buffer is flushed before flushing the current
@@ -773,4 +1076,26 @@ static void lv_refr_vdb_flush(void)
         else
             vdb->buf_act = vdb->buf1;
     }
+
+#if LV_USE_PERF_STATS
+    _lv_perf_add_flush(_lv_perf_time_us() - perf_start);
+#endif
+}
+
+/**
+ * Call the design callback of an object to draw it.
+ * Adds the time of the call to the statistics if `LV_USE_PERF_STATS` is enabled.
+ * @param obj pointer to an object
+ * @param clip_area the object can draw only here
+ * @param mode LV_DESIGN_DRAW_MAIN or LV_DESIGN_DRAW_POST
+ */
+static void lv_refr_design(lv_obj_t * obj, const lv_area_t * clip_area, lv_design_mode_t mode)
+{
+#if LV_USE_PERF_STATS
+    uint32_t perf_start = _lv_perf_time_us();
+    obj->design_cb(obj, clip_area, mode);
+    _lv_perf_add_design(obj, _lv_perf_time_us() - perf_start);
+#else
+    obj->design_cb(obj, clip_area, mode);
+#endif
 }
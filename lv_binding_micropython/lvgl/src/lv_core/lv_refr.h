@@ -64,6 +64,17 @@ void lv_refr_now(lv_disp_t * disp);
  */
 void _lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p);
 
+/**
+ * Scroll the content of an area on a display. If the driver can move pixels (`copy_cb`) the pixels
+ * already on the display are moved in the next refresh and only the uncovered strips are redrawn.
+ * Else the area is invalidated.
+ * @param disp pointer to display (NULL can be used if there is only one display)
+ * @param area_p the area to scroll. Nothing else but the moving content should be drawn here.
+ * @param dx horizontal movement of the content
+ * @param dy vertical movement of the content
+ */
+void _lv_scroll_area(lv_disp_t * disp, const lv_area_t * area_p, lv_coord_t dx, lv_coord_t dy);
+
 /**
  * Get the display which is being refreshed
  * @return the display being refreshed
@@ -78,6 +89,13 @@ lv_disp_t * _lv_refr_get_disp_refreshing(void);
  */
 void _lv_refr_set_disp_refreshing(lv_disp_t * disp);
 
+/**
+ * Get the region which is being refreshed on the display being refreshed.
+ * Areas invalidated meanwhile are collected for the next refresh.
+ * @return the region being refreshed
+ */
+const lv_region_t * _lv_refr_get_inv_region(void);
+
 #if LV_USE_PERF_MONITOR
 /**
  * Get the average FPS since start up
@@ -7,10 +7,12 @@
  *      INCLUDES
  *********************/
 #include "lv_draw_blend.h"
+#include "lv_draw_blend_simd.h"
 #include "lv_img_decoder.h"
 #include "../lv_misc/lv_math.h"
 #include "../lv_hal/lv_hal_disp.h"
 #include "../lv_core/lv_refr.h"
+#include "../lv_core/lv_perf.h"
 
 #if LV_USE_GPU_NXP_PXP
     #include "../lv_gpu/lv_gpu_nxp_pxp.h"
@@ -25,6 +27,13 @@
  *********************/
 #define GPU_SIZE_LIMIT      240
 
+/*The SIMD kernels don't handle the alpha channel of transparent screens*/
+#if LV_COLOR_SCREEN_TRANSP
+    #define SIMD_MIX_ALLOWED(disp)  ((disp)->driver.screen_transp == 0)
+#else
+    #define SIMD_MIX_ALLOWED(disp)  true
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -62,6 +71,7 @@ static void map_blended(const lv_area_t * disp_area, lv_color_t * disp_buf,  con
                         const lv_area_t * map_area, const lv_color_t * map_buf, lv_opa_t opa,
                         const lv_opa_t * mask, lv_draw_mask_res_t mask_res, lv_blend_mode_t mode);
 
+static inline lv_color_t color_blend_true_color(lv_color_t fg, lv_color_t bg, lv_opa_t opa, lv_blend_mode_t mode);
 static inline lv_color_t color_blend_true_color_additive(lv_color_t fg, lv_color_t bg, lv_opa_t opa);
 static inline lv_color_t color_blend_true_color_subtractive(lv_color_t fg, lv_color_t bg, lv_opa_t opa);
 #endif
@@ -149,6 +159,10 @@ LV_ATTRIBUTE_FAST_MEM void _lv_blend_fill(const lv_area_t * clip_area, const lv_
     is_common = _lv_area_intersect(&draw_area, clip_area, fill_area);
     if(!is_common) return;
 
+#if LV_USE_PERF_STATS
+    _lv_perf_add_blend_px(lv_area_get_size(&draw_area));
+#endif
+
     /* Now `draw_area` has absolute coordinates.
      * Make it relative to `disp_area` to simplify draw to `disp_buf`*/
     draw_area.x1 -= disp_area->x1;
@@ -210,6 +224,10 @@ LV_ATTRIBUTE_FAST_MEM void _lv_blend_map(const lv_area_t * clip_area, const lv_a
     is_common = _lv_area_intersect(&draw_area, clip_area, map_area);
     if(!is_common) return;
 
+#if LV_USE_PERF_STATS
+    _lv_perf_add_blend_px(lv_area_get_size(&draw_area));
+#endif
+
     lv_disp_t * disp = _lv_refr_get_disp_refreshing();
     lv_disp_buf_t * vdb = lv_disp_get_buf(disp);
     const lv_area_t * disp_area = &vdb->area;
@@ -353,6 +371,9 @@ LV_ATTRIBUTE_FAST_MEM static void fill_normal(const lv_area_t * disp_area, lv_co
                 disp->driver.gpu_fill_cb(&disp->driver, disp_buf, disp_w, draw_area, color);
                 return;
             }
+#endif
+#if LV_USE_BLEND_SIMD
+            if(_lv_blend_simd_fill(disp_buf_first, disp_w, draw_area_w, draw_area_h, color, opa, NULL)) return;
 #endif
             /*Software rendering*/
             for(y = 0; y < draw_area_h; y++) {
@@ -405,6 +426,11 @@ LV_ATTRIBUTE_FAST_MEM static void fill_normal(const lv_area_t * disp_area, lv_co
                 return;
             }
 #endif
+
+#if LV_USE_BLEND_SIMD
+            if(SIMD_MIX_ALLOWED(disp) &&
+               _lv_blend_simd_fill(disp_buf_first, disp_w, draw_area_w, draw_area_h, color, opa, NULL)) return;
+#endif
             lv_color_t last_dest_color = LV_COLOR_BLACK;
             lv_color_t last_res_color = lv_color_mix(color, last_dest_color, opa);
 
@@ -444,6 +470,11 @@ LV_ATTRIBUTE_FAST_MEM static void fill_normal(const lv_area_t * disp_area, lv_co
         }
 #endif
 
+#if LV_USE_BLEND_SIMD
+        if(SIMD_MIX_ALLOWED(disp) &&
+           _lv_blend_simd_fill(disp_buf_first, disp_w, draw_area_w, draw_area_h, color, opa, mask)) return;
+#endif
+
         /*Buffer the result color to avoid recalculating the same color*/
         lv_color_t last_dest_color;
         lv_color_t last_res_color;
@@ -574,31 +605,29 @@ static void fill_blended(const lv_area_t * disp_area, lv_color_t * disp_buf,  co
     /*Create a temp. disp_buf which always point to current line to draw*/
     lv_color_t * disp_buf_tmp = disp_buf + disp_w * draw_area->y1;
 
-    lv_color_t (*blend_fp)(lv_color_t, lv_color_t, lv_opa_t);
-    switch(mode) {
-        case LV_BLEND_MODE_ADDITIVE:
-            blend_fp = color_blend_true_color_additive;
-            break;
-        case LV_BLEND_MODE_SUBTRACTIVE:
-            blend_fp = color_blend_true_color_subtractive;
-            break;
-        default:
-            LV_LOG_WARN("fill_blended: unsupported blend mode");
-            return;
+    if(mode != LV_BLEND_MODE_ADDITIVE && mode != LV_BLEND_MODE_SUBTRACTIVE) {
+        LV_LOG_WARN("fill_blended: unsupported blend mode");
+        return;
     }
 
+#if LV_USE_BLEND_SIMD
+    if(_lv_blend_simd_fill_blended(disp_buf_tmp + draw_area->x1, disp_w,
+                                   lv_area_get_width(draw_area), lv_area_get_height(draw_area), color, opa,
+                                   mask_res == LV_DRAW_MASK_RES_FULL_COVER ? NULL : mask, mode)) return;
+#endif
+
     int32_t x;
     int32_t y;
 
     /*Simple fill (maybe with opacity), no masking*/
     if(mask_res == LV_DRAW_MASK_RES_FULL_COVER) {
         lv_color_t last_dest_color = LV_COLOR_BLACK;
-        lv_color_t last_res_color = lv_color_mix(color, last_dest_color, opa);
+        lv_color_t last_res_color = color_blend_true_color(color, last_dest_color, opa, mode);
         for(y = draw_area->y1; y <= draw_area->y2; y++) {
             for(x = draw_area->x1; x <= draw_area->x2; x++) {
                 if(last_dest_color.full != disp_buf_tmp[x].full) {
                     last_dest_color = disp_buf_tmp[x];
-                    last_res_color = blend_fp(color, disp_buf_tmp[x], opa);
+                    last_res_color = color_blend_true_color(color, disp_buf_tmp[x], opa, mode);
                 }
                 disp_buf_tmp[x] = last_res_color;
             }
@@ -628,7 +657,7 @@ static void fill_blended(const lv_area_t * disp_area, lv_color_t * disp_buf,  co
                 if(mask_tmp[x] != last_mask || last_dest_color.full != disp_buf_tmp[x].full) {
                     lv_opa_t opa_tmp = mask_tmp[x] >= LV_OPA_MAX ? opa : (uint32_t)((uint32_t)mask_tmp[x] * opa) >> 8;
 
-                    last_res_color = blend_fp(color, disp_buf_tmp[x], opa_tmp);
+                    last_res_color = color_blend_true_color(color, disp_buf_tmp[x], opa_tmp, mode);
                     last_mask = mask_tmp[x];
                     last_dest_color.full = disp_buf_tmp[x].full;
                 }
@@ -790,6 +819,9 @@ LV_ATTRIBUTE_FAST_MEM static void map_normal(const lv_area_t * disp_area, lv_col
             }
 #endif
 
+#if LV_USE_BLEND_SIMD
+            if(_lv_blend_simd_map(disp_buf_first, disp_w, map_buf_first, map_w, draw_area_w, draw_area_h, opa, NULL)) return;
+#endif
             /*Software rendering*/
             for(y = 0; y < draw_area_h; y++) {
                 _lv_memcpy(disp_buf_first, map_buf_first, draw_area_w * sizeof(lv_color_t));
@@ -840,6 +872,11 @@ LV_ATTRIBUTE_FAST_MEM static void map_normal(const lv_area_t * disp_area, lv_col
             }
 #endif
 
+#if LV_USE_BLEND_SIMD
+            if(SIMD_MIX_ALLOWED(disp) &&
+               _lv_blend_simd_map(disp_buf_first, disp_w, map_buf_first, map_w, draw_area_w, draw_area_h, opa, NULL)) return;
+#endif
+
             /*Software rendering*/
 
             for(y = 0; y < draw_area_h; y++) {
@@ -862,6 +899,11 @@ LV_ATTRIBUTE_FAST_MEM static void map_normal(const lv_area_t * disp_area, lv_col
     }
     /*Masked*/
     else {
+#if LV_USE_BLEND_SIMD
+        if(SIMD_MIX_ALLOWED(disp) &&
+           _lv_blend_simd_map(disp_buf_first, disp_w, map_buf_first, map_w, draw_area_w, draw_area_h, opa, mask)) return;
+#endif
+
         /*Only the mask matters*/
         if(opa > LV_OPA_MAX) {
             /*Go to the first pixel of the row */
@@ -970,33 +1012,31 @@ static void map_blended(const lv_area_t * disp_area, lv_color_t * disp_buf,  con
     /*Create a temp. map_buf which always point to current line to draw*/
     const lv_color_t * map_buf_tmp = map_buf + map_w * (draw_area->y1 - (map_area->y1 - disp_area->y1));
 
-    lv_color_t (*blend_fp)(lv_color_t, lv_color_t, lv_opa_t);
-    switch(mode) {
-        case LV_BLEND_MODE_ADDITIVE:
-            blend_fp = color_blend_true_color_additive;
-            break;
-        case LV_BLEND_MODE_SUBTRACTIVE:
-            blend_fp = color_blend_true_color_subtractive;
-            break;
-        default:
-            LV_LOG_WARN("fill_blended: unsupported blend mode");
-            return;
+    /*Go to the first px of the row*/
+    map_buf_tmp += (draw_area->x1 - (map_area->x1 - disp_area->x1));
+
+    if(mode != LV_BLEND_MODE_ADDITIVE && mode != LV_BLEND_MODE_SUBTRACTIVE) {
+        LV_LOG_WARN("map_blended: unsupported blend mode");
+        return;
     }
 
+#if LV_USE_BLEND_SIMD
+    if(_lv_blend_simd_map_blended(disp_buf_tmp + draw_area->x1, disp_w, map_buf_tmp, map_w,
+                                  draw_area_w, lv_area_get_height(draw_area), opa,
+                                  mask_res == LV_DRAW_MASK_RES_FULL_COVER ? NULL : mask, mode)) return;
+#endif
+
+    /*The map will be indexed from `draw_area->x1` so compensate it.*/
+    map_buf_tmp -= draw_area->x1;
+
     int32_t x;
     int32_t y;
 
     /*Simple fill (maybe with opacity), no masking*/
     if(mask_res == LV_DRAW_MASK_RES_FULL_COVER) {
-        /*Go to the first px of the row*/
-        map_buf_tmp += (draw_area->x1 - (map_area->x1 - disp_area->x1));
-
-        /*The map will be indexed from `draw_area->x1` so compensate it.*/
-        map_buf_tmp -= draw_area->x1;
-
         for(y = draw_area->y1; y <= draw_area->y2; y++) {
             for(x = draw_area->x1; x <= draw_area->x2; x++) {
-                disp_buf_tmp[x] = blend_fp(map_buf_tmp[x], disp_buf_tmp[x], opa);
+                disp_buf_tmp[x] = color_blend_true_color(map_buf_tmp[x], disp_buf_tmp[x], opa, mode);
             }
             disp_buf_tmp += disp_w;
             map_buf_tmp += map_w;
@@ -1009,12 +1049,11 @@ static void map_blended(const lv_area_t * disp_area, lv_color_t * disp_buf,  con
          * but it corresponds to zero index. So prepare `mask_tmp` accordingly. */
         const lv_opa_t * mask_tmp = mask - draw_area->x1;
 
-        map_buf_tmp -= draw_area->x1;
         for(y = draw_area->y1; y <= draw_area->y2; y++) {
             for(x = draw_area->x1; x <= draw_area->x2; x++) {
                 if(mask_tmp[x] == 0) continue;
                 lv_opa_t opa_tmp = mask_tmp[x] >= LV_OPA_MAX ? opa : ((opa * mask_tmp[x]) >> 8);
-                disp_buf_tmp[x] = blend_fp(map_buf_tmp[x], disp_buf_tmp[x], opa_tmp);
+                disp_buf_tmp[x] = color_blend_true_color(map_buf_tmp[x], disp_buf_tmp[x], opa_tmp, mode);
             }
             disp_buf_tmp += disp_w;
             mask_tmp += draw_area_w;
@@ -1023,6 +1062,16 @@ static void map_blended(const lv_area_t * disp_area, lv_color_t * disp_buf,  con
     }
 }
 
+/**
+ * Blend a color with the additive or subtractive mode.
+ * Inlined in the loops so the mode is a predictable branch instead of a call through a pointer.
+ */
+static inline lv_color_t color_blend_true_color(lv_color_t fg, lv_color_t bg, lv_opa_t opa, lv_blend_mode_t mode)
+{
+    if(mode == LV_BLEND_MODE_SUBTRACTIVE) return color_blend_true_color_subtractive(fg, bg, opa);
+    else return color_blend_true_color_additive(fg, bg, opa);
+}
+
 static inline lv_color_t color_blend_true_color_additive(lv_color_t fg, lv_color_t bg, lv_opa_t opa)
 {
 
@@ -1043,6 +1092,7 @@ static inline lv_color_t color_blend_true_color_additive(lv_color_t fg, lv_color
 #endif
 
 #if LV_COLOR_DEPTH == 8
+    tmp = bg.ch.green + fg.ch.green;
     fg.ch.green = LV_MATH_MIN(tmp, 7);
 #elif LV_COLOR_DEPTH == 16
 #if LV_COLOR_16_SWAP == 0
@@ -1056,12 +1106,13 @@ static inline lv_color_t color_blend_true_color_additive(lv_color_t fg, lv_color
 #endif
 
 #elif LV_COLOR_DEPTH == 32
+    tmp = bg.ch.green + fg.ch.green;
     fg.ch.green = LV_MATH_MIN(tmp, 255);
 #endif
 
     tmp = bg.ch.blue + fg.ch.blue;
 #if LV_COLOR_DEPTH == 8
-    fg.ch.blue = LV_MATH_MIN(tmp, 4);
+    fg.ch.blue = LV_MATH_MIN(tmp, 3);
 #elif LV_COLOR_DEPTH == 16
     fg.ch.blue = LV_MATH_MIN(tmp, 31);
 #elif LV_COLOR_DEPTH == 32
@@ -1087,7 +1138,7 @@ static inline lv_color_t color_blend_true_color_subtractive(lv_color_t fg, lv_co
     tmp = bg.ch.green - fg.ch.green;
     fg.ch.green = LV_MATH_MAX(tmp, 0);
 #else
-    tmp = (bg.ch.green_h << 3) + bg.ch.green_l + (fg.ch.green_h << 3) + fg.ch.green_l;
+    tmp = (bg.ch.green_h << 3) + bg.ch.green_l - (fg.ch.green_h << 3) - fg.ch.green_l;
     tmp = LV_MATH_MAX(tmp, 0);
     fg.ch.green_h = tmp >> 3;
     fg.ch.green_l = tmp & 0x7;
@@ -0,0 +1,1074 @@
+/**
+ * @file lv_draw_blend_simd.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stddef.h>
+#include "lv_draw_blend_simd.h"
+
+#if LV_USE_BLEND_SIMD
+
+#if (LV_COLOR_DEPTH == 32 || (LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP == 0)) && (defined(__x86_64__) || defined(_M_X64))
+    #define BLEND_SIMD_X64  1
+#else
+    #define BLEND_SIMD_X64  0
+#endif
+
+#if BLEND_SIMD_X64
+#include <string.h>
+#include <emmintrin.h>
+#include <immintrin.h>
+#ifdef _MSC_VER
+    #include <intrin.h>
+#else
+    #include <cpuid.h>
+#endif
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+#if BLEND_SIMD_X64
+#ifdef __GNUC__
+    #define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+    #define TARGET_AVX2
+#endif
+
+/*Pixels in a vector*/
+#define PX_SSE2     (16 / (int32_t)sizeof(lv_color_t))
+#define PX_AVX2     (32 / (int32_t)sizeof(lv_color_t))
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef void (*blended_row_t)(lv_color_t * dest, const lv_color_t * src, int32_t src_inc, const lv_opa_t * mask,
+                              lv_opa_t opa, int32_t len);
+
+/**
+ * Row kernels of an instruction set.
+ * `blend` and the blended modes read the source with a step of `src_inc` (0: the same pixels for a fill, 1: a map).
+ * Mask values from `mask_max` mean `opa`, smaller ones scale it (`fill_normal` and `map_normal` differ in this).
+ * The normal mode has kernels only for 32 bit colors, else its fields are NULL.
+ */
+typedef struct {
+    void (*fill)(lv_color_t * dest, lv_color_t color, int32_t len);
+    void (*copy)(lv_color_t * dest, const lv_color_t * src, int32_t len);
+    void (*blend)(lv_color_t * dest, const lv_color_t * src, int32_t src_inc, const lv_opa_t * mask,
+                  lv_opa_t opa, lv_opa_t mask_max, int32_t len);
+    blended_row_t additive;
+    blended_row_t subtractive;
+} kernels_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if BLEND_SIMD_X64
+static void cpuid(uint32_t leaf, uint32_t subleaf, uint32_t regs[4]);
+static lv_blend_simd_t cpu_simd(void);
+static inline bool mask_transp(const lv_opa_t * mask, int32_t n);
+
+#if LV_COLOR_DEPTH == 32
+static void fill_row_sse2(lv_color_t * dest, lv_color_t color, int32_t len);
+static void copy_row_sse2(lv_color_t * dest, const lv_color_t * src, int32_t len);
+static void blend_row_sse2(lv_color_t * dest, const lv_color_t * src, int32_t src_inc, const lv_opa_t * mask,
+                           lv_opa_t opa, lv_opa_t mask_max, int32_t len);
+static void blend_tail_sse2(lv_color_t * dest, const lv_color_t * src, int32_t src_inc, const lv_opa_t * mask,
+                            lv_opa_t opa, lv_opa_t mask_max, int32_t len);
+#endif
+static void additive_row_sse2(lv_color_t * dest, const lv_color_t * src, int32_t src_inc, const lv_opa_t * mask,
+                              lv_opa_t opa, int32_t len);
+static void subtractive_row_sse2(lv_color_t * dest, const lv_color_t * src, int32_t src_inc, const lv_opa_t * mask,
+                                 lv_opa_t opa, int32_t len);
+static void blended_tail_sse2(lv_color_t * dest, const lv_color_t * src, int32_t src_inc, const lv_opa_t * mask,
+                              lv_opa_t opa, int32_t len, bool sub);
+
+#if LV_COLOR_DEPTH == 32
+TARGET_AVX2 static void fill_row_avx2(lv_color_t * dest, lv_color_t color, int32_t len);
+TARGET_AVX2 static void copy_row_avx2(lv_color_t * dest, const lv_color_t * src, int32_t len);
+TARGET_AVX2 static void blend_row_avx2(lv_color_t * dest, const lv_color_t * src, int32_t src_inc,
+                                       const lv_opa_t * mask, lv_opa_t opa, lv_opa_t mask_max, int32_t len);
+#endif
+TARGET_AVX2 static void additive_row_avx2(lv_color_t * dest, const lv_color_t * src, int32_t src_inc,
+                                          const lv_opa_t * mask, lv_opa_t opa, int32_t len);
+TARGET_AVX2 static void subtractive_row_avx2(lv_color_t * dest, const lv_color_t * src, int32_t src_inc,
+                                             const lv_opa_t * mask, lv_opa_t opa, int32_t len);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#if BLEND_SIMD_X64
+#if LV_COLOR_DEPTH == 32
+static const kernels_t kernels_sse2 = {fill_row_sse2, copy_row_sse2, blend_row_sse2,
+                                       additive_row_sse2, subtractive_row_sse2
+                                      };
+static const kernels_t kernels_avx2 = {fill_row_avx2, copy_row_avx2, blend_row_avx2,
+                                       additive_row_avx2, subtractive_row_avx2
+                                      };
+#else
+static const kernels_t kernels_sse2 = {NULL, NULL, NULL, additive_row_sse2, subtractive_row_sse2};
+static const kernels_t kernels_avx2 = {NULL, NULL, NULL, additive_row_avx2, subtractive_row_avx2};
+#endif
+#endif
+
+static const kernels_t * kernels;
+static lv_blend_simd_t simd_act;
+static lv_blend_simd_t simd_max;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Select the best kernels for the CPU. Called by `lv_init()`.
+ */
+void _lv_blend_simd_init(void)
+{
+#if BLEND_SIMD_X64
+    simd_max = cpu_simd();
+#else
+    simd_max = LV_BLEND_SIMD_NONE;
+#endif
+    _lv_blend_simd_set(simd_max);
+}
+
+/**
+ * Select the kernels to use, e.g. to compare them with the scalar code
+ * @param simd the kernels to use. Limited to the best ones supported by the CPU and the build.
+ * @return the kernels really selected
+ */
+lv_blend_simd_t _lv_blend_simd_set(lv_blend_simd_t simd)
+{
+    if(simd > simd_max) simd = simd_max;
+
+    kernels = NULL;
+#if BLEND_SIMD_X64
+    if(simd == LV_BLEND_SIMD_SSE2) kernels = &kernels_sse2;
+    else if(simd == LV_BLEND_SIMD_AVX2) kernels = &kernels_avx2;
+#endif
+
+    simd_act = simd;
+    return simd;
+}
+
+/**
+ * Get the selected kernels
+ * @return `LV_BLEND_SIMD_NONE` if the scalar code is used
+ */
+lv_blend_simd_t _lv_blend_simd_get(void)
+{
+    return simd_act;
+}
+
+/**
+ * Get the name of the kernels
+ * @param simd the kernels
+ * @return "none", "sse2" or "avx2"
+ */
+const char * _lv_blend_simd_name(lv_blend_simd_t simd)
+{
+    switch(simd) {
+        case LV_BLEND_SIMD_SSE2:
+            return "sse2";
+        case LV_BLEND_SIMD_AVX2:
+            return "avx2";
+        default:
+            return "none";
+    }
+}
+
+/**
+ * Fill an area of a buffer with a color like `fill_normal()`
+ * @param dest the first pixel of the area
+ * @param dest_stride width of the destination buffer in pixels
+ * @param w width of the area
+ * @param h height of the area
+ * @param color fill color
+ * @param opa overall opacity
+ * @param mask `w * h` mask values or NULL if there is no mask
+ * @return false: no kernels are selected, the scalar code should be used
+ */
+bool _lv_blend_simd_fill(lv_color_t * dest, int32_t dest_stride, int32_t w, int32_t h,
+                         lv_color_t color, lv_opa_t opa, const lv_opa_t * mask)
+{
+    if(kernels == NULL || kernels->fill == NULL) return false;
+
+    int32_t y;
+    if(mask == NULL && opa > LV_OPA_MAX) {
+        for(y = 0; y < h; y++) {
+            kernels->fill(dest, color, w);
+            dest += dest_stride;
+        }
+        return true;
+    }
+
+    /*`blend` reads 8 pixels at once from the source*/
+    lv_color_t color_buf[8];
+    int32_t i;
+    for(i = 0; i < 8; i++) color_buf[i] = color;
+
+    for(y = 0; y < h; y++) {
+        kernels->blend(dest, color_buf, 0, mask, opa, LV_OPA_COVER, w);
+        dest += dest_stride;
+        if(mask) mask += w;
+    }
+
+    return true;
+}
+
+/**
+ * Copy an area of a map to a buffer like `map_normal()`
+ * @param dest the first pixel of the destination area
+ * @param dest_stride width of the destination buffer in pixels
+ * @param src the first pixel of the source area
+ * @param src_stride width of the map in pixels
+ * @param w width of the area
+ * @param h height of the area
+ * @param opa overall opacity
+ * @param mask `w * h` mask values or NULL if there is no mask
+ * @return false: no kernels are selected, the scalar code should be used
+ */
+bool _lv_blend_simd_map(lv_color_t * dest, int32_t dest_stride, const lv_color_t * src, int32_t src_stride,
+                        int32_t w, int32_t h, lv_opa_t opa, const lv_opa_t * mask)
+{
+    if(kernels == NULL || kernels->copy == NULL) return false;
+
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        if(mask == NULL && opa > LV_OPA_MAX) kernels->copy(dest, src, w);
+        else kernels->blend(dest, src, 1, mask, opa, LV_OPA_MAX, w);
+
+        dest += dest_stride;
+        src += src_stride;
+        if(mask) mask += w;
+    }
+
+    return true;
+}
+
+#if LV_USE_BLEND_MODES
+/**
+ * Fill an area of a buffer with a color like `fill_blended()`
+ * @param dest the first pixel of the area
+ * @param dest_stride width of the destination buffer in pixels
+ * @param w width of the area
+ * @param h height of the area
+ * @param color fill color
+ * @param opa overall opacity
+ * @param mask `w * h` mask values or NULL if there is no mask
+ * @param mode `LV_BLEND_MODE_ADDITIVE` or `LV_BLEND_MODE_SUBTRACTIVE`
+ * @return false: no kernels are selected, the scalar code should be used
+ */
+bool _lv_blend_simd_fill_blended(lv_color_t * dest, int32_t dest_stride, int32_t w, int32_t h,
+                                 lv_color_t color, lv_opa_t opa, const lv_opa_t * mask, lv_blend_mode_t mode)
+{
+    if(kernels == NULL) return false;
+
+    blended_row_t row = mode == LV_BLEND_MODE_SUBTRACTIVE ? kernels->subtractive : kernels->additive;
+
+    /*The kernels read a 256 bit vector at once from the source*/
+    lv_color_t color_buf[32 / sizeof(lv_color_t)];
+    uint32_t i;
+    for(i = 0; i < sizeof(color_buf) / sizeof(color_buf[0]); i++) color_buf[i] = color;
+
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        row(dest, color_buf, 0, mask, opa, w);
+        dest += dest_stride;
+        if(mask) mask += w;
+    }
+
+    return true;
+}
+
+/**
+ * Blend an area of a map to a buffer like `map_blended()`
+ * @param dest the first pixel of the destination area
+ * @param dest_stride width of the destination buffer in pixels
+ * @param src the first pixel of the source area
+ * @param src_stride width of the map in pixels
+ * @param w width of the area
+ * @param h height of the area
+ * @param opa overall opacity
+ * @param mask `w * h` mask values or NULL if there is no mask
+ * @param mode `LV_BLEND_MODE_ADDITIVE` or `LV_BLEND_MODE_SUBTRACTIVE`
+ * @return false: no kernels are selected, the scalar code should be used
+ */
+bool _lv_blend_simd_map_blended(lv_color_t * dest, int32_t dest_stride, const lv_color_t * src, int32_t src_stride,
+                                int32_t w, int32_t h, lv_opa_t opa, const lv_opa_t * mask, lv_blend_mode_t mode)
+{
+    if(kernels == NULL) return false;
+
+    blended_row_t row = mode == LV_BLEND_MODE_SUBTRACTIVE ? kernels->subtractive : kernels->additive;
+
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        row(dest, src, 1, mask, opa, w);
+        dest += dest_stride;
+        src += src_stride;
+        if(mask) mask += w;
+    }
+
+    return true;
+}
+#endif /*LV_USE_BLEND_MODES*/
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if BLEND_SIMD_X64
+
+static void cpuid(uint32_t leaf, uint32_t subleaf, uint32_t regs[4])
+{
+#ifdef _MSC_VER
+    int r[4];
+    __cpuidex(r, (int)leaf, (int)subleaf);
+    regs[0] = r[0];
+    regs[1] = r[1];
+    regs[2] = r[2];
+    regs[3] = r[3];
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+/**
+ * Get the best kernels for the CPU. SSE2 is part of x86-64.
+ * AVX2 is usable only if the CPU has it and XCR0 enables the YMM state
+ * (firmware doesn't always set up the latter).
+ */
+static lv_blend_simd_t cpu_simd(void)
+{
+    uint32_t regs[4];
+
+    cpuid(0, 0, regs);
+    if(regs[0] < 7) return LV_BLEND_SIMD_SSE2;
+
+    cpuid(1, 0, regs);
+    if((regs[2] & (1UL << 27)) == 0 || (regs[2] & (1UL << 28)) == 0) return LV_BLEND_SIMD_SSE2;   /*OSXSAVE, AVX*/
+
+    uint64_t xcr0;
+#ifdef _MSC_VER
+    xcr0 = _xgetbv(0);
+#else
+    uint32_t lo, hi;
+    __asm__ __volatile__("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    xcr0 = ((uint64_t)hi << 32) | lo;
+#endif
+    if((xcr0 & 0x6) != 0x6) return LV_BLEND_SIMD_SSE2;    /*XMM and YMM state*/
+
+    cpuid(7, 0, regs);
+    return (regs[1] & (1UL << 5)) ? LV_BLEND_SIMD_AVX2 : LV_BLEND_SIMD_SSE2;
+}
+
+/**
+ * Check whether `n` (at most 16) mask values are all 0
+ */
+static inline bool mask_transp(const lv_opa_t * mask, int32_t n)
+{
+    uint32_t m[4] = {0};
+    memcpy(m, mask, (size_t)n);
+    return (m[0] | m[1] | m[2] | m[3]) == 0;
+}
+
+/*=====================
+ * SSE2
+ *====================*/
+
+#if LV_COLOR_DEPTH == 32
+
+/**
+ * Scale the opacity with the mask values of 4 pixels in 32 bit lanes: `m >= mask_max ? opa : m * opa >> 8`
+ */
+static inline __m128i scale4_sse2(__m128i m, lv_opa_t opa, lv_opa_t mask_max)
+{
+    __m128i opa_v = _mm_set1_epi32(opa);
+    __m128i scaled = _mm_srli_epi32(_mm_mullo_epi16(m, opa_v), 8);
+    __m128i full = _mm_cmpgt_epi32(m, _mm_set1_epi32(mask_max - 1));
+    return _mm_or_si128(_mm_and_si128(full, opa_v), _mm_andnot_si128(full, scaled));
+}
+
+/**
+ * Get the opacity of 4 pixels from their mask values in 32 bit lanes
+ */
+static inline __m128i opa4_sse2(__m128i m, lv_opa_t opa, lv_opa_t mask_max)
+{
+    if(opa > LV_OPA_MAX) return m;
+    return scale4_sse2(m, opa, mask_max);
+}
+
+/**
+ * Repeat the opacities of 4 pixels (32 bit lanes) on the 16 bit lanes of their channels.
+ * `lo` gets pixel 0 and 1, `hi` pixel 2 and 3 like `_mm_unpacklo/hi_epi8` of the pixels.
+ */
+static inline void spread4_sse2(__m128i a, __m128i * lo, __m128i * hi)
+{
+    __m128i a2 = _mm_or_si128(a, _mm_slli_epi32(a, 16));
+    *lo = _mm_unpacklo_epi32(a2, a2);
+    *hi = _mm_unpackhi_epi32(a2, a2);
+}
+
+/**
+ * `lv_color_mix()` of 4 pixels on 16 bit lanes: (s * a + d * (255 - a) + ofs) * 0x8081 >> 23
+ * @param s_lo `s * a + ofs` of pixel 0 and 1
+ * @param s_hi `s * a + ofs` of pixel 2 and 3
+ * @param d destination pixels
+ * @param inv_lo `255 - a` of pixel 0 and 1
+ * @param inv_hi `255 - a` of pixel 2 and 3
+ * @return the mixed pixels with 0xFF alpha
+ */
+static inline __m128i mix4_sse2(__m128i s_lo, __m128i s_hi, __m128i d, __m128i inv_lo, __m128i inv_hi)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i div255 = _mm_set1_epi16((short)0x8081);
+
+    __m128i lo = _mm_add_epi16(s_lo, _mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), inv_lo));
+    __m128i hi = _mm_add_epi16(s_hi, _mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), inv_hi));
+    lo = _mm_srli_epi16(_mm_mulhi_epu16(lo, div255), 7);
+    hi = _mm_srli_epi16(_mm_mulhi_epu16(hi, div255), 7);
+    return _mm_or_si128(_mm_packus_epi16(lo, hi), _mm_set1_epi32((int)0xFF000000));
+}
+
+/**
+ * Blend 4 pixels like `fill_normal()` and `map_normal()`
+ * @param s source pixels
+ * @param d destination pixels
+ * @param m mask values in 32 bit lanes
+ * @param a opacities in 32 bit lanes (from `opa4_sse2()`)
+ * @return the result pixels
+ */
+static inline __m128i blend4_sse2(__m128i s, __m128i d, __m128i m, __m128i a)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i v255 = _mm_set1_epi16(255);
+    const __m128i ofs = _mm_set1_epi16(LV_COLOR_MIX_ROUND_OFS);
+
+    __m128i a_lo, a_hi;
+    spread4_sse2(a, &a_lo, &a_hi);
+    __m128i s_lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(s, zero), a_lo), ofs);
+    __m128i s_hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(s, zero), a_hi), ofs);
+    __m128i res = mix4_sse2(s_lo, s_hi, d, _mm_sub_epi16(v255, a_lo), _mm_sub_epi16(v255, a_hi));
+
+    /*Copy the source where the opacity is 255 and keep the destination where the mask is 0*/
+    __m128i copy = _mm_cmpeq_epi32(a, _mm_set1_epi32(LV_OPA_COVER));
+    __m128i keep = _mm_cmpeq_epi32(m, zero);
+    res = _mm_or_si128(_mm_and_si128(copy, s), _mm_andnot_si128(copy, res));
+    return _mm_or_si128(_mm_and_si128(keep, d), _mm_andnot_si128(keep, res));
+}
+
+static void fill_row_sse2(lv_color_t * dest, lv_color_t color, int32_t len)
+{
+    __m128i c = _mm_set1_epi32((int)color.full);
+    int32_t x;
+    for(x = 0; x <= len - 4; x += 4) {
+        _mm_storeu_si128((__m128i *)(dest + x), c);
+    }
+    for(; x < len; x++) dest[x] = color;
+}
+
+static void copy_row_sse2(lv_color_t * dest, const lv_color_t * src, int32_t len)
+{
+    int32_t x;
+    for(x = 0; x <= len - 4; x += 4) {
+        _mm_storeu_si128((__m128i *)(dest + x), _mm_loadu_si128((const __m128i *)(src + x)));
+    }
+    for(; x < len; x++) dest[x] = src[x];
+}
+
+static void blend_row_sse2(lv_color_t * dest, const lv_color_t * src, int32_t src_inc, const lv_opa_t * mask,
+                           lv_opa_t opa, lv_opa_t mask_max, int32_t len)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i v255 = _mm_set1_epi16(255);
+    const __m128i ofs = _mm_set1_epi16(LV_COLOR_MIX_ROUND_OFS);
+    int32_t x = 0;
+
+    if(mask == NULL) {
+        /*The same opacity everywhere and it's less than 255 (else it was a copy):
+         *only mix, and the source of a fill can be multiplied in advance*/
+        __m128i a_lo = _mm_set1_epi16(opa);
+        __m128i inv = _mm_sub_epi16(v255, a_lo);
+        __m128i s_lo = zero;
+        __m128i s_hi = zero;
+        if(src_inc == 0) {
+            __m128i s = _mm_loadu_si128((const __m128i *)src);
+            s_lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(s, zero), a_lo), ofs);
+            s_hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(s, zero), a_lo), ofs);
+        }
+        for(; x <= len - 4; x += 4) {
+            if(src_inc) {
+                __m128i s = _mm_loadu_si128((const __m128i *)(src + x));
+                s_lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(s, zero), a_lo), ofs);
+                s_hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(s, zero), a_lo), ofs);
+            }
+            __m128i d = _mm_loadu_si128((const __m128i *)(dest + x));
+            _mm_storeu_si128((__m128i *)(dest + x), mix4_sse2(s_lo, s_hi, d, inv, inv));
+        }
+    }
+    else {
+        for(; x <= len - 4; x += 4) {
+            uint32_t m4;
+            memcpy(&m4, &mask[x], sizeof(m4));
+            if(m4 == 0) continue;
+
+            __m128i s = _mm_loadu_si128((const __m128i *)(src + x * src_inc));
+            if(m4 == 0xFFFFFFFF && opa > LV_OPA_MAX) {
+                _mm_storeu_si128((__m128i *)(dest + x), s);
+                continue;
+            }
+
+            __m128i m = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128((int)m4), zero), zero);
+            __m128i d = _mm_loadu_si128((const __m128i *)(dest + x));
+            _mm_storeu_si128((__m128i *)(dest + x), blend4_sse2(s, d, m, opa4_sse2(m, opa, mask_max)));
+        }
+    }
+
+    if(x < len) {
+        blend_tail_sse2(dest + x, src + x * src_inc, src_inc, mask ? mask + x : NULL, opa, mask_max, len - x);
+    }
+}
+
+/**
+ * Blend the last 1..3 pixels of a row: copy them to a vector with a 0 mask in the unused lanes
+ */
+static void blend_tail_sse2(lv_color_t * dest, const lv_color_t * src, int32_t src_inc, const lv_opa_t * mask,
+                            lv_opa_t opa, lv_opa_t mask_max, int32_t len)
+{
+    uint32_t d4[4] = {0};
+    uint32_t s4[4] = {0};
+    uint8_t m4[4] = {0};
+    int32_t i;
+    for(i = 0; i < len; i++) {
+        d4[i] = dest[i].full;
+        s4[i] = src[i * src_inc].full;
+        m4[i] = mask ? mask[i] : LV_OPA_COVER;
+    }
+
+    uint32_t m32;
+    memcpy(&m32, m4, sizeof(m32));
+    __m128i m = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128((int)m32), _mm_setzero_si128()),
+                                   _mm_setzero_si128());
+    __m128i res = blend4_sse2(_mm_loadu_si128((const __m128i *)s4), _mm_loadu_si128((const __m128i *)d4),
+                              m, opa4_sse2(m, opa, mask_max));
+    _mm_storeu_si128((__m128i *)d4, res);
+
+    for(i = 0; i < len; i++) dest[i].full = d4[i];
+}
+
+/**
+ * Get the mask values of 4 pixels in 32 bit lanes
+ */
+static inline __m128i blended_mask_sse2(const lv_opa_t * mask)
+{
+    uint32_t m4;
+    memcpy(&m4, mask, sizeof(m4));
+    return _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128((int)m4), _mm_setzero_si128()),
+                              _mm_setzero_si128());
+}
+
+/**
+ * Get the opacity of 4 pixels from their mask values like `fill_blended()` and `map_blended()`
+ */
+static inline __m128i blended_opa_sse2(__m128i m, lv_opa_t opa)
+{
+    return scale4_sse2(m, opa, LV_OPA_MAX);
+}
+
+static inline __m128i blended_opa_set_sse2(lv_opa_t opa)
+{
+    return _mm_set1_epi32(opa);
+}
+
+/**
+ * Blend 4 pixels like `color_blend_true_color_additive/subtractive()`:
+ * the normal mode with the saturated sum or difference (with the alpha of the source)
+ * but the destination is kept up to `LV_OPA_MIN` opacity.
+ * @param s source pixels
+ * @param d destination pixels
+ * @param a opacities in 32 bit lanes
+ * @param sub true: subtractive, false: additive mode
+ * @return the result pixels
+ */
+static inline __m128i blended_px_sse2(__m128i s, __m128i d, __m128i a, bool sub)
+{
+    const __m128i alpha = _mm_set1_epi32((int)0xFF000000);
+
+    __m128i res = sub ? _mm_subs_epu8(d, s) : _mm_adds_epu8(s, d);
+    res = _mm_or_si128(_mm_andnot_si128(alpha, res), _mm_and_si128(alpha, s));
+
+    __m128i visible = _mm_and_si128(a, _mm_cmpgt_epi32(a, _mm_set1_epi32(LV_OPA_MIN)));
+    return blend4_sse2(res, d, visible, a);
+}
+
+#else /*LV_COLOR_DEPTH == 16*/
+
+/**
+ * Get the mask values of 8 pixels in 16 bit lanes
+ */
+static inline __m128i blended_mask_sse2(const lv_opa_t * mask)
+{
+    return _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)mask), _mm_setzero_si128());
+}
+
+/**
+ * Get the opacity of 8 pixels from their mask values like `fill_blended()` and `map_blended()`
+ */
+static inline __m128i blended_opa_sse2(__m128i m, lv_opa_t opa)
+{
+    __m128i opa_v = _mm_set1_epi16(opa);
+    __m128i scaled = _mm_srli_epi16(_mm_mullo_epi16(m, opa_v), 8);
+    __m128i full = _mm_cmpgt_epi16(m, _mm_set1_epi16(LV_OPA_MAX - 1));
+    return _mm_or_si128(_mm_and_si128(full, opa_v), _mm_andnot_si128(full, scaled));
+}
+
+static inline __m128i blended_opa_set_sse2(lv_opa_t opa)
+{
+    return _mm_set1_epi16(opa);
+}
+
+/**
+ * `lv_color_mix()` of a color channel of 8 pixels in 16 bit lanes
+ */
+static inline __m128i mix_ch8_sse2(__m128i s, __m128i d, __m128i a, __m128i inv)
+{
+    __m128i t = _mm_add_epi16(_mm_mullo_epi16(s, a), _mm_mullo_epi16(d, inv));
+    t = _mm_add_epi16(t, _mm_set1_epi16(LV_COLOR_MIX_ROUND_OFS));
+    return _mm_srli_epi16(_mm_mulhi_epu16(t, _mm_set1_epi16((short)0x8081)), 7);
+}
+
+/**
+ * Blend 8 RGB565 pixels like `color_blend_true_color_additive/subtractive()`.
+ * Mixing with 255 opacity gives back the saturated channels, so it needs no special case.
+ * @param s source pixels
+ * @param d destination pixels
+ * @param a opacities in 16 bit lanes
+ * @param sub true: subtractive, false: additive mode
+ * @return the result pixels
+ */
+static inline __m128i blended_px_sse2(__m128i s, __m128i d, __m128i a, bool sub)
+{
+    const __m128i max5 = _mm_set1_epi16(0x1F);
+    const __m128i max6 = _mm_set1_epi16(0x3F);
+
+    __m128i sr = _mm_srli_epi16(s, 11);
+    __m128i sg = _mm_and_si128(_mm_srli_epi16(s, 5), max6);
+    __m128i sb = _mm_and_si128(s, max5);
+    __m128i dr = _mm_srli_epi16(d, 11);
+    __m128i dg = _mm_and_si128(_mm_srli_epi16(d, 5), max6);
+    __m128i db = _mm_and_si128(d, max5);
+
+    __m128i r, g, b;
+    if(sub) {
+        r = _mm_subs_epu16(dr, sr);
+        g = _mm_subs_epu16(dg, sg);
+        b = _mm_subs_epu16(db, sb);
+    }
+    else {
+        r = _mm_min_epi16(_mm_add_epi16(sr, dr), max5);
+        g = _mm_min_epi16(_mm_add_epi16(sg, dg), max6);
+        b = _mm_min_epi16(_mm_add_epi16(sb, db), max5);
+    }
+
+    __m128i inv = _mm_sub_epi16(_mm_set1_epi16(255), a);
+    r = mix_ch8_sse2(r, dr, a, inv);
+    g = mix_ch8_sse2(g, dg, a, inv);
+    b = mix_ch8_sse2(b, db, a, inv);
+    __m128i res = _mm_or_si128(_mm_or_si128(_mm_slli_epi16(r, 11), _mm_slli_epi16(g, 5)), b);
+
+    __m128i keep = _mm_cmplt_epi16(a, _mm_set1_epi16(LV_OPA_MIN + 1));
+    return _mm_or_si128(_mm_and_si128(keep, d), _mm_andnot_si128(keep, res));
+}
+
+#endif /*LV_COLOR_DEPTH*/
+
+/**
+ * Blend a row with the additive or subtractive mode like `fill_blended()` and `map_blended()`.
+ * Inlined into the kernels of the two modes, so `sub` is a constant in their loops.
+ */
+static inline void blended_row_sse2(lv_color_t * dest, const lv_color_t * src, int32_t src_inc,
+                                    const lv_opa_t * mask, lv_opa_t opa, int32_t len, bool sub)
+{
+    int32_t x = 0;
+
+    if(mask == NULL) {
+        if(opa <= LV_OPA_MIN) return;
+
+        __m128i a = blended_opa_set_sse2(opa);
+        if(src_inc == 0) {
+            /*The result depends only on the destination: reuse it while the destination is the same*/
+            __m128i s = _mm_loadu_si128((const __m128i *)src);
+            __m128i last_d = _mm_setzero_si128();
+            __m128i last_res = blended_px_sse2(s, last_d, a, sub);
+            for(; x <= len - PX_SSE2; x += PX_SSE2) {
+                __m128i d = _mm_loadu_si128((const __m128i *)(dest + x));
+                if(_mm_movemask_epi8(_mm_cmpeq_epi8(d, last_d)) != 0xFFFF) {
+                    last_d = d;
+                    last_res = blended_px_sse2(s, d, a, sub);
+                }
+                _mm_storeu_si128((__m128i *)(dest + x), last_res);
+            }
+        }
+        else {
+            for(; x <= len - PX_SSE2; x += PX_SSE2) {
+                __m128i s = _mm_loadu_si128((const __m128i *)(src + x));
+                __m128i d = _mm_loadu_si128((const __m128i *)(dest + x));
+                _mm_storeu_si128((__m128i *)(dest + x), blended_px_sse2(s, d, a, sub));
+            }
+        }
+    }
+    else {
+        for(; x <= len - PX_SSE2; x += PX_SSE2) {
+            if(mask_transp(&mask[x], PX_SSE2)) continue;
+
+            __m128i s = _mm_loadu_si128((const __m128i *)(src + x * src_inc));
+            __m128i d = _mm_loadu_si128((const __m128i *)(dest + x));
+            __m128i a = blended_opa_sse2(blended_mask_sse2(&mask[x]), opa);
+            _mm_storeu_si128((__m128i *)(dest + x), blended_px_sse2(s, d, a, sub));
+        }
+    }
+
+    if(x < len) {
+        blended_tail_sse2(dest + x, src + x * src_inc, src_inc, mask ? mask + x : NULL, opa, len - x, sub);
+    }
+}
+
+static void additive_row_sse2(lv_color_t * dest, const lv_color_t * src, int32_t src_inc, const lv_opa_t * mask,
+                              lv_opa_t opa, int32_t len)
+{
+    blended_row_sse2(dest, src, src_inc, mask, opa, len, false);
+}
+
+static void subtractive_row_sse2(lv_color_t * dest, const lv_color_t * src, int32_t src_inc, const lv_opa_t * mask,
+                                 lv_opa_t opa, int32_t len)
+{
+    blended_row_sse2(dest, src, src_inc, mask, opa, len, true);
+}
+
+/**
+ * Blend the last pixels of a row which don't fill a vector: copy them to a vector with a 0 mask in the unused lanes
+ */
+static void blended_tail_sse2(lv_color_t * dest, const lv_color_t * src, int32_t src_inc, const lv_opa_t * mask,
+                              lv_opa_t opa, int32_t len, bool sub)
+{
+    lv_color_t d_px[PX_SSE2];
+    lv_color_t s_px[PX_SSE2];
+    lv_opa_t m_px[PX_SSE2];
+    memset(d_px, 0, sizeof(d_px));
+    memset(s_px, 0, sizeof(s_px));
+    memset(m_px, 0, sizeof(m_px));
+
+    int32_t i;
+    for(i = 0; i < len; i++) {
+        d_px[i] = dest[i];
+        s_px[i] = src[i * src_inc];
+        m_px[i] = mask ? mask[i] : LV_OPA_COVER;
+    }
+
+    __m128i a = blended_opa_sse2(blended_mask_sse2(m_px), opa);
+    __m128i res = blended_px_sse2(_mm_loadu_si128((const __m128i *)s_px), _mm_loadu_si128((const __m128i *)d_px), a,
+                                  sub);
+    _mm_storeu_si128((__m128i *)d_px, res);
+
+    for(i = 0; i < len; i++) dest[i] = d_px[i];
+}
+
+/*=====================
+ * AVX2
+ *====================*/
+
+#if LV_COLOR_DEPTH == 32
+
+/**
+ * Like `scale4_sse2()` for 8 pixels
+ */
+TARGET_AVX2 static inline __m256i scale8_avx2(__m256i m, lv_opa_t opa, lv_opa_t mask_max)
+{
+    __m256i opa_v = _mm256_set1_epi32(opa);
+    __m256i scaled = _mm256_srli_epi32(_mm256_mullo_epi16(m, opa_v), 8);
+    __m256i full = _mm256_cmpgt_epi32(m, _mm256_set1_epi32(mask_max - 1));
+    return _mm256_blendv_epi8(scaled, opa_v, full);
+}
+
+/**
+ * Get the opacity of 8 pixels from their mask values in 32 bit lanes
+ */
+TARGET_AVX2 static inline __m256i opa8_avx2(__m256i m, lv_opa_t opa, lv_opa_t mask_max)
+{
+    if(opa > LV_OPA_MAX) return m;
+    return scale8_avx2(m, opa, mask_max);
+}
+
+/**
+ * Like `mix4_sse2()` for 8 pixels.
+ * The unpack instructions work in 128 bit lanes, so `lo` is pixel 0, 1, 4, 5 and `hi` is pixel 2, 3, 6, 7.
+ */
+TARGET_AVX2 static inline __m256i mix8_avx2(__m256i s_lo, __m256i s_hi, __m256i d, __m256i inv_lo, __m256i inv_hi)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i div255 = _mm256_set1_epi16((short)0x8081);
+
+    __m256i lo = _mm256_add_epi16(s_lo, _mm256_mullo_epi16(_mm256_unpacklo_epi8(d, zero), inv_lo));
+    __m256i hi = _mm256_add_epi16(s_hi, _mm256_mullo_epi16(_mm256_unpackhi_epi8(d, zero), inv_hi));
+    lo = _mm256_srli_epi16(_mm256_mulhi_epu16(lo, div255), 7);
+    hi = _mm256_srli_epi16(_mm256_mulhi_epu16(hi, div255), 7);
+    return _mm256_or_si256(_mm256_packus_epi16(lo, hi), _mm256_set1_epi32((int)0xFF000000));
+}
+
+/**
+ * Blend 8 pixels like `blend4_sse2()`
+ */
+TARGET_AVX2 static inline __m256i blend8_avx2(__m256i s, __m256i d, __m256i m, __m256i a)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i v255 = _mm256_set1_epi16(255);
+    const __m256i ofs = _mm256_set1_epi16(LV_COLOR_MIX_ROUND_OFS);
+
+    __m256i a2 = _mm256_or_si256(a, _mm256_slli_epi32(a, 16));
+    __m256i a_lo = _mm256_unpacklo_epi32(a2, a2);
+    __m256i a_hi = _mm256_unpackhi_epi32(a2, a2);
+    __m256i s_lo = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(s, zero), a_lo), ofs);
+    __m256i s_hi = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(s, zero), a_hi), ofs);
+    __m256i res = mix8_avx2(s_lo, s_hi, d, _mm256_sub_epi16(v255, a_lo), _mm256_sub_epi16(v255, a_hi));
+
+    res = _mm256_blendv_epi8(res, s, _mm256_cmpeq_epi32(a, _mm256_set1_epi32(LV_OPA_COVER)));
+    return _mm256_blendv_epi8(res, d, _mm256_cmpeq_epi32(m, zero));
+}
+
+TARGET_AVX2 static void fill_row_avx2(lv_color_t * dest, lv_color_t color, int32_t len)
+{
+    __m256i c = _mm256_set1_epi32((int)color.full);
+    int32_t x;
+    for(x = 0; x <= len - 8; x += 8) {
+        _mm256_storeu_si256((__m256i *)(dest + x), c);
+    }
+    for(; x < len; x++) dest[x] = color;
+}
+
+TARGET_AVX2 static void copy_row_avx2(lv_color_t * dest, const lv_color_t * src, int32_t len)
+{
+    int32_t x;
+    for(x = 0; x <= len - 8; x += 8) {
+        _mm256_storeu_si256((__m256i *)(dest + x), _mm256_loadu_si256((const __m256i *)(src + x)));
+    }
+    for(; x < len; x++) dest[x] = src[x];
+}
+
+TARGET_AVX2 static void blend_row_avx2(lv_color_t * dest, const lv_color_t * src, int32_t src_inc,
+                                       const lv_opa_t * mask, lv_opa_t opa, lv_opa_t mask_max, int32_t len)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i v255 = _mm256_set1_epi16(255);
+    const __m256i ofs = _mm256_set1_epi16(LV_COLOR_MIX_ROUND_OFS);
+    int32_t x = 0;
+
+    if(mask == NULL) {
+        __m256i a_lo = _mm256_set1_epi16(opa);
+        __m256i inv = _mm256_sub_epi16(v255, a_lo);
+        __m256i s_lo = zero;
+        __m256i s_hi = zero;
+        if(src_inc == 0) {
+            __m256i s = _mm256_loadu_si256((const __m256i *)src);
+            s_lo = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(s, zero), a_lo), ofs);
+            s_hi = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(s, zero), a_lo), ofs);
+        }
+        for(; x <= len - 8; x += 8) {
+            if(src_inc) {
+                __m256i s = _mm256_loadu_si256((const __m256i *)(src + x));
+                s_lo = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(s, zero), a_lo), ofs);
+                s_hi = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(s, zero), a_lo), ofs);
+            }
+            __m256i d = _mm256_loadu_si256((const __m256i *)(dest + x));
+            _mm256_storeu_si256((__m256i *)(dest + x), mix8_avx2(s_lo, s_hi, d, inv, inv));
+        }
+    }
+    else {
+        for(; x <= len - 8; x += 8) {
+            uint64_t m8;
+            memcpy(&m8, &mask[x], sizeof(m8));
+            if(m8 == 0) continue;
+
+            __m256i s = _mm256_loadu_si256((const __m256i *)(src + x * src_inc));
+            if(m8 == UINT64_MAX && opa > LV_OPA_MAX) {
+                _mm256_storeu_si256((__m256i *)(dest + x), s);
+                continue;
+            }
+
+            __m256i m = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)&mask[x]));
+            __m256i d = _mm256_loadu_si256((const __m256i *)(dest + x));
+            _mm256_storeu_si256((__m256i *)(dest + x), blend8_avx2(s, d, m, opa8_avx2(m, opa, mask_max)));
+        }
+    }
+
+    if(x < len) {
+        blend_row_sse2(dest + x, src + x * src_inc, src_inc, mask ? mask + x : NULL, opa, mask_max, len - x);
+    }
+}
+
+TARGET_AVX2 static inline __m256i blended_mask_avx2(const lv_opa_t * mask)
+{
+    return _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)mask));
+}
+
+TARGET_AVX2 static inline __m256i blended_opa_avx2(__m256i m, lv_opa_t opa)
+{
+    return scale8_avx2(m, opa, LV_OPA_MAX);
+}
+
+TARGET_AVX2 static inline __m256i blended_opa_set_avx2(lv_opa_t opa)
+{
+    return _mm256_set1_epi32(opa);
+}
+
+/**
+ * Like `blended_px_sse2()` for 8 pixels
+ */
+TARGET_AVX2 static inline __m256i blended_px_avx2(__m256i s, __m256i d, __m256i a, bool sub)
+{
+    __m256i res = sub ? _mm256_subs_epu8(d, s) : _mm256_adds_epu8(s, d);
+    res = _mm256_blendv_epi8(res, s, _mm256_set1_epi32((int)0xFF000000));
+
+    __m256i visible = _mm256_and_si256(a, _mm256_cmpgt_epi32(a, _mm256_set1_epi32(LV_OPA_MIN)));
+    return blend8_avx2(res, d, visible, a);
+}
+
+#else /*LV_COLOR_DEPTH == 16*/
+
+TARGET_AVX2 static inline __m256i blended_mask_avx2(const lv_opa_t * mask)
+{
+    return _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)mask));
+}
+
+TARGET_AVX2 static inline __m256i blended_opa_avx2(__m256i m, lv_opa_t opa)
+{
+    __m256i opa_v = _mm256_set1_epi16(opa);
+    __m256i scaled = _mm256_srli_epi16(_mm256_mullo_epi16(m, opa_v), 8);
+    __m256i full = _mm256_cmpgt_epi16(m, _mm256_set1_epi16(LV_OPA_MAX - 1));
+    return _mm256_blendv_epi8(scaled, opa_v, full);
+}
+
+TARGET_AVX2 static inline __m256i blended_opa_set_avx2(lv_opa_t opa)
+{
+    return _mm256_set1_epi16(opa);
+}
+
+TARGET_AVX2 static inline __m256i mix_ch16_avx2(__m256i s, __m256i d, __m256i a, __m256i inv)
+{
+    __m256i t = _mm256_add_epi16(_mm256_mullo_epi16(s, a), _mm256_mullo_epi16(d, inv));
+    t = _mm256_add_epi16(t, _mm256_set1_epi16(LV_COLOR_MIX_ROUND_OFS));
+    return _mm256_srli_epi16(_mm256_mulhi_epu16(t, _mm256_set1_epi16((short)0x8081)), 7);
+}
+
+/**
+ * Like `blended_px_sse2()` for 16 pixels
+ */
+TARGET_AVX2 static inline __m256i blended_px_avx2(__m256i s, __m256i d, __m256i a, bool sub)
+{
+    const __m256i max5 = _mm256_set1_epi16(0x1F);
+    const __m256i max6 = _mm256_set1_epi16(0x3F);
+
+    __m256i sr = _mm256_srli_epi16(s, 11);
+    __m256i sg = _mm256_and_si256(_mm256_srli_epi16(s, 5), max6);
+    __m256i sb = _mm256_and_si256(s, max5);
+    __m256i dr = _mm256_srli_epi16(d, 11);
+    __m256i dg = _mm256_and_si256(_mm256_srli_epi16(d, 5), max6);
+    __m256i db = _mm256_and_si256(d, max5);
+
+    __m256i r, g, b;
+    if(sub) {
+        r = _mm256_subs_epu16(dr, sr);
+        g = _mm256_subs_epu16(dg, sg);
+        b = _mm256_subs_epu16(db, sb);
+    }
+    else {
+        r = _mm256_min_epi16(_mm256_add_epi16(sr, dr), max5);
+        g = _mm256_min_epi16(_mm256_add_epi16(sg, dg), max6);
+        b = _mm256_min_epi16(_mm256_add_epi16(sb, db), max5);
+    }
+
+    __m256i inv = _mm256_sub_epi16(_mm256_set1_epi16(255), a);
+    r = mix_ch16_avx2(r, dr, a, inv);
+    g = mix_ch16_avx2(g, dg, a, inv);
+    b = mix_ch16_avx2(b, db, a, inv);
+    __m256i res = _mm256_or_si256(_mm256_or_si256(_mm256_slli_epi16(r, 11), _mm256_slli_epi16(g, 5)), b);
+
+    return _mm256_blendv_epi8(res, d, _mm256_cmpgt_epi16(_mm256_set1_epi16(LV_OPA_MIN + 1), a));
+}
+
+#endif /*LV_COLOR_DEPTH*/
+
+/**
+ * Like `blended_row_sse2()` with 256 bit vectors
+ */
+TARGET_AVX2 static inline void blended_row_avx2(lv_color_t * dest, const lv_color_t * src, int32_t src_inc,
+                                                const lv_opa_t * mask, lv_opa_t opa, int32_t len, bool sub)
+{
+    int32_t x = 0;
+
+    if(mask == NULL) {
+        if(opa <= LV_OPA_MIN) return;
+
+        __m256i a = blended_opa_set_avx2(opa);
+        if(src_inc == 0) {
+            __m256i s = _mm256_loadu_si256((const __m256i *)src);
+            __m256i last_d = _mm256_setzero_si256();
+            __m256i last_res = blended_px_avx2(s, last_d, a, sub);
+            for(; x <= len - PX_AVX2; x += PX_AVX2) {
+                __m256i d = _mm256_loadu_si256((const __m256i *)(dest + x));
+                if(_mm256_movemask_epi8(_mm256_cmpeq_epi8(d, last_d)) != -1) {
+                    last_d = d;
+                    last_res = blended_px_avx2(s, d, a, sub);
+                }
+                _mm256_storeu_si256((__m256i *)(dest + x), last_res);
+            }
+        }
+        else {
+            for(; x <= len - PX_AVX2; x += PX_AVX2) {
+                __m256i s = _mm256_loadu_si256((const __m256i *)(src + x));
+                __m256i d = _mm256_loadu_si256((const __m256i *)(dest + x));
+                _mm256_storeu_si256((__m256i *)(dest + x), blended_px_avx2(s, d, a, sub));
+            }
+        }
+    }
+    else {
+        for(; x <= len - PX_AVX2; x += PX_AVX2) {
+            if(mask_transp(&mask[x], PX_AVX2)) continue;
+
+            __m256i s = _mm256_loadu_si256((const __m256i *)(src + x * src_inc));
+            __m256i d = _mm256_loadu_si256((const __m256i *)(dest + x));
+            __m256i a = blended_opa_avx2(blended_mask_avx2(&mask[x]), opa);
+            _mm256_storeu_si256((__m256i *)(dest + x), blended_px_avx2(s, d, a, sub));
+        }
+    }
+
+    if(x < len) {
+        if(sub) subtractive_row_sse2(dest + x, src + x * src_inc, src_inc, mask ? mask + x : NULL, opa, len - x);
+        else additive_row_sse2(dest + x, src + x * src_inc, src_inc, mask ? mask + x : NULL, opa, len - x);
+    }
+}
+
+TARGET_AVX2 static void additive_row_avx2(lv_color_t * dest, const lv_color_t * src, int32_t src_inc,
+                                          const lv_opa_t * mask, lv_opa_t opa, int32_t len)
+{
+    blended_row_avx2(dest, src, src_inc, mask, opa, len, false);
+}
+
+TARGET_AVX2 static void subtractive_row_avx2(lv_color_t * dest, const lv_color_t * src, int32_t src_inc,
+                                             const lv_opa_t * mask, lv_opa_t opa, int32_t len)
+{
+    blended_row_avx2(dest, src, src_inc, mask, opa, len, true);
+}
+
+#endif /*BLEND_SIMD_X64*/
+
+#endif /*LV_USE_BLEND_SIMD*/
@@ -0,0 +1,143 @@
+/**
+ * @file lv_draw_blend_simd.h
+ * SSE2 and AVX2 kernels of the blend modes on x86-64: the normal mode for 32 bit colors,
+ * the additive and subtractive modes for 32 and 16 bit colors.
+ * The kernels give the same pixels as the scalar code of `lv_draw_blend.c` which remains the reference.
+ */
+
+#ifndef LV_DRAW_BLEND_SIMD_H
+#define LV_DRAW_BLEND_SIMD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdbool.h>
+#include "../lv_misc/lv_color.h"
+#include "lv_draw_blend.h"
+
+#if LV_USE_BLEND_SIMD
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+enum {
+    LV_BLEND_SIMD_NONE,     /*Scalar code*/
+    LV_BLEND_SIMD_SSE2,
+    LV_BLEND_SIMD_AVX2,
+};
+typedef uint8_t lv_blend_simd_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+//! @cond Doxygen_Suppress
+
+/**
+ * Select the best kernels for the CPU. Called by `lv_init()`.
+ */
+void _lv_blend_simd_init(void);
+
+/**
+ * Select the kernels to use, e.g. to compare them with the scalar code
+ * @param simd the kernels to use. Limited to the best ones supported by the CPU and the build.
+ * @return the kernels really selected
+ */
+lv_blend_simd_t _lv_blend_simd_set(lv_blend_simd_t simd);
+
+/**
+ * Get the selected kernels
+ * @return `LV_BLEND_SIMD_NONE` if the scalar code is used
+ */
+lv_blend_simd_t _lv_blend_simd_get(void);
+
+/**
+ * Get the name of the kernels
+ * @param simd the kernels
+ * @return "none", "sse2" or "avx2"
+ */
+const char * _lv_blend_simd_name(lv_blend_simd_t simd);
+
+/**
+ * Fill an area of a buffer with a color like `fill_normal()`
+ * @param dest the first pixel of the area
+ * @param dest_stride width of the destination buffer in pixels
+ * @param w width of the area
+ * @param h height of the area
+ * @param color fill color
+ * @param opa overall opacity
+ * @param mask `w * h` mask values or NULL if there is no mask
+ * @return false: no kernels are selected, the scalar code should be used
+ */
+bool _lv_blend_simd_fill(lv_color_t * dest, int32_t dest_stride, int32_t w, int32_t h,
+                         lv_color_t color, lv_opa_t opa, const lv_opa_t * mask);
+
+/**
+ * Copy an area of a map to a buffer like `map_normal()`
+ * @param dest the first pixel of the destination area
+ * @param dest_stride width of the destination buffer in pixels
+ * @param src the first pixel of the source area
+ * @param src_stride width of the map in pixels
+ * @param w width of the area
+ * @param h height of the area
+ * @param opa overall opacity
+ * @param mask `w * h` mask values or NULL if there is no mask
+ * @return false: no kernels are selected, the scalar code should be used
+ */
+bool _lv_blend_simd_map(lv_color_t * dest, int32_t dest_stride, const lv_color_t * src, int32_t src_stride,
+                        int32_t w, int32_t h, lv_opa_t opa, const lv_opa_t * mask);
+
+#if LV_USE_BLEND_MODES
+/**
+ * Fill an area of a buffer with a color like `fill_blended()`
+ * @param dest the first pixel of the area
+ * @param dest_stride width of the destination buffer in pixels
+ * @param w width of the area
+ * @param h height of the area
+ * @param color fill color
+ * @param opa overall opacity
+ * @param mask `w * h` mask values or NULL if there is no mask
+ * @param mode `LV_BLEND_MODE_ADDITIVE` or `LV_BLEND_MODE_SUBTRACTIVE`
+ * @return false: no kernels are selected, the scalar code should be used
+ */
+bool _lv_blend_simd_fill_blended(lv_color_t * dest, int32_t dest_stride, int32_t w, int32_t h,
+                                 lv_color_t color, lv_opa_t opa, const lv_opa_t * mask, lv_blend_mode_t mode);
+
+/**
+ * Blend an area of a map to a buffer like `map_blended()`
+ * @param dest the first pixel of the destination area
+ * @param dest_stride width of the destination buffer in pixels
+ * @param src the first pixel of the source area
+ * @param src_stride width of the map in pixels
+ * @param w width of the area
+ * @param h height of the area
+ * @param opa overall opacity
+ * @param mask `w * h` mask values or NULL if there is no mask
+ * @param mode `LV_BLEND_MODE_ADDITIVE` or `LV_BLEND_MODE_SUBTRACTIVE`
+ * @return false: no kernels are selected, the scalar code should be used
+ */
+bool _lv_blend_simd_map_blended(lv_color_t * dest, int32_t dest_stride, const lv_color_t * src, int32_t src_stride,
+                                int32_t w, int32_t h, lv_opa_t opa, const lv_opa_t * mask, lv_blend_mode_t mode);
+#endif
+
+//! @endcond
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_BLEND_SIMD*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_DRAW_BLEND_SIMD_H*/
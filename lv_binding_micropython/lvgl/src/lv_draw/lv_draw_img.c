@@ -13,6 +13,7 @@
 #include "../lv_core/lv_refr.h"
 #include "../lv_misc/lv_mem.h"
 #include "../lv_misc/lv_math.h"
+#include "../lv_misc/lv_worker.h"
 #if LV_USE_GPU_STM32_DMA2D
     #include "../lv_gpu/lv_gpu_stm32_dma2d.h"
 #elif LV_USE_GPU_NXP_PXP
@@ -85,6 +86,10 @@ void lv_draw_img(const lv_area_t * coords, const lv_area_t * mask, const void *
     res = lv_img_draw_core(coords, mask, src, dsc);
 
     if(res == LV_RES_INV) {
+#if LV_REFR_PARALLEL_MAX > 1
+        /*A worker couldn't open the image, the band is drawn again on the main core*/
+        if(_lv_worker_is_parallel() && _lv_worker_has_failed(_lv_worker_get_id())) return;
+#endif
         LV_LOG_WARN("Image draw error");
         show_error(coords, mask, "No\ndata");
         return;
@@ -278,6 +283,12 @@ LV_ATTRIBUTE_FAST_MEM static lv_res_t lv_img_draw_core(const lv_area_t * coords,
     }
     /* The whole uncompressed image is not available. Try to read it line-by-line*/
     else {
+        /*Only the main core can use the decoders. Let it draw again what this worker is drawing.*/
+        if(_lv_worker_is_parallel() && _lv_worker_get_id() != 0) {
+            _lv_worker_fail();
+            return LV_RES_OK;
+        }
+
         lv_area_t mask_com; /*Common area of mask and coords*/
         bool union_ok;
         union_ok = _lv_area_intersect(&mask_com, clip_area, coords);
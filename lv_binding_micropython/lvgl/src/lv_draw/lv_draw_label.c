@@ -12,6 +12,7 @@
 #include "../lv_core/lv_refr.h"
 #include "../lv_misc/lv_bidi.h"
 #include "../lv_misc/lv_debug.h"
+#include "../lv_misc/lv_worker.h"
 
 /*********************
  *      DEFINES
@@ -29,6 +30,13 @@ enum {
 };
 typedef uint8_t cmd_state_t;
 
+/*The opacity table of the last letter, one for each worker rendering in parallel*/
+typedef struct {
+    lv_opa_t opa_table[256];
+    lv_opa_t prev_opa;
+    uint32_t prev_bpp;
+} letter_opa_cache_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -158,6 +166,9 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
     uint32_t line_start     = 0;
     int32_t last_line_start = -1;
 
+    /*The hint is updated while drawing so the workers rendering in parallel can't use it*/
+    if(_lv_worker_is_parallel()) hint = NULL;
+
     /*Check the hint to use the cached info*/
     if(hint && y_ofs == 0 && coords->y1 < 0) {
         /*If the label changed too much recalculate the hint.*/
@@ -484,19 +495,18 @@ LV_ATTRIBUTE_FAST_MEM static void draw_letter_normal(lv_coord_t pos_x, lv_coord_
             return; /*Invalid bpp. Can't render the letter*/
     }
 
-    static lv_opa_t opa_table[256];
-    static lv_opa_t prev_opa = LV_OPA_TRANSP;
-    static uint32_t prev_bpp = 0;
+    static letter_opa_cache_t opa_caches[LV_REFR_PARALLEL_MAX];
     if(opa < LV_OPA_MAX) {
-        if(prev_opa != opa || prev_bpp != bpp) {
+        letter_opa_cache_t * c = &opa_caches[_lv_worker_get_id()];
+        if(c->prev_opa != opa || c->prev_bpp != bpp) {
             uint32_t i;
             for(i = 0; i < shades; i++) {
-                opa_table[i] = bpp_opa_table_p[i] == LV_OPA_COVER ? opa : ((bpp_opa_table_p[i] * opa) >> 8);
+                c->opa_table[i] = bpp_opa_table_p[i] == LV_OPA_COVER ? opa : ((bpp_opa_table_p[i] * opa) >> 8);
             }
         }
-        bpp_opa_table_p = opa_table;
-        prev_opa = opa;
-        prev_bpp = bpp;
+        bpp_opa_table_p = c->opa_table;
+        c->prev_opa = opa;
+        c->prev_bpp = bpp;
     }
 
     int32_t col, row;
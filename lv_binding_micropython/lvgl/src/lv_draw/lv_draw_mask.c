@@ -11,6 +11,8 @@
 #include "../lv_misc/lv_log.h"
 #include "../lv_misc/lv_debug.h"
 #include "../lv_misc/lv_gc.h"
+#include "../lv_misc/lv_worker.h"
+#include "../lv_core/lv_perf.h"
 
 /*********************
  *      DEFINES
@@ -19,6 +21,15 @@
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_RADIUS_CACHE_SIZE
+/*A row of a precomputed corner. The rows follow `_lv_draw_mask_radius_corner_t` from the top (or bottom) edge.
+ *The pixels before `x` are transparent, the pixels after the `len` opacities are fully covered.*/
+typedef struct {
+    uint32_t opa_start;     /*Index of the row's first opacity among the opacities following the rows*/
+    lv_coord_t x;           /*Column of the first opacity counted from the left (or right) edge*/
+    lv_coord_t len;         /*Number of opacities*/
+} radius_row_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
@@ -32,6 +43,17 @@ LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t lv_draw_mask_radius(lv_opa_t * m
 LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t lv_draw_mask_angle(lv_opa_t * mask_buf, lv_coord_t abs_x,
                                                                    lv_coord_t abs_y, lv_coord_t len,
                                                                    lv_draw_mask_angle_param_t * param);
+LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t radius_corner(lv_opa_t * mask_buf, lv_coord_t abs_x, lv_coord_t abs_y,
+                                                              lv_coord_t len, lv_draw_mask_radius_param_t * p);
+#if LV_RADIUS_CACHE_SIZE
+LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t radius_corner_cached(lv_opa_t * mask_buf, lv_coord_t abs_x,
+                                                                     lv_coord_t abs_y, lv_coord_t len,
+                                                                     const lv_draw_mask_radius_param_t * p,
+                                                                     const _lv_draw_mask_radius_corner_t * corner);
+static uint8_t radius_cache_get(lv_coord_t radius);
+static uint8_t radius_cache_add(lv_coord_t radius);
+static void radius_corner_row(lv_opa_t * buf, lv_draw_mask_radius_param_t * p, lv_coord_t t, radius_row_t * row);
+#endif
 LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t lv_draw_mask_fade(lv_opa_t * mask_buf, lv_coord_t abs_x,
                                                                   lv_coord_t abs_y, lv_coord_t len,
                                                                   lv_draw_mask_fade_param_t * param);
@@ -52,6 +74,11 @@ LV_ATTRIBUTE_FAST_MEM static inline void sqrt_approx(lv_sqrt_res_t * q, lv_sqrt_
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LV_RADIUS_CACHE_SIZE
+    static lv_coord_t radius_cache_missed[LV_REFR_PARALLEL_MAX];    /*A radius not found by each worker*/
+    static lv_coord_t radius_cache_rejected[_LV_MASK_RADIUS_CACHE_NUM];    /*Radii not added to the full cache*/
+    static uint8_t radius_cache_rejected_next;
+#endif
 
 /**********************
  *      MACROS
@@ -69,10 +96,11 @@ LV_ATTRIBUTE_FAST_MEM static inline void sqrt_approx(lv_sqrt_res_t * q, lv_sqrt_
  */
 int16_t lv_draw_mask_add(void * param, void * custom_id)
 {
+    _lv_draw_mask_saved_t * list = LV_GC_ROOT(_lv_draw_mask_list)[_lv_worker_get_id()];
     /*Look for a free entry*/
     uint8_t i;
     for(i = 0; i < _LV_MASK_MAX_NUM; i++) {
-        if(LV_GC_ROOT(_lv_draw_mask_list[i]).param == NULL) break;
+        if(list[i].param == NULL) break;
     }
 
     if(i >= _LV_MASK_MAX_NUM) {
@@ -80,8 +108,12 @@ int16_t lv_draw_mask_add(void * param, void * custom_id)
         return LV_MASK_ID_INV;
     }
 
-    LV_GC_ROOT(_lv_draw_mask_list[i]).param = param;
-    LV_GC_ROOT(_lv_draw_mask_list[i]).custom_id = custom_id;
+    list[i].param = param;
+    list[i].custom_id = custom_id;
+
+#if LV_USE_PERF_STATS
+    _lv_perf_add_masks(1);
+#endif
 
     return i;
 }
@@ -103,7 +135,7 @@ LV_ATTRIBUTE_FAST_MEM lv_draw_mask_res_t lv_draw_mask_apply(lv_opa_t * mask_buf,
     bool changed = false;
     lv_draw_mask_common_dsc_t * dsc;
 
-    _lv_draw_mask_saved_t * m = LV_GC_ROOT(_lv_draw_mask_list);
+    _lv_draw_mask_saved_t * m = LV_GC_ROOT(_lv_draw_mask_list)[_lv_worker_get_id()];
 
     while(m->param) {
         dsc = m->param;
@@ -129,9 +161,10 @@ void * lv_draw_mask_remove_id(int16_t id)
     void * p = NULL;
 
     if(id != LV_MASK_ID_INV) {
-        p = LV_GC_ROOT(_lv_draw_mask_list[id]).param;
-        LV_GC_ROOT(_lv_draw_mask_list[id]).param = NULL;
-        LV_GC_ROOT(_lv_draw_mask_list[id]).custom_id = NULL;
+        _lv_draw_mask_saved_t * list = LV_GC_ROOT(_lv_draw_mask_list)[_lv_worker_get_id()];
+        p = list[id].param;
+        list[id].param = NULL;
+        list[id].custom_id = NULL;
     }
 
     return p;
@@ -145,13 +178,14 @@ void * lv_draw_mask_remove_id(int16_t id)
  */
 void * lv_draw_mask_remove_custom(void * custom_id)
 {
+    _lv_draw_mask_saved_t * list = LV_GC_ROOT(_lv_draw_mask_list)[_lv_worker_get_id()];
     void * p = NULL;
     uint8_t i;
     for(i = 0; i < _LV_MASK_MAX_NUM; i++) {
-        if(LV_GC_ROOT(_lv_draw_mask_list[i]).custom_id == custom_id) {
-            p = LV_GC_ROOT(_lv_draw_mask_list[i]).param;
-            LV_GC_ROOT(_lv_draw_mask_list[i]).param = NULL;
-            LV_GC_ROOT(_lv_draw_mask_list[i]).custom_id = NULL;
+        if(list[i].custom_id == custom_id) {
+            p = list[i].param;
+            list[i].param = NULL;
+            list[i].custom_id = NULL;
         }
     }
     return p;
@@ -163,14 +197,50 @@ void * lv_draw_mask_remove_custom(void * custom_id)
  */
 LV_ATTRIBUTE_FAST_MEM uint8_t lv_draw_mask_get_cnt(void)
 {
+    _lv_draw_mask_saved_t * list = LV_GC_ROOT(_lv_draw_mask_list)[_lv_worker_get_id()];
     uint8_t cnt = 0;
     uint8_t i;
     for(i = 0; i < _LV_MASK_MAX_NUM; i++) {
-        if(LV_GC_ROOT(_lv_draw_mask_list[i]).param) cnt++;
+        if(list[i].param) cnt++;
     }
     return cnt;
 }
 
+/**
+ * Precompute the corners which were missing while the workers were rendering in parallel.
+ * Called by the refresh after a parallel section.
+ */
+void _lv_draw_mask_radius_cache_add_missed(void)
+{
+#if LV_RADIUS_CACHE_SIZE
+    uint32_t i;
+    for(i = 0; i < LV_REFR_PARALLEL_MAX; i++) {
+        if(radius_cache_missed[i] == 0) continue;
+
+        radius_cache_get(radius_cache_missed[i]);
+        radius_cache_missed[i] = 0;
+    }
+#endif
+}
+
+/**
+ * Free all the precomputed corners of rounded rectangles. Radius masks initialized earlier
+ * calculate their corners row by row.
+ */
+void _lv_draw_mask_radius_cache_clean(void)
+{
+#if LV_RADIUS_CACHE_SIZE
+    _lv_draw_mask_radius_corner_t ** cache = LV_GC_ROOT(_lv_draw_mask_radius_cache);
+    uint32_t i;
+    for(i = 0; i < _LV_MASK_RADIUS_CACHE_NUM; i++) {
+        if(cache[i]) {
+            lv_mem_free(cache[i]);
+            cache[i] = NULL;
+        }
+    }
+#endif
+}
+
 /**
  *Initialize a line mask from two points.
  * @param param pointer to a `lv_draw_mask_param_t` to initialize
@@ -376,6 +446,14 @@ void lv_draw_mask_radius_init(lv_draw_mask_radius_param_t * param, const lv_area
     param->y_prev = INT32_MIN;
     param->y_prev_x.f = 0;
     param->y_prev_x.i = 0;
+    param->cache_slot = 0;
+
+#if LV_RADIUS_CACHE_SIZE
+    if(radius > 0) {
+        uint8_t slot = radius_cache_get(radius);
+        if(slot < _LV_MASK_RADIUS_CACHE_NUM) param->cache_slot = slot;
+    }
+#endif
 }
 
 /**
@@ -924,6 +1002,33 @@ LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t lv_draw_mask_radius(lv_opa_t * m
         return LV_DRAW_MASK_RES_CHANGED;
     }
 
+#if LV_RADIUS_CACHE_SIZE
+    const _lv_draw_mask_radius_corner_t * corner = LV_GC_ROOT(_lv_draw_mask_radius_cache)[p->cache_slot];
+    if(corner && corner->radius == radius) {
+        return radius_corner_cached(mask_buf, abs_x, abs_y, len, p, corner);
+    }
+#endif
+
+    return radius_corner(mask_buf, abs_x, abs_y, len, p);
+}
+
+/**
+ * Calculate the corners of a radius mask in a row
+ * @param mask_buf the mask of the row
+ * @param abs_x absolute X coordinate of the row's first pixel
+ * @param abs_y absolute Y coordinate of the row. Has to be in the top or bottom `radius` rows of the rectangle.
+ * @param len length of the row
+ * @param p the radius mask
+ * @return `LV_DRAW_MASK_RES_TRANSP` or `LV_DRAW_MASK_RES_CHANGED`
+ */
+LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t radius_corner(lv_opa_t * mask_buf, lv_coord_t abs_x, lv_coord_t abs_y,
+                                                              lv_coord_t len, lv_draw_mask_radius_param_t * p)
+{
+    bool outer = p->cfg.outer;
+    int32_t radius = p->cfg.radius;
+    lv_area_t rect;
+    lv_area_copy(&rect, &p->cfg.rect);
+
     int32_t k = rect.x1 - abs_x; /*First relevant coordinate on the of the mask*/
     int32_t w = lv_area_get_width(&rect);
     int32_t h = lv_area_get_height(&rect);
@@ -1123,6 +1228,202 @@ LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t lv_draw_mask_radius(lv_opa_t * m
     return LV_DRAW_MASK_RES_CHANGED;
 }
 
+#if LV_RADIUS_CACHE_SIZE
+/**
+ * Apply the precomputed corners of a radius mask to a row. Gives the same mask as `radius_corner()`.
+ * @param mask_buf the mask of the row
+ * @param abs_x absolute X coordinate of the row's first pixel
+ * @param abs_y absolute Y coordinate of the row. Has to be in the top or bottom `radius` rows of the rectangle.
+ * @param len length of the row
+ * @param p the radius mask
+ * @param corner the precomputed corner for the radius of `p`
+ * @return `LV_DRAW_MASK_RES_TRANSP` or `LV_DRAW_MASK_RES_CHANGED`
+ */
+LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t radius_corner_cached(lv_opa_t * mask_buf, lv_coord_t abs_x,
+                                                                     lv_coord_t abs_y, lv_coord_t len,
+                                                                     const lv_draw_mask_radius_param_t * p,
+                                                                     const _lv_draw_mask_radius_corner_t * corner)
+{
+    const lv_area_t * rect = &p->cfg.rect;
+    const radius_row_t * rows = (const radius_row_t *)(corner + 1);
+
+    /*The bottom corners are the mirrors of the top corners*/
+    int32_t t = abs_y - rect->y1;
+    if(t >= corner->radius) t = rect->y2 - abs_y;
+
+    const radius_row_t * row = &rows[t];
+    const lv_opa_t * opa = (const lv_opa_t *)&rows[corner->radius] + row->opa_start;
+    int32_t opa_len = row->len;
+
+    /*The first opacity on the left goes to the right, on the right it goes to the left*/
+    int32_t kl = rect->x1 - abs_x + row->x;
+    int32_t kr = rect->x2 - abs_x - row->x;
+
+    if(p->cfg.outer == 0) {
+        /*Clear the pixels outside of the corners*/
+        if(kl >= len || kr < 0) return LV_DRAW_MASK_RES_TRANSP;
+        if(kl > 0) _lv_memset_00(mask_buf, kl);
+        if(kr < len - 1) _lv_memset_00(&mask_buf[kr + 1], len - kr - 1);
+    }
+
+    /*Left corner*/
+    int32_t i = kl < 0 ? -kl : 0;
+    int32_t i_end = LV_MATH_MIN(opa_len, len - kl);
+    if(p->cfg.outer == 0) {
+        for(; i < i_end; i++) mask_buf[kl + i] = mask_mix(mask_buf[kl + i], opa[i]);
+    }
+    else {
+        for(; i < i_end; i++) mask_buf[kl + i] = mask_mix(mask_buf[kl + i], 255 - opa[i]);
+    }
+
+    /*Right corner*/
+    i = kr >= len ? kr - len + 1 : 0;
+    i_end = LV_MATH_MIN(opa_len, kr + 1);
+    if(p->cfg.outer == 0) {
+        for(; i < i_end; i++) mask_buf[kr - i] = mask_mix(mask_buf[kr - i], opa[i]);
+    }
+    else {
+        for(; i < i_end; i++) mask_buf[kr - i] = mask_mix(mask_buf[kr - i], 255 - opa[i]);
+    }
+
+    if(p->cfg.outer) {
+        /*Clear the pixels between the corners*/
+        int32_t first = LV_MATH_MAX(kl + opa_len, 0);
+        int32_t last = LV_MATH_MIN(kr - opa_len, len - 1);
+        if(first <= last) _lv_memset_00(&mask_buf[first], last - first + 1);
+    }
+
+    return LV_DRAW_MASK_RES_CHANGED;
+}
+
+/**
+ * Find the precomputed corner of a radius. Precompute it if it's missing.
+ * @param radius the radius
+ * @return index of the corner in the cache or `_LV_MASK_RADIUS_CACHE_NUM` if it's not cached
+ */
+static uint8_t radius_cache_get(lv_coord_t radius)
+{
+    _lv_draw_mask_radius_corner_t ** cache = LV_GC_ROOT(_lv_draw_mask_radius_cache);
+
+    /*The workers rendering in parallel only look up the cache*/
+    bool parallel = _lv_worker_is_parallel();
+
+    uint8_t i;
+    for(i = 0; i < _LV_MASK_RADIUS_CACHE_NUM; i++) {
+        if(cache[i] && cache[i]->radius == radius) {
+            if(!parallel) _lv_mem_lru_use(&cache[i]->lru);
+            return i;
+        }
+    }
+
+    /*Let the main core add it after the parallel section*/
+    if(parallel) {
+        radius_cache_missed[_lv_worker_get_id()] = radius;
+        return _LV_MASK_RADIUS_CACHE_NUM;
+    }
+
+    return radius_cache_add(radius);
+}
+
+/**
+ * Precompute the corner of a radius with `radius_corner()` and add it to the cache.
+ * If the cache is full, the least recently used corners are dropped for it, but only if the radius was
+ * rejected recently too. Else radii used in turn which don't fit together would drop each other before reuse.
+ * @param radius the radius
+ * @return index of the corner in the cache or `_LV_MASK_RADIUS_CACHE_NUM` if it's rejected or out of memory
+ */
+static uint8_t radius_cache_add(lv_coord_t radius)
+{
+    /*A quarter circle crosses less than `2 * radius` pixels, so it's the limit of the opacities*/
+    uint32_t opa_max = 2 * (uint32_t)radius;
+    uint32_t size = sizeof(_lv_draw_mask_radius_corner_t) + radius * sizeof(radius_row_t) + opa_max;
+    if(size > LV_RADIUS_CACHE_SIZE) return _LV_MASK_RADIUS_CACHE_NUM;
+
+    _lv_draw_mask_radius_corner_t ** cache = LV_GC_ROOT(_lv_draw_mask_radius_cache);
+    uint8_t slot = _lv_mem_lru_reserve((void **)cache, _LV_MASK_RADIUS_CACHE_NUM, size, LV_RADIUS_CACHE_SIZE, false);
+    if(slot == _LV_MASK_RADIUS_CACHE_NUM) {
+        /*Drop corners only for a radius rejected recently*/
+        uint8_t i;
+        for(i = 0; i < _LV_MASK_RADIUS_CACHE_NUM && radius_cache_rejected[i] != radius; i++);
+        if(i == _LV_MASK_RADIUS_CACHE_NUM) {
+            radius_cache_rejected[radius_cache_rejected_next] = radius;
+            radius_cache_rejected_next = (radius_cache_rejected_next + 1) % _LV_MASK_RADIUS_CACHE_NUM;
+            return _LV_MASK_RADIUS_CACHE_NUM;
+        }
+        radius_cache_rejected[i] = 0;
+        slot = _lv_mem_lru_reserve((void **)cache, _LV_MASK_RADIUS_CACHE_NUM, size, LV_RADIUS_CACHE_SIZE, true);
+        if(slot == _LV_MASK_RADIUS_CACHE_NUM) return _LV_MASK_RADIUS_CACHE_NUM;
+    }
+
+    _lv_draw_mask_radius_corner_t * corner = lv_mem_alloc(size);
+    lv_opa_t * buf = _lv_mem_buf_get(radius);
+    if(corner == NULL || buf == NULL) {
+        if(corner) lv_mem_free(corner);
+        if(buf) _lv_mem_buf_release(buf);
+        return _LV_MASK_RADIUS_CACHE_NUM;
+    }
+
+    /*A rectangle with only corners. Its left corner is calculated to the buffer row by row.*/
+    lv_draw_mask_radius_param_t p;
+    lv_area_set(&p.cfg.rect, 0, 0, 2 * radius - 1, 2 * radius - 1);
+    p.cfg.radius = radius;
+    p.cfg.outer = 0;
+    p.y_prev = INT32_MIN;
+    p.y_prev_x.f = 0;
+    p.y_prev_x.i = 0;
+
+    radius_row_t * rows = (radius_row_t *)(corner + 1);
+    lv_opa_t * opa = (lv_opa_t *)&rows[radius];
+    uint32_t opa_cnt = 0;
+    lv_coord_t t;
+    for(t = 0; t < radius; t++) {
+        radius_corner_row(buf, &p, t, &rows[t]);
+        if(opa_cnt + rows[t].len > opa_max) break;
+
+        rows[t].opa_start = opa_cnt;
+        _lv_memcpy(&opa[opa_cnt], &buf[rows[t].x], rows[t].len);
+        opa_cnt += rows[t].len;
+    }
+    _lv_mem_buf_release(buf);
+
+    if(t < radius) {
+        LV_LOG_WARN("radius_cache_add: too many opacities");
+        lv_mem_free(corner);
+        return _LV_MASK_RADIUS_CACHE_NUM;
+    }
+
+    corner->radius = radius;
+    corner->lru.size = size;
+    _lv_mem_lru_use(&corner->lru);
+    cache[slot] = corner;
+
+    return slot;
+}
+
+/**
+ * Calculate a row of the left corner of a rectangle with `radius_corner()`
+ * @param buf buffer for the `radius` pixels of the corner
+ * @param p radius mask of a rectangle with its left top corner at (0;0)
+ * @param t index of the row from the top
+ * @param row store the first not transparent pixel of the row and the number of not fully covered pixels from there
+ */
+static void radius_corner_row(lv_opa_t * buf, lv_draw_mask_radius_param_t * p, lv_coord_t t, radius_row_t * row)
+{
+    lv_coord_t radius = p->cfg.radius;
+    _lv_memset_ff(buf, radius);
+    radius_corner(buf, 0, t, radius, p);
+
+    lv_coord_t x = 0;
+    while(x < radius && buf[x] == LV_OPA_TRANSP) x++;
+
+    lv_coord_t x_last = radius - 1;
+    while(x_last >= x && buf[x_last] == LV_OPA_COVER) x_last--;
+
+    row->x = x;
+    row->len = x_last - x + 1;
+}
+#endif
+
 LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t lv_draw_mask_fade(lv_opa_t * mask_buf, lv_coord_t abs_x,
                                                                   lv_coord_t abs_y, lv_coord_t len,
                                                                   lv_draw_mask_fade_param_t * p)
@@ -16,12 +16,14 @@ extern "C" {
 #include <stdbool.h>
 #include "../lv_misc/lv_area.h"
 #include "../lv_misc/lv_color.h"
+#include "../lv_misc/lv_mem.h"
 
 /*********************
  *      DEFINES
  *********************/
 #define LV_MASK_ID_INV  (-1)
 #define _LV_MASK_MAX_NUM     16
+#define _LV_MASK_RADIUS_CACHE_NUM   16
 
 /**********************
  *      TYPEDEFS
@@ -134,6 +136,8 @@ typedef struct {
     int32_t y_prev;
     lv_sqrt_res_t y_prev_x;
 
+    /*Index of the precomputed corner in the radius cache. Used only if the corner there has the same radius.*/
+    uint8_t cache_slot;
 } lv_draw_mask_radius_param_t;
 
 typedef struct {
@@ -165,7 +169,17 @@ typedef struct {
     void * custom_id;
 } _lv_draw_mask_saved_t;
 
-typedef _lv_draw_mask_saved_t _lv_draw_mask_saved_arr_t[_LV_MASK_MAX_NUM];
+/*The masks of each worker rendering in parallel (see `lv_worker.h`)*/
+typedef _lv_draw_mask_saved_t _lv_draw_mask_saved_arr_t[LV_REFR_PARALLEL_MAX][_LV_MASK_MAX_NUM];
+
+/*A corner of the rounded rectangles with a given radius (see `LV_RADIUS_CACHE_SIZE`).
+ *It's followed by the description of its `radius` rows and their opacities.*/
+typedef struct {
+    _lv_mem_lru_t lru;      /*Its size with the rows and opacities*/
+    lv_coord_t radius;
+} _lv_draw_mask_radius_corner_t;
+
+typedef _lv_draw_mask_radius_corner_t * _lv_draw_mask_radius_cache_arr_t[_LV_MASK_RADIUS_CACHE_NUM];
 
 /**********************
  * GLOBAL PROTOTYPES
@@ -221,6 +235,18 @@ void * lv_draw_mask_remove_custom(void * custom_id);
  */
 LV_ATTRIBUTE_FAST_MEM uint8_t lv_draw_mask_get_cnt(void);
 
+/**
+ * Precompute the corners which were missing while the workers were rendering in parallel.
+ * Called by the refresh after a parallel section.
+ */
+void _lv_draw_mask_radius_cache_add_missed(void);
+
+/**
+ * Free all the precomputed corners of rounded rectangles. Radius masks initialized earlier
+ * calculate their corners row by row.
+ */
+void _lv_draw_mask_radius_cache_clean(void);
+
 //! @endcond
 
 /**
@@ -13,6 +13,8 @@
 #include "../lv_misc/lv_txt_ap.h"
 #include "../lv_core/lv_refr.h"
 #include "../lv_misc/lv_debug.h"
+#include "../lv_misc/lv_worker.h"
+#include "../lv_misc/lv_gc.h"
 
 /*********************
  *      DEFINES
@@ -24,6 +26,15 @@
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_DITHER_GRADIENT && LV_COLOR_DEPTH == 16
+/*A color of a gradient with the channels of the two colors summed with their mix ratios,
+ *i.e. 255 times the channels of the mixed color without rounding*/
+typedef struct {
+    uint16_t r;
+    uint16_t g;
+    uint16_t b;
+} grad_dither_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
@@ -42,6 +53,10 @@ LV_ATTRIBUTE_FAST_MEM static void draw_shadow(const lv_area_t * coords, const lv
 LV_ATTRIBUTE_FAST_MEM static void shadow_draw_corner_buf(const lv_area_t * coords,  uint16_t * sh_buf, lv_coord_t s,
                                                          lv_coord_t r);
 LV_ATTRIBUTE_FAST_MEM static void shadow_blur_corner(lv_coord_t size, lv_coord_t sw, uint16_t * sh_ups_buf);
+#if LV_SHADOW_CACHE_SIZE
+static const lv_opa_t * shadow_cache_get(const _lv_draw_shadow_corner_t * key);
+static void shadow_cache_add(const _lv_draw_shadow_corner_t * key, const lv_opa_t * sh_buf);
+#endif
 #endif
 
 #if LV_USE_PATTERN
@@ -53,15 +68,32 @@ LV_ATTRIBUTE_FAST_MEM static void shadow_blur_corner(lv_coord_t size, lv_coord_t
 #endif
 static void draw_full_border(const lv_area_t * area_inner, const lv_area_t * area_outer, const lv_area_t * clip,
                              lv_coord_t radius, bool radius_is_in, lv_color_t color, lv_opa_t opa, lv_blend_mode_t blend_mode);
-LV_ATTRIBUTE_FAST_MEM static inline lv_color_t grad_get(const lv_draw_rect_dsc_t * dsc, lv_coord_t s, lv_coord_t i);
+LV_ATTRIBUTE_FAST_MEM static void grad_mix_get(const lv_draw_rect_dsc_t * dsc, int32_t s, int32_t from, int32_t len,
+                                                lv_opa_t * mix);
+#if LV_DITHER_GRADIENT && LV_COLOR_DEPTH == 16
+LV_ATTRIBUTE_FAST_MEM static void grad_dither_lut(const lv_draw_rect_dsc_t * dsc, int32_t s, int32_t from, int32_t len,
+                                                  grad_dither_t * lut);
+LV_ATTRIBUTE_FAST_MEM static void grad_dither_line(const grad_dither_t * c, int32_t c_step, lv_coord_t x, lv_coord_t y,
+                                                   int32_t len, lv_color_t * line);
+#else
+LV_ATTRIBUTE_FAST_MEM static void grad_lut(const lv_draw_rect_dsc_t * dsc, int32_t s, int32_t from, int32_t len,
+                                           lv_color_t * lut);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LV_DITHER_GRADIENT && LV_COLOR_DEPTH == 16
+/*4x4 ordered dither matrix scaled to the fractions of a color step: `255 * (n + 0.5) / 16`*/
+static const uint8_t dither_th[4][4] = {
+    {  8, 135,  40, 167},
+    {199,  72, 231, 104},
+    { 56, 183,  24, 151},
+    {247, 120, 215,  88}
+};
+#endif
 #if LV_USE_SHADOW && LV_SHADOW_CACHE_SIZE
-    static uint8_t sh_cache[LV_SHADOW_CACHE_SIZE * LV_SHADOW_CACHE_SIZE];
-    static int32_t sh_cache_size = -1;
-    static int32_t sh_cache_r = -1;
+    static _lv_draw_shadow_corner_t shadow_cache_missed[LV_REFR_PARALLEL_MAX];  /*A corner not found by each worker*/
 #endif
 
 /**********************
@@ -125,6 +157,51 @@ void lv_draw_rect(const lv_area_t * coords, const lv_area_t * clip, const lv_dra
     LV_ASSERT_MEM_INTEGRITY();
 }
 
+/**
+ * Calculate the shadow corners which were missing while the workers were rendering in parallel
+ * and add them to the cache. Called by the refresh after a parallel section.
+ */
+void _lv_draw_shadow_cache_add_missed(void)
+{
+#if LV_USE_SHADOW && LV_SHADOW_CACHE_SIZE
+    uint32_t i;
+    for(i = 0; i < LV_REFR_PARALLEL_MAX; i++) {
+        _lv_draw_shadow_corner_t * key = &shadow_cache_missed[i];
+        if(key->sw == 0) continue;
+
+        if(shadow_cache_get(key) == NULL) {
+            int32_t corner_size = key->sw + key->r;
+            uint16_t * sh_buf = _lv_mem_buf_get(corner_size * corner_size * sizeof(uint16_t));
+            if(sh_buf) {
+                lv_area_t sh_rect_area;
+                lv_area_set(&sh_rect_area, 0, 0, key->w - 1, key->h - 1);
+                shadow_draw_corner_buf(&sh_rect_area, sh_buf, key->sw, key->r);
+                shadow_cache_add(key, (lv_opa_t *)sh_buf);
+                _lv_mem_buf_release(sh_buf);
+            }
+        }
+        key->sw = 0;
+    }
+#endif
+}
+
+/**
+ * Free all the cached shadow corners
+ */
+void _lv_draw_shadow_cache_clean(void)
+{
+#if LV_USE_SHADOW && LV_SHADOW_CACHE_SIZE
+    _lv_draw_shadow_corner_t ** cache = LV_GC_ROOT(_lv_draw_shadow_cache);
+    uint32_t i;
+    for(i = 0; i < _LV_SHADOW_CACHE_NUM; i++) {
+        if(cache[i]) {
+            lv_mem_free(cache[i]);
+            cache[i] = NULL;
+        }
+    }
+#endif
+}
+
 /**
  * Draw a pixel
  * @param point the coordinates of the point to draw
@@ -214,7 +291,6 @@ LV_ATTRIBUTE_FAST_MEM static void draw_bg(const lv_area_t * coords, const lv_are
     uint16_t other_mask_cnt = lv_draw_mask_get_cnt();
     bool simple_mode = true;
     if(other_mask_cnt) simple_mode = false;
-    else if(grad_dir == LV_GRAD_DIR_HOR) simple_mode = false;
 
     int16_t mask_rout_id = LV_MASK_ID_INV;
 
@@ -245,16 +321,45 @@ LV_ATTRIBUTE_FAST_MEM static void draw_bg(const lv_area_t * coords, const lv_are
         lv_draw_mask_res_t mask_res = LV_DRAW_MASK_RES_FULL_COVER;
         lv_color_t grad_color = dsc->bg_color;
 
+        /*Pre-compute the colors of the gradient in the drawn area.
+         *A horizontal gradient (or a dithered vertical one) is blended line by line from `grad_map`.*/
+        int32_t draw_area_h = lv_area_get_height(&draw_area);
+        lv_coord_t grad_x = disp_area->x1 + draw_area.x1;
+        lv_coord_t grad_y = disp_area->y1 + draw_area.y1;
         lv_color_t * grad_map = NULL;
-        /*In case of horizontal gradient pre-compute a line with a gradient*/
+        lv_color_t * grad_lut_buf = NULL;
+#if LV_DITHER_GRADIENT && LV_COLOR_DEPTH == 16
+        grad_dither_t * grad_dither_buf = NULL;
         if(grad_dir == LV_GRAD_DIR_HOR) {
-            grad_map = _lv_mem_buf_get(coords_w * sizeof(lv_color_t));
-
+            /*The dithered lines repeat after 4 lines*/
+            grad_dither_buf = _lv_mem_buf_get(draw_area_w * sizeof(grad_dither_t));
+            grad_dither_lut(dsc, coords_w, grad_x - coords_bg.x1, draw_area_w, grad_dither_buf);
+            grad_lut_buf = _lv_mem_buf_get(4 * draw_area_w * sizeof(lv_color_t));
             int32_t i;
-            for(i = 0; i < coords_w; i++) {
-                grad_map[i] = grad_get(dsc, coords_w, i);
+            for(i = 0; i < 4; i++) {
+                grad_dither_line(grad_dither_buf, 1, grad_x, grad_y + i, draw_area_w, &grad_lut_buf[i * draw_area_w]);
             }
+            _lv_mem_buf_release(grad_dither_buf);
+            grad_dither_buf = NULL;
+            grad_map = grad_lut_buf;
+        }
+        else if(grad_dir == LV_GRAD_DIR_VER) {
+            grad_dither_buf = _lv_mem_buf_get(draw_area_h * sizeof(grad_dither_t));
+            grad_dither_lut(dsc, coords_h, grad_y - coords_bg.y1, draw_area_h, grad_dither_buf);
+            grad_lut_buf = _lv_mem_buf_get(draw_area_w * sizeof(lv_color_t));
+            grad_map = grad_lut_buf;
         }
+#else
+        if(grad_dir == LV_GRAD_DIR_HOR) {
+            grad_lut_buf = _lv_mem_buf_get(draw_area_w * sizeof(lv_color_t));
+            grad_lut(dsc, coords_w, grad_x - coords_bg.x1, draw_area_w, grad_lut_buf);
+            grad_map = grad_lut_buf;
+        }
+        else if(grad_dir == LV_GRAD_DIR_VER) {
+            grad_lut_buf = _lv_mem_buf_get(draw_area_h * sizeof(lv_color_t));
+            grad_lut(dsc, coords_h, grad_y - coords_bg.y1, draw_area_h, grad_lut_buf);
+        }
+#endif
 
         bool split = false;
         if(lv_area_get_width(&coords_bg) - 2 * rout > SPLIT_LIMIT) split = true;
@@ -262,9 +367,9 @@ LV_ATTRIBUTE_FAST_MEM static void draw_bg(const lv_area_t * coords, const lv_are
         lv_opa_t opa2;
 
         lv_area_t fill_area;
-        fill_area.x1 = coords_bg.x1;
-        fill_area.x2 = coords_bg.x2;
-        fill_area.y1 = disp_area->y1 + draw_area.y1;
+        fill_area.x1 = grad_x;
+        fill_area.x2 = grad_x + draw_area_w - 1;
+        fill_area.y1 = grad_y;
         fill_area.y2 = fill_area.y1;
         for(h = draw_area.y1; h <= draw_area.y2; h++) {
             int32_t y = h + vdb->area.y1;
@@ -292,13 +397,22 @@ LV_ATTRIBUTE_FAST_MEM static void draw_bg(const lv_area_t * coords, const lv_are
             }
 
             /*Get the current line color*/
+#if LV_DITHER_GRADIENT && LV_COLOR_DEPTH == 16
+            if(grad_dir == LV_GRAD_DIR_VER) {
+                grad_dither_line(&grad_dither_buf[h - draw_area.y1], 0, grad_x, y, draw_area_w, grad_map);
+            }
+            else if(grad_dir == LV_GRAD_DIR_HOR) {
+                grad_map = &grad_lut_buf[((h - draw_area.y1) & 0x3) * draw_area_w];
+            }
+#else
             if(grad_dir == LV_GRAD_DIR_VER) {
-                grad_color = grad_get(dsc, lv_area_get_height(&coords_bg), y - coords_bg.y1);
+                grad_color = grad_lut_buf[h - draw_area.y1];
             }
+#endif
 
             /* If there is not other mask and drawing the corner area split the drawing to corner and middle areas
              * because it the middle mask shouldn't be taken into account (therefore its faster)*/
-            if(simple_mode && split &&
+            if(simple_mode && split && grad_map == NULL &&
                (y < coords_bg.y1 + rout + 1 ||
                 y > coords_bg.y2 - rout - 1)) {
 
@@ -331,7 +445,7 @@ LV_ATTRIBUTE_FAST_MEM static void draw_bg(const lv_area_t * coords, const lv_are
 
             }
             else {
-                if(grad_dir == LV_GRAD_DIR_HOR) {
+                if(grad_map) {
                     _lv_blend_map(clip, &fill_area, grad_map, mask_buf, mask_res, opa2, dsc->bg_blend_mode);
                 }
                 else if(grad_dir == LV_GRAD_DIR_VER) {
@@ -374,7 +488,10 @@ LV_ATTRIBUTE_FAST_MEM static void draw_bg(const lv_area_t * coords, const lv_are
 
         }
 
-        if(grad_map) _lv_mem_buf_release(grad_map);
+        if(grad_lut_buf) _lv_mem_buf_release(grad_lut_buf);
+#if LV_DITHER_GRADIENT && LV_COLOR_DEPTH == 16
+        if(grad_dither_buf) _lv_mem_buf_release(grad_dither_buf);
+#endif
     }
 
     lv_draw_mask_remove_id(mask_rout_id);
@@ -504,20 +621,131 @@ LV_ATTRIBUTE_FAST_MEM static void draw_border(const lv_area_t * coords, const lv
     }
 }
 
-LV_ATTRIBUTE_FAST_MEM static inline lv_color_t grad_get(const lv_draw_rect_dsc_t * dsc, lv_coord_t s, lv_coord_t i)
+/**
+ * Get the mix ratios of the two colors of a gradient in a range
+ * @param dsc the descriptor with the colors and the stops of the gradient
+ * @param s size of the gradient (the width or height of the background)
+ * @param from the first position to get, relative to the start of the gradient
+ * @param len number of positions to get
+ * @param mix store `len` mix ratios here. 0: main color, 255: gradient color
+ */
+LV_ATTRIBUTE_FAST_MEM static void grad_mix_get(const lv_draw_rect_dsc_t * dsc, int32_t s, int32_t from, int32_t len,
+                                                lv_opa_t * mix)
 {
     int32_t min = (dsc->bg_main_color_stop * s) >> 8;
-    if(i <= min) return dsc->bg_color;
-
     int32_t max = (dsc->bg_grad_color_stop * s) >> 8;
-    if(i >= max) return dsc->bg_grad_color;
+    int32_t end = from + len;
+    int32_t i = from;
+
+    for(; i < end && i <= min; i++) *mix++ = 0;
+
+    if(i < end && i < max) {
+        /*Step `(i - min) * 255 / d` without a division in every position*/
+        uint32_t d = (s * (dsc->bg_grad_color_stop - dsc->bg_main_color_stop)) >> 8;
+        uint32_t q = ((i - min) * 255) / d;
+        uint32_t r = ((i - min) * 255) % d;
+        uint32_t q_step = 255 / d;
+        uint32_t r_step = 255 % d;
+        for(; i < end && i < max; i++) {
+            *mix++ = q;
+            q += q_step;
+            r += r_step;
+            if(r >= d) {
+                q++;
+                r -= d;
+            }
+        }
+    }
+
+    for(; i < end; i++) *mix++ = 255;
+}
+
+#if LV_DITHER_GRADIENT && LV_COLOR_DEPTH == 16
+/**
+ * Get the colors of a gradient in a range without rounding them to 16 bit
+ * @param dsc the descriptor with the colors and the stops of the gradient
+ * @param s size of the gradient (the width or height of the background)
+ * @param from the first position to get, relative to the start of the gradient
+ * @param len number of positions to get
+ * @param lut store `len` colors here
+ */
+LV_ATTRIBUTE_FAST_MEM static void grad_dither_lut(const lv_draw_rect_dsc_t * dsc, int32_t s, int32_t from, int32_t len,
+                                                  grad_dither_t * lut)
+{
+    lv_opa_t * mix = _lv_mem_buf_get(len);
+    grad_mix_get(dsc, s, from, len, mix);
+
+    uint32_t r1 = LV_COLOR_GET_R(dsc->bg_color);
+    uint32_t g1 = LV_COLOR_GET_G(dsc->bg_color);
+    uint32_t b1 = LV_COLOR_GET_B(dsc->bg_color);
+    uint32_t r2 = LV_COLOR_GET_R(dsc->bg_grad_color);
+    uint32_t g2 = LV_COLOR_GET_G(dsc->bg_grad_color);
+    uint32_t b2 = LV_COLOR_GET_B(dsc->bg_grad_color);
+
+    int32_t i;
+    for(i = 0; i < len; i++) {
+        uint32_t m = mix[i];
+        lut[i].r = r2 * m + r1 * (255 - m);
+        lut[i].g = g2 * m + g1 * (255 - m);
+        lut[i].b = b2 * m + b1 * (255 - m);
+    }
+
+    _lv_mem_buf_release(mix);
+}
+
+/**
+ * Round the colors of a gradient to 16 bit with ordered dithering
+ * @param c the first color of the gradient
+ * @param c_step 1: use the next color for the next pixel, 0: use `c` for the whole line
+ * @param x absolute X coordinate of the first pixel
+ * @param y absolute Y coordinate of the line
+ * @param len number of pixels
+ * @param line store `len` colors here
+ */
+LV_ATTRIBUTE_FAST_MEM static void grad_dither_line(const grad_dither_t * c, int32_t c_step, lv_coord_t x, lv_coord_t y,
+                                                   int32_t len, lv_color_t * line)
+{
+    const uint8_t * th = dither_th[y & 0x3];
+
+    /*A single color repeats after 4 pixels*/
+    int32_t calc_len = c_step == 0 ? LV_MATH_MIN(len, 4) : len;
+    int32_t i;
+    for(i = 0; i < calc_len; i++) {
+        uint32_t t = th[(x + i) & 0x3];
+        LV_COLOR_SET_R(line[i], LV_MATH_UDIV255(c->r + t));
+        LV_COLOR_SET_G(line[i], LV_MATH_UDIV255(c->g + t));
+        LV_COLOR_SET_B(line[i], LV_MATH_UDIV255(c->b + t));
+        c += c_step;
+    }
+
+    for(; i < len; i++) line[i] = line[i - 4];
+}
+#else
+/**
+ * Get the colors of a gradient in a range
+ * @param dsc the descriptor with the colors and the stops of the gradient
+ * @param s size of the gradient (the width or height of the background)
+ * @param from the first position to get, relative to the start of the gradient
+ * @param len number of positions to get
+ * @param lut store `len` colors here
+ */
+LV_ATTRIBUTE_FAST_MEM static void grad_lut(const lv_draw_rect_dsc_t * dsc, int32_t s, int32_t from, int32_t len,
+                                           lv_color_t * lut)
+{
+    lv_opa_t * mix = _lv_mem_buf_get(len);
+    grad_mix_get(dsc, s, from, len, mix);
+
+    int32_t i;
+    for(i = 0; i < len; i++) {
+        if(i > 0 && mix[i] == mix[i - 1]) lut[i] = lut[i - 1];
+        else if(mix[i] == 0) lut[i] = dsc->bg_color;
+        else if(mix[i] == 255) lut[i] = dsc->bg_grad_color;
+        else lut[i] = lv_color_mix(dsc->bg_grad_color, dsc->bg_color, mix[i]);
+    }
 
-    int32_t d = dsc->bg_grad_color_stop - dsc->bg_main_color_stop;
-    d = (s * d) >> 8;
-    i -= min;
-    lv_opa_t mix = (i * 255) / d;
-    return lv_color_mix(dsc->bg_grad_color, dsc->bg_color, mix);
+    _lv_mem_buf_release(mix);
 }
+#endif
 
 #if LV_USE_SHADOW
 LV_ATTRIBUTE_FAST_MEM static void draw_shadow(const lv_area_t * coords, const lv_area_t * clip,
@@ -591,22 +819,29 @@ LV_ATTRIBUTE_FAST_MEM static void draw_shadow(const lv_area_t * coords, const lv
     lv_opa_t * sh_buf;
 
 #if LV_SHADOW_CACHE_SIZE
-    if(sh_cache_size == corner_size && sh_cache_r == r_sh) {
-        /*Use the cache if available*/
+    /*The corner depends only on these. The far edges of rectangles larger than `2 * corner_size`
+     *are out of the corner, so they have the same corner.*/
+    _lv_draw_shadow_corner_t key;
+    key.w = LV_MATH_MIN(lv_area_get_width(&sh_rect_area), 2 * corner_size);
+    key.h = LV_MATH_MIN(lv_area_get_height(&sh_rect_area), 2 * corner_size);
+    key.r = r_sh;
+    key.sw = sw;
+    key.lru.size = 0;
+    key.lru.last_use = 0;
+
+    const lv_opa_t * sh_cached = shadow_cache_get(&key);
+    if(sh_cached) {
+        /*Copy it as the corner buffer is mirrored below*/
         sh_buf = _lv_mem_buf_get(corner_size * corner_size);
-        _lv_memcpy(sh_buf, sh_cache, corner_size * corner_size);
+        _lv_memcpy(sh_buf, sh_cached, corner_size * corner_size);
     }
     else {
         /*A larger buffer is required for calculation */
         sh_buf = _lv_mem_buf_get(corner_size * corner_size * sizeof(uint16_t));
         shadow_draw_corner_buf(&sh_rect_area, (uint16_t *)sh_buf, dsc->shadow_width, r_sh);
 
-        /*Cache the corner if it fits into the cache size*/
-        if(corner_size * corner_size < sizeof(sh_cache)) {
-            _lv_memcpy(sh_cache, sh_buf, corner_size * corner_size);
-            sh_cache_size = corner_size;
-            sh_cache_r = r_sh;
-        }
+        /*The workers rendering in parallel only read the cache*/
+        if(!_lv_worker_is_parallel()) shadow_cache_add(&key, sh_buf);
     }
 #else
     sh_buf = _lv_mem_buf_get(corner_size * corner_size * sizeof(uint16_t));
@@ -1145,6 +1380,60 @@ LV_ATTRIBUTE_FAST_MEM static void shadow_blur_corner(lv_coord_t size, lv_coord_t
     _lv_mem_buf_release(sh_ups_blur_buf);
 }
 
+#if LV_SHADOW_CACHE_SIZE
+/**
+ * Look up a shadow corner in the cache
+ * @param key the parameters of the corner
+ * @return the `(sw + r)^2` opacities of the corner or NULL if it's not cached
+ */
+static const lv_opa_t * shadow_cache_get(const _lv_draw_shadow_corner_t * key)
+{
+    _lv_draw_shadow_corner_t ** cache = LV_GC_ROOT(_lv_draw_shadow_cache);
+
+    /*The workers rendering in parallel only look up the cache*/
+    bool parallel = _lv_worker_is_parallel();
+
+    uint32_t i;
+    for(i = 0; i < _LV_SHADOW_CACHE_NUM; i++) {
+        _lv_draw_shadow_corner_t * corner = cache[i];
+        if(corner && corner->w == key->w && corner->h == key->h && corner->r == key->r && corner->sw == key->sw) {
+            if(!parallel) _lv_mem_lru_use(&corner->lru);
+            return (const lv_opa_t *)(corner + 1);
+        }
+    }
+
+    /*Let the main core add it after the parallel section*/
+    if(parallel) shadow_cache_missed[_lv_worker_get_id()] = *key;
+
+    return NULL;
+}
+
+/**
+ * Add a calculated shadow corner to the cache. Drop the least recently used corners if it doesn't fit.
+ * @param key the parameters of the corner
+ * @param sh_buf the `(sw + r)^2` opacities of the corner
+ */
+static void shadow_cache_add(const _lv_draw_shadow_corner_t * key, const lv_opa_t * sh_buf)
+{
+    uint32_t corner_size = key->sw + key->r;
+    uint32_t size = sizeof(_lv_draw_shadow_corner_t) + corner_size * corner_size;
+    if(size > LV_SHADOW_CACHE_SIZE) return;
+
+    _lv_draw_shadow_corner_t ** cache = LV_GC_ROOT(_lv_draw_shadow_cache);
+    uint32_t slot = _lv_mem_lru_reserve((void **)cache, _LV_SHADOW_CACHE_NUM, size, LV_SHADOW_CACHE_SIZE, true);
+    if(slot == _LV_SHADOW_CACHE_NUM) return;
+
+    _lv_draw_shadow_corner_t * corner = lv_mem_alloc(size);
+    if(corner == NULL) return;
+
+    _lv_memcpy(corner + 1, sh_buf, corner_size * corner_size);
+    *corner = *key;
+    corner->lru.size = size;
+    _lv_mem_lru_use(&corner->lru);
+    cache[slot] = corner;
+}
+#endif
+
 #endif
 
 #if LV_USE_OUTLINE
@@ -14,10 +14,12 @@ extern "C" {
  *      INCLUDES
  *********************/
 #include "../lv_core/lv_style.h"
+#include "../lv_misc/lv_mem.h"
 
 /*********************
  *      DEFINES
  *********************/
+#define _LV_SHADOW_CACHE_NUM    16
 
 /**********************
  *      TYPEDEFS
@@ -81,12 +83,34 @@ typedef struct {
     lv_blend_mode_t value_blend_mode;
 } lv_draw_rect_dsc_t;
 
+/*A blurred shadow corner (see `LV_SHADOW_CACHE_SIZE`). It's followed by its `(sw + r)^2` opacities.*/
+typedef struct {
+    _lv_mem_lru_t lru;      /*Its size with the opacities*/
+    lv_coord_t w;           /*Size of the shadow's rectangle. Larger rectangles than `2 * (sw + r)` have the same corner.*/
+    lv_coord_t h;
+    lv_coord_t r;           /*Radius of the shadow*/
+    lv_coord_t sw;          /*Shadow width*/
+} _lv_draw_shadow_corner_t;
+
+typedef _lv_draw_shadow_corner_t * _lv_draw_shadow_cache_arr_t[_LV_SHADOW_CACHE_NUM];
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
 
 LV_ATTRIBUTE_FAST_MEM void lv_draw_rect_dsc_init(lv_draw_rect_dsc_t * dsc);
 
+/**
+ * Calculate the shadow corners which were missing while the workers were rendering in parallel
+ * and add them to the cache. Called by the refresh after a parallel section.
+ */
+void _lv_draw_shadow_cache_add_missed(void);
+
+/**
+ * Free all the cached shadow corners
+ */
+void _lv_draw_shadow_cache_clean(void);
+
 //! @endcond
 
 /**
@@ -12,6 +12,7 @@
 #include "lv_draw_img.h"
 #include "../lv_hal/lv_hal_tick.h"
 #include "../lv_misc/lv_gc.h"
+#include "../lv_misc/lv_worker.h"
 
 /*********************
  *      DEFINES
@@ -73,9 +74,12 @@ lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color)
 
     lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
 
+    /*The workers rendering in parallel only look up the cache*/
+    bool parallel = _lv_worker_is_parallel();
+
     /*Decrement all lifes. Make the entries older*/
     uint16_t i;
-    for(i = 0; i < entry_cnt; i++) {
+    for(i = 0; i < entry_cnt && !parallel; i++) {
         if(cache[i].life > INT32_MIN + LV_IMG_CACHE_AGING) {
             cache[i].life -= LV_IMG_CACHE_AGING;
         }
@@ -96,8 +100,10 @@ lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color)
              * Image difficult to open should live longer to keep avoid frequent their recaching.
              * Therefore increase `life` with `time_to_open`*/
             cached_src = &cache[i];
-            cached_src->life += cached_src->dec_dsc.time_to_open * LV_IMG_CACHE_LIFE_GAIN;
-            if(cached_src->life > LV_IMG_CACHE_LIFE_LIMIT) cached_src->life = LV_IMG_CACHE_LIFE_LIMIT;
+            if(!parallel) {
+                cached_src->life += cached_src->dec_dsc.time_to_open * LV_IMG_CACHE_LIFE_GAIN;
+                if(cached_src->life > LV_IMG_CACHE_LIFE_LIMIT) cached_src->life = LV_IMG_CACHE_LIFE_LIMIT;
+            }
             LV_LOG_TRACE("image draw: image found in the cache");
             break;
         }
@@ -106,6 +112,12 @@ lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color)
     /*The image is not cached then cache it now*/
     if(cached_src) return cached_src;
 
+    /*Only the main core can open an image. Let it draw again what this worker is drawing.*/
+    if(parallel) {
+        _lv_worker_fail();
+        return NULL;
+    }
+
     /*Find an entry to reuse. Select the entry with the least life*/
     cached_src = &cache[0];
     for(i = 1; i < entry_cnt; i++) {
@@ -124,6 +136,12 @@ lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color)
     }
 
 #else
+    /*Only the main core can open an image. Let it draw again what this worker is drawing.*/
+    if(_lv_worker_is_parallel()) {
+        _lv_worker_fail();
+        return NULL;
+    }
+
     cached_src = &cache_temp;
 #endif
     /*Open the image and measure the time to open*/
@@ -12,6 +12,7 @@
 #include "../lv_misc/lv_ll.h"
 #include "../lv_misc/lv_color.h"
 #include "../lv_misc/lv_gc.h"
+#include "../lv_misc/lv_worker.h"
 
 /*********************
  *      DEFINES
@@ -89,6 +90,12 @@ lv_res_t lv_img_decoder_get_info(const char * src, lv_img_header_t * header)
     header->w = 0;
     header->cf = LV_IMG_CF_UNKNOWN;
 
+    /*Only the main core can use the decoders. Let it draw again what this worker is drawing.*/
+    if(_lv_worker_is_parallel() && _lv_worker_get_id() != 0) {
+        _lv_worker_fail();
+        return LV_RES_INV;
+    }
+
     lv_res_t res = LV_RES_INV;
     lv_img_decoder_t * d;
     _LV_LL_READ(LV_GC_ROOT(_lv_img_defoder_ll), d) {
@@ -14,6 +14,7 @@
 #include "../lv_misc/lv_log.h"
 #include "../lv_misc/lv_utils.h"
 #include "../lv_misc/lv_mem.h"
+#include "../lv_misc/lv_worker.h"
 
 /*********************
  *      DEFINES
@@ -28,6 +29,15 @@ typedef enum {
     RLE_STATE_COUNTER,
 } rle_state_t;
 
+typedef struct {
+    uint32_t rdp;
+    const uint8_t * in;
+    uint8_t bpp;
+    uint8_t prev_v;
+    uint8_t cnt;
+    rle_state_t state;
+} rle_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -39,23 +49,18 @@ static int32_t kern_pair_16_compare(const void * ref, const void * element);
 
 #if LV_USE_FONT_COMPRESSED
     static void decompress(const uint8_t * in, uint8_t * out, lv_coord_t w, lv_coord_t h, uint8_t bpp, bool prefilter);
-    static inline void decompress_line(uint8_t * out, lv_coord_t w);
+    static inline void decompress_line(rle_t * rle, uint8_t * out, lv_coord_t w);
     static inline uint8_t get_bits(const uint8_t * in, uint32_t bit_pos, uint8_t len);
     static inline void bits_write(uint8_t * out, uint32_t bit_pos, uint8_t val, uint8_t len);
-    static inline void rle_init(const uint8_t * in,  uint8_t bpp);
-    static inline uint8_t rle_next(void);
+    static inline void rle_init(rle_t * rle, const uint8_t * in,  uint8_t bpp);
+    static inline uint8_t rle_next(rle_t * rle);
 #endif /* LV_USE_FONT_COMPRESSED */
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 #if LV_USE_FONT_COMPRESSED
-    static uint32_t rle_rdp;
-    static const uint8_t * rle_in;
-    static uint8_t rle_bpp;
-    static uint8_t rle_prev_v;
-    static uint8_t rle_cnt;
-    static rle_state_t rle_state;
+    static rle_t rle_workers[LV_REFR_PARALLEL_MAX];
 #endif /* LV_USE_FONT_COMPRESSED */
 
 /**********************
@@ -112,17 +117,18 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t unic
                 break;
         }
 
-        if(_lv_mem_get_size(LV_GC_ROOT(_lv_font_decompr_buf)) < buf_size) {
-            uint8_t * tmp = lv_mem_realloc(LV_GC_ROOT(_lv_font_decompr_buf), buf_size);
-            LV_ASSERT_MEM(tmp);
-            if(tmp == NULL) return NULL;
-            LV_GC_ROOT(_lv_font_decompr_buf) = tmp;
+        uint8_t ** decompr_buf = &LV_GC_ROOT(_lv_font_decompr_buf)[_lv_worker_get_id()];
+        if(_lv_mem_get_size(*decompr_buf) < buf_size) {
+            if(_lv_worker_realloc((void **)decompr_buf, buf_size) == false) {
+                LV_ASSERT_MEM(NULL);
+                return NULL;
+            }
         }
 
         bool prefilter = fdsc->bitmap_format == LV_FONT_FMT_TXT_COMPRESSED ? true : false;
-        decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], LV_GC_ROOT(_lv_font_decompr_buf), gdsc->box_w, gdsc->box_h,
+        decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], *decompr_buf, gdsc->box_w, gdsc->box_h,
                    (uint8_t)fdsc->bpp, prefilter);
-        return LV_GC_ROOT(_lv_font_decompr_buf);
+        return *decompr_buf;
 #else /* !LV_USE_FONT_COMPRESSED */
         return NULL;
 #endif
@@ -188,9 +194,12 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
  */
 void _lv_font_clean_up_fmt_txt(void)
 {
-    if(LV_GC_ROOT(_lv_font_decompr_buf)) {
-        lv_mem_free(LV_GC_ROOT(_lv_font_decompr_buf));
-        LV_GC_ROOT(_lv_font_decompr_buf) = NULL;
+    uint32_t i;
+    for(i = 0; i < LV_REFR_PARALLEL_MAX; i++) {
+        if(LV_GC_ROOT(_lv_font_decompr_buf)[i]) {
+            lv_mem_free(LV_GC_ROOT(_lv_font_decompr_buf)[i]);
+            LV_GC_ROOT(_lv_font_decompr_buf)[i] = NULL;
+        }
     }
 }
 
@@ -204,8 +213,9 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
 
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *) font->dsc;
 
-    /*Check the cache first*/
-    if(letter == fdsc->last_letter) return fdsc->last_glyph_id;
+    /*Check the cache first. It's shared so the workers rendering in parallel don't use it.*/
+    bool cache = !_lv_worker_is_parallel();
+    if(cache && letter == fdsc->last_letter) return fdsc->last_glyph_id;
 
     uint16_t i;
     for(i = 0; i < fdsc->cmap_num; i++) {
@@ -244,13 +254,17 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
         }
 
         /*Update the cache*/
-        fdsc->last_letter = letter;
-        fdsc->last_glyph_id = glyph_id;
+        if(cache) {
+            fdsc->last_letter = letter;
+            fdsc->last_glyph_id = glyph_id;
+        }
         return glyph_id;
     }
 
-    fdsc->last_letter = letter;
-    fdsc->last_glyph_id = 0;
+    if(cache) {
+        fdsc->last_letter = letter;
+        fdsc->last_glyph_id = 0;
+    }
     return 0;
 
 }
@@ -347,7 +361,8 @@ static void decompress(const uint8_t * in, uint8_t * out, lv_coord_t w, lv_coord
     uint8_t wr_size = bpp;
     if(bpp == 3) wr_size = 4;
 
-    rle_init(in, bpp);
+    rle_t * rle = &rle_workers[_lv_worker_get_id()];
+    rle_init(rle, in, bpp);
 
     uint8_t * line_buf1 = _lv_mem_buf_get(w);
 
@@ -357,7 +372,7 @@ static void decompress(const uint8_t * in, uint8_t * out, lv_coord_t w, lv_coord
         line_buf2 = _lv_mem_buf_get(w);
     }
 
-    decompress_line(line_buf1, w);
+    decompress_line(rle, line_buf1, w);
 
     lv_coord_t y;
     lv_coord_t x;
@@ -369,7 +384,7 @@ static void decompress(const uint8_t * in, uint8_t * out, lv_coord_t w, lv_coord
 
     for(y = 1; y < h; y++) {
         if(prefilter) {
-            decompress_line(line_buf2, w);
+            decompress_line(rle, line_buf2, w);
 
             for(x = 0; x < w; x++) {
                 line_buf1[x] = line_buf2[x] ^ line_buf1[x];
@@ -378,7 +393,7 @@ static void decompress(const uint8_t * in, uint8_t * out, lv_coord_t w, lv_coord
             }
         }
         else {
-            decompress_line(line_buf1, w);
+            decompress_line(rle, line_buf1, w);
 
             for(x = 0; x < w; x++) {
                 bits_write(out, wrp, line_buf1[x], bpp);
@@ -393,14 +408,15 @@ static void decompress(const uint8_t * in, uint8_t * out, lv_coord_t w, lv_coord
 
 /**
  * Decompress one line. Store one pixel per byte
+ * @param rle the state of the decompression
  * @param out output buffer
  * @param w width of the line in pixel count
  */
-static inline void decompress_line(uint8_t * out, lv_coord_t w)
+static inline void decompress_line(rle_t * rle, uint8_t * out, lv_coord_t w)
 {
     lv_coord_t i;
     for(i = 0; i < w; i++) {
-        out[i] = rle_next();
+        out[i] = rle_next(rle);
     }
 }
 
@@ -495,67 +511,67 @@ static inline void bits_write(uint8_t * out, uint32_t bit_pos, uint8_t val, uint
     out[byte_pos] |= (val << bit_pos);
 }
 
-static inline void rle_init(const uint8_t * in,  uint8_t bpp)
+static inline void rle_init(rle_t * rle, const uint8_t * in,  uint8_t bpp)
 {
-    rle_in = in;
-    rle_bpp = bpp;
-    rle_state = RLE_STATE_SINGLE;
-    rle_rdp = 0;
-    rle_prev_v = 0;
-    rle_cnt = 0;
+    rle->in = in;
+    rle->bpp = bpp;
+    rle->state = RLE_STATE_SINGLE;
+    rle->rdp = 0;
+    rle->prev_v = 0;
+    rle->cnt = 0;
 }
 
-static inline uint8_t rle_next(void)
+static inline uint8_t rle_next(rle_t * rle)
 {
     uint8_t v = 0;
     uint8_t ret = 0;
 
-    if(rle_state == RLE_STATE_SINGLE) {
-        ret = get_bits(rle_in, rle_rdp, rle_bpp);
-        if(rle_rdp != 0 && rle_prev_v == ret) {
-            rle_cnt = 0;
-            rle_state = RLE_STATE_REPEATE;
+    if(rle->state == RLE_STATE_SINGLE) {
+        ret = get_bits(rle->in, rle->rdp, rle->bpp);
+        if(rle->rdp != 0 && rle->prev_v == ret) {
+            rle->cnt = 0;
+            rle->state = RLE_STATE_REPEATE;
         }
 
-        rle_prev_v = ret;
-        rle_rdp += rle_bpp;
+        rle->prev_v = ret;
+        rle->rdp += rle->bpp;
     }
-    else if(rle_state == RLE_STATE_REPEATE) {
-        v = get_bits(rle_in, rle_rdp, 1);
-        rle_cnt++;
-        rle_rdp += 1;
+    else if(rle->state == RLE_STATE_REPEATE) {
+        v = get_bits(rle->in, rle->rdp, 1);
+        rle->cnt++;
+        rle->rdp += 1;
         if(v == 1) {
-            ret = rle_prev_v;
-            if(rle_cnt == 11) {
-                rle_cnt = get_bits(rle_in, rle_rdp, 6);
-                rle_rdp += 6;
-                if(rle_cnt != 0) {
-                    rle_state = RLE_STATE_COUNTER;
+            ret = rle->prev_v;
+            if(rle->cnt == 11) {
+                rle->cnt = get_bits(rle->in, rle->rdp, 6);
+                rle->rdp += 6;
+                if(rle->cnt != 0) {
+                    rle->state = RLE_STATE_COUNTER;
                 }
                 else {
-                    ret = get_bits(rle_in, rle_rdp, rle_bpp);
-                    rle_prev_v = ret;
-                    rle_rdp += rle_bpp;
-                    rle_state = RLE_STATE_SINGLE;
+                    ret = get_bits(rle->in, rle->rdp, rle->bpp);
+                    rle->prev_v = ret;
+                    rle->rdp += rle->bpp;
+                    rle->state = RLE_STATE_SINGLE;
                 }
             }
         }
         else {
-            ret = get_bits(rle_in, rle_rdp, rle_bpp);
-            rle_prev_v = ret;
-            rle_rdp += rle_bpp;
-            rle_state = RLE_STATE_SINGLE;
+            ret = get_bits(rle->in, rle->rdp, rle->bpp);
+            rle->prev_v = ret;
+            rle->rdp += rle->bpp;
+            rle->state = RLE_STATE_SINGLE;
         }
 
     }
-    else if(rle_state == RLE_STATE_COUNTER) {
-        ret = rle_prev_v;
-        rle_cnt--;
-        if(rle_cnt == 0) {
-            ret = get_bits(rle_in, rle_rdp, rle_bpp);
-            rle_prev_v = ret;
-            rle_rdp += rle_bpp;
-            rle_state = RLE_STATE_SINGLE;
+    else if(rle->state == RLE_STATE_COUNTER) {
+        ret = rle->prev_v;
+        rle->cnt--;
+        if(rle->cnt == 0) {
+            ret = get_bits(rle->in, rle->rdp, rle->bpp);
+            rle->prev_v = ret;
+            rle->rdp += rle->bpp;
+            rle->state = RLE_STATE_SINGLE;
         }
     }
 
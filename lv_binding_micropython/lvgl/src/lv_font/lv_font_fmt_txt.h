@@ -192,6 +192,9 @@ typedef struct {
 
 } lv_font_fmt_txt_dsc_t;
 
+/*The decompression buffers of each worker rendering in parallel (see `lv_worker.h`)*/
+typedef uint8_t * lv_font_decompr_buf_arr_t[LV_REFR_PARALLEL_MAX];
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
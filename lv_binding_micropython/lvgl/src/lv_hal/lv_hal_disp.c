@@ -75,11 +75,17 @@ void lv_disp_drv_init(lv_disp_drv_t * driver)
     driver->gpu_fill_cb  = NULL;
 #endif
 
+#if LV_REFR_PARALLEL_MAX > 1
+    driver->parallel_cb  = NULL;
+    driver->parallel_cnt = 1;
+#endif
+
 #if LV_USE_USER_DATA
     driver->user_data = NULL;
 #endif
 
     driver->set_px_cb = NULL;
+    driver->copy_cb = NULL;
 }
 
 /**
@@ -137,7 +143,10 @@ lv_disp_t * lv_disp_drv_register(lv_disp_drv_t * driver)
     LV_ASSERT_MEM(disp->refr_task);
     if(disp->refr_task == NULL) return NULL;
 
-    disp->inv_p = 0;
+    lv_region_init(&disp->inv_region);
+    lv_region_init(&disp->refr_region);
+    lv_region_init(&disp->occ_region);
+    disp->scroll_pending = 0;
     disp->last_activity_time = 0;
 
     disp->bg_color = LV_COLOR_WHITE;
@@ -206,6 +215,9 @@ void lv_disp_remove(lv_disp_t * disp)
     }
 
     _lv_ll_remove(&LV_GC_ROOT(_lv_disp_ll), disp);
+    lv_region_free(&disp->inv_region);
+    lv_region_free(&disp->refr_region);
+    lv_region_free(&disp->occ_region);
     lv_mem_free(disp);
 
     if(was_default) lv_disp_set_default(_lv_ll_get_head(&LV_GC_ROOT(_lv_disp_ll)));
@@ -364,25 +376,12 @@ lv_disp_buf_t * lv_disp_get_buf(lv_disp_t * disp)
 }
 
 /**
- * Get the number of areas in the buffer
- * @return number of invalid areas
+ * Get the number of rectangles in the invalid region
+ * @return number of invalid rectangles
  */
 uint16_t lv_disp_get_inv_buf_size(lv_disp_t * disp)
 {
-    return disp->inv_p;
-}
-
-/**
- * Pop (delete) the last 'num' invalidated areas from the buffer
- * @param num number of areas to delete
- */
-void _lv_disp_pop_from_inv_buf(lv_disp_t * disp, uint16_t num)
-{
-
-    if(disp->inv_p < num)
-        disp->inv_p = 0;
-    else
-        disp->inv_p -= num;
+    return disp->inv_region.cnt;
 }
 
 /**
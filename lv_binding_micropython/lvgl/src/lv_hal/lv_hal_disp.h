@@ -20,6 +20,7 @@ extern "C" {
 #include "lv_hal.h"
 #include "../lv_misc/lv_color.h"
 #include "../lv_misc/lv_area.h"
+#include "../lv_misc/lv_region.h"
 #include "../lv_misc/lv_ll.h"
 #include "../lv_misc/lv_task.h"
 
@@ -27,7 +28,7 @@ extern "C" {
  *      DEFINES
  *********************/
 #ifndef LV_INV_BUF_SIZE
-#define LV_INV_BUF_SIZE 32 /*Buffer size for invalid areas */
+#define LV_INV_BUF_SIZE 32 /*Max. number of areas to refresh in a frame. The invalid region is simplified to it*/
 #endif
 
 #ifndef LV_ATTRIBUTE_FLUSH_READY
@@ -111,12 +112,30 @@ typedef struct _disp_drv_t {
      * User can execute very simple tasks here or yield the task */
     void (*wait_cb)(struct _disp_drv_t * disp_drv);
 
+    /** OPTIONAL: Move the pixels of `area` on the display by `dx` and `dy` (the areas can overlap).
+     * The pixels moved out of `area` are dropped, the uncovered ones will be redrawn.
+     * Used to scroll without redrawing the content which is only shifted.
+     * Called when the previous flush is ready. Return `false` if it can't be done: the area is redrawn.*/
+    bool (*copy_cb)(struct _disp_drv_t * disp_drv, const lv_area_t * area, lv_coord_t dx, lv_coord_t dy);
+
     /** OPTIONAL: Called when lvgl needs any CPU cache that affects rendering to be cleaned */
     void (*clean_dcache_cb)(struct _disp_drv_t * disp_drv);
 
     /** OPTIONAL: called to wait while the gpu is working */
     void (*gpu_wait_cb)(struct _disp_drv_t * disp_drv);
 
+#if LV_REFR_PARALLEL_MAX > 1
+    /** OPTIONAL: Called to render the bands of an area on several cores.
+     * Call `band_cb(0)` on the calling core and `band_cb(1)` ... `band_cb(band_cnt - 1)` on other cores
+     * at the same time, then return `true` when all of them are ready.
+     * Return `false` without calling `band_cb` if the other cores are not available.*/
+    bool (*parallel_cb)(struct _disp_drv_t * disp_drv, void (*band_cb)(uint32_t id), uint32_t band_cnt);
+
+    /** Number of cores `parallel_cb` can use, the calling core included.
+     * The workers spin while waiting for each other so they should really run at the same time.*/
+    uint32_t parallel_cnt;
+#endif
+
 #if LV_USE_GPU
 
     /** OPTIONAL: Blend two memories using opacity (GPU only)*/
@@ -168,10 +187,21 @@ uint8_t del_prev  :
     const void * bg_img;       /**< An image source to display as wallpaper*/
     lv_opa_t bg_opa;              /**<Opacity of the background color or wallpaper */
 
-    /** Invalidated (marked to redraw) areas*/
-    lv_area_t inv_areas[LV_INV_BUF_SIZE];
-    uint8_t inv_area_joined[LV_INV_BUF_SIZE];
-    uint32_t inv_p : 10;
+    /** Invalidated (marked to redraw) pixels*/
+    lv_region_t inv_region;
+
+    /** The invalid region being refreshed. Swapped with `inv_region` to reuse the memory.
+     *  (Stored here so that a garbage collector finds its memory through the display list)*/
+    lv_region_t refr_region;
+
+    /** Covered by opaque objects in the area part being refreshed*/
+    lv_region_t occ_region;
+
+    /** An area whose pixels will be moved by `scroll_dx` and `scroll_dy` before the next refresh*/
+    lv_area_t scroll_area;
+    lv_coord_t scroll_dx;
+    lv_coord_t scroll_dy;
+    uint8_t scroll_pending : 1;
 
     /*Miscellaneous data*/
     uint32_t last_activity_time; /**< Last time there was activity on this display */
@@ -314,17 +344,11 @@ lv_disp_t * lv_disp_get_next(lv_disp_t * disp);
 lv_disp_buf_t * lv_disp_get_buf(lv_disp_t * disp);
 
 /**
- * Get the number of areas in the buffer
- * @return number of invalid areas
+ * Get the number of rectangles in the invalid region
+ * @return number of invalid rectangles
  */
 uint16_t lv_disp_get_inv_buf_size(lv_disp_t * disp);
 
-/**
- * Pop (delete) the last 'num' invalidated areas from the buffer
- * @param num number of areas to delete
- */
-void _lv_disp_pop_from_inv_buf(lv_disp_t * disp, uint16_t num);
-
 /**
  * Check the driver configuration if it's double buffered (both `buf1` and `buf2` are set)
  * @param disp pointer to to display to check
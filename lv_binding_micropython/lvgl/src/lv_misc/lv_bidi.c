@@ -10,6 +10,7 @@
 #include "lv_bidi.h"
 #include "lv_txt.h"
 #include "../lv_misc/lv_mem.h"
+#include "lv_worker.h"
 
 #if LV_USE_BIDI
 
@@ -31,6 +32,11 @@ typedef struct {
     lv_bidi_dir_t dir;
 } bracket_stack_t;
 
+typedef struct {
+    bracket_stack_t items[LV_BIDI_BRACKLET_DEPTH];
+    uint8_t p;
+} bracket_stacks_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -56,8 +62,7 @@ static uint32_t get_txt_len(const char * txt, uint32_t max_len);
  **********************/
 static const uint8_t bracket_left[] = {"<({["};
 static const uint8_t bracket_right[] = {">)}]"};
-static bracket_stack_t br_stack[LV_BIDI_BRACKLET_DEPTH];
-static uint8_t br_stack_p;
+static bracket_stacks_t br_stacks[LV_REFR_PARALLEL_MAX];  /*One for each worker rendering in parallel*/
 
 /**********************
  *      MACROS
@@ -239,7 +244,7 @@ void _lv_bidi_process_paragraph(const char * str_in, char * str_out, uint32_t le
     lv_bidi_dir_t dir = base_dir;
 
     /*Empty the bracket stack*/
-    br_stack_p = 0;
+    br_stacks[_lv_worker_get_id()].p = 0;
 
     /*Process neutral chars in the beginning*/
     while(rd < len) {
@@ -584,6 +589,7 @@ static lv_bidi_dir_t bracket_process(const char * txt, uint32_t next_pos, uint32
                                      lv_bidi_dir_t base_dir)
 {
     lv_bidi_dir_t bracket_dir = LV_BIDI_DIR_NEUTRAL;
+    bracket_stacks_t * br_stack = &br_stacks[_lv_worker_get_id()];
 
     uint8_t i;
     /*Is the letter an opening bracket?*/
@@ -638,19 +644,19 @@ static lv_bidi_dir_t bracket_process(const char * txt, uint32_t next_pos, uint32
     /*The letter was an opening bracket*/
     if(bracket_left[i] != '\0') {
 
-        if(bracket_dir == LV_BIDI_DIR_NEUTRAL || br_stack_p == LV_BIDI_BRACKLET_DEPTH) return LV_BIDI_DIR_NEUTRAL;
+        if(bracket_dir == LV_BIDI_DIR_NEUTRAL || br_stack->p == LV_BIDI_BRACKLET_DEPTH) return LV_BIDI_DIR_NEUTRAL;
 
-        br_stack[br_stack_p].bracklet_pos = i;
-        br_stack[br_stack_p].dir = bracket_dir;
+        br_stack->items[br_stack->p].bracklet_pos = i;
+        br_stack->items[br_stack->p].dir = bracket_dir;
 
-        br_stack_p++;
+        br_stack->p++;
         return bracket_dir;
     }
-    else if(br_stack_p > 0) {
+    else if(br_stack->p > 0) {
         /*Is the letter a closing bracket of the last opening?*/
-        if(letter == bracket_right[br_stack[br_stack_p - 1].bracklet_pos]) {
-            bracket_dir = br_stack[br_stack_p - 1].dir;
-            br_stack_p--;
+        if(letter == bracket_right[br_stack->items[br_stack->p - 1].bracklet_pos]) {
+            bracket_dir = br_stack->items[br_stack->p - 1].dir;
+            br_stack->p--;
             return bracket_dir;
         }
     }
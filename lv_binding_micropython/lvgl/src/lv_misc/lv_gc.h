@@ -20,6 +20,8 @@ extern "C" {
 #include "lv_task.h"
 #include "../lv_draw/lv_img_cache.h"
 #include "../lv_draw/lv_draw_mask.h"
+#include "../lv_draw/lv_draw_rect.h"
+#include "../lv_font/lv_font_fmt_txt.h"
 
 /*********************
  *      DEFINES
@@ -39,11 +41,13 @@ extern "C" {
     f(lv_task_t*, _lv_task_act)                                    \
     f(lv_mem_buf_arr_t , _lv_mem_buf)                              \
     f(_lv_draw_mask_saved_arr_t , _lv_draw_mask_list)              \
+    f(_lv_draw_mask_radius_cache_arr_t , _lv_draw_mask_radius_cache) \
+    f(_lv_draw_shadow_cache_arr_t , _lv_draw_shadow_cache)         \
     f(void * , _lv_theme_material_styles)                          \
     f(void * , _lv_theme_template_styles)                          \
     f(void * , _lv_theme_mono_styles)                              \
     f(void * , _lv_theme_empty_styles)                             \
-    f(uint8_t *, _lv_font_decompr_buf)                             \
+    f(lv_font_decompr_buf_arr_t, _lv_font_decompr_buf)             \
 
 #define LV_DEFINE_ROOT(root_type, root_name) root_type root_name;
 #define LV_ROOTS LV_ITERATE_ROOTS(LV_DEFINE_ROOT)
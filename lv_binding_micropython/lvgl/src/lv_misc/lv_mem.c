@@ -10,6 +10,7 @@
 #include "lv_mem.h"
 #include "lv_math.h"
 #include "lv_gc.h"
+#include "lv_worker.h"
 #include <string.h>
 
 #if LV_MEM_CUSTOM != 0
@@ -63,6 +64,7 @@ typedef struct {
 #endif
 
 #define MEM_BUF_SMALL_SIZE 16
+#define MEM_BUF_SMALL_NUM  2
 
 /**********************
  *  STATIC PROTOTYPES
@@ -81,17 +83,15 @@ typedef struct {
 #endif
 
 static uint32_t zero_mem; /*Give the address of this variable if 0 byte should be allocated*/
+static uint32_t lru_use_cnt; /*Counts the uses of the items of the caches (see `_lv_mem_lru_use()`)*/
 
 #if LV_MEM_CUSTOM == 0
     static uint32_t mem_max_size; /*Tracks the maximum total size of memory ever used from the internal heap*/
 #endif
 
-static uint8_t mem_buf1_32[MEM_BUF_SMALL_SIZE];
-static uint8_t mem_buf2_32[MEM_BUF_SMALL_SIZE];
-
-static lv_mem_buf_t mem_buf_small[] = {{.p = mem_buf1_32, .size = MEM_BUF_SMALL_SIZE, .used = 0},
-    {.p = mem_buf2_32, .size = MEM_BUF_SMALL_SIZE, .used = 0}
-};
+/*Small static buffers of each worker*/
+static uint8_t mem_buf_small[LV_REFR_PARALLEL_MAX][MEM_BUF_SMALL_NUM][MEM_BUF_SMALL_SIZE];
+static uint8_t mem_buf_small_used[LV_REFR_PARALLEL_MAX][MEM_BUF_SMALL_NUM];
 
 /**********************
  *      MACROS
@@ -328,6 +328,24 @@ void * lv_mem_realloc(void * data_p, size_t new_size)
 
 #endif /* lv_enable_gc */
 
+/**
+ * Reallocate a memory like `lv_mem_realloc` but never leave with an exception of the bound language
+ * (see `LV_MEM_CUSTOM_REALLOC_MAYBE`)
+ * @param data_p pointer to an allocated memory or NULL
+ * @param new_size the desired new size in byte
+ * @return pointer to the new memory or NULL if there is not enough memory
+ */
+void * _lv_mem_realloc_maybe(void * data_p, size_t new_size)
+{
+#if LV_ENABLE_GC
+    void * new_p = LV_MEM_CUSTOM_REALLOC_MAYBE(data_p, new_size);
+    if(new_p == NULL) LV_LOG_WARN("Couldn't allocate memory");
+    return new_p;
+#else
+    return lv_mem_realloc(data_p, new_size);
+#endif
+}
+
 /**
  * Join the adjacent free memory blocks
  */
@@ -467,13 +485,16 @@ void * _lv_mem_buf_get(uint32_t size)
 {
     if(size == 0) return NULL;
 
+    uint32_t id = _lv_worker_get_id();
+    lv_mem_buf_t * bufs = LV_GC_ROOT(_lv_mem_buf)[id];
+
     /*Try small static buffers first*/
     uint8_t i;
     if(size <= MEM_BUF_SMALL_SIZE) {
-        for(i = 0; i < sizeof(mem_buf_small) / sizeof(mem_buf_small[0]); i++) {
-            if(mem_buf_small[i].used == 0) {
-                mem_buf_small[i].used = 1;
-                return mem_buf_small[i].p;
+        for(i = 0; i < MEM_BUF_SMALL_NUM; i++) {
+            if(mem_buf_small_used[id][i] == 0) {
+                mem_buf_small_used[id][i] = 1;
+                return mem_buf_small[id][i];
             }
         }
     }
@@ -481,39 +502,37 @@ void * _lv_mem_buf_get(uint32_t size)
     /*Try to find a free buffer with suitable size */
     int8_t i_guess = -1;
     for(i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
-        if(LV_GC_ROOT(_lv_mem_buf[i]).used == 0 && LV_GC_ROOT(_lv_mem_buf[i]).size >= size) {
-            if(LV_GC_ROOT(_lv_mem_buf[i]).size == size) {
-                LV_GC_ROOT(_lv_mem_buf[i]).used = 1;
-                return LV_GC_ROOT(_lv_mem_buf[i]).p;
+        if(bufs[i].used == 0 && bufs[i].size >= size) {
+            if(bufs[i].size == size) {
+                bufs[i].used = 1;
+                return bufs[i].p;
             }
             else if(i_guess < 0) {
                 i_guess = i;
             }
             /*If size of `i` is closer to `size` prefer it*/
-            else if(LV_GC_ROOT(_lv_mem_buf[i]).size < LV_GC_ROOT(_lv_mem_buf[i_guess]).size) {
+            else if(bufs[i].size < bufs[i_guess].size) {
                 i_guess = i;
             }
         }
     }
 
     if(i_guess >= 0) {
-        LV_GC_ROOT(_lv_mem_buf[i_guess]).used = 1;
-        return LV_GC_ROOT(_lv_mem_buf[i_guess]).p;
+        bufs[i_guess].used = 1;
+        return bufs[i_guess].p;
     }
 
     /*Reallocate a free buffer*/
     for(i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
-        if(LV_GC_ROOT(_lv_mem_buf[i]).used == 0) {
+        if(bufs[i].used == 0) {
             /*if this fails you probably need to increase your LV_MEM_SIZE/heap size*/
-            void * buf = lv_mem_realloc(LV_GC_ROOT(_lv_mem_buf[i]).p, size);
-            if(buf == NULL) {
+            if(_lv_worker_realloc(&bufs[i].p, size) == false) {
                 LV_DEBUG_ASSERT(false, "Out of memory, can't allocate a new buffer (increase your LV_MEM_SIZE/heap size)", 0x00);
                 return NULL;
             }
-            LV_GC_ROOT(_lv_mem_buf[i]).used = 1;
-            LV_GC_ROOT(_lv_mem_buf[i]).size = size;
-            LV_GC_ROOT(_lv_mem_buf[i]).p    = buf;
-            return LV_GC_ROOT(_lv_mem_buf[i]).p;
+            bufs[i].used = 1;
+            bufs[i].size = size;
+            return bufs[i].p;
         }
     }
 
@@ -527,19 +546,21 @@ void * _lv_mem_buf_get(uint32_t size)
  */
 void _lv_mem_buf_release(void * p)
 {
+    uint32_t id = _lv_worker_get_id();
+    lv_mem_buf_t * bufs = LV_GC_ROOT(_lv_mem_buf)[id];
     uint8_t i;
 
     /*Try small static buffers first*/
-    for(i = 0; i < sizeof(mem_buf_small) / sizeof(mem_buf_small[0]); i++) {
-        if(mem_buf_small[i].p == p) {
-            mem_buf_small[i].used = 0;
+    for(i = 0; i < MEM_BUF_SMALL_NUM; i++) {
+        if(mem_buf_small[id][i] == p) {
+            mem_buf_small_used[id][i] = 0;
             return;
         }
     }
 
     for(i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
-        if(LV_GC_ROOT(_lv_mem_buf[i]).p == p) {
-            LV_GC_ROOT(_lv_mem_buf[i]).used = 0;
+        if(bufs[i].p == p) {
+            bufs[i].used = 0;
             return;
         }
     }
@@ -548,25 +569,77 @@ void _lv_mem_buf_release(void * p)
 }
 
 /**
- * Free all memory buffers
+ * Free all memory buffers (of all workers)
  */
 void _lv_mem_buf_free_all(void)
 {
+    uint32_t id;
     uint8_t i;
-    for(i = 0; i < sizeof(mem_buf_small) / sizeof(mem_buf_small[0]); i++) {
-        mem_buf_small[i].used = 0;
+    for(id = 0; id < LV_REFR_PARALLEL_MAX; id++) {
+        lv_mem_buf_t * bufs = LV_GC_ROOT(_lv_mem_buf)[id];
+
+        for(i = 0; i < MEM_BUF_SMALL_NUM; i++) {
+            mem_buf_small_used[id][i] = 0;
+        }
+
+        for(i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
+            if(bufs[i].p) {
+                lv_mem_free(bufs[i].p);
+                bufs[i].p = NULL;
+                bufs[i].used = 0;
+                bufs[i].size = 0;
+            }
+        }
     }
+}
 
-    for(i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
-        if(LV_GC_ROOT(_lv_mem_buf[i]).p) {
-            lv_mem_free(LV_GC_ROOT(_lv_mem_buf[i]).p);
-            LV_GC_ROOT(_lv_mem_buf[i]).p = NULL;
-            LV_GC_ROOT(_lv_mem_buf[i]).used = 0;
-            LV_GC_ROOT(_lv_mem_buf[i]).size = 0;
+/**
+ * Find a free slot in a cache for a new item. Free the least recently used items if the cache is full.
+ * @param items the slots of the cache: NULL or an item allocated with `lv_mem_alloc()` starting with `_lv_mem_lru_t`
+ * @param num number of slots
+ * @param size size of the new item in bytes
+ * @param budget max. total size of the items in bytes
+ * @param evict false: fail instead of freeing items
+ * @return index of the free slot or `num` if the item doesn't fit
+ */
+uint32_t _lv_mem_lru_reserve(void * items[], uint32_t num, uint32_t size, uint32_t budget, bool evict)
+{
+    if(size > budget) return num;
+
+    while(1) {
+        uint32_t used = 0;
+        uint32_t lru = num;
+        uint32_t slot = num;
+        uint32_t i;
+        for(i = 0; i < num; i++) {
+            _lv_mem_lru_t * item = items[i];
+            if(item == NULL) {
+                if(slot == num) slot = i;
+            }
+            else {
+                used += item->size;
+                if(lru == num || item->last_use < ((_lv_mem_lru_t *)items[lru])->last_use) lru = i;
+            }
         }
+
+        if(slot != num && used + size <= budget) return slot;
+        if(!evict) return num;
+
+        lv_mem_free(items[lru]);
+        items[lru] = NULL;
     }
 }
 
+/**
+ * Mark an item of a cache as the most recently used one
+ * @param item the item
+ */
+void _lv_mem_lru_use(_lv_mem_lru_t * item)
+{
+    lru_use_cnt++;
+    item->last_use = lru_use_cnt;
+}
+
 #if LV_MEMCPY_MEMSET_STD == 0
 /**
  * Same as `memcpy` but optimized for 4 byte operation.
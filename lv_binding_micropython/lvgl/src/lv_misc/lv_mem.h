@@ -17,6 +17,7 @@ extern "C" {
 
 #include <stdint.h>
 #include <stddef.h>
+#include <stdbool.h>
 #include "lv_log.h"
 #include "lv_types.h"
 
@@ -56,9 +57,16 @@ typedef struct {
     uint8_t used    : 1;
 } lv_mem_buf_t;
 
-typedef lv_mem_buf_t lv_mem_buf_arr_t[LV_MEM_BUF_MAX_NUM];
+/*The buffers of each worker rendering in parallel (see `lv_worker.h`)*/
+typedef lv_mem_buf_t lv_mem_buf_arr_t[LV_REFR_PARALLEL_MAX][LV_MEM_BUF_MAX_NUM];
 extern lv_mem_buf_arr_t _lv_mem_buf;
 
+/*The header of the items of a cache with a memory budget (see `_lv_mem_lru_reserve()`)*/
+typedef struct {
+    uint32_t size;          /*Size of the item in bytes with the header*/
+    uint32_t last_use;      /*The least recently used item is dropped first*/
+} _lv_mem_lru_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -96,6 +104,15 @@ void lv_mem_free(const void * data);
  */
 void * lv_mem_realloc(void * data_p, size_t new_size);
 
+/**
+ * Reallocate a memory like `lv_mem_realloc` but never leave with an exception of the bound language
+ * (see `LV_MEM_CUSTOM_REALLOC_MAYBE`)
+ * @param data_p pointer to an allocated memory or NULL
+ * @param new_size the desired new size in byte
+ * @return pointer to the new memory or NULL if there is not enough memory
+ */
+void * _lv_mem_realloc_maybe(void * data_p, size_t new_size);
+
 /**
  * Join the adjacent free memory blocks
  */
@@ -138,6 +155,23 @@ void _lv_mem_buf_release(void * p);
  */
 void _lv_mem_buf_free_all(void);
 
+/**
+ * Find a free slot in a cache for a new item. Free the least recently used items if the cache is full.
+ * @param items the slots of the cache: NULL or an item allocated with `lv_mem_alloc()` starting with `_lv_mem_lru_t`
+ * @param num number of slots
+ * @param size size of the new item in bytes
+ * @param budget max. total size of the items in bytes
+ * @param evict false: fail instead of freeing items
+ * @return index of the free slot or `num` if the item doesn't fit
+ */
+uint32_t _lv_mem_lru_reserve(void * items[], uint32_t num, uint32_t size, uint32_t budget, bool evict);
+
+/**
+ * Mark an item of a cache as the most recently used one
+ * @param item the item
+ */
+void _lv_mem_lru_use(_lv_mem_lru_t * item);
+
 //! @cond Doxygen_Suppress
 
 #if LV_MEMCPY_MEMSET_STD
@@ -1,4 +1,6 @@
 CSRCS += lv_area.c
+CSRCS += lv_region.c
+CSRCS += lv_worker.c
 CSRCS += lv_task.c
 CSRCS += lv_fs.c
 CSRCS += lv_anim.c
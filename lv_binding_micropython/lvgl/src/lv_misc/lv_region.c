@@ -0,0 +1,581 @@
+/**
+ * @file lv_region.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+
+#include "lv_region.h"
+#include "lv_math.h"
+#include "lv_mem.h"
+#include "lv_log.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define REGION_MIN_SIZE 8
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*Builds the result of an operation band by band into the work buffer of a region*/
+typedef struct {
+    lv_region_t * reg;
+    lv_area_t * rects;
+    uint32_t cnt;
+    uint32_t size;
+    uint32_t band;      /*Index of the first rectangle of the band being built*/
+    uint32_t prev_band; /*Index of the first rectangle of the previous band*/
+    uint8_t has_prev : 1;
+    uint8_t ok : 1;
+} region_builder_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static bool reserve(lv_area_t ** buf, uint32_t * size, uint32_t need);
+static uint32_t band_end(const lv_region_t * reg, uint32_t i);
+static void builder_init(region_builder_t * b, lv_region_t * reg);
+static void builder_add(region_builder_t * b, lv_coord_t y1, lv_coord_t y2, lv_coord_t x1, lv_coord_t x2);
+static void builder_end_band(region_builder_t * b);
+static bool builder_finish(region_builder_t * b);
+static void copy_band(region_builder_t * b, uint32_t i, uint32_t j, lv_coord_t y1, lv_coord_t y2);
+static void join_bands(region_builder_t * b, uint32_t i, uint32_t j, uint32_t k, uint32_t l, lv_coord_t y1,
+                       lv_coord_t y2, const lv_area_t * area_p);
+static uint32_t bands_union_width(const lv_region_t * reg, uint32_t i, uint32_t j, uint32_t k, uint32_t l);
+static uint32_t band_size(const lv_region_t * reg, uint32_t i, uint32_t j);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Initialize an empty region
+ * @param reg pointer to a region
+ */
+void lv_region_init(lv_region_t * reg)
+{
+    _lv_memset_00(reg, sizeof(lv_region_t));
+}
+
+/**
+ * Free the memory of a region. It's empty after it.
+ * @param reg pointer to a region
+ */
+void lv_region_free(lv_region_t * reg)
+{
+    if(reg->rects) lv_mem_free(reg->rects);
+    if(reg->tmp) lv_mem_free(reg->tmp);
+    lv_region_init(reg);
+}
+
+/**
+ * Remove all rectangles from a region but keep its memory
+ * @param reg pointer to a region
+ */
+void lv_region_clear(lv_region_t * reg)
+{
+    reg->cnt = 0;
+}
+
+/**
+ * Copy a region
+ * @param dest pointer to the destination region (initialized)
+ * @param src pointer to the source region
+ * @return false: out of memory, `dest` is the bounding box of `src`
+ */
+bool lv_region_copy(lv_region_t * dest, const lv_region_t * src)
+{
+    if(dest == src) return true;
+
+    if(src->cnt == 0) {
+        dest->cnt = 0;
+        return true;
+    }
+
+    if(reserve(&dest->rects, &dest->size, src->cnt) == false) {
+        if(reserve(&dest->rects, &dest->size, 1) == false) {
+            dest->cnt = 0;
+            return false;
+        }
+        lv_area_copy(&dest->rects[0], &src->extents);
+        lv_area_copy(&dest->extents, &src->extents);
+        dest->cnt = 1;
+        return false;
+    }
+
+    _lv_memcpy(dest->rects, src->rects, src->cnt * sizeof(lv_area_t));
+    lv_area_copy(&dest->extents, &src->extents);
+    dest->cnt = src->cnt;
+    return true;
+}
+
+/**
+ * Add an area to a region
+ * @param reg pointer to a region
+ * @param area_p the area to add
+ * @return false: out of memory, the region got the bounding box of the result
+ */
+bool lv_region_union_area(lv_region_t * reg, const lv_area_t * area_p)
+{
+    if(area_p->x1 > area_p->x2 || area_p->y1 > area_p->y2) return true;
+
+    if(reg->cnt == 0) {
+        if(reserve(&reg->rects, &reg->size, 1) == false) return false;
+        lv_area_copy(&reg->rects[0], area_p);
+        lv_area_copy(&reg->extents, area_p);
+        reg->cnt = 1;
+        return true;
+    }
+
+    if(lv_region_is_in(reg, area_p)) return true;
+
+    region_builder_t b;
+    builder_init(&b, reg);
+
+    /*First row of the area which is neither in a band nor added yet*/
+    int32_t next_y = area_p->y1;
+    uint32_t i = 0;
+    while(i < reg->cnt) {
+        uint32_t j = band_end(reg, i);
+        lv_coord_t by1 = reg->rects[i].y1;
+        lv_coord_t by2 = reg->rects[i].y2;
+
+        /*Rows of the area above this band*/
+        if(next_y < by1 && next_y <= area_p->y2) {
+            builder_add(&b, next_y, LV_MATH_MIN(by1 - 1, area_p->y2), area_p->x1, area_p->x2);
+            builder_end_band(&b);
+        }
+        next_y = LV_MATH_MAX(next_y, by2 + 1);
+
+        /*Split the band by the rows of the area*/
+        if(by1 < area_p->y1) {
+            copy_band(&b, i, j, by1, LV_MATH_MIN(by2, area_p->y1 - 1));
+        }
+        if(by1 <= area_p->y2 && by2 >= area_p->y1) {
+            join_bands(&b, i, j, j, j, LV_MATH_MAX(by1, area_p->y1), LV_MATH_MIN(by2, area_p->y2), area_p);
+        }
+        if(by2 > area_p->y2) {
+            copy_band(&b, i, j, LV_MATH_MAX(by1, area_p->y2 + 1), by2);
+        }
+
+        i = j;
+    }
+
+    /*Rows of the area below the last band*/
+    if(next_y <= area_p->y2) {
+        builder_add(&b, next_y, area_p->y2, area_p->x1, area_p->x2);
+        builder_end_band(&b);
+    }
+
+    if(builder_finish(&b) == false) {
+        LV_LOG_WARN("lv_region_union_area: out of memory, use the bounding box");
+        _lv_area_join(&reg->rects[0], &reg->extents, area_p);
+        lv_area_copy(&reg->extents, &reg->rects[0]);
+        reg->cnt = 1;
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Remove an area from a region
+ * @param reg pointer to a region
+ * @param area_p the area to remove
+ * @return false: out of memory, the region is unchanged
+ */
+bool lv_region_subtract_area(lv_region_t * reg, const lv_area_t * area_p)
+{
+    if(reg->cnt == 0) return true;
+    if(area_p->x1 > area_p->x2 || area_p->y1 > area_p->y2) return true;
+    if(_lv_area_is_on(&reg->extents, area_p) == false) return true;
+
+    region_builder_t b;
+    builder_init(&b, reg);
+
+    uint32_t i = 0;
+    while(i < reg->cnt) {
+        uint32_t j = band_end(reg, i);
+        lv_coord_t by1 = reg->rects[i].y1;
+        lv_coord_t by2 = reg->rects[i].y2;
+
+        if(by1 < area_p->y1) {
+            copy_band(&b, i, j, by1, LV_MATH_MIN(by2, area_p->y1 - 1));
+        }
+        if(by1 <= area_p->y2 && by2 >= area_p->y1) {
+            lv_coord_t y1 = LV_MATH_MAX(by1, area_p->y1);
+            lv_coord_t y2 = LV_MATH_MIN(by2, area_p->y2);
+            uint32_t k;
+            for(k = i; k < j; k++) {
+                const lv_area_t * r = &reg->rects[k];
+                if(r->x1 < area_p->x1) builder_add(&b, y1, y2, r->x1, LV_MATH_MIN(r->x2, area_p->x1 - 1));
+                if(r->x2 > area_p->x2) builder_add(&b, y1, y2, LV_MATH_MAX(r->x1, area_p->x2 + 1), r->x2);
+            }
+            builder_end_band(&b);
+        }
+        if(by2 > area_p->y2) {
+            copy_band(&b, i, j, LV_MATH_MAX(by1, area_p->y2 + 1), by2);
+        }
+
+        i = j;
+    }
+
+    return builder_finish(&b);
+}
+
+/**
+ * Reduce the number of rectangles of a region by joining the ones whose
+ * join adds the fewest pixels, until at most `max_cnt` are left.
+ * @param reg pointer to a region
+ * @param max_cnt the maximal number of rectangles to keep (at least 1)
+ */
+void lv_region_simplify(lv_region_t * reg, uint32_t max_cnt)
+{
+    if(max_cnt == 0) max_cnt = 1;
+
+    while(reg->cnt > max_cnt) {
+        /*Find the cheapest join: two neighbors in a band or two consecutive bands*/
+        uint32_t best_cost = UINT32_MAX;
+        uint32_t best_i = 0;    /*First rectangle to join*/
+        uint32_t best_k = 0;    /*Start of the next band if bands are joined, else 0*/
+        uint32_t i = 0;
+        while(i < reg->cnt && best_cost != 0) {
+            uint32_t j = band_end(reg, i);
+            uint32_t h = lv_area_get_height(&reg->rects[i]);
+            uint32_t k;
+            for(k = i; k + 1 < j; k++) {
+                uint32_t cost = (reg->rects[k + 1].x1 - reg->rects[k].x2 - 1) * h;
+                if(cost < best_cost) {
+                    best_cost = cost;
+                    best_i = k;
+                    best_k = 0;
+                }
+            }
+
+            if(j < reg->cnt) {
+                uint32_t l = band_end(reg, j);
+                uint32_t joined_h = reg->rects[j].y2 - reg->rects[i].y1 + 1;
+                uint32_t cost = bands_union_width(reg, i, j, j, l) * joined_h -
+                                band_size(reg, i, j) - band_size(reg, j, l);
+                if(cost < best_cost) {
+                    best_cost = cost;
+                    best_i = i;
+                    best_k = j;
+                }
+            }
+            i = j;
+        }
+
+        /*Rebuild the region with the join*/
+        region_builder_t b;
+        builder_init(&b, reg);
+        i = 0;
+        while(i < reg->cnt) {
+            uint32_t j = band_end(reg, i);
+            if(best_k != 0 && i == best_i) {
+                uint32_t l = band_end(reg, j);
+                join_bands(&b, i, j, j, l, reg->rects[i].y1, reg->rects[j].y2, NULL);
+                i = l;
+                continue;
+            }
+
+            uint32_t k;
+            for(k = i; k < j; k++) {
+                const lv_area_t * r = &reg->rects[k];
+                if(best_k == 0 && k == best_i) {
+                    builder_add(&b, r->y1, r->y2, r->x1, reg->rects[k + 1].x2);
+                    k++;
+                }
+                else {
+                    builder_add(&b, r->y1, r->y2, r->x1, r->x2);
+                }
+            }
+            builder_end_band(&b);
+            i = j;
+        }
+
+        if(builder_finish(&b) == false) {
+            lv_area_copy(&reg->rects[0], &reg->extents);
+            reg->cnt = 1;
+        }
+    }
+}
+
+/**
+ * Check if an area is fully in a region
+ * @param reg pointer to a region
+ * @param area_p the area to check
+ * @return true: all pixels of the area are in the region
+ */
+bool lv_region_is_in(const lv_region_t * reg, const lv_area_t * area_p)
+{
+    if(reg->cnt == 0) return false;
+    if(_lv_area_is_in(area_p, &reg->extents, 0) == false) return false;
+
+    /*Each row of the area has to be in a band, in a single rectangle*/
+    int32_t y = area_p->y1;
+    uint32_t i = 0;
+    while(i < reg->cnt) {
+        uint32_t j = band_end(reg, i);
+        if(reg->rects[i].y2 >= y) {
+            if(reg->rects[i].y1 > y) return false;
+
+            uint32_t k;
+            for(k = i; k < j; k++) {
+                if(reg->rects[k].x1 <= area_p->x1 && reg->rects[k].x2 >= area_p->x2) break;
+            }
+            if(k == j) return false;
+
+            y = reg->rects[i].y2 + 1;
+            if(y > area_p->y2) return true;
+        }
+        i = j;
+    }
+
+    return false;
+}
+
+/**
+ * Get the number of pixels in a region
+ * @param reg pointer to a region
+ * @return number of pixels
+ */
+uint32_t lv_region_get_size(const lv_region_t * reg)
+{
+    uint32_t size = 0;
+    uint32_t i;
+    for(i = 0; i < reg->cnt; i++) {
+        size += lv_area_get_size(&reg->rects[i]);
+    }
+
+    return size;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Make sure a rectangle buffer can hold `need` rectangles
+ * @return false: out of memory, the buffer is unchanged
+ */
+static bool reserve(lv_area_t ** buf, uint32_t * size, uint32_t need)
+{
+    if(*size >= need) return true;
+
+    uint32_t new_size = LV_MATH_MAX(need, LV_MATH_MAX(*size * 2, REGION_MIN_SIZE));
+    lv_area_t * new_buf = lv_mem_realloc(*buf, new_size * sizeof(lv_area_t));
+    if(new_buf == NULL) return false;
+
+    *buf = new_buf;
+    *size = new_size;
+    return true;
+}
+
+/**
+ * Get the index after the last rectangle of the band starting at `i`
+ */
+static uint32_t band_end(const lv_region_t * reg, uint32_t i)
+{
+    lv_coord_t y1 = reg->rects[i].y1;
+    for(i++; i < reg->cnt && reg->rects[i].y1 == y1; i++);
+    return i;
+}
+
+static void builder_init(region_builder_t * b, lv_region_t * reg)
+{
+    b->reg = reg;
+    b->rects = reg->tmp;
+    b->size = reg->tmp_size;
+    b->cnt = 0;
+    b->band = 0;
+    b->prev_band = 0;
+    b->has_prev = 0;
+    b->ok = 1;
+}
+
+/**
+ * Add a rectangle to the band being built. They have to come in `x1` order,
+ * overlapping or touching ones are joined.
+ */
+static void builder_add(region_builder_t * b, lv_coord_t y1, lv_coord_t y2, lv_coord_t x1, lv_coord_t x2)
+{
+    if(b->ok == 0) return;
+
+    if(b->cnt > b->band) {
+        lv_area_t * last = &b->rects[b->cnt - 1];
+        if(x1 <= last->x2 + 1) {
+            if(x2 > last->x2) last->x2 = x2;
+            return;
+        }
+    }
+
+    if(reserve(&b->rects, &b->size, b->cnt + 1) == false) {
+        b->ok = 0;
+        return;
+    }
+
+    lv_area_t * r = &b->rects[b->cnt];
+    r->x1 = x1;
+    r->y1 = y1;
+    r->x2 = x2;
+    r->y2 = y2;
+    b->cnt++;
+}
+
+/**
+ * Close the band being built. Coalesce it into the previous band if that's
+ * right above it and has the same horizontal spans.
+ */
+static void builder_end_band(region_builder_t * b)
+{
+    if(b->ok == 0 || b->cnt == b->band) return;
+
+    uint32_t n = b->cnt - b->band;
+    if(b->has_prev && b->band - b->prev_band == n &&
+       b->rects[b->prev_band].y2 + 1 == b->rects[b->band].y1) {
+        uint32_t k;
+        for(k = 0; k < n; k++) {
+            const lv_area_t * p = &b->rects[b->prev_band + k];
+            const lv_area_t * c = &b->rects[b->band + k];
+            if(p->x1 != c->x1 || p->x2 != c->x2) break;
+        }
+
+        if(k == n) {
+            lv_coord_t y2 = b->rects[b->band].y2;
+            for(k = b->prev_band; k < b->band; k++) b->rects[k].y2 = y2;
+            b->cnt = b->band;
+            return;
+        }
+    }
+
+    b->prev_band = b->band;
+    b->has_prev = 1;
+    b->band = b->cnt;
+}
+
+/**
+ * Make the built rectangles the content of the region
+ * @return false: out of memory, the region is unchanged
+ */
+static bool builder_finish(region_builder_t * b)
+{
+    lv_region_t * reg = b->reg;
+
+    if(b->ok == 0) {
+        reg->tmp = b->rects;
+        reg->tmp_size = b->size;
+        return false;
+    }
+
+    reg->tmp = reg->rects;
+    reg->tmp_size = reg->size;
+    reg->rects = b->rects;
+    reg->size = b->size;
+    reg->cnt = b->cnt;
+
+    if(reg->cnt) {
+        reg->extents.y1 = reg->rects[0].y1;
+        reg->extents.y2 = reg->rects[reg->cnt - 1].y2;
+        reg->extents.x1 = reg->rects[0].x1;
+        reg->extents.x2 = reg->rects[0].x2;
+        uint32_t i;
+        for(i = 1; i < reg->cnt; i++) {
+            if(reg->rects[i].x1 < reg->extents.x1) reg->extents.x1 = reg->rects[i].x1;
+            if(reg->rects[i].x2 > reg->extents.x2) reg->extents.x2 = reg->rects[i].x2;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Add the rows `y1..y2` of the band `i..j` as a band
+ */
+static void copy_band(region_builder_t * b, uint32_t i, uint32_t j, lv_coord_t y1, lv_coord_t y2)
+{
+    const lv_region_t * reg = b->reg;
+    for(; i < j; i++) {
+        builder_add(b, y1, y2, reg->rects[i].x1, reg->rects[i].x2);
+    }
+    builder_end_band(b);
+}
+
+/**
+ * Add a band on the rows `y1..y2` with the horizontal spans of the bands
+ * `i..j` and `k..l` and of an optional area
+ */
+static void join_bands(region_builder_t * b, uint32_t i, uint32_t j, uint32_t k, uint32_t l, lv_coord_t y1,
+                       lv_coord_t y2, const lv_area_t * area_p)
+{
+    const lv_region_t * reg = b->reg;
+    bool area_added = area_p == NULL;
+
+    while(i < j || k < l) {
+        const lv_area_t * r;
+        if(k >= l || (i < j && reg->rects[i].x1 <= reg->rects[k].x1)) r = &reg->rects[i++];
+        else r = &reg->rects[k++];
+
+        if(!area_added && area_p->x1 < r->x1) {
+            builder_add(b, y1, y2, area_p->x1, area_p->x2);
+            area_added = true;
+        }
+        builder_add(b, y1, y2, r->x1, r->x2);
+    }
+
+    if(!area_added) builder_add(b, y1, y2, area_p->x1, area_p->x2);
+    builder_end_band(b);
+}
+
+/**
+ * Get the number of columns covered by the bands `i..j` and `k..l`
+ */
+static uint32_t bands_union_width(const lv_region_t * reg, uint32_t i, uint32_t j, uint32_t k, uint32_t l)
+{
+    uint32_t w = 0;
+    int32_t x1 = 0;
+    int32_t x2 = -1;
+    bool open = false;
+
+    while(i < j || k < l) {
+        const lv_area_t * r;
+        if(k >= l || (i < j && reg->rects[i].x1 <= reg->rects[k].x1)) r = &reg->rects[i++];
+        else r = &reg->rects[k++];
+
+        if(open && r->x1 <= x2 + 1) {
+            if(r->x2 > x2) x2 = r->x2;
+        }
+        else {
+            if(open) w += x2 - x1 + 1;
+            x1 = r->x1;
+            x2 = r->x2;
+            open = true;
+        }
+    }
+    if(open) w += x2 - x1 + 1;
+
+    return w;
+}
+
+/**
+ * Get the number of pixels in the band `i..j`
+ */
+static uint32_t band_size(const lv_region_t * reg, uint32_t i, uint32_t j)
+{
+    uint32_t size = 0;
+    for(; i < j; i++) size += lv_area_get_size(&reg->rects[i]);
+    return size;
+}
@@ -0,0 +1,131 @@
+/**
+ * @file lv_region.h
+ * A set of pixels stored as y-x banded rectangles.
+ *
+ * The rectangles are sorted by `y1` then by `x1`. They never overlap and the
+ * ones on the same rows form a band: they share `y1` and `y2`. Vertically
+ * touching bands with the same horizontal spans are coalesced, so the
+ * representation of a set of pixels is unique and compact.
+ */
+
+#ifndef LV_REGION_H
+#define LV_REGION_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include "lv_area.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/** A set of pixels stored as y-x banded rectangles*/
+typedef struct {
+    lv_area_t * rects;  /**< The rectangles in y-x banded order*/
+    uint32_t cnt;       /**< Number of rectangles*/
+    uint32_t size;      /**< Allocated number of rectangles*/
+    lv_area_t * tmp;    /**< Work buffer to build the result of operations*/
+    uint32_t tmp_size;  /**< Allocated number of rectangles in `tmp`*/
+    lv_area_t extents;  /**< Bounding box of the rectangles. Valid only if `cnt != 0`*/
+} lv_region_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize an empty region
+ * @param reg pointer to a region
+ */
+void lv_region_init(lv_region_t * reg);
+
+/**
+ * Free the memory of a region. It's empty after it.
+ * @param reg pointer to a region
+ */
+void lv_region_free(lv_region_t * reg);
+
+/**
+ * Remove all rectangles from a region but keep its memory
+ * @param reg pointer to a region
+ */
+void lv_region_clear(lv_region_t * reg);
+
+/**
+ * Copy a region
+ * @param dest pointer to the destination region (initialized)
+ * @param src pointer to the source region
+ * @return false: out of memory, `dest` is the bounding box of `src`
+ */
+bool lv_region_copy(lv_region_t * dest, const lv_region_t * src);
+
+/**
+ * Add an area to a region
+ * @param reg pointer to a region
+ * @param area_p the area to add
+ * @return false: out of memory, the region got the bounding box of the result
+ */
+bool lv_region_union_area(lv_region_t * reg, const lv_area_t * area_p);
+
+/**
+ * Remove an area from a region
+ * @param reg pointer to a region
+ * @param area_p the area to remove
+ * @return false: out of memory, the region is unchanged
+ */
+bool lv_region_subtract_area(lv_region_t * reg, const lv_area_t * area_p);
+
+/**
+ * Reduce the number of rectangles of a region by joining the ones whose
+ * join adds the fewest pixels, until at most `max_cnt` are left.
+ * @param reg pointer to a region
+ * @param max_cnt the maximal number of rectangles to keep (at least 1)
+ */
+void lv_region_simplify(lv_region_t * reg, uint32_t max_cnt);
+
+/**
+ * Check if an area is fully in a region
+ * @param reg pointer to a region
+ * @param area_p the area to check
+ * @return true: all pixels of the area are in the region
+ */
+bool lv_region_is_in(const lv_region_t * reg, const lv_area_t * area_p);
+
+/**
+ * Get the number of pixels in a region
+ * @param reg pointer to a region
+ * @return number of pixels
+ */
+uint32_t lv_region_get_size(const lv_region_t * reg);
+
+/**
+ * Check if a region is empty
+ * @param reg pointer to a region
+ * @return true: no pixels in the region
+ */
+static inline bool lv_region_is_empty(const lv_region_t * reg)
+{
+    return reg->cnt == 0;
+}
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_REGION_H*/
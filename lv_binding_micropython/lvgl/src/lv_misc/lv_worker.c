@@ -0,0 +1,238 @@
+/**
+ * @file lv_worker.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_worker.h"
+
+#if LV_REFR_PARALLEL_MAX > 1
+
+/*********************
+ *      DEFINES
+ *********************/
+#if defined(__GNUC__) || defined(__clang__)
+    #define LOAD_RELAXED(v)         __atomic_load_n(&(v), __ATOMIC_RELAXED)
+    #define STORE_RELAXED(v, x)     __atomic_store_n(&(v), (x), __ATOMIC_RELAXED)
+    #define LOAD_ACQUIRE(v)         __atomic_load_n(&(v), __ATOMIC_ACQUIRE)
+    #define STORE_RELEASE(v, x)     __atomic_store_n(&(v), (x), __ATOMIC_RELEASE)
+    #define ADD_RELEASE(v, x)       __atomic_add_fetch(&(v), (x), __ATOMIC_RELEASE)
+#else
+    #error "LV_REFR_PARALLEL_MAX > 1 requires a compiler with __atomic builtins (GCC or Clang)"
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+enum {
+    REQ_NONE,
+    REQ_REALLOC,    /*Set by the worker*/
+    REQ_DONE,       /*Set by the main core*/
+};
+
+typedef struct {
+    lv_uintptr_t stack_mark;    /*Registered in `_lv_worker_enter`, 0 if not running*/
+    void ** p;                  /*Parameters of the request*/
+    size_t size;
+    bool res;                   /*Result of the request*/
+    uint8_t req;
+    uint8_t failed;
+} lv_worker_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void serve_requests(void);
+static void realloc_request(lv_worker_t * w);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+uint32_t _lv_worker_cnt;
+static uint32_t left_cnt;
+static lv_worker_t workers[LV_REFR_PARALLEL_MAX];
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Start a parallel section on the main core
+ * @param cnt number of workers, the main core included
+ */
+void _lv_worker_begin(uint32_t cnt)
+{
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        workers[i].stack_mark = 0;
+        workers[i].req = REQ_NONE;
+        workers[i].failed = 0;
+    }
+
+    left_cnt = 0;
+    _lv_worker_cnt = cnt;
+}
+
+/**
+ * End a parallel section on the main core. All workers have to be left.
+ */
+void _lv_worker_end(void)
+{
+    _lv_worker_cnt = 0;
+}
+
+/**
+ * Called by a worker when it starts to run
+ * @param id ID of the worker (0: the main core)
+ * @param stack_mark address of a local variable in the function of the worker.
+ *                   All the drawing should be done in functions called from there.
+ */
+void _lv_worker_enter(uint32_t id, void * stack_mark)
+{
+    STORE_RELAXED(workers[id].stack_mark, (lv_uintptr_t)stack_mark);
+}
+
+/**
+ * Called by a worker when it's ready. The main core waits here until all workers are ready
+ * and serves their requests in the meantime.
+ * @param id ID of the worker
+ */
+void _lv_worker_leave(uint32_t id)
+{
+    if(id != 0) {
+        STORE_RELAXED(workers[id].stack_mark, 0);
+        ADD_RELEASE(left_cnt, 1);
+        return;
+    }
+
+    /*The others might wait for memory*/
+    while(LOAD_ACQUIRE(left_cnt) < _lv_worker_cnt - 1) {
+        serve_requests();
+    }
+
+    STORE_RELAXED(workers[0].stack_mark, 0);
+}
+
+/**
+ * Get the ID of the worker running the caller
+ * @return ID of the worker. 0: the main core or no parallel section
+ */
+uint32_t _lv_worker_get_id(void)
+{
+    if(_lv_worker_cnt == 0) return 0;
+
+    /*The stack grows downwards: the caller's worker registered the closest address above this one*/
+    uint8_t here;
+    lv_uintptr_t sp = (lv_uintptr_t)&here;
+    lv_uintptr_t dist_min = (lv_uintptr_t) -1;
+    uint32_t id = 0;
+    uint32_t i;
+    for(i = 0; i < _lv_worker_cnt; i++) {
+        lv_uintptr_t mark = LOAD_RELAXED(workers[i].stack_mark);
+        if(mark >= sp && mark - sp < dist_min) {
+            dist_min = mark - sp;
+            id = i;
+        }
+    }
+
+    return id;
+}
+
+/**
+ * Reallocate a memory on any worker. On the main core it's `lv_mem_realloc` (`_lv_mem_realloc_maybe`
+ * in a parallel section), on the other workers the main core is asked to do it and the worker waits.
+ * @param p pointer to the pointer of a memory allocated by `lv_mem_alloc` (or NULL).
+ *          Updated by the main core, so it's never lost if the memory is garbage collected.
+ * @param new_size the desired new size in byte
+ * @return true: success; false: out of memory, `*p` is unchanged
+ */
+bool _lv_worker_realloc(void ** p, size_t new_size)
+{
+    uint32_t id = _lv_worker_get_id();
+    lv_worker_t * w = &workers[id];
+    w->p = p;
+    w->size = new_size;
+
+    if(id == 0) {
+        realloc_request(w);
+        return w->res;
+    }
+
+    STORE_RELEASE(w->req, REQ_REALLOC);
+    while(LOAD_ACQUIRE(w->req) != REQ_DONE);
+    w->req = REQ_NONE;
+
+    return w->res;
+}
+
+/**
+ * Serve the pending requests of the workers. Does nothing if not called on the main core.
+ */
+void _lv_worker_serve(void)
+{
+    if(_lv_worker_cnt == 0 || _lv_worker_get_id() != 0) return;
+
+    serve_requests();
+}
+
+/**
+ * Mark the work of the calling worker as failed. The work should be done again on the
+ * main core after the parallel section.
+ */
+void _lv_worker_fail(void)
+{
+    workers[_lv_worker_get_id()].failed = 1;
+}
+
+/**
+ * Check if a worker failed
+ * @param id ID of a worker
+ * @return true: `_lv_worker_fail()` was called by the worker in the last parallel section
+ */
+bool _lv_worker_has_failed(uint32_t id)
+{
+    return workers[id].failed != 0;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Do the pending requests of the workers. Only the main core can call it.
+ */
+static void serve_requests(void)
+{
+    uint32_t i;
+    for(i = 1; i < _lv_worker_cnt; i++) {
+        lv_worker_t * w = &workers[i];
+        if(LOAD_ACQUIRE(w->req) == REQ_REALLOC) {
+            realloc_request(w);
+            STORE_RELEASE(w->req, REQ_DONE);
+        }
+    }
+}
+
+/**
+ * Reallocate the memory of a request. In a parallel section an exception of the bound language
+ * (e.g. MemoryError) would leave the workers waiting forever, so it fails with `false` instead.
+ * @param w pointer to the worker which made the request
+ */
+static void realloc_request(lv_worker_t * w)
+{
+    void * new_p;
+    if(_lv_worker_cnt != 0) new_p = _lv_mem_realloc_maybe(*w->p, w->size);
+    else new_p = lv_mem_realloc(*w->p, w->size);
+
+    if(new_p) *w->p = new_p;
+    w->res = new_p != NULL;
+}
+
+#endif /*LV_REFR_PARALLEL_MAX > 1*/
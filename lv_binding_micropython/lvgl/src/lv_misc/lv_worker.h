@@ -0,0 +1,161 @@
+/**
+ * @file lv_worker.h
+ * Run the rendering on several cores.
+ *
+ * During a parallel section `LV_REFR_PARALLEL_MAX` workers draw at the same time.
+ * Worker 0 is the core which started the section (the "main core"), the others are
+ * started by the display driver's `parallel_cb`. Every worker has its own draw state
+ * (mask list, memory buffers, etc.) selected by `_lv_worker_get_id()`.
+ *
+ * A worker finds its ID from its stack position: each worker registers an address
+ * on its stack when it starts and the closest registered address above the current
+ * stack pointer belongs to the caller. The stacks of the workers never overlap,
+ * so no thread local storage is required.
+ *
+ * Only the main core allocates memory, the other workers ask it with `_lv_worker_realloc()`.
+ * Work which can't be done on a worker (e.g. opening an image) makes it fail with
+ * `_lv_worker_fail()` and the main core does it again after the section.
+ */
+
+#ifndef LV_WORKER_H
+#define LV_WORKER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "lv_mem.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+#if LV_REFR_PARALLEL_MAX > 1
+extern uint32_t _lv_worker_cnt;
+#endif
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+#if LV_REFR_PARALLEL_MAX > 1
+
+/**
+ * Start a parallel section on the main core
+ * @param cnt number of workers, the main core included
+ */
+void _lv_worker_begin(uint32_t cnt);
+
+/**
+ * End a parallel section on the main core. All workers have to be left.
+ */
+void _lv_worker_end(void);
+
+/**
+ * Called by a worker when it starts to run
+ * @param id ID of the worker (0: the main core)
+ * @param stack_mark address of a local variable in the function of the worker.
+ *                   All the drawing should be done in functions called from there.
+ */
+void _lv_worker_enter(uint32_t id, void * stack_mark);
+
+/**
+ * Called by a worker when it's ready. The main core waits here until all workers are ready
+ * and serves their requests in the meantime.
+ * @param id ID of the worker
+ */
+void _lv_worker_leave(uint32_t id);
+
+/**
+ * Get the ID of the worker running the caller
+ * @return ID of the worker. 0: the main core or no parallel section
+ */
+uint32_t _lv_worker_get_id(void);
+
+/**
+ * Check if a parallel section is running
+ * @return true: workers are running, shared data (caches, etc.) must not be modified
+ */
+static inline bool _lv_worker_is_parallel(void)
+{
+    return _lv_worker_cnt != 0;
+}
+
+/**
+ * Reallocate a memory on any worker. On the main core it's `lv_mem_realloc` (`_lv_mem_realloc_maybe`
+ * in a parallel section), on the other workers the main core is asked to do it and the worker waits.
+ * @param p pointer to the pointer of a memory allocated by `lv_mem_alloc` (or NULL).
+ *          Updated by the main core, so it's never lost if the memory is garbage collected.
+ * @param new_size the desired new size in byte
+ * @return true: success; false: out of memory, `*p` is unchanged
+ */
+bool _lv_worker_realloc(void ** p, size_t new_size);
+
+/**
+ * Serve the pending requests of the workers. Does nothing if not called on the main core.
+ */
+void _lv_worker_serve(void);
+
+/**
+ * Mark the work of the calling worker as failed. The work should be done again on the
+ * main core after the parallel section.
+ */
+void _lv_worker_fail(void);
+
+/**
+ * Check if a worker failed
+ * @param id ID of a worker
+ * @return true: `_lv_worker_fail()` was called by the worker in the last parallel section
+ */
+bool _lv_worker_has_failed(uint32_t id);
+
+#else
+
+static inline uint32_t _lv_worker_get_id(void)
+{
+    return 0;
+}
+
+static inline bool _lv_worker_is_parallel(void)
+{
+    return false;
+}
+
+static inline void _lv_worker_serve(void)
+{
+}
+
+static inline void _lv_worker_fail(void)
+{
+}
+
+static inline bool _lv_worker_realloc(void ** p, size_t new_size)
+{
+    void * new_p = lv_mem_realloc(*p, new_size);
+    if(new_p == NULL) return false;
+    *p = new_p;
+    return true;
+}
+
+#endif /*LV_REFR_PARALLEL_MAX > 1*/
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_WORKER_H*/
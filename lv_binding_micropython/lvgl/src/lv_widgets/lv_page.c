@@ -51,6 +51,7 @@ static lv_style_list_t * lv_page_get_style(lv_obj_t * page, uint8_t part);
 static lv_res_t lv_page_scrollable_signal(lv_obj_t * scrl, lv_signal_t sign, void * param);
 static void scrl_def_event_cb(lv_obj_t * scrl, lv_event_t event);
 static void refr_ext_draw_pad(lv_obj_t * page);
+static void get_scroll_area(lv_obj_t * page, lv_get_scroll_area_info_t * info);
 #if LV_USE_ANIMATION
     static void edge_flash_anim(void * page, lv_anim_value_t v);
     static void edge_flash_anim_end(lv_anim_t * a);
@@ -889,6 +890,10 @@ static lv_res_t lv_page_signal(lv_obj_t * page, lv_signal_t sign, void * param)
         *editable       = true;
 #endif
     }
+    else if(sign == LV_SIGNAL_GET_SCROLL_AREA) {
+        /*Widgets drawing over the scrollable in their own design function can't be scrolled this way*/
+        if(page->design_cb == lv_page_design) get_scroll_area(page, param);
+    }
 
     return res;
 }
@@ -1322,6 +1327,62 @@ static void scrlbar_refresh(lv_obj_t * page)
     }
 }
 
+/**
+ * Get the area where nothing is drawn over the scrollable and tell whether the background is a
+ * single color there. The scrollbars, the edge flash, the border and the rounded corners are left out.
+ * @param page pointer to a page object
+ * @param info store the result here
+ */
+static void get_scroll_area(lv_obj_t * page, lv_get_scroll_area_info_t * info)
+{
+    lv_page_ext_t * ext = lv_obj_get_ext_attr(page);
+
+#if LV_USE_ANIMATION
+    if(ext->edge_flash.left_ip || ext->edge_flash.right_ip || ext->edge_flash.top_ip || ext->edge_flash.bottom_ip) {
+        return;
+    }
+#endif
+
+    lv_area_t area;
+    lv_area_copy(&area, &page->coords);
+
+    lv_style_int_t border_w = lv_obj_get_style_border_width(page, LV_PAGE_PART_BG);
+    area.x1 += border_w;
+    area.y1 += border_w;
+    area.x2 -= border_w;
+    area.y2 -= border_w;
+
+    lv_style_int_t r = lv_obj_get_style_radius(page, LV_PAGE_PART_BG);
+    r = LV_MATH_MIN(r, lv_obj_get_height(page) / 2);
+    area.y1 += r;
+    area.y2 -= r;
+
+    if(ext->scrlbar.mode != LV_SCROLLBAR_MODE_OFF && (ext->scrlbar.mode & LV_SCROLLBAR_MODE_HIDE) == 0) {
+        lv_style_int_t sb_width = lv_obj_get_style_size(page, LV_PAGE_PART_SCROLLBAR);
+        lv_style_int_t sb_right = lv_obj_get_style_pad_right(page, LV_PAGE_PART_SCROLLBAR);
+        lv_style_int_t sb_bottom = lv_obj_get_style_pad_bottom(page, LV_PAGE_PART_SCROLLBAR);
+        area.x2 = LV_MATH_MIN(area.x2, page->coords.x2 - sb_width - sb_right);
+        area.y2 = LV_MATH_MIN(area.y2, page->coords.y2 - sb_width - sb_bottom);
+    }
+
+    if(area.x1 > area.x2 || area.y1 > area.y2) return;
+    lv_area_copy(&info->area, &area);
+
+    /*Content moving over a single color background looks the same everywhere*/
+    info->bg_uniform = false;
+    if(lv_obj_get_style_bg_opa(page, LV_PAGE_PART_BG) < LV_OPA_MAX) return;
+    if(lv_obj_get_style_opa_scale(page, LV_PAGE_PART_BG) < LV_OPA_MAX) return;
+    if(lv_obj_get_style_bg_blend_mode(page, LV_PAGE_PART_BG) != LV_BLEND_MODE_NORMAL) return;
+    if(lv_obj_get_style_bg_grad_dir(page, LV_PAGE_PART_BG) != LV_GRAD_DIR_NONE) return;
+    if(lv_obj_get_style_transform_width(page, LV_PAGE_PART_BG) < 0) return;
+    if(lv_obj_get_style_transform_height(page, LV_PAGE_PART_BG) < 0) return;
+    if(lv_obj_get_style_pattern_image(page, LV_PAGE_PART_BG) &&
+       lv_obj_get_style_pattern_opa(page, LV_PAGE_PART_BG) > LV_OPA_MIN) return;
+    if(lv_obj_get_style_value_str(page, LV_PAGE_PART_BG) &&
+       lv_obj_get_style_value_opa(page, LV_PAGE_PART_BG) > LV_OPA_MIN) return;
+    info->bg_uniform = true;
+}
+
 static void refr_ext_draw_pad(lv_obj_t * page)
 {
     lv_style_int_t sb_bottom = lv_obj_get_style_pad_bottom(page, LV_PAGE_PART_SCROLLBAR);
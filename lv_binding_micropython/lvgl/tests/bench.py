@@ -0,0 +1,51 @@
+#!/usr/bin/env python3
+
+# Build and run the scene benchmarks of lv_bench on the headless display.
+#
+#   ./bench.py              run every scene, check the reference images
+#   ./bench.py -s shadow    run one scene
+#   ./bench.py -u           save the reference images after an intended rendering change
+#   ./bench.py -k none      use the scalar blend code instead of the SSE2/AVX2 kernels
+#   ./bench.py -h           list the other options
+#
+# The options are passed to lv_bench/bench.bin.
+
+import os
+import sys
+import build
+
+# Like the advanced features config but without the debug checks, so they are not measured
+bench_features = dict(build.advanced_features)
+bench_features.update({
+  "LV_USE_DEBUG":0,
+  "LV_USE_ASSERT_NULL":0,
+  "LV_USE_ASSERT_MEM":0,
+  "LV_USE_ASSERT_STR":0,
+  "LV_USE_ASSERT_OBJ":0,
+  "LV_USE_ASSERT_STYLE":0,
+  "LV_USE_LOG":0,
+})
+
+def bench(args):
+  print("=============================")
+  print("Benchmark")
+  print("=============================")
+
+  make = "make -C lv_bench LVGL_DIR_NAME=" + build.lvgldirname
+  cmd = make + " -j8 BIN=bench.bin DEFINES=" + build.make_defines(bench_features) + " OPTIMIZATION=" + build.optimization
+
+  # The LVGL objects are shared with the tests so always start from scratch
+  os.system("make clean LVGL_DIR_NAME=" + build.lvgldirname)
+  os.system(make + " clean BIN=bench.bin")
+  ret = os.system(cmd)
+  if(ret != 0):
+    print("BUILD ERROR! (error code " + str(ret) + ")")
+    exit(1)
+
+  ret = os.system("cd lv_bench && ./bench.bin " + " ".join(args))
+  if(ret != 0):
+    print("RUN ERROR! (error code " + str(ret) + ")")
+    exit(1)
+
+if __name__ == "__main__":
+  bench(sys.argv[1:])
@@ -9,6 +9,15 @@ lvgldirname = '"' + lvgldirname + '"'
 base_defines = '"-DLV_CONF_PATH=' + lvgldirname +'/tests/lv_test_conf.h -DLV_BUILD_TEST"'
 optimization = '"-O3 -g0"'
 
+def make_defines(defines):
+  d_all = base_defines[:-1] + " ";
+
+  for d in defines:
+    d_all += " -D" + d + "=" + str(defines[d])
+
+  d_all += '"'
+  return d_all
+
 def build(name, defines):
   global base_defines, optimization
 
@@ -16,13 +25,7 @@ def build(name, defines):
   print(name)
   print("=============================")
 
-  d_all = base_defines[:-1] + " ";
-
-  for d in defines:
-    d_all += " -D" + d + "=" + str(defines[d])
-
-  d_all += '"'
-  cmd = "make -j8 BIN=test.bin LVGL_DIR_NAME=" + lvgldirname + " DEFINES=" + d_all + " OPTIMIZATION=" + optimization
+  cmd = "make -j8 BIN=test.bin LVGL_DIR_NAME=" + lvgldirname + " DEFINES=" + make_defines(defines) + " OPTIMIZATION=" + optimization
 
   print("---------------------------")
   print("Clean")
@@ -59,6 +62,8 @@ minimal_monochrome = {
   "LV_USE_ANIMATION":0,
   "LV_ANTIALIAS":0,
   "LV_GPU":0,
+  "LV_RADIUS_CACHE_SIZE":0,
+  "LV_SHADOW_CACHE_SIZE":0,
   "LV_USE_FILESYSTEM":0,
   "LV_USE_IMG_TRANSFORM":0,
   "LV_USE_API_EXTENSION_V6":0,
@@ -138,6 +143,8 @@ all_obj_minimal_features = {
   "LV_USE_ANIMATION":0,
   "LV_ANTIALIAS":0,
   "LV_GPU":0,
+  "LV_RADIUS_CACHE_SIZE":0,
+  "LV_SHADOW_CACHE_SIZE":0,
   "LV_USE_FILESYSTEM":0,
   "LV_USE_IMG_TRANSFORM":0,
   "LV_USE_API_EXTENSION_V6":0,
@@ -211,6 +218,8 @@ all_obj_all_features = {
   "LV_VER_RES_MAX":320,
   "LV_COLOR_DEPTH":32,
   "LV_COLOR_SCREEN_TRANSP":1,
+  "LV_REFR_PARALLEL_MAX":4,
+  "LV_USE_PERF_STATS":1,
   "LV_USE_GROUP":1,
   "LV_USE_ANIMATION":1,
   "LV_ANTIALIAS":1,
@@ -291,6 +300,8 @@ advanced_features = {
   "LV_COLOR_DEPTH":32,
   "LV_COLOR_16_SWAP":0,
   "LV_COLOR_SCREEN_TRANSP":1,
+  "LV_REFR_PARALLEL_MAX":4,
+  "LV_USE_PERF_STATS":1,
   "LV_USE_GROUP":1,
   "LV_USE_ANIMATION":1,
   "LV_ANTIALIAS":1,
@@ -369,7 +380,18 @@ advanced_features = {
   "LV_USE_WIN":1
 }
 
-build("Minimal monochrome", minimal_monochrome)
-build("All objects, minimal features", all_obj_minimal_features)
-build("All objects, all common features", all_obj_all_features)
-build("All objects, with advanced features", advanced_features)
+# The same with 16 bit colors and dithered gradients
+all_obj_minimal_features_16bit = dict(all_obj_minimal_features)
+all_obj_minimal_features_16bit["LV_COLOR_DEPTH"] = 16
+all_obj_minimal_features_16bit["LV_DITHER_GRADIENT"] = 1
+
+if __name__ == "__main__":
+  build("Minimal monochrome", minimal_monochrome)
+  build("All objects, minimal features", all_obj_minimal_features)
+  build("All objects, minimal features, 16 bit colors", all_obj_minimal_features_16bit)
+  build("All objects, all common features", all_obj_all_features)
+  build("All objects, with advanced features", advanced_features)
+
+  # Render a few frames of every benchmark scene and compare them with the reference images
+  import bench
+  bench.bench(["-f", "2"])
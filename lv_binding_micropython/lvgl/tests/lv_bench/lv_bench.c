@@ -0,0 +1,697 @@
+/**
+ * @file lv_bench.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_bench.h"
+
+#if LV_BUILD_TEST
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "lv_headless.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+/*Virtual time between two frames*/
+#define FRAME_PERIOD    LV_DISP_DEF_REFR_PERIOD
+
+#define GRID_COLS       6
+#define GRID_ROWS       4
+#define GRID_GAP        12
+#define IMG_SIZE        64
+#define CHART_POINTS    60
+#define PAGE_ITEMS      60
+#define BTN_COLS        20
+#define BTN_ROWS        10
+#define BTN_GAP         6
+#define CARD_COLS       4
+#define CARD_ROWS       3
+#define CARD_GAP        40
+#define HEADER_CNT      3
+#define HEADER_H        56
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    const char * name;
+    void (*create)(lv_obj_t * scr);
+    void (*update)(uint32_t frame);     /*Change the scene before rendering a frame. Can be NULL.*/
+    bool full_redraw;                   /*Invalidate the whole screen in every frame*/
+} scene_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static bool run_scene(const scene_t * scene, const lv_bench_opts_t * opts, bool * ref_ok);
+static bool check_ref(const scene_t * scene, const lv_bench_opts_t * opts);
+static void dump_frame(const scene_t * scene, const lv_bench_opts_t * opts, uint32_t frame);
+static uint64_t time_ns(void);
+static uint32_t rnd(void);
+static lv_obj_t * grid_cell(lv_obj_t * scr, uint32_t i);
+static lv_color_t palette(uint32_t i);
+
+static void rect_radius_create(lv_obj_t * scr);
+static void rect_opa_create(lv_obj_t * scr);
+static void shadow_create(lv_obj_t * scr);
+static void card_grid_create(lv_obj_t * scr);
+static void gradient_create(lv_obj_t * scr);
+static void grad_headers_create(lv_obj_t * scr);
+#if LV_USE_BLEND_MODES
+    static void blend_modes_create(lv_obj_t * scr);
+#endif
+#if LV_USE_BTN
+    static void btn_grid_create(lv_obj_t * scr);
+#endif
+#if LV_USE_LABEL
+    static void label_fonts_create(lv_obj_t * scr);
+#endif
+#if LV_USE_IMG && LV_USE_IMG_TRANSFORM
+    static void img_transform_create(lv_obj_t * scr);
+    static void img_transform_update(uint32_t frame);
+#endif
+#if LV_USE_ARC
+    static void arc_create(lv_obj_t * scr);
+    static void arc_update(uint32_t frame);
+#endif
+#if LV_USE_CHART
+    static void chart_create(lv_obj_t * scr);
+    static void chart_update(uint32_t frame);
+#endif
+#if LV_USE_PAGE && LV_USE_BTN && LV_USE_LABEL
+    static void page_scroll_create(lv_obj_t * scr);
+    static void page_scroll_update(uint32_t frame);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static const scene_t scenes[] = {
+    {"rect_radius", rect_radius_create, NULL, true},
+    {"rect_opa", rect_opa_create, NULL, true},
+    {"shadow", shadow_create, NULL, true},
+    {"card_grid", card_grid_create, NULL, true},
+    {"gradient", gradient_create, NULL, true},
+    {"grad_headers", grad_headers_create, NULL, true},
+#if LV_USE_BLEND_MODES
+    {"blend_modes", blend_modes_create, NULL, true},
+#endif
+#if LV_USE_BTN
+    {"btn_grid", btn_grid_create, NULL, true},
+#endif
+#if LV_USE_LABEL
+    {"label_fonts", label_fonts_create, NULL, true},
+#endif
+#if LV_USE_IMG && LV_USE_IMG_TRANSFORM
+    {"img_transform", img_transform_create, img_transform_update, true},
+#endif
+#if LV_USE_ARC
+    {"arc", arc_create, arc_update, true},
+#endif
+#if LV_USE_CHART
+    {"chart", chart_create, chart_update, true},
+#endif
+#if LV_USE_PAGE && LV_USE_BTN && LV_USE_LABEL
+    {"page_scroll", page_scroll_create, page_scroll_update, false},
+#endif
+};
+
+/*Objects of the scene being run*/
+static lv_obj_t * objs[GRID_COLS * GRID_ROWS];
+static uint32_t obj_cnt;
+
+#if LV_USE_CHART
+    static lv_chart_series_t * sers[4];
+    static uint32_t ser_cnt;
+#endif
+
+#if LV_USE_IMG && LV_USE_IMG_TRANSFORM
+    static uint8_t img_map[IMG_SIZE * IMG_SIZE * LV_IMG_PX_SIZE_ALPHA_BYTE];
+    static lv_img_dsc_t img_dsc;
+#endif
+
+#if LV_USE_PAGE && LV_USE_BTN && LV_USE_LABEL
+    static lv_coord_t scrl_y0;
+#endif
+
+static uint32_t rnd_state;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Run the benchmark scenes on the default display and print ms/frame and pixels/s of each
+ * @param opts options of the run
+ * @return number of scenes which differ from their reference image or couldn't be checked
+ */
+uint32_t lv_bench_run(const lv_bench_opts_t * opts)
+{
+    uint32_t fail_cnt = 0;
+    bool found = false;
+
+#if LV_USE_BLEND_SIMD
+    printf("Blend kernels: %s\n", _lv_blend_simd_name(_lv_blend_simd_get()));
+#endif
+    printf("%-16s %8s %10s %10s %10s  %s\n", "scene", "frames", "ms/frame", "px/frame", "Mpx/s", "reference");
+
+    uint32_t i;
+    for(i = 0; i < sizeof(scenes) / sizeof(scenes[0]); i++) {
+        if(opts->scene && strcmp(opts->scene, scenes[i].name) != 0) continue;
+        found = true;
+
+        bool ref_ok = true;
+        run_scene(&scenes[i], opts, &ref_ok);
+        if(!ref_ok) fail_cnt++;
+    }
+
+    if(!found) {
+        printf("No scene named '%s'\n", opts->scene);
+        fail_cnt++;
+    }
+
+    return fail_cnt;
+}
+
+/**
+ * Print the names of the scenes
+ */
+void lv_bench_list(void)
+{
+    uint32_t i;
+    for(i = 0; i < sizeof(scenes) / sizeof(scenes[0]); i++) {
+        printf("%s\n", scenes[i].name);
+    }
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Create a scene, check its first frame and measure the next frames
+ * @param scene the scene to run
+ * @param opts options of the run
+ * @param ref_ok set to false if the first frame differs from the reference image
+ * @return true: the scene ran
+ */
+static bool run_scene(const scene_t * scene, const lv_bench_opts_t * opts, bool * ref_ok)
+{
+    lv_obj_t * old_scr = lv_scr_act();
+    lv_obj_t * scr = lv_obj_create(NULL, NULL);
+    lv_scr_load(scr);
+    lv_obj_del(old_scr);
+
+    obj_cnt = 0;
+    rnd_state = 1;
+    scene->create(scr);
+
+    /*The first frame is always a full redraw*/
+    if(scene->update) scene->update(0);
+    lv_obj_invalidate(scr);
+    lv_refr_now(NULL);
+    dump_frame(scene, opts, 0);
+
+    *ref_ok = check_ref(scene, opts);
+    const char * ref_res = "-";
+    if(opts->ref == LV_BENCH_REF_CHECK) ref_res = *ref_ok ? "PASS" : "FAIL";
+    else if(opts->ref == LV_BENCH_REF_UPDATE) ref_res = *ref_ok ? "saved" : "FAIL";
+
+    uint64_t px_start = lv_headless_get_flushed_px();
+    uint64_t ns = 0;
+    uint32_t f;
+    for(f = 1; f <= opts->frames; f++) {
+        lv_headless_tick_advance(FRAME_PERIOD);
+        if(scene->update) scene->update(f);
+        if(scene->full_redraw) lv_obj_invalidate(scr);
+
+        uint64_t t = time_ns();
+        lv_refr_now(NULL);
+        ns += time_ns() - t;
+
+        dump_frame(scene, opts, f);
+    }
+
+    uint64_t px = lv_headless_get_flushed_px() - px_start;
+    double ms_per_frame = opts->frames ? (double)ns / 1e6 / opts->frames : 0.0;
+    double px_per_frame = opts->frames ? (double)px / opts->frames : 0.0;
+    double mpx_per_s = ns ? (double)px * 1e3 / (double)ns : 0.0;
+
+    printf("%-16s %8u %10.3f %10.0f %10.2f  %s\n", scene->name, (unsigned int)opts->frames,
+           ms_per_frame, px_per_frame, mpx_per_s, ref_res);
+    fflush(stdout);
+
+    return true;
+}
+
+/**
+ * Compare the first frame of a scene with its reference image or save it as the reference
+ * @param scene the scene being run
+ * @param opts options of the run
+ * @return true: the frame equals the reference (or it was saved); false: different or error
+ */
+static bool check_ref(const scene_t * scene, const lv_bench_opts_t * opts)
+{
+    if(opts->ref == LV_BENCH_REF_NONE) return true;
+
+    char path[256];
+    snprintf(path, sizeof(path), "%s/bench_%s.png", opts->ref_dir, scene->name);
+
+    if(opts->ref == LV_BENCH_REF_UPDATE) {
+        if(lv_headless_save_png(path)) return true;
+        printf("Can't save '%s'\n", path);
+        return false;
+    }
+
+    int32_t diff = lv_headless_cmp_png(path);
+    if(diff < 0) {
+        printf("Can't read '%s' or its size is different\n", path);
+        return false;
+    }
+    else if(diff > 0) {
+        printf("%d pixels differ from '%s'\n", diff, path);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Save a frame of the scene if requested
+ * @param scene the scene being run
+ * @param opts options of the run
+ * @param frame index of the frame
+ */
+static void dump_frame(const scene_t * scene, const lv_bench_opts_t * opts, uint32_t frame)
+{
+    if(opts->dump_dir == NULL) return;
+
+    char path[256];
+    snprintf(path, sizeof(path), "%s/%s_%04u.ppm", opts->dump_dir, scene->name, (unsigned int)frame);
+    if(!lv_headless_save_ppm(path)) printf("Can't save '%s'\n", path);
+}
+
+static uint64_t time_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/**
+ * A pseudo random number which is the same in every run
+ * @return a number in [0..0x7FFF]
+ */
+static uint32_t rnd(void)
+{
+    rnd_state = rnd_state * 1103515245 + 12345;
+    return (rnd_state >> 16) & 0x7FFF;
+}
+
+/**
+ * Create a plain object in a cell of a grid covering the screen
+ * @param scr the screen
+ * @param i index of the cell
+ * @return the new object
+ */
+static lv_obj_t * grid_cell(lv_obj_t * scr, uint32_t i)
+{
+    lv_coord_t w = (lv_obj_get_width(scr) - GRID_GAP) / GRID_COLS;
+    lv_coord_t h = (lv_obj_get_height(scr) - GRID_GAP) / GRID_ROWS;
+
+    lv_obj_t * obj = lv_obj_create(scr, NULL);
+    lv_obj_set_pos(obj, GRID_GAP + (i % GRID_COLS) * w, GRID_GAP + (i / GRID_COLS) * h);
+    lv_obj_set_size(obj, w - GRID_GAP, h - GRID_GAP);
+    lv_obj_set_style_local_bg_color(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, palette(i));
+    lv_obj_set_style_local_border_width(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 0);
+    lv_obj_set_style_local_shadow_width(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 0);
+    lv_obj_set_style_local_outline_width(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 0);
+
+    objs[obj_cnt++] = obj;
+    return obj;
+}
+
+static lv_color_t palette(uint32_t i)
+{
+    return lv_color_hsv_to_rgb((i * 47) % 360, 70, 90);
+}
+
+static void rect_radius_create(lv_obj_t * scr)
+{
+    uint32_t i;
+    for(i = 0; i < GRID_COLS * GRID_ROWS; i++) {
+        lv_obj_t * obj = grid_cell(scr, i);
+        lv_obj_set_style_local_radius(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 4 + (i * 7) % 40);
+        lv_obj_set_style_local_border_width(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, i % 3 * 2);
+        lv_obj_set_style_local_border_color(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, palette(i + 7));
+        lv_obj_set_style_local_bg_opa(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, i % 4 == 0 ? LV_OPA_60 : LV_OPA_COVER);
+    }
+}
+
+static void rect_opa_create(lv_obj_t * scr)
+{
+    /*Translucent objects overlapping their neighbors, so every pixel is mixed a few times*/
+    uint32_t i;
+    for(i = 0; i < GRID_COLS * GRID_ROWS; i++) {
+        lv_obj_t * obj = grid_cell(scr, i);
+        lv_obj_set_size(obj, lv_obj_get_width(obj) * 2, lv_obj_get_height(obj) * 2);
+        lv_obj_set_style_local_radius(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, (i % 2) * 24);
+        lv_obj_set_style_local_bg_opa(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_OPA_30 + (i % 5) * LV_OPA_10);
+    }
+}
+
+static void shadow_create(lv_obj_t * scr)
+{
+    uint32_t i;
+    for(i = 0; i < GRID_COLS * GRID_ROWS; i++) {
+        lv_obj_t * obj = grid_cell(scr, i);
+        lv_obj_set_style_local_radius(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 8);
+        lv_obj_set_style_local_shadow_width(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 8 + (i % 3) * 12);
+        lv_obj_set_style_local_shadow_spread(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, (i % 2) * 4);
+        lv_obj_set_style_local_shadow_ofs_x(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 4);
+        lv_obj_set_style_local_shadow_ofs_y(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 6);
+        lv_obj_set_style_local_shadow_color(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, palette(i + 3));
+    }
+}
+
+static void card_grid_create(lv_obj_t * scr)
+{
+    /*Identical white cards with large, soft shadows on a light screen*/
+    lv_obj_set_style_local_bg_color(scr, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_MAKE(0xe8, 0xea, 0xf0));
+
+    lv_coord_t w = (lv_obj_get_width(scr) - CARD_GAP) / CARD_COLS;
+    lv_coord_t h = (lv_obj_get_height(scr) - CARD_GAP) / CARD_ROWS;
+
+    uint32_t i;
+    for(i = 0; i < CARD_COLS * CARD_ROWS; i++) {
+        lv_obj_t * card = lv_obj_create(scr, NULL);
+        lv_obj_set_pos(card, CARD_GAP + (i % CARD_COLS) * w, CARD_GAP + (i / CARD_COLS) * h);
+        lv_obj_set_size(card, w - CARD_GAP, h - CARD_GAP);
+        lv_obj_set_style_local_bg_color(card, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_WHITE);
+        lv_obj_set_style_local_border_width(card, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 0);
+        lv_obj_set_style_local_outline_width(card, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 0);
+        lv_obj_set_style_local_radius(card, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 12);
+        lv_obj_set_style_local_shadow_width(card, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 40);
+        lv_obj_set_style_local_shadow_ofs_y(card, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 12);
+        lv_obj_set_style_local_shadow_color(card, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_MAKE(0x30, 0x38, 0x50));
+        lv_obj_set_style_local_shadow_opa(card, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_OPA_40);
+    }
+}
+
+static void gradient_create(lv_obj_t * scr)
+{
+    uint32_t i;
+    for(i = 0; i < GRID_COLS * GRID_ROWS; i++) {
+        lv_obj_t * obj = grid_cell(scr, i);
+        lv_obj_set_style_local_radius(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, (i % 2) * 16);
+        lv_obj_set_style_local_bg_grad_color(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, palette(i + 11));
+        lv_obj_set_style_local_bg_grad_dir(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT,
+                                           i % 3 == 0 ? LV_GRAD_DIR_HOR : LV_GRAD_DIR_VER);
+        lv_obj_set_style_local_bg_main_stop(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, (i % 4) * 32);
+        lv_obj_set_style_local_bg_grad_stop(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 255 - (i % 3) * 48);
+    }
+}
+
+static void grad_headers_create(lv_obj_t * scr)
+{
+    /*Full width header bars with horizontal gradients above a grid of rounded, vertical gradient buttons*/
+    lv_coord_t w = lv_obj_get_width(scr);
+    lv_coord_t h = lv_obj_get_height(scr);
+
+    uint32_t i;
+    for(i = 0; i < HEADER_CNT; i++) {
+        lv_obj_t * header = lv_obj_create(scr, NULL);
+        lv_obj_set_pos(header, 0, i * HEADER_H);
+        lv_obj_set_size(header, w, HEADER_H);
+        lv_obj_set_style_local_radius(header, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, i == 0 ? 0 : 8);
+        lv_obj_set_style_local_border_width(header, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 0);
+        lv_obj_set_style_local_bg_color(header, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, palette(i));
+        lv_obj_set_style_local_bg_grad_color(header, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, palette(i + 3));
+        lv_obj_set_style_local_bg_grad_dir(header, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_GRAD_DIR_HOR);
+    }
+
+    lv_coord_t top = HEADER_CNT * HEADER_H;
+    lv_coord_t btn_w = w / BTN_COLS * 2;
+    lv_coord_t btn_h = (h - top) / BTN_ROWS * 2;
+    for(i = 0; i < (BTN_COLS / 2) * (BTN_ROWS / 2); i++) {
+        lv_obj_t * btn = lv_obj_create(scr, NULL);
+        lv_obj_set_pos(btn, (i % (BTN_COLS / 2)) * btn_w + BTN_GAP / 2,
+                       top + (i / (BTN_COLS / 2)) * btn_h + BTN_GAP / 2);
+        lv_obj_set_size(btn, btn_w - BTN_GAP, btn_h - BTN_GAP);
+        lv_obj_set_style_local_radius(btn, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 10);
+        lv_obj_set_style_local_border_width(btn, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 0);
+        lv_obj_set_style_local_bg_color(btn, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, palette(i));
+        lv_obj_set_style_local_bg_grad_color(btn, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT,
+                                             lv_color_darken(palette(i), LV_OPA_40));
+        lv_obj_set_style_local_bg_grad_dir(btn, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_GRAD_DIR_VER);
+    }
+}
+
+#if LV_USE_BLEND_MODES
+static void blend_modes_create(lv_obj_t * scr)
+{
+    /*Glowing objects on a dark screen: additive shadows and backgrounds overlapping their neighbors,
+     *every third background darkens with the subtractive mode*/
+    lv_obj_set_style_local_bg_color(scr, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_MAKE(0x20, 0x20, 0x30));
+
+    uint32_t i;
+    for(i = 0; i < GRID_COLS * GRID_ROWS; i++) {
+        lv_obj_t * obj = grid_cell(scr, i);
+        lv_obj_set_width(obj, lv_obj_get_width(obj) * 3 / 2);
+        lv_obj_set_style_local_radius(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 12);
+        lv_obj_set_style_local_bg_color(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, lv_color_darken(palette(i), LV_OPA_50));
+        lv_obj_set_style_local_bg_opa(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, i % 2 ? LV_OPA_70 : LV_OPA_COVER);
+        lv_obj_set_style_local_bg_blend_mode(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT,
+                                             i % 3 == 0 ? LV_BLEND_MODE_SUBTRACTIVE : LV_BLEND_MODE_ADDITIVE);
+        lv_obj_set_style_local_shadow_width(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 24);
+        lv_obj_set_style_local_shadow_spread(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 4);
+        lv_obj_set_style_local_shadow_color(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, palette(i + 5));
+        lv_obj_set_style_local_shadow_blend_mode(obj, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_BLEND_MODE_ADDITIVE);
+    }
+}
+#endif
+
+#if LV_USE_BTN
+static void btn_grid_create(lv_obj_t * scr)
+{
+    /*Many small buttons of the theme (fully rounded, with border) in three sizes, so a few radii are used*/
+    lv_coord_t w = (lv_obj_get_width(scr) - BTN_GAP) / BTN_COLS;
+    lv_coord_t h = (lv_obj_get_height(scr) - BTN_GAP) / BTN_ROWS;
+
+    uint32_t i;
+    for(i = 0; i < BTN_COLS * BTN_ROWS; i++) {
+        lv_coord_t shrink = (i % 3) * 4;
+        lv_obj_t * btn = lv_btn_create(scr, NULL);
+        lv_obj_set_pos(btn, BTN_GAP + (i % BTN_COLS) * w + shrink / 2, BTN_GAP + (i / BTN_COLS) * h + shrink / 2);
+        lv_obj_set_size(btn, w - BTN_GAP - shrink, h - BTN_GAP - shrink);
+        lv_obj_set_style_local_bg_color(btn, LV_BTN_PART_MAIN, LV_STATE_DEFAULT, palette(i));
+    }
+}
+#endif
+
+#if LV_USE_LABEL
+static void label_fonts_create(lv_obj_t * scr)
+{
+    static const char * txt = "The quick brown fox jumps over the lazy dog. 0123456789 "
+                              "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor.";
+    const lv_font_t * fonts[] = {
+#if LV_FONT_MONTSERRAT_12
+        &lv_font_montserrat_12,
+#endif
+#if LV_FONT_MONTSERRAT_16
+        &lv_font_montserrat_16,
+#endif
+#if LV_FONT_MONTSERRAT_22
+        &lv_font_montserrat_22,
+#endif
+#if LV_FONT_MONTSERRAT_28
+        &lv_font_montserrat_28,
+#endif
+#if LV_FONT_MONTSERRAT_28_COMPRESSED
+        &lv_font_montserrat_28_compressed,
+#endif
+        lv_theme_get_font_normal()
+    };
+
+    lv_coord_t w = lv_obj_get_width(scr);
+    lv_coord_t y = GRID_GAP;
+    uint32_t i;
+    for(i = 0; i < sizeof(fonts) / sizeof(fonts[0]); i++) {
+        lv_obj_t * label = lv_label_create(scr, NULL);
+        lv_label_set_long_mode(label, LV_LABEL_LONG_BREAK);
+        lv_obj_set_width(label, w - 2 * GRID_GAP);
+        lv_obj_set_pos(label, GRID_GAP, y);
+        lv_obj_set_style_local_text_font(label, LV_LABEL_PART_MAIN, LV_STATE_DEFAULT, fonts[i]);
+        lv_obj_set_style_local_text_color(label, LV_LABEL_PART_MAIN, LV_STATE_DEFAULT, palette(i * 5));
+        lv_label_set_text(label, txt);
+        y += lv_obj_get_height(label) + GRID_GAP;
+    }
+}
+#endif
+
+#if LV_USE_IMG && LV_USE_IMG_TRANSFORM
+static void img_transform_create(lv_obj_t * scr)
+{
+    /*A colorful image with a transparent border and a translucent corner*/
+    uint32_t i;
+    for(i = 0; i < IMG_SIZE * IMG_SIZE; i++) {
+        uint32_t x = i % IMG_SIZE;
+        uint32_t y = i / IMG_SIZE;
+        lv_color_t c = lv_color_make(x * 4, y * 4, (x ^ y) * 4);
+        lv_opa_t a = LV_OPA_COVER;
+        if(x < 4 || y < 4 || x >= IMG_SIZE - 4 || y >= IMG_SIZE - 4) a = LV_OPA_TRANSP;
+        else if(x > IMG_SIZE / 2 && y > IMG_SIZE / 2) a = LV_OPA_50;
+        memcpy(&img_map[i * LV_IMG_PX_SIZE_ALPHA_BYTE], &c, sizeof(lv_color_t));
+        img_map[i * LV_IMG_PX_SIZE_ALPHA_BYTE + LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = a;
+    }
+    img_dsc.header.cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
+    img_dsc.header.w = IMG_SIZE;
+    img_dsc.header.h = IMG_SIZE;
+    img_dsc.data_size = sizeof(img_map);
+    img_dsc.data = img_map;
+
+    lv_coord_t w = lv_obj_get_width(scr) / 4;
+    lv_coord_t h = lv_obj_get_height(scr) / 2;
+    for(i = 0; i < 8; i++) {
+        lv_obj_t * img = lv_img_create(scr, NULL);
+        lv_img_set_src(img, &img_dsc);
+        lv_obj_set_pos(img, (i % 4) * w + (w - IMG_SIZE) / 2, (i / 4) * h + (h - IMG_SIZE) / 2);
+        lv_img_set_zoom(img, 128 + i * 48);
+        lv_img_set_antialias(img, i % 2 == 0);
+        objs[obj_cnt++] = img;
+    }
+}
+
+static void img_transform_update(uint32_t frame)
+{
+    uint32_t i;
+    for(i = 0; i < obj_cnt; i++) {
+        lv_img_set_angle(objs[i], (i * 450 + frame * 50) % 3600);
+    }
+}
+#endif
+
+#if LV_USE_ARC
+static void arc_create(lv_obj_t * scr)
+{
+    lv_coord_t w = lv_obj_get_width(scr) / 4;
+    lv_coord_t h = lv_obj_get_height(scr) / 2;
+    lv_coord_t size = LV_MATH_MIN(w, h) - GRID_GAP;
+    uint32_t i;
+    for(i = 0; i < 8; i++) {
+        lv_obj_t * arc = lv_arc_create(scr, NULL);
+        lv_obj_set_size(arc, size, size);
+        lv_obj_set_pos(arc, (i % 4) * w + (w - size) / 2, (i / 4) * h + (h - size) / 2);
+        lv_arc_set_bg_angles(arc, 0, 360);
+        lv_obj_set_style_local_line_width(arc, LV_ARC_PART_BG, LV_STATE_DEFAULT, 4 + i * 2);
+        lv_obj_set_style_local_line_width(arc, LV_ARC_PART_INDIC, LV_STATE_DEFAULT, 4 + i * 2);
+        lv_obj_set_style_local_line_rounded(arc, LV_ARC_PART_INDIC, LV_STATE_DEFAULT, i % 2 == 0);
+        lv_obj_set_style_local_line_color(arc, LV_ARC_PART_INDIC, LV_STATE_DEFAULT, palette(i));
+        objs[obj_cnt++] = arc;
+    }
+}
+
+static void arc_update(uint32_t frame)
+{
+    uint32_t i;
+    for(i = 0; i < obj_cnt; i++) {
+        uint16_t start = (frame * 4 + i * 30) % 360;
+        lv_arc_set_angles(objs[i], start, (start + 90 + i * 25) % 360);
+    }
+}
+#endif
+
+#if LV_USE_CHART
+static void chart_create(lv_obj_t * scr)
+{
+    lv_coord_t w = lv_obj_get_width(scr) - 2 * GRID_GAP;
+    lv_coord_t h = (lv_obj_get_height(scr) - 3 * GRID_GAP) / 2;
+
+    ser_cnt = 0;
+
+    lv_obj_t * line = lv_chart_create(scr, NULL);
+    lv_obj_set_pos(line, GRID_GAP, GRID_GAP);
+    lv_obj_set_size(line, w, h);
+    lv_chart_set_type(line, LV_CHART_TYPE_LINE);
+    lv_chart_set_point_count(line, CHART_POINTS);
+    lv_chart_set_div_line_count(line, 5, 8);
+    lv_obj_set_style_local_bg_opa(line, LV_CHART_PART_SERIES, LV_STATE_DEFAULT, LV_OPA_50);
+    lv_obj_set_style_local_bg_grad_dir(line, LV_CHART_PART_SERIES, LV_STATE_DEFAULT, LV_GRAD_DIR_VER);
+    lv_obj_set_style_local_bg_main_stop(line, LV_CHART_PART_SERIES, LV_STATE_DEFAULT, 255);
+    lv_obj_set_style_local_bg_grad_stop(line, LV_CHART_PART_SERIES, LV_STATE_DEFAULT, 0);
+    objs[obj_cnt++] = line;
+
+    lv_obj_t * col = lv_chart_create(scr, NULL);
+    lv_obj_set_pos(col, GRID_GAP, 2 * GRID_GAP + h);
+    lv_obj_set_size(col, w, h);
+    lv_chart_set_type(col, LV_CHART_TYPE_COLUMN);
+    lv_chart_set_point_count(col, CHART_POINTS / 3);
+    objs[obj_cnt++] = col;
+
+    uint32_t i;
+    for(i = 0; i < 4; i++) {
+        lv_obj_t * chart = i < 2 ? line : col;
+        lv_chart_series_t * ser = lv_chart_add_series(chart, palette(i * 3));
+        uint32_t p;
+        for(p = 0; p < CHART_POINTS; p++) lv_chart_set_next(chart, ser, rnd() % 100);
+        sers[ser_cnt++] = ser;
+    }
+}
+
+static void chart_update(uint32_t frame)
+{
+    LV_UNUSED(frame);
+
+    uint32_t i;
+    for(i = 0; i < ser_cnt; i++) {
+        lv_chart_set_next(objs[i < 2 ? 0 : 1], sers[i], rnd() % 100);
+    }
+}
+#endif
+
+#if LV_USE_PAGE && LV_USE_BTN && LV_USE_LABEL
+static void page_scroll_create(lv_obj_t * scr)
+{
+    lv_obj_t * page = lv_page_create(scr, NULL);
+    lv_obj_set_pos(page, GRID_GAP, GRID_GAP);
+    lv_obj_set_size(page, lv_obj_get_width(scr) / 2, lv_obj_get_height(scr) - 2 * GRID_GAP);
+    lv_page_set_scrl_layout(page, LV_LAYOUT_COLUMN_MID);
+    lv_page_set_scrollbar_mode(page, LV_SCROLLBAR_MODE_ON);
+
+    uint32_t i;
+    for(i = 0; i < PAGE_ITEMS; i++) {
+        lv_obj_t * btn = lv_btn_create(page, NULL);
+        lv_obj_set_width(btn, lv_page_get_width_fit(page) - GRID_GAP);
+        lv_obj_set_style_local_bg_color(btn, LV_BTN_PART_MAIN, LV_STATE_DEFAULT, palette(i));
+        lv_obj_t * label = lv_label_create(btn, NULL);
+        lv_label_set_text_fmt(label, "Item %d", (int)i);
+    }
+
+    objs[obj_cnt++] = page;
+    scrl_y0 = lv_obj_get_y(lv_page_get_scrollable(page));
+}
+
+static void page_scroll_update(uint32_t frame)
+{
+    lv_obj_t * page = objs[0];
+    lv_obj_t * scrl = lv_page_get_scrollable(page);
+    lv_coord_t range = lv_obj_get_height(scrl) - lv_obj_get_height(page) + 2 * scrl_y0;
+    if(range <= 0) return;
+
+    /*Scroll down and back up*/
+    lv_coord_t pos = (frame * 9) % (2 * range);
+    if(pos > range) pos = 2 * range - pos;
+    lv_obj_set_y(scrl, scrl_y0 - pos);
+}
+#endif
+
+#endif /*LV_BUILD_TEST*/
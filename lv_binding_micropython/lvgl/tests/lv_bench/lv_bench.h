@@ -0,0 +1,72 @@
+/**
+ * @file lv_bench.h
+ * Benchmark scenes rendered on the headless display. Every scene stresses a drawing path
+ * (rounded rectangles, shadows, shadowed cards, gradients, gradient headers and buttons, blend modes, rounded buttons,
+ * text, transformed images, arcs, charts, scrolling) and is rendered the same way in every run, so its first frame can be
+ * compared to a reference image.
+ */
+
+#ifndef LV_BENCH_H
+#define LV_BENCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+
+#if LV_BUILD_TEST
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+enum {
+    LV_BENCH_REF_NONE,      /*Don't use the reference images*/
+    LV_BENCH_REF_CHECK,     /*Compare the first frame of the scenes with the reference images*/
+    LV_BENCH_REF_UPDATE,    /*Save the first frame of the scenes as reference images*/
+};
+typedef uint8_t lv_bench_ref_t;
+
+typedef struct {
+    uint32_t frames;        /*Number of frames to measure in every scene*/
+    const char * scene;     /*Run only this scene. NULL: run all*/
+    lv_bench_ref_t ref;     /*What to do with the reference images*/
+    const char * ref_dir;   /*Directory of the reference images*/
+    const char * dump_dir;  /*Save every frame here as a PPM file. NULL: don't save*/
+} lv_bench_opts_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Run the benchmark scenes on the default display and print ms/frame and pixels/s of each
+ * @param opts options of the run
+ * @return number of scenes which differ from their reference image or couldn't be checked
+ */
+uint32_t lv_bench_run(const lv_bench_opts_t * opts);
+
+/**
+ * Print the names of the scenes
+ */
+void lv_bench_list(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_BUILD_TEST*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_BENCH_H*/
@@ -0,0 +1,124 @@
+#include "../../lvgl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "lv_headless.h"
+#include "lv_bench.h"
+
+#if LV_BUILD_TEST
+
+static void usage(const char * name);
+
+int main(int argc, char ** argv)
+{
+    lv_bench_opts_t opts;
+    opts.frames = 100;
+    opts.scene = NULL;
+    opts.ref = LV_BENCH_REF_CHECK;
+    opts.ref_dir = "../lv_test_ref_imgs";
+    opts.dump_dir = NULL;
+    lv_coord_t buf_rows = 0;
+    const char * simd_name = NULL;
+
+    int c;
+    while((c = getopt(argc, argv, "f:s:unr:o:b:k:lh")) != -1) {
+        switch(c) {
+            case 'f':
+                opts.frames = atoi(optarg);
+                break;
+            case 's':
+                opts.scene = optarg;
+                break;
+            case 'u':
+                opts.ref = LV_BENCH_REF_UPDATE;
+                break;
+            case 'n':
+                opts.ref = LV_BENCH_REF_NONE;
+                break;
+            case 'r':
+                opts.ref_dir = optarg;
+                break;
+            case 'o':
+                opts.dump_dir = optarg;
+                break;
+            case 'b':
+                buf_rows = atoi(optarg);
+                break;
+            case 'k':
+                simd_name = optarg;
+                break;
+            case 'l':
+                lv_bench_list();
+                return 0;
+            default:
+                usage(argv[0]);
+                return c == 'h' ? 0 : 2;
+        }
+    }
+
+#if LV_COLOR_DEPTH != 32
+    /*The reference images are saved with 32 bit color depth*/
+    if(opts.ref == LV_BENCH_REF_CHECK) {
+        printf("Skip the reference images with LV_COLOR_DEPTH %d\n", LV_COLOR_DEPTH);
+        opts.ref = LV_BENCH_REF_NONE;
+    }
+#endif
+
+    lv_init();
+
+    if(simd_name) {
+#if LV_USE_BLEND_SIMD
+        lv_blend_simd_t simd;
+        for(simd = LV_BLEND_SIMD_NONE; simd <= LV_BLEND_SIMD_AVX2; simd++) {
+            if(strcmp(simd_name, _lv_blend_simd_name(simd)) == 0) break;
+        }
+        if(simd > LV_BLEND_SIMD_AVX2) {
+            printf("Unknown blend kernels '%s'\n", simd_name);
+            return 2;
+        }
+        if(_lv_blend_simd_set(simd) != simd) {
+            printf("The '%s' blend kernels are not supported here\n", simd_name);
+            return 2;
+        }
+#else
+        printf("The blend kernels are disabled (LV_USE_BLEND_SIMD 0)\n");
+        return 2;
+#endif
+    }
+    if(lv_headless_init(LV_HOR_RES_MAX, LV_VER_RES_MAX, buf_rows) == NULL) {
+        printf("Can't create the display\n");
+        return 1;
+    }
+
+    uint32_t fail_cnt = lv_bench_run(&opts);
+    lv_headless_deinit();
+
+    if(fail_cnt) {
+        printf("%u scene(s) failed\n", (unsigned int)fail_cnt);
+        return 1;
+    }
+
+    return 0;
+}
+
+uint32_t custom_tick_get(void)
+{
+    return lv_headless_tick_get();
+}
+
+static void usage(const char * name)
+{
+    printf("Usage: %s [options]\n"
+           "  -f <n>    frames to measure in every scene (default 100)\n"
+           "  -s <name> run only this scene\n"
+           "  -l        list the scenes\n"
+           "  -u        save the first frames as reference images\n"
+           "  -n        don't compare with the reference images\n"
+           "  -r <dir>  directory of the reference images (default ../lv_test_ref_imgs)\n"
+           "  -o <dir>  save every frame as PPM into this directory\n"
+           "  -b <n>    height of the draw buffer in rows (default: full screen)\n"
+           "  -k <name> blend kernels: none, sse2 or avx2 (default: the best for the CPU)\n", name);
+}
+
+#endif
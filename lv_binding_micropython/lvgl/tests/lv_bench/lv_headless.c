@@ -0,0 +1,269 @@
+/**
+ * @file lv_headless.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_headless.h"
+
+#if LV_BUILD_TEST
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <png.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
+static uint8_t * fb_to_rgb(void);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_disp_t * disp;
+static lv_disp_buf_t disp_buf;
+static lv_color_t * draw_buf;
+static lv_color_t * fb;
+static lv_coord_t fb_w;
+static lv_coord_t fb_h;
+static uint64_t flushed_px;
+static uint32_t tick;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Register the headless display as the default display
+ * @param hor_res horizontal resolution
+ * @param ver_res vertical resolution
+ * @param buf_rows height of the draw buffer in rows. 0: the whole screen.
+ * @return pointer to the display or NULL if out of memory
+ */
+lv_disp_t * lv_headless_init(lv_coord_t hor_res, lv_coord_t ver_res, lv_coord_t buf_rows)
+{
+    if(buf_rows <= 0 || buf_rows > ver_res) buf_rows = ver_res;
+
+    fb = calloc((size_t)hor_res * ver_res, sizeof(lv_color_t));
+    draw_buf = malloc((size_t)hor_res * buf_rows * sizeof(lv_color_t));
+    if(fb == NULL || draw_buf == NULL) {
+        free(fb);
+        free(draw_buf);
+        fb = NULL;
+        draw_buf = NULL;
+        return NULL;
+    }
+
+    fb_w = hor_res;
+    fb_h = ver_res;
+    flushed_px = 0;
+
+    lv_disp_buf_init(&disp_buf, draw_buf, NULL, (uint32_t)hor_res * buf_rows);
+
+    lv_disp_drv_t disp_drv;
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.hor_res = hor_res;
+    disp_drv.ver_res = ver_res;
+    disp_drv.buffer = &disp_buf;
+    disp_drv.flush_cb = flush_cb;
+#if LV_COLOR_SCREEN_TRANSP
+    /*The frame buffer is opaque like a real screen*/
+    disp_drv.screen_transp = 0;
+#endif
+    disp = lv_disp_drv_register(&disp_drv);
+    lv_disp_set_default(disp);
+
+    return disp;
+}
+
+/**
+ * Remove the headless display and free its buffers
+ */
+void lv_headless_deinit(void)
+{
+    if(disp == NULL) return;
+
+    lv_disp_remove(disp);
+    disp = NULL;
+
+    free(fb);
+    free(draw_buf);
+    fb = NULL;
+    draw_buf = NULL;
+}
+
+/**
+ * Get the frame buffer of the headless display
+ * @return the pixels of the screen, row by row. Valid until `lv_headless_deinit()`.
+ */
+const lv_color_t * lv_headless_get_fb(void)
+{
+    return fb;
+}
+
+/**
+ * Get the number of pixels flushed to the frame buffer
+ * @return flushed pixels since `lv_headless_init()`
+ */
+uint64_t lv_headless_get_flushed_px(void)
+{
+    return flushed_px;
+}
+
+/**
+ * Get the virtual time
+ * @return milliseconds since start, changed only by `lv_headless_tick_advance()`
+ */
+uint32_t lv_headless_tick_get(void)
+{
+    return tick;
+}
+
+/**
+ * Move the virtual time forward and run the LVGL tasks which got due
+ * @param ms milliseconds to move the time with
+ */
+void lv_headless_tick_advance(uint32_t ms)
+{
+    tick += ms;
+    lv_task_handler();
+}
+
+/**
+ * Save the frame buffer as a binary PPM (P6) file
+ * @param path path of the file to write
+ * @return true: saved; false: the file can't be written
+ */
+bool lv_headless_save_ppm(const char * path)
+{
+    uint8_t * rgb = fb_to_rgb();
+    if(rgb == NULL) return false;
+
+    FILE * fp = fopen(path, "wb");
+    bool res = false;
+    if(fp) {
+        size_t size = (size_t)fb_w * fb_h * 3;
+        fprintf(fp, "P6\n%d %d\n255\n", fb_w, fb_h);
+        res = fwrite(rgb, 1, size, fp) == size;
+        if(fclose(fp) != 0) res = false;
+    }
+
+    free(rgb);
+    return res;
+}
+
+/**
+ * Save the frame buffer as an RGB PNG file
+ * @param path path of the file to write
+ * @return true: saved; false: the file can't be written
+ */
+bool lv_headless_save_png(const char * path)
+{
+    uint8_t * rgb = fb_to_rgb();
+    if(rgb == NULL) return false;
+
+    png_image img;
+    memset(&img, 0, sizeof(img));
+    img.version = PNG_IMAGE_VERSION;
+    img.width = fb_w;
+    img.height = fb_h;
+    img.format = PNG_FORMAT_RGB;
+
+    bool res = png_image_write_to_file(&img, path, 0, rgb, 0, NULL) != 0;
+
+    free(rgb);
+    return res;
+}
+
+/**
+ * Compare the frame buffer with a PNG file
+ * @param path path of the reference PNG
+ * @return number of different pixels, -1 if the file can't be read or its size is different
+ */
+int32_t lv_headless_cmp_png(const char * path)
+{
+    png_image img;
+    memset(&img, 0, sizeof(img));
+    img.version = PNG_IMAGE_VERSION;
+    if(png_image_begin_read_from_file(&img, path) == 0) return -1;
+
+    if(img.width != (png_uint_32)fb_w || img.height != (png_uint_32)fb_h) {
+        png_image_free(&img);
+        return -1;
+    }
+
+    img.format = PNG_FORMAT_RGB;
+    uint8_t * ref = malloc(PNG_IMAGE_SIZE(img));
+    uint8_t * act = fb_to_rgb();
+    int32_t diff = -1;
+    if(ref && act && png_image_finish_read(&img, NULL, ref, 0, NULL) != 0) {
+        uint32_t i;
+        uint32_t px_cnt = (uint32_t)fb_w * fb_h;
+        diff = 0;
+        for(i = 0; i < px_cnt; i++) {
+            if(memcmp(&ref[i * 3], &act[i * 3], 3) != 0) diff++;
+        }
+    }
+    else {
+        png_image_free(&img);
+    }
+
+    free(ref);
+    free(act);
+    return diff;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    lv_coord_t w = lv_area_get_width(area);
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        memcpy(&fb[(uint32_t)y * fb_w + area->x1], color_p, w * sizeof(lv_color_t));
+        color_p += w;
+    }
+
+    flushed_px += lv_area_get_size(area);
+    lv_disp_flush_ready(disp_drv);
+}
+
+/**
+ * Convert the frame buffer to 8 bit RGB
+ * @return the RGB pixels allocated with `malloc` or NULL if out of memory
+ */
+static uint8_t * fb_to_rgb(void)
+{
+    uint32_t px_cnt = (uint32_t)fb_w * fb_h;
+    uint8_t * rgb = malloc(px_cnt * 3);
+    if(rgb == NULL) return NULL;
+
+    uint32_t i;
+    for(i = 0; i < px_cnt; i++) {
+        uint32_t c32 = lv_color_to32(fb[i]);
+        rgb[i * 3 + 0] = (c32 >> 16) & 0xFF;
+        rgb[i * 3 + 1] = (c32 >> 8) & 0xFF;
+        rgb[i * 3 + 2] = c32 & 0xFF;
+    }
+
+    return rgb;
+}
+
+#endif /*LV_BUILD_TEST*/
@@ -0,0 +1,106 @@
+/**
+ * @file lv_headless.h
+ * A display driver which renders into a frame buffer in RAM. Used to run LVGL on a host
+ * without a screen: the frames can be saved as PPM or PNG and compared to reference images.
+ *
+ * The LVGL tick should come from `lv_headless_tick_get()` (`LV_TICK_CUSTOM_SYS_TIME_EXPR`).
+ * It's a virtual clock moved only by `lv_headless_tick_advance()`, so the tasks and animations
+ * run the same way in every run regardless of the speed of the host.
+ */
+
+#ifndef LV_HEADLESS_H
+#define LV_HEADLESS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+
+#if LV_BUILD_TEST
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Register the headless display as the default display
+ * @param hor_res horizontal resolution
+ * @param ver_res vertical resolution
+ * @param buf_rows height of the draw buffer in rows. 0: the whole screen.
+ * @return pointer to the display or NULL if out of memory
+ */
+lv_disp_t * lv_headless_init(lv_coord_t hor_res, lv_coord_t ver_res, lv_coord_t buf_rows);
+
+/**
+ * Remove the headless display and free its buffers
+ */
+void lv_headless_deinit(void);
+
+/**
+ * Get the frame buffer of the headless display
+ * @return the pixels of the screen, row by row. Valid until `lv_headless_deinit()`.
+ */
+const lv_color_t * lv_headless_get_fb(void);
+
+/**
+ * Get the number of pixels flushed to the frame buffer
+ * @return flushed pixels since `lv_headless_init()`
+ */
+uint64_t lv_headless_get_flushed_px(void);
+
+/**
+ * Get the virtual time
+ * @return milliseconds since start, changed only by `lv_headless_tick_advance()`
+ */
+uint32_t lv_headless_tick_get(void);
+
+/**
+ * Move the virtual time forward and run the LVGL tasks which got due
+ * @param ms milliseconds to move the time with
+ */
+void lv_headless_tick_advance(uint32_t ms);
+
+/**
+ * Save the frame buffer as a binary PPM (P6) file
+ * @param path path of the file to write
+ * @return true: saved; false: the file can't be written
+ */
+bool lv_headless_save_ppm(const char * path);
+
+/**
+ * Save the frame buffer as an RGB PNG file
+ * @param path path of the file to write
+ * @return true: saved; false: the file can't be written
+ */
+bool lv_headless_save_png(const char * path);
+
+/**
+ * Compare the frame buffer with a PNG file
+ * @param path path of the reference PNG
+ * @return number of different pixels, -1 if the file can't be read or its size is different
+ */
+int32_t lv_headless_cmp_png(const char * path);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_BUILD_TEST*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_HEADLESS_H*/
@@ -0,0 +1,222 @@
+/**
+ * @file lv_test_blend.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_core.h"
+#include "lv_test_blend.h"
+
+#if LV_BUILD_TEST
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+/*Size of the display buffer and max. size of the blended areas*/
+#define BUF_W       96
+#define BUF_H       12
+#define AREA_W_MAX  77
+#define AREA_H_MAX  5
+
+#define SIMD_CASES  2000
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_USE_BLEND_SIMD
+    static void simd_exact(void);
+    static void simd_case(lv_blend_simd_t simd, uint32_t case_id);
+    static void rnd_mask(lv_opa_t * mask, uint32_t len);
+    static lv_color_t rnd_color(void);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#if LV_USE_BLEND_SIMD
+    static lv_color_t buf_ref[BUF_W * BUF_H];
+    static lv_color_t buf_act[BUF_W * BUF_H];
+    static lv_color_t map_buf[(AREA_W_MAX + 8) * AREA_H_MAX];
+    static lv_opa_t mask_buf[AREA_W_MAX * AREA_H_MAX];
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_blend(void)
+{
+    lv_test_print("");
+    lv_test_print("====================");
+    lv_test_print("Start lv_blend tests");
+    lv_test_print("====================");
+
+    lv_test_rnd_seed(12345);
+
+#if LV_USE_BLEND_SIMD
+    simd_exact();
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_USE_BLEND_SIMD
+static void simd_exact(void)
+{
+    lv_test_print("");
+    lv_test_print("Blend random areas with the SIMD kernels, compare with the scalar code:");
+    lv_test_print("-----------------------------------------------------------------------");
+
+    lv_blend_simd_t simd_best = _lv_blend_simd_get();
+    if(simd_best == LV_BLEND_SIMD_NONE) {
+        lv_test_print("No SIMD kernels for this CPU or build, skip");
+        return;
+    }
+
+    /*Make the blend functions draw into the test buffers*/
+    lv_disp_t * disp = lv_disp_get_default();
+    lv_disp_buf_t * vdb = lv_disp_get_buf(disp);
+    lv_disp_t * disp_refr_ori = _lv_refr_get_disp_refreshing();
+    lv_area_t area_ori = vdb->area;
+    lv_color_t * buf_act_ori = vdb->buf_act;
+    _lv_refr_set_disp_refreshing(disp);
+    lv_area_set(&vdb->area, 0, 0, BUF_W - 1, BUF_H - 1);
+#if LV_COLOR_SCREEN_TRANSP
+    /*The kernels are not used on transparent screens*/
+    uint32_t screen_transp_ori = disp->driver.screen_transp;
+    disp->driver.screen_transp = 0;
+#endif
+
+    lv_blend_simd_t simd;
+    for(simd = LV_BLEND_SIMD_SSE2; simd <= simd_best; simd++) {
+        lv_test_print("Kernels: %s", _lv_blend_simd_name(simd));
+        uint32_t i;
+        for(i = 0; i < SIMD_CASES; i++) {
+            simd_case(simd, i);
+        }
+    }
+
+    _lv_blend_simd_set(simd_best);
+#if LV_COLOR_SCREEN_TRANSP
+    disp->driver.screen_transp = screen_transp_ori;
+#endif
+    vdb->area = area_ori;
+    vdb->buf_act = buf_act_ori;
+    _lv_refr_set_disp_refreshing(disp_refr_ori);
+}
+
+/**
+ * Blend a random fill or map with the scalar code and with a SIMD kernels and compare the results
+ */
+static void simd_case(lv_blend_simd_t simd, uint32_t case_id)
+{
+    static const lv_opa_t opas[] = {LV_OPA_COVER, LV_OPA_MAX + 1, LV_OPA_MAX, LV_OPA_50, LV_OPA_MIN, 1};
+
+    lv_disp_buf_t * vdb = lv_disp_get_buf(lv_disp_get_default());
+
+    lv_area_t area;
+    area.x1 = lv_test_rnd(BUF_W - AREA_W_MAX);
+    area.y1 = lv_test_rnd(BUF_H - AREA_H_MAX);
+    area.x2 = area.x1 + lv_test_rnd(AREA_W_MAX);
+    area.y2 = area.y1 + lv_test_rnd(AREA_H_MAX);
+    uint32_t w = lv_area_get_width(&area);
+    uint32_t h = lv_area_get_height(&area);
+
+    bool is_map = lv_test_rnd(2);
+#if LV_USE_BLEND_MODES
+    static const lv_blend_mode_t modes[] = {LV_BLEND_MODE_NORMAL, LV_BLEND_MODE_ADDITIVE, LV_BLEND_MODE_SUBTRACTIVE};
+    static const char * mode_names[] = {"normal", "additive", "subtractive"};
+    uint32_t mode_id = lv_test_rnd(3);
+#else
+    static const lv_blend_mode_t modes[] = {LV_BLEND_MODE_NORMAL};
+    static const char * mode_names[] = {"normal"};
+    uint32_t mode_id = 0;
+#endif
+    lv_opa_t opa = lv_test_rnd(3) ? opas[lv_test_rnd(sizeof(opas) / sizeof(opas[0]))] : lv_test_rnd(256);
+    lv_color_t color = rnd_color();
+    bool masked = lv_test_rnd(3) != 0;
+    if(masked) rnd_mask(mask_buf, w * h);
+
+    /*The map is wider than the area on both sides*/
+    lv_area_t map_area = area;
+    map_area.x1 -= 3;
+    map_area.x2 += 5;
+    uint32_t i;
+    for(i = 0; i < (uint32_t)lv_area_get_size(&map_area); i++) map_buf[i] = rnd_color();
+
+    /*Runs of the same color to reach the caches of the last result*/
+    lv_color_t dest_color = rnd_color();
+    for(i = 0; i < BUF_W * BUF_H; i++) {
+        if(lv_test_rnd(16) == 0) dest_color = rnd_color();
+        buf_ref[i] = dest_color;
+    }
+    memcpy(buf_act, buf_ref, sizeof(buf_ref));
+
+    /*The blend functions round the mask without anti-aliasing, so pass a copy to both*/
+    lv_opa_t mask_tmp[AREA_W_MAX * AREA_H_MAX];
+    lv_draw_mask_res_t mask_res = masked ? LV_DRAW_MASK_RES_CHANGED : LV_DRAW_MASK_RES_FULL_COVER;
+    lv_color_t * bufs[2] = {buf_ref, buf_act};
+    lv_blend_simd_t simds[2] = {LV_BLEND_SIMD_NONE, simd};
+    for(i = 0; i < 2; i++) {
+        _lv_blend_simd_set(simds[i]);
+        vdb->buf_act = bufs[i];
+        memcpy(mask_tmp, mask_buf, sizeof(mask_tmp));
+        if(is_map) _lv_blend_map(&area, &map_area, map_buf, masked ? mask_tmp : NULL, mask_res, opa, modes[mode_id]);
+        else _lv_blend_fill(&area, &area, color, masked ? mask_tmp : NULL, mask_res, opa, modes[mode_id]);
+    }
+
+    if(memcmp(buf_ref, buf_act, sizeof(buf_ref)) != 0) {
+        for(i = 0; i < BUF_W * BUF_H && buf_ref[i].full == buf_act[i].full; i++);
+        lv_test_error("%s case %d: %s %s %dx%d opa %d %s, pixel %d,%d is 0x%08x instead of 0x%08x",
+                      _lv_blend_simd_name(simd), case_id, mode_names[mode_id], is_map ? "map" : "fill", w, h, opa,
+                      masked ? "masked" : "no mask",
+                      i % BUF_W, i / BUF_W, buf_act[i].full, buf_ref[i].full);
+    }
+}
+
+/**
+ * Random mask values with runs of 0 and 255 to reach the shortcuts of the kernels
+ */
+static void rnd_mask(lv_opa_t * mask, uint32_t len)
+{
+    uint32_t i = 0;
+    while(i < len) {
+        uint32_t run = 1 + lv_test_rnd(12);
+        uint32_t kind = lv_test_rnd(4);
+        for(; run > 0 && i < len; run--, i++) {
+            if(kind == 0) mask[i] = LV_OPA_TRANSP;
+            else if(kind == 1) mask[i] = LV_OPA_COVER;
+            else if(kind == 2) mask[i] = LV_OPA_MAX + lv_test_rnd(3);
+            else mask[i] = lv_test_rnd(256);
+        }
+    }
+}
+
+/**
+ * A color with random alpha too to see that it's handled like in the scalar code
+ */
+static lv_color_t rnd_color(void)
+{
+    lv_color_t c;
+    c.full = (lv_test_rnd(0x10000) << 16) | lv_test_rnd(0x10000);
+    return c;
+}
+
+#endif
+
+#endif
@@ -13,6 +13,11 @@
 #include "lv_test_obj.h"
 #include "lv_test_style.h"
 #include "lv_test_font_loader.h"
+#include "lv_test_region.h"
+#include "lv_test_refr.h"
+#include "lv_test_blend.h"
+#include "lv_test_draw_mask.h"
+#include "lv_test_draw_rect.h"
 
 /*********************
  *      DEFINES
@@ -29,6 +34,7 @@
 /**********************
  *  STATIC VARIABLES
  **********************/
+static uint32_t rnd_seed;
 
 /**********************
  *      MACROS
@@ -48,6 +54,32 @@ void lv_test_core(void)
     lv_test_obj();
     lv_test_style();
     lv_test_font_loader();
+    lv_test_region();
+    lv_test_refr();
+    lv_test_blend();
+    lv_test_draw_mask();
+    lv_test_draw_rect();
+}
+
+/**
+ * Restart the pseudo random numbers of the tests.
+ * A test seeds them once so it gets the same numbers whatever ran before it.
+ * @param seed the start state
+ */
+void lv_test_rnd_seed(uint32_t seed)
+{
+    rnd_seed = seed;
+}
+
+/**
+ * Get the next pseudo random number
+ * @param max upper limit (exclusive)
+ * @return a number in [0, max)
+ */
+uint32_t lv_test_rnd(uint32_t max)
+{
+    rnd_seed = rnd_seed * 1103515245 + 12345;
+    return (rnd_seed >> 8) % max;
 }
 
 /**********************
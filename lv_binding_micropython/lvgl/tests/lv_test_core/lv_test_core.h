@@ -13,6 +13,7 @@ extern "C" {
 /*********************
  *      INCLUDES
  *********************/
+#include <stdint.h>
 
 /*********************
  *      DEFINES
@@ -26,6 +27,8 @@ extern "C" {
  * GLOBAL PROTOTYPES
  **********************/
 void lv_test_core(void);
+void lv_test_rnd_seed(uint32_t seed);
+uint32_t lv_test_rnd(uint32_t max);
 
 /**********************
  *      MACROS
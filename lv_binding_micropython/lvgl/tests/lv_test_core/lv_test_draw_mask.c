@@ -0,0 +1,225 @@
+/**
+ * @file lv_test_draw_mask.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../../src/lv_misc/lv_gc.h"
+#include "../lv_test_assert.h"
+#include "lv_test_core.h"
+#include "lv_test_draw_mask.h"
+
+#if LV_BUILD_TEST
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+/*Max. size of the rectangles and rows around them*/
+#define RECT_W_MAX  70
+#define RECT_H_MAX  60
+#define ROW_LEN_MAX (RECT_W_MAX + 20)
+#define ROW_CNT_MAX (RECT_H_MAX + 4)
+
+#define RADIUS_CASES  600
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_RADIUS_CACHE_SIZE
+    static void radius_cached_exact(void);
+    static void radius_case(uint32_t case_id);
+    static void radius_cache_lru(void);
+    static bool radius_is_cached(lv_coord_t radius);
+    static uint32_t radius_cache_used(void);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#if LV_RADIUS_CACHE_SIZE
+    static lv_opa_t rows_cached[ROW_CNT_MAX][ROW_LEN_MAX];
+    static lv_draw_mask_res_t res_cached[ROW_CNT_MAX];
+    static lv_opa_t rows_ori[ROW_CNT_MAX][ROW_LEN_MAX];
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_draw_mask(void)
+{
+    lv_test_print("");
+    lv_test_print("========================");
+    lv_test_print("Start lv_draw_mask tests");
+    lv_test_print("========================");
+
+    lv_test_rnd_seed(54321);
+
+#if LV_RADIUS_CACHE_SIZE
+    radius_cached_exact();
+    radius_cache_lru();
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_RADIUS_CACHE_SIZE
+static void radius_cached_exact(void)
+{
+    lv_test_print("");
+    lv_test_print("Apply radius masks with precomputed corners, compare with the calculated ones:");
+    lv_test_print("------------------------------------------------------------------------------");
+
+    uint32_t i;
+    for(i = 0; i < RADIUS_CASES; i++) {
+        radius_case(i);
+    }
+}
+
+/**
+ * Apply a random radius mask on random rows around its rectangle with a precomputed corner,
+ * then without the cache and compare the results
+ */
+static void radius_case(uint32_t case_id)
+{
+    lv_area_t rect;
+    rect.x1 = 10 + lv_test_rnd(10);
+    rect.y1 = 2;
+    rect.x2 = rect.x1 + lv_test_rnd(RECT_W_MAX);
+    rect.y2 = rect.y1 + lv_test_rnd(RECT_H_MAX);
+    lv_coord_t radius = lv_test_rnd(4) == 0 ? LV_RADIUS_CIRCLE : (lv_coord_t)lv_test_rnd(RECT_H_MAX / 2 + 2);
+    bool inv = lv_test_rnd(2);
+
+    _lv_draw_mask_radius_cache_clean();
+    lv_draw_mask_radius_param_t p;
+    lv_draw_mask_radius_init(&p, &rect, radius, inv);
+    lv_draw_mask_radius_param_t p_ori = p;
+
+    /*Random rows which might start or end in the corners, with random values of the other masks*/
+    lv_coord_t x[ROW_CNT_MAX];
+    lv_coord_t len[ROW_CNT_MAX];
+    lv_coord_t row_cnt = lv_area_get_height(&rect) + 4;
+    lv_coord_t y;
+    for(y = 0; y < row_cnt; y++) {
+        x[y] = lv_test_rnd(ROW_LEN_MAX);
+        len[y] = 1 + lv_test_rnd(ROW_LEN_MAX - x[y]);
+        if(lv_test_rnd(3) == 0) {
+            x[y] = 0;
+            len[y] = ROW_LEN_MAX;
+        }
+
+        lv_coord_t i;
+        for(i = 0; i < ROW_LEN_MAX; i++) rows_ori[y][i] = lv_test_rnd(3) ? LV_OPA_COVER : lv_test_rnd(256);
+        memcpy(rows_cached[y], rows_ori[y], ROW_LEN_MAX);
+        res_cached[y] = p.dsc.cb(&rows_cached[y][x[y]], x[y], y, len[y], &p);
+    }
+
+    /*Calculate the corners again row by row*/
+    _lv_draw_mask_radius_cache_clean();
+    for(y = 0; y < row_cnt; y++) {
+        lv_draw_mask_res_t res = p_ori.dsc.cb(&rows_ori[y][x[y]], x[y], y, len[y], &p_ori);
+
+        /*A transparent row might be returned as cleared. The mask isn't set if it's transparent.*/
+        if(res == LV_DRAW_MASK_RES_TRANSP || res_cached[y] == LV_DRAW_MASK_RES_TRANSP) {
+            if(res == LV_DRAW_MASK_RES_TRANSP) memset(&rows_ori[y][x[y]], 0x00, len[y]);
+            if(res_cached[y] == LV_DRAW_MASK_RES_TRANSP) memset(&rows_cached[y][x[y]], 0x00, len[y]);
+        }
+        else if(res != res_cached[y]) {
+            lv_test_error("case %d: radius %d of %dx%d %s, row %d returns %d instead of %d", case_id, p.cfg.radius,
+                          lv_area_get_width(&rect), lv_area_get_height(&rect), inv ? "outer" : "inner", y,
+                          res_cached[y], res);
+        }
+
+        if(memcmp(rows_ori[y], rows_cached[y], ROW_LEN_MAX) != 0) {
+            lv_coord_t i;
+            for(i = 0; rows_ori[y][i] == rows_cached[y][i]; i++);
+            lv_test_error("case %d: radius %d of %dx%d %s, pixel %d,%d is %d instead of %d", case_id, p.cfg.radius,
+                          lv_area_get_width(&rect), lv_area_get_height(&rect), inv ? "outer" : "inner", i, y,
+                          rows_cached[y][i], rows_ori[y][i]);
+        }
+    }
+}
+
+/**
+ * Add more corners than the cache can hold and see that the least recently used ones are dropped
+ */
+static void radius_cache_lru(void)
+{
+    lv_test_print("");
+    lv_test_print("Drop the least recently used corners:");
+    lv_test_print("-------------------------------------");
+
+    _lv_draw_mask_radius_cache_clean();
+
+    lv_area_t rect;
+    lv_area_set(&rect, 0, 0, 399, 399);
+    lv_draw_mask_radius_param_t p;
+
+    /*Use radius 5 again after every new radius. A radius is added to the full cache when it's used again.*/
+    bool new_cached = true;
+    bool used_kept = true;
+    uint32_t used_max = 0;
+    lv_coord_t radius;
+    for(radius = 10; radius < 100; radius++) {
+        lv_draw_mask_radius_init(&p, &rect, radius, false);
+        lv_draw_mask_radius_init(&p, &rect, radius, false);
+        if(!radius_is_cached(radius)) new_cached = false;
+        lv_draw_mask_radius_init(&p, &rect, 5, false);
+        if(!radius_is_cached(5)) used_kept = false;
+        used_max = LV_MATH_MAX(used_max, radius_cache_used());
+    }
+
+    lv_test_assert_int_eq(1, new_cached, "the new corners are cached");
+    lv_test_assert_int_eq(1, used_kept, "the used corner is kept");
+    lv_test_assert_int_lt(LV_RADIUS_CACHE_SIZE + 1, used_max, "the cache is in its memory limit");
+    lv_test_assert_int_eq(0, radius_is_cached(10), "the oldest corner is dropped");
+    lv_test_assert_int_eq(1, radius_is_cached(99), "the newest corner is kept");
+
+    lv_draw_mask_radius_init(&p, &rect, 150, false);
+    lv_test_assert_int_eq(0, radius_is_cached(150), "a radius used once doesn't drop corners");
+    lv_test_assert_int_eq(1, radius_is_cached(99), "the corners are kept for a radius used once");
+    lv_draw_mask_radius_init(&p, &rect, 150, false);
+    lv_test_assert_int_eq(1, radius_is_cached(150), "a radius used again drops corners");
+
+    _lv_draw_mask_radius_cache_clean();
+    lv_test_assert_int_eq(0, radius_cache_used(), "the cache is empty after clean");
+}
+
+static bool radius_is_cached(lv_coord_t radius)
+{
+    uint32_t i;
+    for(i = 0; i < _LV_MASK_RADIUS_CACHE_NUM; i++) {
+        _lv_draw_mask_radius_corner_t * corner = LV_GC_ROOT(_lv_draw_mask_radius_cache)[i];
+        if(corner && corner->radius == radius) return true;
+    }
+    return false;
+}
+
+static uint32_t radius_cache_used(void)
+{
+    uint32_t used = 0;
+    uint32_t i;
+    for(i = 0; i < _LV_MASK_RADIUS_CACHE_NUM; i++) {
+        _lv_draw_mask_radius_corner_t * corner = LV_GC_ROOT(_lv_draw_mask_radius_cache)[i];
+        if(corner) used += corner->lru.size;
+    }
+    return used;
+}
+
+#endif
+
+#endif
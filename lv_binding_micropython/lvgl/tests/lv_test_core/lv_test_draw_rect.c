@@ -0,0 +1,410 @@
+/**
+ * @file lv_test_draw_rect.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../../src/lv_misc/lv_gc.h"
+#include "../lv_test_assert.h"
+#include "lv_test_core.h"
+#include "lv_test_draw_rect.h"
+
+#if LV_BUILD_TEST
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+/*Size of the display buffer and max. size of the rectangles*/
+#define BUF_W       200
+#define BUF_H       160
+#define RECT_W_MAX  60
+#define RECT_H_MAX  50
+
+#define SHADOW_CASES  300
+#define GRAD_CASES    300
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_USE_SHADOW && LV_SHADOW_CACHE_SIZE
+    static void shadow_cached_exact(void);
+    static bool shadow_case(uint32_t case_id);
+    static void shadow_cache_key(void);
+    static void shadow_cache_clipped(void);
+    static bool shadow_cache_has(lv_coord_t w, lv_coord_t h);
+    static uint32_t shadow_cache_cnt(void);
+#endif
+static void grad_exact(void);
+static uint32_t grad_case(uint32_t case_id);
+static bool grad_px_ok(const lv_draw_rect_dsc_t * dsc, int32_t s, int32_t i, lv_color_t px);
+static void rect_draw(const lv_area_t * coords, const lv_area_t * clip, const lv_draw_rect_dsc_t * dsc);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#if LV_USE_SHADOW && LV_SHADOW_CACHE_SIZE
+    static lv_color_t buf_ref[BUF_W * BUF_H];
+#endif
+static lv_color_t buf_act[BUF_W * BUF_H];
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_draw_rect(void)
+{
+    lv_test_print("");
+    lv_test_print("========================");
+    lv_test_print("Start lv_draw_rect tests");
+    lv_test_print("========================");
+
+    lv_test_rnd_seed(24680);
+
+    /*Make the rectangles draw into the test buffers*/
+    lv_disp_t * disp = lv_disp_get_default();
+    lv_disp_buf_t * vdb = lv_disp_get_buf(disp);
+    lv_disp_t * disp_refr_ori = _lv_refr_get_disp_refreshing();
+    lv_area_t area_ori = vdb->area;
+    lv_color_t * buf_act_ori = vdb->buf_act;
+    _lv_refr_set_disp_refreshing(disp);
+    lv_area_set(&vdb->area, 0, 0, BUF_W - 1, BUF_H - 1);
+
+#if LV_USE_SHADOW && LV_SHADOW_CACHE_SIZE
+    shadow_cached_exact();
+    shadow_cache_key();
+    shadow_cache_clipped();
+    _lv_draw_shadow_cache_clean();
+#endif
+
+    grad_exact();
+
+    vdb->area = area_ori;
+    vdb->buf_act = buf_act_ori;
+    _lv_refr_set_disp_refreshing(disp_refr_ori);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_USE_SHADOW && LV_SHADOW_CACHE_SIZE
+static void shadow_cached_exact(void)
+{
+    lv_test_print("");
+    lv_test_print("Draw clipped shadows with cached corners, compare with the calculated ones:");
+    lv_test_print("---------------------------------------------------------------------------");
+
+    uint32_t shared_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < SHADOW_CASES; i++) {
+        if(shadow_case(i)) shared_cnt++;
+    }
+
+    lv_test_assert_int_gt(0, shared_cnt, "larger shadows share their corners");
+}
+
+/**
+ * Draw a random clipped shadow with a calculated corner. Draw it again with the corner cached by an other
+ * shadow with the same corner and compare the results.
+ * @return true: the corner was cached by a larger shadow
+ */
+static bool shadow_case(uint32_t case_id)
+{
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.bg_opa = LV_OPA_TRANSP;
+    dsc.shadow_color = LV_COLOR_RED;
+    dsc.shadow_width = 1 + lv_test_rnd(30);
+    dsc.shadow_spread = lv_test_rnd(3) ? 0 : (lv_style_int_t)lv_test_rnd(10) - 3;
+    dsc.shadow_ofs_x = lv_test_rnd(2) ? 0 : (lv_style_int_t)lv_test_rnd(11) - 5;
+    dsc.shadow_ofs_y = lv_test_rnd(2) ? 0 : (lv_style_int_t)lv_test_rnd(11) - 5;
+    dsc.shadow_opa = lv_test_rnd(2) ? LV_OPA_COVER : LV_OPA_60;
+    dsc.radius = lv_test_rnd(4) == 0 ? LV_RADIUS_CIRCLE : (lv_style_int_t)lv_test_rnd(30);
+
+    lv_area_t rect;
+    rect.x1 = 60 + lv_test_rnd(20);
+    rect.y1 = 50 + lv_test_rnd(20);
+    rect.x2 = rect.x1 + lv_test_rnd(RECT_W_MAX);
+    rect.y2 = rect.y1 + lv_test_rnd(RECT_H_MAX);
+
+    /*Clip the shadow on any side or not at all*/
+    lv_area_t clip;
+    lv_area_set(&clip, 0, 0, BUF_W - 1, BUF_H - 1);
+    if(lv_test_rnd(3)) {
+        clip.x1 = rect.x1 - 30 + lv_test_rnd(RECT_W_MAX);
+        clip.y1 = rect.y1 - 30 + lv_test_rnd(RECT_H_MAX);
+        clip.x2 = clip.x1 + lv_test_rnd(RECT_W_MAX + 30);
+        clip.y2 = clip.y1 + lv_test_rnd(RECT_H_MAX + 30);
+    }
+
+    _lv_draw_shadow_cache_clean();
+    rect_draw(&rect, &clip, &dsc);
+    memcpy(buf_ref, buf_act, sizeof(buf_ref));
+
+    /*The same or a larger shadow at an other place, might have the same corner*/
+    lv_area_t other;
+    other.x1 = lv_test_rnd(20);
+    other.y1 = lv_test_rnd(20);
+    other.x2 = other.x1 + lv_area_get_width(&rect) - 1 + (lv_test_rnd(2) ? 0 : lv_test_rnd(80));
+    other.y2 = other.y1 + lv_area_get_height(&rect) - 1 + (lv_test_rnd(2) ? 0 : lv_test_rnd(60));
+    lv_area_t full;
+    lv_area_set(&full, 0, 0, BUF_W - 1, BUF_H - 1);
+
+    _lv_draw_shadow_cache_clean();
+    rect_draw(&other, &full, &dsc);
+    uint32_t cnt = shadow_cache_cnt();
+    rect_draw(&rect, &clip, &dsc);
+    bool shared = cnt == 1 && shadow_cache_cnt() == 1;
+
+    if(memcmp(buf_ref, buf_act, sizeof(buf_ref)) != 0) {
+        uint32_t i;
+        for(i = 0; memcmp(&buf_ref[i], &buf_act[i], sizeof(lv_color_t)) == 0; i++);
+        lv_test_error("case %d: shadow width %d, radius %d of %dx%d, pixel %d,%d differs with %s corner", case_id,
+                      dsc.shadow_width, dsc.radius, lv_area_get_width(&rect), lv_area_get_height(&rect),
+                      i % BUF_W, i / BUF_W, shared ? "a cached" : "a calculated");
+    }
+
+    return shared && (lv_area_get_width(&other) != lv_area_get_width(&rect) ||
+                      lv_area_get_height(&other) != lv_area_get_height(&rect));
+}
+
+/**
+ * See which shadows share a corner: the size of the rectangle is part of the key only up to `2 * (sw + r)`
+ */
+static void shadow_cache_key(void)
+{
+    lv_test_print("");
+    lv_test_print("Share the corners of large shadows:");
+    lv_test_print("-----------------------------------");
+
+    _lv_draw_shadow_cache_clean();
+
+    /*The corner is 15 px, rectangles larger than 30 px have the same corner*/
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.bg_opa = LV_OPA_TRANSP;
+    dsc.shadow_width = 10;
+    dsc.radius = 5;
+
+    lv_area_t clip;
+    lv_area_set(&clip, 0, 0, BUF_W - 1, BUF_H - 1);
+    lv_area_t rect;
+    lv_area_set(&rect, 40, 40, 139, 119);
+    rect_draw(&rect, &clip, &dsc);
+    lv_test_assert_int_eq(1, shadow_cache_has(30, 30), "the size is clamped to 2 * (sw + r) in the key");
+
+    lv_area_set(&rect, 60, 30, 119, 129);
+    rect_draw(&rect, &clip, &dsc);
+    dsc.shadow_spread = 5;
+    dsc.shadow_ofs_x = 7;
+    rect_draw(&rect, &clip, &dsc);
+    lv_test_assert_int_eq(1, shadow_cache_cnt(), "large shadows of other sizes, spread and offset share the corner");
+
+    dsc.shadow_spread = 0;
+    lv_area_set(&rect, 60, 30, 79, 129);
+    rect_draw(&rect, &clip, &dsc);
+    lv_test_assert_int_eq(1, shadow_cache_has(20, 30), "a narrow shadow has its own corner");
+
+    /*The radius is limited to the half of the shorter side*/
+    dsc.radius = LV_RADIUS_CIRCLE;
+    lv_area_set(&rect, 60, 30, 83, 129);
+    rect_draw(&rect, &clip, &dsc);
+    lv_test_assert_int_eq(1, shadow_cache_has(24, 44), "a circle is keyed by the size of its corner");
+    lv_test_assert_int_eq(3, shadow_cache_cnt(), "the shadows with other corners don't drop each other");
+}
+
+/**
+ * Cache a corner while drawing only a part of a shadow and draw the whole shadow with it
+ */
+static void shadow_cache_clipped(void)
+{
+    lv_test_print("");
+    lv_test_print("Reuse the corner of a clipped shadow:");
+    lv_test_print("-------------------------------------");
+
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.bg_opa = LV_OPA_TRANSP;
+    dsc.shadow_color = LV_COLOR_RED;
+    dsc.shadow_width = 20;
+    dsc.shadow_ofs_y = 4;
+    dsc.radius = 10;
+
+    lv_area_t rect;
+    lv_area_set(&rect, 50, 40, 149, 119);
+    lv_area_t full;
+    lv_area_set(&full, 0, 0, BUF_W - 1, BUF_H - 1);
+
+    _lv_draw_shadow_cache_clean();
+    rect_draw(&rect, &full, &dsc);
+    memcpy(buf_ref, buf_act, sizeof(buf_ref));
+
+    /*Only a few pixels of the top left corner's outer edge*/
+    lv_area_t clip;
+    lv_area_set(&clip, 38, 32, 42, 36);
+    _lv_draw_shadow_cache_clean();
+    rect_draw(&rect, &clip, &dsc);
+    lv_test_assert_int_eq(1, shadow_cache_cnt(), "a clipped shadow caches its corner");
+
+    rect_draw(&rect, &full, &dsc);
+    lv_test_assert_int_eq(1, shadow_cache_cnt(), "the whole shadow uses the corner of the clipped one");
+    lv_test_assert_int_eq(0, memcmp(buf_ref, buf_act, sizeof(buf_ref)), "the corner of a clipped shadow is complete");
+}
+
+static bool shadow_cache_has(lv_coord_t w, lv_coord_t h)
+{
+    uint32_t i;
+    for(i = 0; i < _LV_SHADOW_CACHE_NUM; i++) {
+        _lv_draw_shadow_corner_t * corner = LV_GC_ROOT(_lv_draw_shadow_cache)[i];
+        if(corner && corner->w == w && corner->h == h) return true;
+    }
+    return false;
+}
+
+static uint32_t shadow_cache_cnt(void)
+{
+    uint32_t cnt = 0;
+    uint32_t i;
+    for(i = 0; i < _LV_SHADOW_CACHE_NUM; i++) {
+        if(LV_GC_ROOT(_lv_draw_shadow_cache)[i]) cnt++;
+    }
+    return cnt;
+}
+
+#endif
+
+static void grad_exact(void)
+{
+    lv_test_print("");
+    lv_test_print("Draw clipped gradients, compare with the calculated colors:");
+    lv_test_print("-----------------------------------------------------------");
+
+    uint32_t checked_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < GRAD_CASES; i++) {
+        checked_cnt += grad_case(i);
+    }
+
+    lv_test_assert_int_gt(0, checked_cnt, "the gradients have the calculated colors");
+}
+
+/**
+ * Draw a random clipped gradient and compare its not masked pixels with the calculated colors
+ * @return number of checked pixels
+ */
+static uint32_t grad_case(uint32_t case_id)
+{
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.bg_color = lv_color_make(lv_test_rnd(256), lv_test_rnd(256), lv_test_rnd(256));
+    dsc.bg_grad_color = lv_color_make(lv_test_rnd(256), lv_test_rnd(256), lv_test_rnd(256));
+    dsc.bg_grad_dir = lv_test_rnd(2) ? LV_GRAD_DIR_HOR : LV_GRAD_DIR_VER;
+    dsc.bg_main_color_stop = lv_test_rnd(2) ? 0 : lv_test_rnd(128);
+    dsc.bg_grad_color_stop = lv_test_rnd(2) ? 255 : 128 + lv_test_rnd(128);
+    dsc.radius = lv_test_rnd(3) ? 0 : lv_test_rnd(15);
+
+    lv_area_t rect;
+    rect.x1 = 10 + lv_test_rnd(40);
+    rect.y1 = 10 + lv_test_rnd(40);
+    rect.x2 = rect.x1 + lv_test_rnd(BUF_W - 60);
+    rect.y2 = rect.y1 + lv_test_rnd(BUF_H - 60);
+
+    lv_area_t clip;
+    lv_area_set(&clip, 0, 0, BUF_W - 1, BUF_H - 1);
+    if(lv_test_rnd(3)) {
+        clip.x1 = rect.x1 - 10 + lv_test_rnd(lv_area_get_width(&rect));
+        clip.y1 = rect.y1 - 10 + lv_test_rnd(lv_area_get_height(&rect));
+        clip.x2 = clip.x1 + lv_test_rnd(lv_area_get_width(&rect) + 10);
+        clip.y2 = clip.y1 + lv_test_rnd(lv_area_get_height(&rect) + 10);
+    }
+
+    rect_draw(&rect, &clip, &dsc);
+
+    /*Skip the rows with rounded corners*/
+    lv_area_t check;
+    if(_lv_area_intersect(&check, &rect, &clip) == false) return 0;
+    int32_t r = LV_MATH_MIN(dsc.radius, LV_MATH_MIN(lv_area_get_width(&rect), lv_area_get_height(&rect)) >> 1);
+    check.y1 = LV_MATH_MAX(check.y1, rect.y1 + r);
+    check.y2 = LV_MATH_MIN(check.y2, rect.y2 - r);
+
+    uint32_t checked_cnt = 0;
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = check.y1; y <= check.y2; y++) {
+        for(x = check.x1; x <= check.x2; x++) {
+            lv_color_t px = buf_act[y * BUF_W + x];
+            bool ok;
+            if(dsc.bg_grad_dir == LV_GRAD_DIR_HOR) ok = grad_px_ok(&dsc, lv_area_get_width(&rect), x - rect.x1, px);
+            else ok = grad_px_ok(&dsc, lv_area_get_height(&rect), y - rect.y1, px);
+
+            if(!ok) {
+                lv_test_error("case %d: %s gradient of %dx%d, pixel %d,%d differs", case_id,
+                              dsc.bg_grad_dir == LV_GRAD_DIR_HOR ? "horizontal" : "vertical",
+                              lv_area_get_width(&rect), lv_area_get_height(&rect), x, y);
+            }
+            checked_cnt++;
+        }
+    }
+
+    return checked_cnt;
+}
+
+/**
+ * Check the color of a pixel of a gradient
+ * @param dsc the descriptor of the gradient
+ * @param s size of the gradient
+ * @param i position of the pixel in the gradient
+ * @param px the drawn color
+ * @return true: the color is the calculated one (or one of its nearest colors if the gradient is dithered)
+ */
+static bool grad_px_ok(const lv_draw_rect_dsc_t * dsc, int32_t s, int32_t i, lv_color_t px)
+{
+    int32_t min = (dsc->bg_main_color_stop * s) >> 8;
+    int32_t max = (dsc->bg_grad_color_stop * s) >> 8;
+    int32_t mix;
+    if(i <= min) mix = 0;
+    else if(i >= max) mix = 255;
+    else mix = ((i - min) * 255) / ((s * (dsc->bg_grad_color_stop - dsc->bg_main_color_stop)) >> 8);
+
+#if LV_DITHER_GRADIENT && LV_COLOR_DEPTH == 16
+    /*The dithered channels are rounded up or down from the exact mix*/
+    int32_t sum[3];
+    sum[0] = LV_COLOR_GET_R(dsc->bg_grad_color) * mix + LV_COLOR_GET_R(dsc->bg_color) * (255 - mix);
+    sum[1] = LV_COLOR_GET_G(dsc->bg_grad_color) * mix + LV_COLOR_GET_G(dsc->bg_color) * (255 - mix);
+    sum[2] = LV_COLOR_GET_B(dsc->bg_grad_color) * mix + LV_COLOR_GET_B(dsc->bg_color) * (255 - mix);
+    int32_t ch[3] = {LV_COLOR_GET_R(px), LV_COLOR_GET_G(px), LV_COLOR_GET_B(px)};
+    uint32_t c;
+    for(c = 0; c < 3; c++) {
+        if(ch[c] * 255 <= sum[c] - 255 || ch[c] * 255 >= sum[c] + 255) return false;
+    }
+    return true;
+#else
+    return px.full == lv_color_mix(dsc->bg_grad_color, dsc->bg_color, mix).full;
+#endif
+}
+
+/**
+ * Clear the test buffer and draw a rectangle
+ */
+static void rect_draw(const lv_area_t * coords, const lv_area_t * clip, const lv_draw_rect_dsc_t * dsc)
+{
+    uint32_t i;
+    for(i = 0; i < BUF_W * BUF_H; i++) buf_act[i] = LV_COLOR_WHITE;
+
+    lv_disp_get_buf(lv_disp_get_default())->buf_act = buf_act;
+    lv_draw_rect(coords, clip, dsc);
+}
+
+#endif
@@ -0,0 +1,514 @@
+/**
+ * @file lv_test_refr.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_refr.h"
+
+#if LV_BUILD_TEST
+
+#if LV_REFR_PARALLEL_MAX > 1
+    #include <pthread.h>
+    #include <unistd.h>
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+#define CARD_COLS 4
+#define CARD_ROWS 2
+
+/*Bands of the parallel test and the number of frames to measure*/
+#define PARALLEL_CNT    4
+#define PARALLEL_FRAMES 20
+#define IMG_SIZE        32
+
+/*Distance of the rows in the scrolled page and of a scroll step*/
+#define SCROLL_ROW_H 20
+#define SCROLL_STEP  7
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+#if LV_REFR_PARALLEL_MAX > 1
+typedef struct {
+    void (*band_cb)(uint32_t id);
+    uint32_t id;
+} band_job_t;
+#endif
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void occlusion(void);
+static lv_design_res_t card_design(lv_obj_t * obj, const lv_area_t * clip_area, lv_design_mode_t mode);
+static uint32_t redraw(void);
+#if LV_USE_PERF_STATS && LV_USE_BTN && LV_USE_LABEL
+    static void perf_stats(void);
+    static const lv_perf_widget_t * perf_widget(const char * name);
+#endif
+#if LV_REFR_PARALLEL_MAX > 1 && LV_USE_LABEL && LV_USE_IMG
+    static void parallel(void);
+    static void parallel_scene(void);
+    static uint32_t parallel_bench(void);
+    static bool pthread_parallel_cb(lv_disp_drv_t * disp_drv, void (*band_cb)(uint32_t id), uint32_t band_cnt);
+    static void * band_thread(void * p);
+#endif
+#if LV_USE_PAGE && LV_USE_LABEL
+    static void scroll(void);
+    static void scroll_flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
+    static bool scroll_copy_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_coord_t dx, lv_coord_t dy);
+    static uint32_t scroll_redraw(void);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_design_cb_t ancestor_design;
+static uint32_t card_draw_cnt;
+#if LV_REFR_PARALLEL_MAX > 1 && LV_USE_LABEL && LV_USE_IMG
+    static lv_color_t serial_fb[LV_HOR_RES_MAX * LV_VER_RES_MAX];
+    static uint8_t img_map[IMG_SIZE * IMG_SIZE * LV_IMG_PX_SIZE_ALPHA_BYTE];
+    static lv_img_dsc_t img_dsc;
+#endif
+#if LV_USE_PAGE && LV_USE_LABEL
+    static lv_color_t scroll_fb[LV_HOR_RES_MAX * LV_VER_RES_MAX];
+    #if LV_ANTIALIAS
+        static lv_color_t scroll_ref[LV_HOR_RES_MAX * LV_VER_RES_MAX];
+    #endif
+    static uint32_t scroll_flush_px;
+    static uint32_t scroll_copy_cnt;
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_refr(void)
+{
+    lv_test_print("");
+    lv_test_print("===================");
+    lv_test_print("Start lv_refr tests");
+    lv_test_print("===================");
+
+    occlusion();
+#if LV_USE_PERF_STATS && LV_USE_BTN && LV_USE_LABEL
+    perf_stats();
+#endif
+#if LV_REFR_PARALLEL_MAX > 1 && LV_USE_LABEL && LV_USE_IMG
+    parallel();
+#endif
+#if LV_USE_PAGE && LV_USE_LABEL
+    scroll();
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void occlusion(void)
+{
+    lv_test_print("");
+    lv_test_print("Objects covered by an opaque panel are not drawn:");
+    lv_test_print("-------------------------------------------------");
+
+    lv_obj_t * scr = lv_scr_act();
+    lv_coord_t w = lv_obj_get_width(scr);
+    lv_coord_t h = lv_obj_get_height(scr);
+
+    /*A grid of cards and a panel above them*/
+    uint32_t i;
+    for(i = 0; i < CARD_COLS * CARD_ROWS; i++) {
+        lv_obj_t * card = lv_obj_create(scr, NULL);
+        lv_obj_set_style_local_radius(card, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 0);
+        lv_obj_set_style_local_shadow_width(card, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 0);
+        lv_obj_set_style_local_outline_width(card, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 0);
+        lv_obj_set_pos(card, (i % CARD_COLS) * w / CARD_COLS + 2, (i / CARD_COLS) * h / CARD_ROWS + 2);
+        lv_obj_set_size(card, w / CARD_COLS - 4, h / CARD_ROWS - 4);
+        ancestor_design = lv_obj_get_design_cb(card);
+        lv_obj_set_design_cb(card, card_design);
+    }
+
+    lv_obj_t * panel = lv_obj_create(scr, NULL);
+    lv_obj_set_style_local_radius(panel, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 0);
+    lv_obj_set_style_local_shadow_width(panel, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 0);
+    lv_obj_set_style_local_outline_width(panel, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 0);
+    lv_obj_set_style_local_bg_opa(panel, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_OPA_COVER);
+    lv_obj_set_pos(panel, 0, 0);
+    lv_obj_set_size(panel, w, h);
+
+    lv_test_assert_int_eq(0, redraw(), "Cards drawn below a full screen panel");
+
+    lv_obj_set_width(panel, w / 2);
+    lv_test_assert_int_eq(CARD_COLS * CARD_ROWS / 2, redraw(), "Cards drawn next to a half screen panel");
+
+    lv_obj_set_size(panel, w / CARD_COLS / 2, h);
+    lv_test_assert_int_eq(CARD_COLS * CARD_ROWS, redraw(), "Cards drawn next to a narrow panel");
+
+    lv_obj_set_size(panel, w, h);
+    lv_obj_set_style_local_bg_opa(panel, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_OPA_50);
+    lv_test_assert_int_eq(CARD_COLS * CARD_ROWS, redraw(), "Cards drawn below a translucent panel");
+
+    lv_obj_set_style_local_bg_opa(panel, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_OPA_COVER);
+    lv_obj_set_style_local_radius(panel, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 10);
+    lv_test_assert_int_gt(0, redraw(), "Cards drawn below a rounded panel");
+
+    lv_obj_clean(scr);
+}
+
+static lv_design_res_t card_design(lv_obj_t * obj, const lv_area_t * clip_area, lv_design_mode_t mode)
+{
+    if(mode == LV_DESIGN_DRAW_MAIN) card_draw_cnt++;
+    return ancestor_design(obj, clip_area, mode);
+}
+
+/**
+ * Redraw the whole screen
+ * @return number of cards drawn
+ */
+static uint32_t redraw(void)
+{
+    card_draw_cnt = 0;
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    return card_draw_cnt;
+}
+
+#if LV_USE_PERF_STATS && LV_USE_BTN && LV_USE_LABEL
+static void perf_stats(void)
+{
+    lv_test_print("");
+    lv_test_print("Collect the refresh statistics:");
+    lv_test_print("-------------------------------");
+
+    lv_obj_t * scr = lv_scr_act();
+    uint32_t i;
+    for(i = 0; i < CARD_COLS; i++) {
+        lv_obj_t * btn = lv_btn_create(scr, NULL);
+        lv_obj_set_style_local_radius(btn, LV_BTN_PART_MAIN, LV_STATE_DEFAULT, 8);
+        lv_obj_set_pos(btn, i * lv_obj_get_width(scr) / CARD_COLS, 10);
+        lv_obj_t * label = lv_label_create(btn, NULL);
+        lv_label_set_text(label, "Button");
+    }
+
+    lv_perf_reset();
+    redraw();
+
+    lv_perf_stats_t * stats = lv_perf_stats();
+    lv_test_assert_int_eq(1, stats->frame.cnt, "One frame is counted");
+    lv_test_assert_int_eq(1, stats->flush.cnt, "One flush sample per frame");
+    lv_test_assert_int_gt(0, stats->area.cnt, "Areas are counted");
+    lv_test_assert_int_eq(stats->frame.ring[0], stats->frame.sum, "The sample is in the ring buffer");
+
+    uint32_t bin_sum = 0;
+    for(i = 0; i < LV_PERF_BIN_CNT; i++) bin_sum += stats->area.bins[i];
+    lv_test_assert_int_eq(stats->area.cnt, bin_sum, "Every area sample is in a bin");
+
+    uint32_t scr_px = lv_obj_get_width(scr) * lv_obj_get_height(scr);
+    lv_test_assert_int_gt(scr_px - 1, stats->blend_px.sum, "The screen background is blended");
+    lv_test_assert_int_gt(0, stats->masks.sum, "The rounded buttons add masks");
+
+    const lv_perf_widget_t * btn_stats = perf_widget("lv_btn");
+    const lv_perf_widget_t * label_stats = perf_widget("lv_label");
+    lv_test_assert_true(btn_stats != NULL, "The buttons are a widget type");
+    lv_test_assert_true(label_stats != NULL, "The labels are a widget type");
+    if(btn_stats) lv_test_assert_int_eq(CARD_COLS * 2, btn_stats->design.cnt, "Main and post draw of the buttons");
+    if(label_stats) lv_test_assert_int_eq(CARD_COLS * 2, label_stats->design.cnt, "Main and post draw of the labels");
+
+    redraw();
+    lv_test_assert_int_eq(2, stats->frame.cnt, "The next frame is counted");
+
+    lv_perf_reset();
+    lv_test_assert_int_eq(0, stats->frame.cnt, "No frames after reset");
+    lv_test_assert_int_eq(0, stats->widget_cnt, "No widget types after reset");
+
+    lv_obj_clean(scr);
+}
+
+/**
+ * Find the statistics of a widget type
+ * @param name name of the type, e.g. "lv_btn"
+ * @return the statistics or NULL if not found
+ */
+static const lv_perf_widget_t * perf_widget(const char * name)
+{
+    lv_perf_stats_t * stats = lv_perf_stats();
+    uint32_t i;
+    for(i = 0; i < stats->widget_cnt; i++) {
+        if(strcmp(stats->widgets[i].name, name) == 0) return &stats->widgets[i];
+    }
+    return NULL;
+}
+#endif
+
+#if LV_REFR_PARALLEL_MAX > 1 && LV_USE_LABEL && LV_USE_IMG
+static void parallel(void)
+{
+    lv_test_print("");
+    lv_test_print("Render in parallel bands, compare with the serial rendering:");
+    lv_test_print("------------------------------------------------------------");
+
+    extern lv_color_t test_fb[];
+    lv_disp_drv_t * drv = &lv_disp_get_default()->driver;
+    uint32_t fb_size = lv_disp_get_hor_res(NULL) * lv_disp_get_ver_res(NULL) * sizeof(lv_color_t);
+
+    parallel_scene();
+
+    redraw();
+    _lv_memcpy(serial_fb, test_fb, fb_size);
+    uint32_t serial_ms = parallel_bench();
+
+    drv->parallel_cb = pthread_parallel_cb;
+    drv->parallel_cnt = PARALLEL_CNT;
+
+    redraw();
+    lv_test_assert_true(memcmp(serial_fb, test_fb, fb_size) == 0, "Parallel rendering equals the serial one");
+
+    /*The workers can't open images, their bands are rendered again after the parallel section*/
+    lv_img_cache_invalidate_src(NULL);
+    redraw();
+    lv_test_assert_true(memcmp(serial_fb, test_fb, fb_size) == 0, "Bands with uncached images are rendered again");
+
+    /*The workers spin while waiting, measure with one band per core*/
+    long core_cnt = sysconf(_SC_NPROCESSORS_ONLN);
+    drv->parallel_cnt = LV_MATH_MAX(core_cnt, 1);
+    uint32_t parallel_ms = parallel_bench();
+
+    lv_test_print("%d frames: serial %d ms, %d cores %d ms", PARALLEL_FRAMES, serial_ms, drv->parallel_cnt, parallel_ms);
+
+    drv->parallel_cb = NULL;
+    drv->parallel_cnt = 1;
+    lv_obj_clean(lv_scr_act());
+}
+
+/**
+ * Cards with shadows and clipped corners, labels and images
+ */
+static void parallel_scene(void)
+{
+    uint32_t i;
+    for(i = 0; i < IMG_SIZE * IMG_SIZE; i++) {
+        lv_color_t c = lv_color_make(i * 8, (i / IMG_SIZE) * 8, 0x80);
+        _lv_memcpy(&img_map[i * LV_IMG_PX_SIZE_ALPHA_BYTE], &c, sizeof(lv_color_t));
+        img_map[i * LV_IMG_PX_SIZE_ALPHA_BYTE + LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = (i % IMG_SIZE) * 8;
+    }
+    img_dsc.header.cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
+    img_dsc.header.w = IMG_SIZE;
+    img_dsc.header.h = IMG_SIZE;
+    img_dsc.data_size = sizeof(img_map);
+    img_dsc.data = img_map;
+
+    lv_obj_t * scr = lv_scr_act();
+    lv_coord_t w = lv_obj_get_width(scr);
+    lv_coord_t h = lv_obj_get_height(scr);
+
+    for(i = 0; i < CARD_COLS * CARD_ROWS; i++) {
+        lv_obj_t * card = lv_obj_create(scr, NULL);
+        lv_obj_set_style_local_radius(card, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 12);
+        lv_obj_set_style_local_clip_corner(card, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, true);
+        lv_obj_set_style_local_shadow_width(card, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, 10);
+        lv_obj_set_style_local_bg_grad_color(card, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_BLUE);
+        lv_obj_set_style_local_bg_grad_dir(card, LV_OBJ_PART_MAIN, LV_STATE_DEFAULT, LV_GRAD_DIR_VER);
+        lv_obj_set_pos(card, (i % CARD_COLS) * w / CARD_COLS + 8, (i / CARD_COLS) * h / CARD_ROWS + 8);
+        lv_obj_set_size(card, w / CARD_COLS - 16, h / CARD_ROWS - 16);
+
+        lv_obj_t * label = lv_label_create(card, NULL);
+        lv_label_set_text(label, "Parallel\nrendering (1+2)");
+        lv_obj_set_pos(label, 4, 4);
+
+        lv_obj_t * img = lv_img_create(card, NULL);
+        lv_img_set_src(img, &img_dsc);
+        lv_obj_set_pos(img, 4, lv_obj_get_height(card) - IMG_SIZE - 4);
+    }
+}
+
+/**
+ * Redraw the screen several times
+ * @return the elapsed milliseconds
+ */
+static uint32_t parallel_bench(void)
+{
+    /*The LVGL tick doesn't run in the tests*/
+    uint32_t t = custom_tick_get();
+    uint32_t i;
+    for(i = 0; i < PARALLEL_FRAMES; i++) redraw();
+    return custom_tick_get() - t;
+}
+
+/**
+ * The display driver's `parallel_cb`: a thread for each band except the first one
+ */
+static bool pthread_parallel_cb(lv_disp_drv_t * disp_drv, void (*band_cb)(uint32_t id), uint32_t band_cnt)
+{
+    LV_UNUSED(disp_drv);
+
+    pthread_t threads[LV_REFR_PARALLEL_MAX];
+    band_job_t jobs[LV_REFR_PARALLEL_MAX];
+    uint32_t i;
+    for(i = 1; i < band_cnt; i++) {
+        jobs[i].band_cb = band_cb;
+        jobs[i].id = i;
+        if(pthread_create(&threads[i], NULL, band_thread, &jobs[i]) != 0) {
+            lv_test_error("Can't start a band thread");
+        }
+    }
+
+    band_cb(0);
+
+    for(i = 1; i < band_cnt; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    return true;
+}
+
+static void * band_thread(void * p)
+{
+    band_job_t * job = p;
+    job->band_cb(job->id);
+    return NULL;
+}
+#endif
+
+#if LV_USE_PAGE && LV_USE_LABEL
+static void scroll(void)
+{
+    lv_test_print("");
+    lv_test_print("Scroll a page by moving its pixels:");
+    lv_test_print("-----------------------------------");
+
+    lv_disp_drv_t * drv = &lv_disp_get_default()->driver;
+    void (*flush_cb)(lv_disp_drv_t *, const lv_area_t *, lv_color_t *) = drv->flush_cb;
+#if LV_ANTIALIAS
+    uint32_t fb_size = lv_disp_get_hor_res(NULL) * lv_disp_get_ver_res(NULL) * sizeof(lv_color_t);
+#endif
+    drv->flush_cb = scroll_flush_cb;
+    drv->copy_cb = scroll_copy_cb;
+
+    lv_obj_t * page = lv_page_create(lv_scr_act(), NULL);
+    lv_obj_set_size(page, lv_obj_get_width(lv_scr_act()) / 2, lv_obj_get_height(lv_scr_act()) - 20);
+    lv_obj_set_pos(page, 10, 10);
+    /*Twice as high as the screen to be scrollable*/
+    uint32_t row_cnt = 2 * lv_obj_get_height(lv_scr_act()) / SCROLL_ROW_H;
+    uint32_t i;
+    for(i = 0; i < row_cnt; i++) {
+        lv_obj_t * label = lv_label_create(page, NULL);
+        lv_label_set_text_fmt(label, "Row %d", i);
+        lv_obj_set_y(label, i * SCROLL_ROW_H);
+    }
+    lv_obj_t * scrl = lv_page_get_scrollable(page);
+    uint32_t full_px = scroll_redraw();
+
+    scroll_copy_cnt = 0;
+    scroll_flush_px = 0;
+    lv_obj_set_y(scrl, lv_obj_get_y(scrl) - SCROLL_STEP);
+    lv_refr_now(NULL);
+    lv_test_assert_int_eq(1, scroll_copy_cnt, "The pixels are moved once");
+    lv_test_assert_int_lt(full_px / 4, scroll_flush_px, "Only a few rows are redrawn");
+
+    /*Two steps in one refresh are moved together*/
+    lv_obj_set_y(scrl, lv_obj_get_y(scrl) - SCROLL_STEP);
+    lv_obj_set_y(scrl, lv_obj_get_y(scrl) - SCROLL_STEP);
+    lv_refr_now(NULL);
+    lv_test_assert_int_eq(2, scroll_copy_cnt, "Two steps are moved at once");
+
+    /*Without anti-aliasing only the first row of a mask is rounded when blending,
+     *so text cut by the edge of a redrawn area can differ from a full redraw*/
+#if LV_ANTIALIAS
+    _lv_memcpy(scroll_ref, scroll_fb, fb_size);
+    scroll_redraw();
+    lv_test_assert_true(memcmp(scroll_ref, scroll_fb, fb_size) == 0, "Moved pixels equal the redrawn ones");
+#endif
+
+    /*A gradient background moves with the content, it can't be moved*/
+    lv_obj_set_style_local_bg_grad_dir(page, LV_PAGE_PART_BG, LV_STATE_DEFAULT, LV_GRAD_DIR_VER);
+    lv_obj_set_style_local_bg_grad_color(page, LV_PAGE_PART_BG, LV_STATE_DEFAULT, LV_COLOR_BLUE);
+    scroll_redraw();
+    lv_obj_set_y(scrl, lv_obj_get_y(scrl) + SCROLL_STEP);
+    lv_refr_now(NULL);
+    lv_test_assert_int_eq(2, scroll_copy_cnt, "Not moved over a gradient");
+
+    /*Nothing can be moved below an object on the page*/
+    lv_obj_set_style_local_bg_grad_dir(page, LV_PAGE_PART_BG, LV_STATE_DEFAULT, LV_GRAD_DIR_NONE);
+    lv_obj_t * cover = lv_obj_create(lv_scr_act(), NULL);
+    lv_obj_set_pos(cover, 20, 20);
+    scroll_redraw();
+    lv_obj_set_y(scrl, lv_obj_get_y(scrl) + SCROLL_STEP);
+    lv_refr_now(NULL);
+    lv_test_assert_int_eq(2, scroll_copy_cnt, "Not moved below an other object");
+
+#if LV_ANTIALIAS
+    _lv_memcpy(scroll_ref, scroll_fb, fb_size);
+    scroll_redraw();
+    lv_test_assert_true(memcmp(scroll_ref, scroll_fb, fb_size) == 0, "Redrawn pixels are the same as in a full redraw");
+#endif
+
+    drv->flush_cb = flush_cb;
+    drv->copy_cb = NULL;
+    lv_obj_clean(lv_scr_act());
+}
+
+static void scroll_flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    lv_coord_t hor_res = lv_disp_get_hor_res(NULL);
+    lv_coord_t w = lv_area_get_width(area);
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        _lv_memcpy(&scroll_fb[y * hor_res + area->x1], color_p, w * sizeof(lv_color_t));
+        color_p += w;
+    }
+
+    scroll_flush_px += lv_area_get_size(area);
+    lv_disp_flush_ready(disp_drv);
+}
+
+/**
+ * The display driver's `copy_cb`: move the pixels in the frame buffer
+ */
+static bool scroll_copy_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_coord_t dx, lv_coord_t dy)
+{
+    LV_UNUSED(disp_drv);
+
+    lv_coord_t hor_res = lv_disp_get_hor_res(NULL);
+    lv_coord_t w = lv_area_get_width(area) - LV_MATH_ABS(dx);
+    lv_coord_t h = lv_area_get_height(area) - LV_MATH_ABS(dy);
+    lv_coord_t src_x = area->x1 + LV_MATH_MAX(-dx, 0);
+    lv_coord_t src_y = area->y1 + LV_MATH_MAX(-dy, 0);
+    lv_coord_t dst_x = area->x1 + LV_MATH_MAX(dx, 0);
+    lv_coord_t dst_y = area->y1 + LV_MATH_MAX(dy, 0);
+
+    lv_coord_t i;
+    for(i = 0; i < h; i++) {
+        lv_coord_t y = dy > 0 ? h - 1 - i : i;
+        memmove(&scroll_fb[(dst_y + y) * hor_res + dst_x], &scroll_fb[(src_y + y) * hor_res + src_x],
+                w * sizeof(lv_color_t));
+    }
+
+    scroll_copy_cnt++;
+    return true;
+}
+
+/**
+ * Redraw the whole screen
+ * @return number of flushed pixels
+ */
+static uint32_t scroll_redraw(void)
+{
+    scroll_flush_px = 0;
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    return scroll_flush_px;
+}
+#endif
+
+#endif
@@ -0,0 +1,326 @@
+/**
+ * @file lv_test_region.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include "../lv_test_assert.h"
+#include "lv_test_core.h"
+#include "lv_test_region.h"
+
+#if LV_BUILD_TEST
+
+/*********************
+ *      DEFINES
+ *********************/
+#define GRID_W  40
+#define GRID_H  30
+
+/*Dashboard of labels for the benchmark*/
+#define DASH_W      800
+#define DASH_H      480
+#define DASH_COLS   8
+#define DASH_ROWS   12
+#define DASH_FRAMES 200
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void random_union_subtract(void);
+static void simplify(void);
+static void dashboard_bench(void);
+static bool region_check(const lv_region_t * reg, const uint8_t * grid);
+static void rnd_area(lv_area_t * a);
+static uint32_t legacy_frame(const lv_area_t * areas, uint32_t cnt);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_test_region(void)
+{
+    lv_test_print("");
+    lv_test_print("=====================");
+    lv_test_print("Start lv_region tests");
+    lv_test_print("=====================");
+
+    lv_test_rnd_seed(12345);
+
+    random_union_subtract();
+    simplify();
+    dashboard_bench();
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void random_union_subtract(void)
+{
+    lv_test_print("");
+    lv_test_print("Union and subtract random areas, compare with a bitmap:");
+    lv_test_print("-------------------------------------------------------");
+
+    static uint8_t grid[GRID_W * GRID_H];
+    _lv_memset_00(grid, sizeof(grid));
+
+    lv_region_t reg;
+    lv_region_init(&reg);
+
+    bool ok = true;
+    bool oom = false;
+    uint32_t i;
+    for(i = 0; i < 300 && ok; i++) {
+        lv_area_t a;
+        rnd_area(&a);
+        bool add = lv_test_rnd(3) != 0;
+        bool res = add ? lv_region_union_area(&reg, &a) : lv_region_subtract_area(&reg, &a);
+        if(res == false) {
+            lv_test_print("Out of memory after %d operations", i);
+            oom = true;
+            break;
+        }
+
+        lv_coord_t x, y;
+        for(y = a.y1; y <= a.y2; y++) {
+            for(x = a.x1; x <= a.x2; x++) grid[y * GRID_W + x] = add ? 1 : 0;
+        }
+
+        ok = region_check(&reg, grid);
+
+        lv_area_t probe;
+        rnd_area(&probe);
+        bool in = true;
+        for(y = probe.y1; y <= probe.y2; y++) {
+            for(x = probe.x1; x <= probe.x2; x++) if(grid[y * GRID_W + x] == 0) in = false;
+        }
+        if(in != lv_region_is_in(&reg, &probe)) ok = false;
+    }
+    lv_test_assert_true(ok, "Region equals the bitmap after each operation");
+
+    lv_region_t copy;
+    lv_region_init(&copy);
+    if(!oom && lv_region_copy(&copy, &reg)) {
+        lv_test_assert_true(region_check(&copy, grid), "Copy equals the bitmap");
+    }
+
+    lv_area_t all = {0, 0, GRID_W - 1, GRID_H - 1};
+    lv_region_union_area(&reg, &all);
+    lv_test_assert_int_eq(1, reg.cnt, "Rectangles after adding the whole grid");
+    lv_region_subtract_area(&reg, &all);
+    lv_test_assert_true(lv_region_is_empty(&reg), "Empty after removing the whole grid");
+
+    lv_region_free(&copy);
+    lv_region_free(&reg);
+}
+
+static void simplify(void)
+{
+    lv_test_print("");
+    lv_test_print("Simplify keeps all pixels with fewer rectangles:");
+    lv_test_print("-----------------------------------------------");
+
+    lv_region_t reg;
+    lv_region_t ori;
+    lv_region_init(&reg);
+    lv_region_init(&ori);
+
+    uint32_t i;
+    for(i = 0; i < 40; i++) {
+        lv_area_t a;
+        rnd_area(&a);
+        lv_region_union_area(&reg, &a);
+    }
+    lv_region_copy(&ori, &reg);
+
+    lv_region_simplify(&reg, 4);
+    lv_test_assert_true(reg.cnt <= 4, "At most 4 rectangles");
+
+    bool ok = true;
+    for(i = 0; i < ori.cnt; i++) {
+        if(lv_region_is_in(&reg, &ori.rects[i]) == false) ok = false;
+    }
+    lv_test_assert_true(ok, "All original pixels are kept");
+    lv_test_assert_true(lv_region_get_size(&reg) >= lv_region_get_size(&ori), "Size is not smaller");
+
+    lv_region_simplify(&reg, 1);
+    lv_test_assert_int_eq(1, reg.cnt, "One rectangle");
+    lv_test_assert_true(lv_region_is_in(&reg, &ori.extents), "It's the bounding box");
+
+    lv_region_free(&ori);
+    lv_region_free(&reg);
+}
+
+/**
+ * Labels on a dashboard are updated a few at a time. Count the pixels that
+ * would be redrawn per frame with the former 32-entry area buffer and with
+ * the region simplified to the same number of rectangles.
+ */
+static void dashboard_bench(void)
+{
+    lv_test_print("");
+    lv_test_print("Redrawn pixels of a dashboard, area buffer vs. region:");
+    lv_test_print("------------------------------------------------------");
+
+    lv_region_t reg;
+    lv_region_init(&reg);
+
+    static lv_area_t areas[DASH_COLS * DASH_ROWS * 2];
+    uint32_t cell_w = DASH_W / DASH_COLS;
+    uint32_t cell_h = DASH_H / DASH_ROWS;
+
+    uint32_t updates;
+    for(updates = 4; updates <= DASH_COLS * DASH_ROWS; updates *= 2) {
+        uint64_t exact_sum = 0;
+        uint64_t region_sum = 0;
+        uint64_t legacy_sum = 0;
+        uint32_t rects_max = 0;
+        bool oom = false;
+
+        uint32_t f;
+        for(f = 0; f < DASH_FRAMES; f++) {
+            uint32_t cnt = 0;
+            uint32_t u;
+            for(u = 0; u < updates; u++) {
+                /*The old and the new text of a label*/
+                uint32_t cell = lv_test_rnd(DASH_COLS * DASH_ROWS);
+                lv_coord_t x = (cell % DASH_COLS) * cell_w + 4;
+                lv_coord_t y = (cell / DASH_COLS) * cell_h + 8;
+                uint32_t k;
+                for(k = 0; k < 2; k++) {
+                    lv_area_set(&areas[cnt], x, y, x + 20 + lv_test_rnd(cell_w - 28), y + 16);
+                    if(lv_region_union_area(&reg, &areas[cnt]) == false) oom = true;
+                    cnt++;
+                }
+            }
+
+            exact_sum += lv_region_get_size(&reg);
+            lv_region_simplify(&reg, LV_INV_BUF_SIZE);
+            region_sum += lv_region_get_size(&reg);
+            if(reg.cnt > rects_max) rects_max = reg.cnt;
+            lv_region_clear(&reg);
+
+            legacy_sum += legacy_frame(areas, cnt);
+        }
+
+        lv_test_print("%3d labels/frame: exact %6d px, region %6d px (max. %d rects), area buffer %6d px",
+                      updates, (int)(exact_sum / DASH_FRAMES), (int)(region_sum / DASH_FRAMES), rects_max,
+                      (int)(legacy_sum / DASH_FRAMES));
+
+        /*Out of memory the region falls back to the bounding box*/
+        if(!oom) lv_test_assert_true(region_sum <= legacy_sum, "Region redraws no more than the area buffer");
+    }
+
+    lv_region_free(&reg);
+}
+
+/**
+ * The invalidation of lv_refr.c before regions: up to LV_INV_BUF_SIZE areas,
+ * the whole screen on overflow, then areas joined pairwise if it's cheaper.
+ * @return the number of redrawn pixels
+ */
+static uint32_t legacy_frame(const lv_area_t * areas, uint32_t cnt)
+{
+    lv_area_t inv[LV_INV_BUF_SIZE];
+    uint8_t joined[LV_INV_BUF_SIZE];
+    uint32_t inv_p = 0;
+    lv_area_t scr = {0, 0, DASH_W - 1, DASH_H - 1};
+
+    uint32_t i, j;
+    for(i = 0; i < cnt; i++) {
+        for(j = 0; j < inv_p; j++) {
+            if(_lv_area_is_in(&areas[i], &inv[j], 0)) break;
+        }
+        if(j < inv_p) continue;
+
+        if(inv_p < LV_INV_BUF_SIZE) {
+            lv_area_copy(&inv[inv_p], &areas[i]);
+        }
+        else {
+            inv_p = 0;
+            lv_area_copy(&inv[inv_p], &scr);
+        }
+        inv_p++;
+    }
+
+    _lv_memset_00(joined, sizeof(joined));
+    for(i = 0; i < inv_p; i++) {
+        if(joined[i]) continue;
+        for(j = 0; j < inv_p; j++) {
+            if(joined[j] || i == j) continue;
+            if(_lv_area_is_on(&inv[i], &inv[j]) == false) continue;
+
+            lv_area_t a;
+            _lv_area_join(&a, &inv[i], &inv[j]);
+            if(lv_area_get_size(&a) < lv_area_get_size(&inv[i]) + lv_area_get_size(&inv[j])) {
+                lv_area_copy(&inv[i], &a);
+                joined[j] = 1;
+            }
+        }
+    }
+
+    uint32_t px = 0;
+    for(i = 0; i < inv_p; i++) {
+        if(joined[i] == 0) px += lv_area_get_size(&inv[i]);
+    }
+
+    return px;
+}
+
+/**
+ * Check the y-x banded structure of a region and compare it with a bitmap
+ */
+static bool region_check(const lv_region_t * reg, const uint8_t * grid)
+{
+    static uint8_t cover[GRID_W * GRID_H];
+    _lv_memset_00(cover, sizeof(cover));
+
+    uint32_t i;
+    for(i = 0; i < reg->cnt; i++) {
+        const lv_area_t * r = &reg->rects[i];
+        if(r->x1 > r->x2 || r->y1 > r->y2) return false;
+        if(i > 0) {
+            const lv_area_t * p = &reg->rects[i - 1];
+            if(p->y1 == r->y1) {
+                /*Same band: same rows, sorted, not touching*/
+                if(p->y2 != r->y2 || p->x2 + 1 >= r->x1) return false;
+            }
+            else if(p->y2 >= r->y1) {
+                return false;
+            }
+        }
+        if(_lv_area_is_in(r, &reg->extents, 0) == false) return false;
+
+        lv_coord_t x, y;
+        for(y = r->y1; y <= r->y2; y++) {
+            for(x = r->x1; x <= r->x2; x++) cover[y * GRID_W + x] = 1;
+        }
+    }
+
+    return memcmp(cover, grid, sizeof(cover)) == 0;
+}
+
+static void rnd_area(lv_area_t * a)
+{
+    a->x1 = lv_test_rnd(GRID_W);
+    a->y1 = lv_test_rnd(GRID_H);
+    a->x2 = a->x1 + lv_test_rnd(GRID_W - a->x1);
+    a->y2 = a->y1 + lv_test_rnd(GRID_H - a->y1);
+}
+
+#endif